@@ -0,0 +1,31 @@
+#include "ALogicDecoder.h"
+
+/*
+Decode
+*/
+const std::vector<LogicFrame>& ALogicDecoder::decode(const LogicCapture& capture, uint32_t rate, size_t limit) {
+    sampleRate = rate;
+    maxFrames = limit;
+    frames.clear();
+    prepare(capture);
+    begin();
+
+    LogicCapture::Reader reader(capture);
+    uint8_t value;
+    uint64_t length;
+    uint64_t start = 0;
+    while (frames.size() < maxFrames && reader.next(value, length)) {
+        onRun(start, value, length);
+        start += length;
+    }
+    if (frames.size() < maxFrames) end(start);
+    return frames;
+}
+
+const std::vector<LogicFrame>& ALogicDecoder::getFrames() const {
+    return frames;
+}
+
+void ALogicDecoder::emit(const LogicFrame& frame) {
+    if (frames.size() < maxFrames) frames.push_back(frame);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Models/LogicCapture.h"
+#include "Models/LogicFrame.h"
+
+/*
+Protocol decoder over a logic capture.
+
+The capture is walked as runs, one call per change of any channel, so
+the cost follows the number of edges and not the sample rate, and an
+idle line costs nothing. Each decoder keeps its own state between runs
+and emits frames with the sample indexes they span.
+*/
+class ALogicDecoder {
+public:
+    virtual ~ALogicDecoder() = default;
+
+    // Frames found in a capture taken at sampleRate, stops after maxFrames
+    const std::vector<LogicFrame>& decode(const LogicCapture& capture, uint32_t sampleRate, size_t maxFrames = MAX_FRAMES);
+
+    const std::vector<LogicFrame>& getFrames() const;
+
+    static constexpr size_t MAX_FRAMES = 4096;
+
+protected:
+    // Pass over the capture before decoding, eg. to measure timings
+    virtual void prepare(const LogicCapture& capture) {}
+
+    // Clear the state
+    virtual void begin() = 0;
+
+    // Samples start to start + length hold value
+    virtual void onRun(uint64_t start, uint8_t value, uint64_t length) = 0;
+
+    // Capture end, size samples
+    virtual void end(uint64_t size) {}
+
+    void emit(const LogicFrame& frame);
+
+    uint32_t sampleRate = 0;
+
+private:
+    std::vector<LogicFrame> frames;
+    size_t maxFrames = MAX_FRAMES;
+};
@@ -21,18 +21,20 @@ BluetoothController::BluetoothController(
 Entry point for BT command
 */
 void BluetoothController::handleCommand(const TerminalCommand& cmd) {
-    const auto& root = cmd.getRoot();
-
-    if      (root == "scan")     handleScan();
-    else if (root == "pair")     handlePair(cmd);
-    else if (root == "spoof")    handleSpoof(cmd);
-    else if (root == "sniff")    handleSniff(cmd);
-    else if (root == "status")   handleStatus();
-    else if (root == "server")   handleServer(cmd);
-    else if (root == "keyboard") handleKeyboard(cmd);
-    else if (root == "mouse")    handleMouse(cmd);
-    else if (root == "reset")    handleReset();
-    else handleHelp();
+    static constexpr CommandRoute<BluetoothController> routes[] = {
+        {"scan",     &BluetoothController::handleScan},
+        {"pair",     &BluetoothController::handlePair},
+        {"spoof",    &BluetoothController::handleSpoof},
+        {"sniff",    &BluetoothController::handleSniff},
+        {"status",   &BluetoothController::handleStatus},
+        {"server",   &BluetoothController::handleServer},
+        {"keyboard", &BluetoothController::handleKeyboard},
+        {"mouse",    &BluetoothController::handleMouse},
+        {"reset",    &BluetoothController::handleReset},
+    };
+    static constexpr CommandRouter router(ModeEnum::Bluetooth, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 /*
@@ -348,18 +350,9 @@ Help
 */
 void BluetoothController::handleHelp() {
     terminalView.println("Bluetooth commands:");
-    terminalView.println("  scan");
-    terminalView.println("  pair <mac>");
-    terminalView.println("  spoof <mac>");
-    terminalView.println("  sniff");
-    terminalView.println("  status");
-    terminalView.println("  server");
-    terminalView.println("  keyboard");
-    terminalView.println("  keyboard <text>");
-    terminalView.println("  mouse <x> <y>");
-    terminalView.println("  mouse click");
-    terminalView.println("  mouse jiggle [ms]");
-    terminalView.println("  reset");
+    for (const auto& command : CommandRegistry::of(ModeEnum::Bluetooth)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
 }
 
 /*
@@ -7,6 +7,7 @@
 #include "Transformers/ArgTransformer.h"
 #include "Models/TerminalCommand.h"
 #include "Managers/UserInputManager.h"
+#include "Dispatchers/CommandRouter.h"
 
 class BluetoothController {
 public:
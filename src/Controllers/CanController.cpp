@@ -1,20 +1,24 @@
 #include "CanController.h"
 
 CanController::CanController(ITerminalView& terminalView, IInput& terminalInput, UserInputManager& userInputManager,
-                             CanService& canService, ArgTransformer& argTransformer)
+                             CanService& canService, ArgTransformer& argTransformer, JobManager& jobManager)
     : terminalView(terminalView), terminalInput(terminalInput), userInputManager(userInputManager),
-      canService(canService), argTransformer(argTransformer) {}
+      canService(canService), argTransformer(argTransformer), jobManager(jobManager) {}
 
 /*
 Entry point for CAN commands
 */
 void CanController::handleCommand(const TerminalCommand& cmd) {
-    if (cmd.getRoot() == "sniff")          handleSniff();
-    else if (cmd.getRoot() == "send")      handleSend(cmd);
-    else if (cmd.getRoot() == "receive")   handleReceive(cmd);
-    else if (cmd.getRoot() == "status")    handleStatus();
-    else if (cmd.getRoot() == "config")    handleConfig();
-    else handleHelp();
+    static constexpr CommandRoute<CanController> routes[] = {
+        {"sniff",   &CanController::handleSniff},
+        {"send",    &CanController::handleSend},
+        {"receive", &CanController::handleReceive},
+        {"status",  &CanController::handleStatus},
+        {"config",  &CanController::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::CAN_, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 /*
@@ -22,32 +26,34 @@ Sniff all CAN frames
 */
 void CanController::handleSniff() {
     canService.reset();
-    
-    terminalView.println("CAN Sniff: Waiting for frame... Press [ENTER] to stop.\n");
-    
-    unsigned long lastFrameTime = millis();
-    while (true) {
-        auto frame = canService.readFrameAsString();
 
-        // Received frame
-        if (!frame.empty()) {
-            terminalView.println(" 📥 " + frame);
-            lastFrameTime = millis();  // reset timer
+    std::vector<uint8_t> resources = {
+        state.getCanCspin(), state.getCanSckPin(), state.getCanSoPin(), state.getCanSiPin(), PinOwnership::SPI_BUS
+    };
+    jobManager.run("CAN Sniff: Waiting for frame", resources, [this](IJobOutput& out) {
+        unsigned long lastFrameTime = millis();
+        while (true) {
+            auto frame = canService.readFrameAsString();
+
+            // Received frame
+            if (!frame.empty()) {
+                out.println(" 📥 " + frame);
+                lastFrameTime = millis();  // reset timer
+            }
+
+            // Reset CAN if no frame for 3 seconds
+            if (millis() - lastFrameTime > 3000) {
+                canService.reset();
+                lastFrameTime = millis();
+            }
+
+            // Abort on [ENTER] or kill
+            if (!out.poll()) {
+                out.println("\nCan Sniff: Stopped by user.");
+                break;
+            }
         }
-
-        // Reset CAN if no frame for 3 seconds
-        if (millis() - lastFrameTime > 3000) {
-            canService.reset();
-            lastFrameTime = millis();
-        }
-
-        // Abort if ENTER is pressed
-        char ch = terminalInput.readChar();
-        if (ch == '\n' || ch == '\r') {
-            terminalView.println("\nCan Sniff: Stopped by user.");
-            break;
-        }
-    }
+    });
 }
 
 /*
@@ -154,11 +160,9 @@ Help message for CAN commands
 */
 void CanController::handleHelp() {
     terminalView.println("Available CAN commands:");
-    terminalView.println("  sniff");
-    terminalView.println("  send [id]");
-    terminalView.println("  receive [id]");
-    terminalView.println("  status");
-    terminalView.println("  config");
+    for (const auto& command : CommandRegistry::of(ModeEnum::CAN_)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
 }
 
 /*
@@ -208,10 +212,12 @@ void CanController::ensureConfigured() {
     if (!configured) {
         handleConfig();
         configured = true;
+        claimPins();
         return;
     }
 
-    // Always reapply config in case pins were reassigned elsewhere
+    // Reapply config only if pins or the SPI bus were used elsewhere
+    if (!claimPins()) return;
     canService.configure(
         state.getCanCspin(),
         state.getCanSckPin(),
@@ -221,3 +227,15 @@ void CanController::ensureConfigured() {
     );
 }
 
+/*
+Claim Pins, true when another mode used them since or the settings changed
+*/
+bool CanController::claimPins() {
+    uint8_t cs = state.getCanCspin();
+    uint8_t sck = state.getCanSckPin();
+    uint8_t so = state.getCanSoPin();
+    uint8_t si = state.getCanSiPin();
+    uint32_t settings = PinOwnership::signature({cs, sck, so, si, state.getCanKbps()});
+    return state.getPinOwnership().claim(ModeEnum::CAN_, {cs, sck, so, si, PinOwnership::SPI_BUS}, settings);
+}
+
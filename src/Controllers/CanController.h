@@ -7,12 +7,14 @@
 #include "Services/CanService.h"
 #include "Transformers/ArgTransformer.h"
 #include "Managers/UserInputManager.h"
+#include "Managers/JobManager.h"
 #include "States/GlobalState.h"
+#include "Dispatchers/CommandRouter.h"
 
 class CanController {
 public:
     CanController(ITerminalView& terminalView, IInput& terminalInput, UserInputManager& userInputManager,
-                  CanService& canService, ArgTransformer& argTransformer);
+                  CanService& canService, ArgTransformer& argTransformer, JobManager& jobManager);
     
     // Entry point to handle CAN commands
     void handleCommand(const TerminalCommand& cmd);
@@ -26,6 +28,7 @@ private:
     CanService& canService;
     ArgTransformer& argTransformer;
     UserInputManager& userInputManager;
+    JobManager& jobManager;
     GlobalState& state = GlobalState::getInstance();
     bool configured = false;
     
@@ -44,6 +47,9 @@ private:
     // Configuring the CAN controller
     void handleConfig();
 
+    // Claim the mode's pins, true when they must be configured again
+    bool claimPins();
+
     // Help message for CAN commands
     void handleHelp();
 };
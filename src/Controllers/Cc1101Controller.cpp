@@ -13,34 +13,24 @@ CC1101Controller::CC1101Controller(ITerminalView& terminalView, IInput& terminal
 Entry point to handle a CC1101 commands
 */
 void CC1101Controller::handleCommand(const TerminalCommand& cmd) {
-    if (cmd.getRoot() == "sniff") {
-        handleRXraw(cmd);
-    }
-    else if (cmd.getRoot() == "config") {
-        handleConfig();
-    } 
-        else if (cmd.getRoot() == "send") {
-        handleSend(cmd);
-    } 
-    else if (cmd.getRoot() == "rxraw") {
-        handleRXraw(cmd);
-    } 
-    else if (cmd.getRoot() == "txraw") {
-        handleTXraw(cmd);
-    } 
-    else if (cmd.getRoot() == "help") {
-        handleHelp();
-    } 
-    else if (cmd.getRoot().empty()) {
+    static constexpr CommandRoute<CC1101Controller> routes[] = {
+        {"send",   &CC1101Controller::handleSend},
+        {"sniff",  &CC1101Controller::handleRXraw},
+        {"rxraw",  &CC1101Controller::handleRXraw},
+        {"txraw",  &CC1101Controller::handleTXraw},
+        {"config", &CC1101Controller::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::CC1101, routes);
+
+    if (cmd.getRoot().empty()) {
         terminalView.println("No command provided. Type 'help' for available commands.");
-    }    
-    else {
+    }
+    else if (!router.dispatch(*this, cmd)) {
         handleHelp();
     }
-    
 }
 
-void CC1101Controller::handleSend(TerminalCommand cmd) {
+void CC1101Controller::handleSend(const TerminalCommand& cmd) {
     std::string raw = cmd.getSubcommand() + cmd.getArgs();
     std::string decoded = argTransformer.decodeEscapes(raw);
         if (decoded.empty()) {
@@ -116,9 +106,9 @@ Help
 void CC1101Controller::handleHelp() {
     terminalView.println("");
     terminalView.println("Unknown CC1101 command. Usage:");
-    terminalView.println("  send <data> - Send data via CC1101");
-    terminalView.println("  config - Configure CC1101 pins");
-    terminalView.println("  raw instructions, e.g: [0x9F r:3]");
+    for (const auto& command : CommandRegistry::of(ModeEnum::CC1101)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
     terminalView.println("");
 }
 
@@ -131,6 +121,9 @@ void CC1101Controller::ensureConfigured() {
         configured = true;
     }
 
+    // Only when the pins or the SPI bus were used by another mode
+    if (!claimPins()) return;
+
     cc1101Service.configure(
     state.getCC1101MOSIPin(),
     state.getCC1101MISOPin(),
@@ -140,4 +133,18 @@ void CC1101Controller::ensureConfigured() {
     state.getCC1101GDO2Pin(),
     1000000
     );
-}
\ No newline at end of file
+}
+
+/*
+Claim Pins, true when another mode used them since or the settings changed
+*/
+bool CC1101Controller::claimPins() {
+    uint8_t mosi = state.getCC1101MOSIPin();
+    uint8_t miso = state.getCC1101MISOPin();
+    uint8_t clk = state.getCC1101CLKPin();
+    uint8_t cs = state.getCC1101CSPin();
+    uint8_t gdo0 = state.getCC1101GDO0Pin();
+    uint8_t gdo2 = state.getCC1101GDO2Pin();
+    return state.getPinOwnership().claim(ModeEnum::CC1101, {mosi, miso, clk, cs, gdo0, gdo2, PinOwnership::SPI_BUS},
+                                         PinOwnership::signature({mosi, miso, clk, cs, gdo0, gdo2}));
+}
@@ -9,6 +9,7 @@
 #include "States/GlobalState.h"
 #include "Transformers/ArgTransformer.h"
 #include "Managers/UserInputManager.h"
+#include "Dispatchers/CommandRouter.h"
 
 class CC1101Controller {
 public:
@@ -33,11 +34,14 @@ private:
 
     // Read digital value from a pin
     void handleReadPin(const TerminalCommand& cmd);
-    void handleSend(TerminalCommand cmd);
+    void handleSend(const TerminalCommand& cmd);
     void handleRXraw(const TerminalCommand& cmd);
     void handleTXraw(const TerminalCommand& cmd);
     
     // Available commands
     void handleHelp();
     void handleConfig();
+
+    // Claim the mode's pins, true when they must be configured again
+    bool claimPins();
 };
\ No newline at end of file
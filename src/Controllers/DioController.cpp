@@ -5,24 +5,27 @@
 /*
 Constructor
 */
-DioController::DioController(ITerminalView& terminalView, IInput& terminalInput, PinService& pinService, ArgTransformer& argTransformer)
-    : terminalView(terminalView), terminalInput(terminalInput), pinService(pinService), argTransformer(argTransformer) {}
+DioController::DioController(ITerminalView& terminalView, IInput& terminalInput, PinService& pinService, ArgTransformer& argTransformer, JobManager& jobManager)
+    : terminalView(terminalView), terminalInput(terminalInput), pinService(pinService), argTransformer(argTransformer), jobManager(jobManager) {}
 
 /*
 Entry point to handle a DIO command
 */
 void DioController::handleCommand(const TerminalCommand& cmd) {
-    if (cmd.getRoot() == "sniff") handleSniff(cmd);
-    else if (cmd.getRoot() == "read")   handleReadPin(cmd); 
-    else if (cmd.getRoot() == "set")    handleSetPin(cmd);
-    else if (cmd.getRoot() == "pullup") handlePullup(cmd);
-    else if (cmd.getRoot() == "pwm")    handlePwm(cmd);
-    else if (cmd.getRoot() == "toggle") handleTogglePin(cmd);
-    else if (cmd.getRoot() == "analog") handleAnalog(cmd);
-    else if (cmd.getRoot() == "measure") handleMeasure(cmd);
-    else if (cmd.getRoot() == "reset")  handleResetPin(cmd);
-    else                                handleHelp();
-    
+    static constexpr CommandRoute<DioController> routes[] = {
+        {"sniff",   &DioController::handleSniff},
+        {"read",    &DioController::handleReadPin},
+        {"set",     &DioController::handleSetPin},
+        {"pullup",  &DioController::handlePullup},
+        {"pwm",     &DioController::handlePwm},
+        {"toggle",  &DioController::handleTogglePin},
+        {"measure", &DioController::handleMeasure},
+        {"analog",  &DioController::handleAnalog},
+        {"reset",   &DioController::handleResetPin},
+    };
+    static constexpr CommandRouter router(ModeEnum::DIO, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 /*
@@ -113,33 +116,23 @@ void DioController::handleSniff(const TerminalCommand& cmd) {
     if (!isPinAllowed(pin, "Sniff")) return;
     pinService.setInput(pin);
 
-    terminalView.println("DIO Sniff: Pin " + std::to_string(pin) + "... Press [ENTER] to stop");
-    
-    int last = pinService.read(pin);
-    terminalView.println("Initial state: " + std::to_string(last));
-
-    unsigned long lastCheck = millis();
-    while (true) {
-        // check ENTER press
-        if (millis() - lastCheck > 10) {
-            lastCheck = millis();
-            char c = terminalInput.readChar();
-            if (c == '\r' || c == '\n') {
-                terminalView.println("DIO Sniff: Stopped.");
-                break;
+    jobManager.run("DIO Sniff: Pin " + std::to_string(pin), {pin}, [this, pin](IJobOutput& out) {
+        int last = pinService.read(pin);
+        out.println("Initial state: " + std::to_string(last));
+
+        // poll() only looks at the input every few ms
+        while (out.poll()) {
+            int current = pinService.read(pin);
+            if (current != last) {
+                std::string transition = (last == 0 && current == 1)
+                    ? "LOW  -> HIGH"
+                    : "HIGH -> LOW";
+                out.println("Pin " + std::to_string(pin) + ": " + transition);
+                last = current;
             }
         }
-
-        // check pin state
-        int current = pinService.read(pin);
-        if (current != last) {
-            std::string transition = (last == 0 && current == 1)
-                ? "LOW  -> HIGH"
-                : "HIGH -> LOW";
-            terminalView.println("Pin " + std::to_string(pin) + ": " + transition);
-            last = current;
-        }
-    }
+        out.println("DIO Sniff: Stopped.");
+    });
 }
 
 /*
@@ -379,15 +372,9 @@ Help
 */
 void DioController::handleHelp() {
     terminalView.println("Unknown DIO command. Usage:");
-    terminalView.println("  sniff <pin>");
-    terminalView.println("  read <pin>");
-    terminalView.println("  set <pin> <H/L/I/O>");
-    terminalView.println("  pullup <pin>");
-    terminalView.println("  pwm <pin> <freq> <duty>");
-    terminalView.println("  measure <pin> [ms]");
-    terminalView.println("  toggle <pin> <ms>");
-    terminalView.println("  analog <pin>");
-    terminalView.println("  reset <pin>");
+    for (const auto& command : CommandRegistry::of(ModeEnum::DIO)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
 }
 
 bool DioController::isPinAllowed(uint8_t pin, const std::string& context) {
@@ -8,11 +8,13 @@
 #include "Models/TerminalCommand.h"
 #include "States/GlobalState.h"
 #include "Transformers/ArgTransformer.h"
+#include "Managers/JobManager.h"
+#include "Dispatchers/CommandRouter.h"
 
 class DioController {
 public:
     // Constructor
-    DioController(ITerminalView& terminalView, IInput& terminalInput, PinService& pinService, ArgTransformer& argTransformer);
+    DioController(ITerminalView& terminalView, IInput& terminalInput, PinService& pinService, ArgTransformer& argTransformer, JobManager& jobManager);
 
     // Entry point to handle a DIO command
     void handleCommand(const TerminalCommand& cmd);
@@ -22,6 +24,7 @@ private:
     IInput& terminalInput;
     PinService& pinService;
     ArgTransformer& argTransformer;
+    JobManager& jobManager;
     GlobalState& state = GlobalState::getInstance();
 
     // Read digital value from a pin
@@ -4,19 +4,21 @@
 Entry point for command
 */
 void EthernetController::handleCommand(const TerminalCommand& cmd) {
-    const auto& root = cmd.getRoot();
-
-    if      (root == "config")    handleConfig();
-    else if (root == "connect")   handleConnect();
-    else if (root == "nc")        handleNetcat(cmd);
-    else if (root == "nmap")      handleNmap(cmd);
-    else if (root == "discovery") handleDiscovery(cmd);
-    else if (root == "ping")      handlePing(cmd);
-    else if (root == "ssh")       handleSsh(cmd);
-    else if (root == "status")    handleStatus();
-    else if (root == "http")      handleHttp(cmd);
-    else if (root == "reset")     handleReset();
-    else                          handleHelp();
+    static constexpr CommandRoute<EthernetController> routes[] = {
+        {"connect",   &EthernetController::handleConnect},
+        {"status",    &EthernetController::handleStatus},
+        {"ping",      &EthernetController::handlePing},
+        {"discovery", &EthernetController::handleDiscovery},
+        {"ssh",       &EthernetController::handleSsh},
+        {"nc",        &EthernetController::handleNetcat},
+        {"nmap",      &EthernetController::handleNmap},
+        {"http",      &EthernetController::handleHttp},
+        {"reset",     &EthernetController::handleReset},
+        {"config",    &EthernetController::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::ETHERNET, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 /*
@@ -174,16 +176,9 @@ Help
 */
 void EthernetController::handleHelp() {
     terminalView.println("Ethernet commands:");
-    terminalView.println("  status");
-    terminalView.println("  connect");
-    terminalView.println("  ping <host>");
-    terminalView.println("  discovery [wifi|eth]");
-    terminalView.println("  ssh <host> <user> <password> [port]");
-    terminalView.println("  nc <host> <port>");
-    terminalView.println("  nmap <host> [port]");
-    terminalView.println("  http get <url>");
-    terminalView.println("  reset");
-    terminalView.println("  config");
+    for (const auto& command : CommandRegistry::of(ModeEnum::ETHERNET)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
 }
 
 /*
@@ -193,10 +188,13 @@ void EthernetController::ensureConfigured() {
     if (!configured) {
         handleConfig();
         configured = true;
+        claimPins();
         return;
     }
 
     // Reconfigure in case these pins have been used somewhere else
+    if (!claimPins()) return;
+
     auto cs = state.getEthernetCsPin();
     auto sck = state.getEthernetSckPin();
     auto miso = state.getEthernetMisoPin();
@@ -208,3 +206,21 @@ void EthernetController::ensureConfigured() {
 
     ethernetService.configure(cs, rst, sck, miso, mosi, irq, frequency, mac);
 }
+
+/*
+Claim Pins, true when another mode used them since or the settings changed
+*/
+bool EthernetController::claimPins() {
+    uint8_t cs = state.getEthernetCsPin();
+    uint8_t sck = state.getEthernetSckPin();
+    uint8_t miso = state.getEthernetMisoPin();
+    uint8_t mosi = state.getEthernetMosiPin();
+    uint8_t rst = state.getEthernetRstPin();
+    uint8_t irq = state.getEthernetIrqPin();
+    const auto& mac = state.getEthernetMac();
+    uint32_t settings = PinOwnership::signature({
+        cs, sck, miso, mosi, rst, irq, state.getEthernetFrequency(),
+        PinOwnership::signature(std::string_view(reinterpret_cast<const char*>(mac.data()), mac.size()))
+    });
+    return state.getPinOwnership().claim(ModeEnum::ETHERNET, {cs, sck, miso, mosi, rst, irq}, settings);
+}
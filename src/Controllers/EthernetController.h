@@ -17,6 +17,7 @@
 #include "States/GlobalState.h"
 #include "Managers/UserInputManager.h"
 #include "Abstracts/ANetworkController.h"
+#include "Dispatchers/CommandRouter.h"
 
 class EthernetController  : public ANetworkController {
 public:
@@ -32,6 +33,9 @@ private:
     // Configure the W5500
     void handleConfig();
 
+    // Claim the mode's pins, true when they must be configured again
+    bool claimPins();
+
     // Ethernet status
     void handleStatus();
 
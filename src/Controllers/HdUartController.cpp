@@ -12,16 +12,20 @@ HdUartController::HdUartController(ITerminalView& terminalView, IInput& terminal
 Entry point for HDUART commands
 */
 void HdUartController::handleCommand(const TerminalCommand& cmd) {
-    if      (cmd.getRoot() == "bridge") handleBridge();
-    else if (cmd.getRoot() == "config") handleConfig();
-    else    handleHelp();
+    static constexpr CommandRoute<HdUartController> routes[] = {
+        {"bridge", &HdUartController::handleBridge},
+        {"config", &HdUartController::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::HDUART, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 /*
 Entry point for HDUART instructions
 */
-void HdUartController::handleInstruction(const std::vector<ByteCode>& bytecodes) {
-    auto result = hdUartService.executeByteCode(bytecodes);
+void HdUartController::handleInstruction(const ByteCodeProgram& program) {
+    auto result = hdUartService.executeByteCode(program);
     terminalView.println("");
     terminalView.print("HDUART Read: ");
     terminalView.println(result.empty() ? "No data" : "\n\n" + result);
@@ -99,30 +103,36 @@ void HdUartController::handleConfig() {
 Help
 */
 void HdUartController::handleHelp() {
-    terminalView.println("\nHDUART Commands:\n"
-                         "  bridge       Interactive mode\n"
-                         "  config       Set TX/RX pin, baud etc.\n"
-                         "  [0x1 r:255]  Instruction syntax\n");
-
+    terminalView.println("\nHDUART Commands:\n");
+    for (const auto& command : CommandRegistry::of(ModeEnum::HDUART)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
+    terminalView.println("");
 }
 
 /*
 Ensure Configuration
 */
 void HdUartController::ensureConfigured() {
-    uartService.end();
+    // Serial1 lets go of the pin if UART mode was using it
+    if (state.getPinOwnership().ownerOf(state.getHdUartPin()) == ModeEnum::UART) {
+        uartService.end();
+    }
 
     if (!configured) {
         handleConfig();
         configured = true;
+        claimPins();
         return;
     }
 
-    hdUartService.end();
-
     // User could have set the same pin to a different usage
     // eg. select UART, then select I2C, then select UART
-    // Always reconfigure pins before use
+    // Reconfigure only when that happened
+    if (!claimPins()) return;
+
+    hdUartService.end();
+
     auto rx = state.getHdUartPin();
     auto parityStr = state.getHdUartParity();
     auto baud = state.getHdUartBaudRate();
@@ -132,4 +142,16 @@ void HdUartController::ensureConfigured() {
     char parity = !parityStr.empty() ? parityStr[0] : 'N';
 
     hdUartService.configure(baud, dataBits, parity, stopBits, rx, inverted);
+}
+
+/*
+Claim Pins, true when another mode used them since or the settings changed
+*/
+bool HdUartController::claimPins() {
+    uint8_t io = state.getHdUartPin();
+    uint32_t settings = PinOwnership::signature({
+        io, static_cast<uint32_t>(state.getHdUartBaudRate()), state.getHdUartDataBits(), state.getHdUartStopBits(),
+        PinOwnership::signature(state.getHdUartParity()), state.isHdUartInverted()
+    });
+    return state.getPinOwnership().claim(ModeEnum::HDUART, {io}, settings);
 }
\ No newline at end of file
@@ -2,13 +2,14 @@
 
 #include "Interfaces/ITerminalView.h"
 #include "Interfaces/IInput.h"
-#include "Models/ByteCode.h"
+#include "Models/ByteCodeProgram.h"
 #include "Models/TerminalCommand.h"
 #include "Services/HdUartService.h"
 #include "Services/UartService.h"
 #include "Transformers/ArgTransformer.h"
 #include "States/GlobalState.h"
 #include "Managers/UserInputManager.h"
+#include "Dispatchers/CommandRouter.h"
 
 class HdUartController {
 public:
@@ -19,7 +20,7 @@ public:
     void handleCommand(const TerminalCommand& cmd);
 
     // Entry point for HDUART instructions
-    void handleInstruction(const std::vector<ByteCode>& bytecodes);
+    void handleInstruction(const ByteCodeProgram& program);
 
     // HDUART config check
     void ensureConfigured();
@@ -42,6 +43,9 @@ private:
     // Configure HDUART
     void handleConfig();
 
+    // Claim the mode's pins, true when they must be configured again
+    bool claimPins();
+
     // Show HDUART Available commands
     void handleHelp();
 };
@@ -9,42 +9,48 @@ I2cController::I2cController(
     I2cService& i2cService,
     ArgTransformer& argTransformer,
     UserInputManager& userInputManager,
-    I2cEepromShell& eepromShell
+    I2cEepromShell& eepromShell,
+    JobManager& jobManager
 )
     : terminalView(terminalView),
       terminalInput(terminalInput),
       i2cService(i2cService),
       argTransformer(argTransformer),
       userInputManager(userInputManager),
-      eepromShell(eepromShell)
+      eepromShell(eepromShell),
+      jobManager(jobManager)
 {}
 
 /*
 Entry point to handle I2C command
 */
 void I2cController::handleCommand(const TerminalCommand& cmd) {
-    if (cmd.getRoot() == "scan") handleScan();
-    else if (cmd.getRoot() == "sniff") handleSniff();
-    else if (cmd.getRoot() == "ping") handlePing(cmd);
-    else if (cmd.getRoot() == "identify") handleIdentify(cmd);
-    else if (cmd.getRoot() == "write") handleWrite(cmd);
-    else if (cmd.getRoot() == "read") handleRead(cmd);
-    else if (cmd.getRoot() == "dump") handleDump(cmd);
-    else if (cmd.getRoot() == "slave") handleSlave(cmd);
-    else if (cmd.getRoot() == "glitch") handleGlitch(cmd);
-    else if (cmd.getRoot() == "flood") handleFlood(cmd);
-    else if (cmd.getRoot() == "eeprom") handleEeprom(cmd);
-    else if (cmd.getRoot() == "recover") handleRecover();
-    else if (cmd.getRoot() == "monitor") handleMonitor(cmd);
-    else if (cmd.getRoot() == "config") handleConfig();
-    else handleHelp();
+    static constexpr CommandRoute<I2cController> routes[] = {
+        {"scan",     &I2cController::handleScan},
+        {"ping",     &I2cController::handlePing},
+        {"identify", &I2cController::handleIdentify},
+        {"sniff",    &I2cController::handleSniff},
+        {"slave",    &I2cController::handleSlave},
+        {"read",     &I2cController::handleRead},
+        {"write",    &I2cController::handleWrite},
+        {"dump",     &I2cController::handleDump},
+        {"glitch",   &I2cController::handleGlitch},
+        {"flood",    &I2cController::handleFlood},
+        {"monitor",  &I2cController::handleMonitor},
+        {"eeprom",   &I2cController::handleEeprom},
+        {"recover",  &I2cController::handleRecover},
+        {"config",   &I2cController::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::I2C, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 /*
 Entry point to handle I2C instruction
 */
-void I2cController::handleInstruction(const std::vector<ByteCode>& bytecodes) {
-    auto result = i2cService.executeByteCode(bytecodes);
+void I2cController::handleInstruction(const ByteCodeProgram& program) {
+    auto result = i2cService.executeByteCode(program);
     if (!result.empty()) {
         terminalView.println("I2C Read:\n");
         terminalView.println(result);
@@ -85,38 +91,41 @@ void I2cController::handleScan() {
 Sniff
 */    
 void I2cController::handleSniff() {
-    terminalView.println("I2C Sniffer: Listening... Press [ENTER] to stop.\n");
-    i2c_sniffer_begin(state.getI2cSclPin(), state.getI2cSdaPin()); // dont need freq to work
-    i2c_sniffer_setup();
-
     terminalView.println("  [INFO] I2C sniffer mode is experimental.");
     terminalView.println("         It may crash or freeze the firmware");
     terminalView.println("         if the data stream is too fast or continuous.\n");
 
-    std::string line;
+    // The sniffer takes the pins over, Wire is configured again by the shell once it ends
+    uint8_t sda = state.getI2cSdaPin();
+    uint8_t scl = state.getI2cSclPin();
+    state.getPinOwnership().release(ModeEnum::I2C);
 
-    while (true) {
-        char key = terminalInput.readChar();
-        if (key == '\r' || key == '\n') break;
+    bool ended = jobManager.run("I2C Sniffer: Listening", {sda, scl, PinOwnership::I2C_BUS}, [sda, scl](IJobOutput& out) {
+        i2c_sniffer_begin(scl, sda); // dont need freq to work
+        i2c_sniffer_setup();
+
+        std::string line;
 
-        while (i2c_sniffer_available()) {
-            char c = i2c_sniffer_read();
+        while (out.poll()) {
+            while (i2c_sniffer_available()) {
+                char c = i2c_sniffer_read();
 
-            if (c == '\n') {
-                line += "  ";
-                terminalView.print(line);
-                line.clear();
-            } else {
-                line += c;
+                if (c == '\n') {
+                    line += "  ";
+                    out.print(line);
+                    line.clear();
+                } else {
+                    line += c;
+                }
             }
+            delay(5);
         }
-        delay(5);
-    }
 
-    i2c_sniffer_reset_buffer();
-    i2c_sniffer_stop();
-    i2cService.configure(state.getI2cSdaPin(), state.getI2cSclPin(), state.getI2cFrequency());
-    terminalView.println("\n\nI2C Sniffer: Stopped.");
+        i2c_sniffer_reset_buffer();
+        i2c_sniffer_stop();
+        out.println("\n\nI2C Sniffer: Stopped.");
+    });
+    if (ended) ensureConfigured();
 }
 
 /*
@@ -323,6 +332,7 @@ void I2cController::handleSlave(const TerminalCommand& cmd) {
 
     // Close slave
     i2cService.endSlave();
+    state.getPinOwnership().release(ModeEnum::I2C);
     ensureConfigured();
     terminalView.println("\nI2S Slave: Stopped by user.");
 }
@@ -626,6 +636,7 @@ void I2cController::handleGlitch(const TerminalCommand& cmd) {
     i2cService.randomClockPulseNoise(scl, sda, freqHz);
     delay(50);
 
+    state.getPinOwnership().release(ModeEnum::I2C);
     ensureConfigured();
     terminalView.println("\nI2C Glitch: Done. Target may be unresponsive or corrupted.");
 }
@@ -695,53 +706,51 @@ void I2cController::handleMonitor(const TerminalCommand& cmd) {
         return;
     }
 
-    terminalView.println("I2C Monitor: Monitoring register changes at 0x" + argTransformer.toHex(addr) + "... Press [ENTER] to stop.\n");
-
-    std::vector<uint8_t> prev(len, 0xFF);
-    std::vector<uint8_t> curr(len, 0xFF);
-    std::vector<bool> valid(len, false);
+    std::vector<uint8_t> resources = { state.getI2cSdaPin(), state.getI2cSclPin(), PinOwnership::I2C_BUS };
+    jobManager.run("I2C Monitor: Monitoring register changes at 0x" + argTransformer.toHex(addr), resources, [this, addr, len, delayMs](IJobOutput& out) {
+        std::vector<uint8_t> prev(len, 0xFF);
+        std::vector<uint8_t> curr(len, 0xFF);
+        std::vector<bool> valid(len, false);
 
-    // First read to initialize prev
-    if (i2cService.isReadableDevice(addr, 0x00)) {
-        performRegisterRead(addr, 0x00, len, prev, valid);
-    } else {
-        performRawRead(addr, 0x00, len, prev, valid);
-    }
-
-    while (true) {
-        // Try register read
+        // First read to initialize prev
         if (i2cService.isReadableDevice(addr, 0x00)) {
-            performRegisterRead(addr, 0x00, len, curr, valid);
+            performRegisterRead(addr, 0x00, len, prev, valid);
         } else {
-            performRawRead(addr, 0x00, len, curr, valid);
+            performRawRead(addr, 0x00, len, prev, valid);
         }
 
-        // Compare and show changes
-        for (uint16_t i = 0; i < len; ++i) {
-            if (valid[i] && curr[i] != prev[i]) {
-                std::stringstream ss;
-                ss << "0x" << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << i
-                   << ": 0x" << std::setw(2) << (int)prev[i]
-                   << " -> 0x" << std::setw(2) << (int)curr[i];
-                terminalView.println(ss.str());
-                prev[i] = curr[i];
+        while (true) {
+            // Try register read
+            if (i2cService.isReadableDevice(addr, 0x00)) {
+                performRegisterRead(addr, 0x00, len, curr, valid);
+            } else {
+                performRawRead(addr, 0x00, len, curr, valid);
             }
-        }
 
-        // Check for user input to stop
-        uint32_t elapsed = 0;
-        while (elapsed < delayMs) {
-            char key = terminalInput.readChar();
-            if (key == '\r' || key == '\n') {
-                terminalView.println("\nI2C Monitor: Stopped by user.");
-                return;
+            // Compare and show changes
+            for (uint16_t i = 0; i < len; ++i) {
+                if (valid[i] && curr[i] != prev[i]) {
+                    std::stringstream ss;
+                    ss << "0x" << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << i
+                       << ": 0x" << std::setw(2) << (int)prev[i]
+                       << " -> 0x" << std::setw(2) << (int)curr[i];
+                    out.println(ss.str());
+                    prev[i] = curr[i];
+                }
             }
-            delay(10);
-            elapsed += 10;
-        }
-    }
 
-    terminalView.println("\nI2C Monitor: Stopped.");
+            // Check for a stop request while waiting
+            uint32_t elapsed = 0;
+            while (elapsed < delayMs) {
+                if (!out.poll()) {
+                    out.println("\nI2C Monitor: Stopped by user.");
+                    return;
+                }
+                delay(10);
+                elapsed += 10;
+            }
+        }
+    });
 }
 
 /*
@@ -767,6 +776,7 @@ void I2cController::handleEeprom(const TerminalCommand& cmd) {
     }
 
     eepromShell.run(addr);
+    state.getPinOwnership().release(ModeEnum::I2C);
     ensureConfigured();
 }
 
@@ -775,21 +785,9 @@ Help
 */
 void I2cController::handleHelp() {
     terminalView.println("Unknown I2C command. Usage:");
-    terminalView.println("  scan");
-    terminalView.println("  ping <addr>");
-    terminalView.println("  identify <addr>");
-    terminalView.println("  sniff");
-    terminalView.println("  slave <addr>");
-    terminalView.println("  read <addr> <reg>");
-    terminalView.println("  write <addr> <reg> <val>");
-    terminalView.println("  dump <addr> [len]");
-    terminalView.println("  glitch <addr>");
-    terminalView.println("  flood <addr>");
-    terminalView.println("  recover");
-    terminalView.println("  monitor <addr> [delay_ms]");
-    terminalView.println("  eeprom [addr]");
-    terminalView.println("  config");
-    terminalView.println("  raw instructions, e.g: [0x13 0x4B r:8]");
+    for (const auto& command : CommandRegistry::of(ModeEnum::I2C)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
 }
 
 /*
@@ -799,15 +797,29 @@ void I2cController::ensureConfigured() {
     if (!configured) {
         handleConfig();
         configured = true;
+        claimPins();
         return;
     }
 
     // User could have set the same pin to a different usage
     // eg. select I2C then select UART then select I2C
-    // Always reconfigure pins before use
+    // Reconfigure only when that happened
+    if (!claimPins()) return;
+
     i2cService.end();
     uint8_t sda = state.getI2cSdaPin();
     uint8_t scl = state.getI2cSclPin();
     uint32_t freq = state.getI2cFrequency();
     i2cService.configure(sda, scl, freq);
+}
+
+/*
+Claim Pins, true when another mode used them since or the settings changed
+*/
+bool I2cController::claimPins() {
+    uint8_t sda = state.getI2cSdaPin();
+    uint8_t scl = state.getI2cSclPin();
+    uint32_t freq = state.getI2cFrequency();
+    return state.getPinOwnership().claim(ModeEnum::I2C, {sda, scl, PinOwnership::I2C_BUS},
+                                         PinOwnership::signature({sda, scl, freq}));
 }
\ No newline at end of file
@@ -7,24 +7,26 @@
 #include "Interfaces/IInput.h"
 #include "Services/I2cService.h"
 #include "Models/TerminalCommand.h"
-#include "Models/ByteCode.h"
+#include "Models/ByteCodeProgram.h"
 #include "States/GlobalState.h"
 #include "Transformers/ArgTransformer.h"
 #include "Managers/UserInputManager.h"
+#include "Managers/JobManager.h"
 #include "Vendors/i2c_sniffer.h"
 #include "Shells/I2cEepromShell.h"
 #include "Data/I2cKnownAdresses.h"
+#include "Dispatchers/CommandRouter.h"
 
 class I2cController {
 public:
     // Constructor
-    I2cController(ITerminalView& terminalView, IInput& terminalInput, I2cService& i2cService, ArgTransformer& argTransformer, UserInputManager& userInputManager, I2cEepromShell& eepromShell);
+    I2cController(ITerminalView& terminalView, IInput& terminalInput, I2cService& i2cService, ArgTransformer& argTransformer, UserInputManager& userInputManager, I2cEepromShell& eepromShell, JobManager& jobManager);
 
     // Entry point for I2C command
     void handleCommand(const TerminalCommand& cmd);
 
     // Entry point for compiled bytecode instructions
-    void handleInstruction(const std::vector<ByteCode>& bytecodes);
+    void handleInstruction(const ByteCodeProgram& program);
 
     // Ensure I2C is configured before use
     void ensureConfigured();
@@ -36,6 +38,7 @@ private:
     ArgTransformer& argTransformer;
     UserInputManager& userInputManager;
     I2cEepromShell& eepromShell;
+    JobManager& jobManager;
     GlobalState& state = GlobalState::getInstance();
     bool configured = false;
     
@@ -66,6 +69,9 @@ private:
     // Configure I2C parameters
     void handleConfig();
 
+    // Claim the mode's pins, true when they must be configured again
+    bool claimPins();
+
     // Monitor I2C device registers
     void handleMonitor(const TerminalCommand& cmd);
 
@@ -11,19 +11,16 @@ I2sController::I2sController(ITerminalView& terminalView, IInput& terminalInput,
       userInputManager(userInputManager) {}
 
 void I2sController::handleCommand(const TerminalCommand& cmd) {
-    if (cmd.getRoot() == "config") {
-        handleConfig();
-    } else if (cmd.getRoot() == "play") {
-        handlePlay(cmd);
-    } else if (cmd.getRoot() == "record") {
-        handleRecord(cmd);
-    } else if (cmd.getRoot() == "test") {
-        handleTest(cmd);
-    } else if (cmd.getRoot() == "reset") {
-        handleReset();
-    } else {
-        handleHelp();
-    }
+    static constexpr CommandRoute<I2sController> routes[] = {
+        {"play",   &I2sController::handlePlay},
+        {"record", &I2sController::handleRecord},
+        {"test",   &I2sController::handleTest},
+        {"reset",  &I2sController::handleReset},
+        {"config", &I2sController::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::I2S, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 
@@ -371,11 +368,9 @@ Help
 */
 void I2sController::handleHelp() {
     terminalView.println("Available I2S commands:");
-    terminalView.println("  play <freq> [duration]");
-    terminalView.println("  record ");
-    terminalView.println("  test <speaker|mic>");
-    terminalView.println("  reset");
-    terminalView.println("  config");
+    for (const auto& command : CommandRegistry::of(ModeEnum::I2S)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
 }
 
 
@@ -403,11 +398,25 @@ void I2sController::ensureConfigured() {
     if (!configured) {
         handleConfig();
         configured = true;
-    } else {
+        claimPins();
+    } else if (claimPins()) {
         // Reapply
         i2sService.end();
         i2sService.configureOutput(state.getI2sBclkPin(), state.getI2sLrckPin(),
                              state.getI2sDataPin(), state.getI2sSampleRate(),
                              state.getI2sBitsPerSample());
     }
+}
+
+/*
+Claim Pins, true when another mode used them since or the settings changed
+*/
+bool I2sController::claimPins() {
+    uint8_t bclk = state.getI2sBclkPin();
+    uint8_t lrck = state.getI2sLrckPin();
+    uint8_t data = state.getI2sDataPin();
+    uint32_t settings = PinOwnership::signature({
+        bclk, lrck, data, state.getI2sSampleRate(), state.getI2sBitsPerSample()
+    });
+    return state.getPinOwnership().claim(ModeEnum::I2S, {bclk, lrck, data}, settings);
 }
\ No newline at end of file
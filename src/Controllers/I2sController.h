@@ -9,6 +9,7 @@
 #include "Models/TerminalCommand.h"
 #include "States/GlobalState.h"
 #include "Data/PcmSoundTestComplete.h"
+#include "Dispatchers/CommandRouter.h"
 
 class I2sController {
 public:
@@ -26,6 +27,9 @@ private:
     // Configure I2S pins and parameters interactively
     void handleConfig();
 
+    // Claim the mode's pins, true when they must be configured again
+    bool claimPins();
+
     // Play a tone at given frequency and optional duration
     void handlePlay(const TerminalCommand& cmd);
 
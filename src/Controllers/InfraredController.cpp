@@ -23,14 +23,18 @@ InfraredController::InfraredController(
 Entry point to handle Infrared command
 */
 void InfraredController::handleCommand(const TerminalCommand& command) {
-    if (command.getRoot() == "config")            handleConfig();
-    else if (command.getRoot() == "send")         handleSend(command);
-    else if (command.getRoot() == "receive")      handleReceive();
-    else if (command.getRoot() == "devicebgone")  handleDeviceBgone();
-    else if (command.getRoot() == "remote")       handleRemote();
-    else if (command.getRoot() == "replay")       handleReplay(command);
-    else if (command.getRoot() == "setprotocol")  handleSetProtocol();
-    else handleHelp();
+    static constexpr CommandRoute<InfraredController> routes[] = {
+        {"send",        &InfraredController::handleSend},
+        {"receive",     &InfraredController::handleReceive},
+        {"setprotocol", &InfraredController::handleSetProtocol},
+        {"devicebgone", &InfraredController::handleDeviceBgone},
+        {"remote",      &InfraredController::handleRemote},
+        {"replay",      &InfraredController::handleReplay},
+        {"config",      &InfraredController::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::Infrared, routes);
+
+    if (!router.dispatch(*this, command)) handleHelp();
 }
 
 /*
@@ -339,24 +343,32 @@ Help
 */
 void InfraredController::handleHelp() {
     terminalView.println("Unknown INFRARED command. Usage:");
-    terminalView.println("  send <addr> <subadd> <cmd>");
-    terminalView.println("  receive");
-    terminalView.println("  setprotocol");
-    terminalView.println("  devicebgone");
-    terminalView.println("  remote");
-    terminalView.println("  replay");
-    terminalView.println("  config");
+    for (const auto& command : CommandRegistry::of(ModeEnum::Infrared)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
 }
 
 void InfraredController::ensureConfigured() {
     if (!configured) {
         handleConfig();
         configured = true;
+        claimPins();
         return;
     }
 
-    // Always reconfigure before use
+    // Reconfigure if the pins were used by another mode
+    if (!claimPins()) return;
+
     uint8_t tx = state.getInfraredTxPin();
     uint8_t rx = state.getInfraredRxPin();
     infraredService.configure(tx, rx);
+}
+
+/*
+Claim Pins, true when another mode used them since or the settings changed
+*/
+bool InfraredController::claimPins() {
+    uint8_t tx = state.getInfraredTxPin();
+    uint8_t rx = state.getInfraredRxPin();
+    return state.getPinOwnership().claim(ModeEnum::Infrared, {tx, rx}, PinOwnership::signature({tx, rx}));
 }
\ No newline at end of file
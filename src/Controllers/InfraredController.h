@@ -14,6 +14,7 @@
 #include "Managers/UserInputManager.h"
 #include "States/GlobalState.h"
 #include "Shells/UniversalRemoteShell.h"
+#include "Dispatchers/CommandRouter.h"
 
 class InfraredController {
 public:
@@ -50,6 +51,9 @@ private:
     // Configure IR settings
     void handleConfig();
 
+    // Claim the mode's pins, true when they must be configured again
+    bool claimPins();
+
     // Send IR command
     void handleSend(const TerminalCommand& command);
 
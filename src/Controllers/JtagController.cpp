@@ -10,9 +10,13 @@ JtagController::JtagController(ITerminalView& terminalView, IInput& terminalInpu
 Entry point that handles JTAG commands
 */
 void JtagController::handleCommand(const TerminalCommand& cmd) {
-    if (cmd.getRoot() == "scan") handleScan(cmd); 
-    else if (cmd.getRoot() == "config") handleConfig();
-    else handleHelp();
+    static constexpr CommandRoute<JtagController> routes[] = {
+        {"scan",   &JtagController::handleScan},
+        {"config", &JtagController::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::JTAG, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 /*
@@ -125,9 +129,9 @@ Help
 void JtagController::handleHelp() {
     terminalView.println("");
     terminalView.println("Unknown JTAG command. Usage:");
-    terminalView.println("  scan swd");
-    terminalView.println("  scan jtag");
-    terminalView.println("  config");
+    for (const auto& command : CommandRegistry::of(ModeEnum::JTAG)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
     terminalView.println("");
 }
 
@@ -139,4 +143,15 @@ void JtagController::ensureConfigured() {
         handleConfig();
         configured = true;
     }
+
+    // Nothing to configure, the scan drives the pins so other modes must reclaim them
+    claimPins();
+}
+
+/*
+Claim Pins, true when another mode used them since or the settings changed
+*/
+bool JtagController::claimPins() {
+    const auto& pins = state.getJtagScanPins();
+    return state.getPinOwnership().claim(ModeEnum::JTAG, pins, 0);
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Services/JtagService.h" 
 #include "States/GlobalState.h"
 #include "Managers/UserInputManager.h"
+#include "Dispatchers/CommandRouter.h"
 
 class JtagController {
 public:
@@ -38,6 +39,9 @@ private:
     // Handle user configuration
     void handleConfig();
 
+    // Claim the mode's pins, true when they must be configured again
+    bool claimPins();
+
     // Show available commands
     void handleHelp();
 };
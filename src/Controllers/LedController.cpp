@@ -15,37 +15,28 @@ LedController::LedController(ITerminalView& terminalView, IInput& terminalInput,
 Command
 */
 void LedController::handleCommand(const TerminalCommand& cmd) {
-    if (cmd.getRoot() == "fill") {
-        handleFill(cmd);
-    } else if (cmd.getRoot() == "scan") {
-        handleScan();
-    } else if (cmd.getRoot() == "set") {
-        handleSet(cmd);
-    } else if (cmd.getRoot() == "reset") {
-        handleReset(cmd);
-    } else if (cmd.getRoot() == "blink") {
-        handleAnimation(cmd);
-    } else if (cmd.getRoot() == "rainbow") {
-        handleAnimation(cmd);
-    } else if (cmd.getRoot() == "chase") {
-        handleAnimation(cmd);
-    } else if (cmd.getRoot() == "cycle") {
-        handleAnimation(cmd);
-    } else if (cmd.getRoot() == "wave") {
-        handleAnimation(cmd);
-    } else if (cmd.getRoot() == "config") {
-        handleConfig();
-    } else if (cmd.getRoot() == "setprotocol") {
-        handleSetProtocol();
-    } else {
-        handleHelp();
-    }
+    static constexpr CommandRoute<LedController> routes[] = {
+        {"scan",        &LedController::handleScan},
+        {"fill",        &LedController::handleFill},
+        {"set",         &LedController::handleSet},
+        {"blink",       &LedController::handleAnimation},
+        {"rainbow",     &LedController::handleAnimation},
+        {"chase",       &LedController::handleAnimation},
+        {"cycle",       &LedController::handleAnimation},
+        {"wave",        &LedController::handleAnimation},
+        {"reset",       &LedController::handleReset},
+        {"setprotocol", &LedController::handleSetProtocol},
+        {"config",      &LedController::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::LED, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 /*
 Instructions
 */
-void LedController::handleInstruction(const std::vector<ByteCode>& bytecodes) {
+void LedController::handleInstruction(const ByteCodeProgram& program) {
     terminalView.println("[ERROR] LED instructions not implemented.");
 }
 
@@ -107,6 +98,7 @@ void LedController::handleScan() {
 
     }
     terminalView.println("\nLED: No protocol matched.");
+    state.getPinOwnership().release(ModeEnum::LED);
     ensureConfigured();
 }
 
@@ -304,17 +296,9 @@ Help
 */
 void LedController::handleHelp() {
     terminalView.println("Unknown LED command. Usage:");
-    terminalView.println("  scan");
-    terminalView.println("  fill blue");
-    terminalView.println("  set 1 red");
-    terminalView.println("  blink");
-    terminalView.println("  rainbow");
-    terminalView.println("  chase");
-    terminalView.println("  cycle");
-    terminalView.println("  wave");
-    terminalView.println("  reset [led num]");
-    terminalView.println("  setprotocol");
-    terminalView.println("  config");
+    for (const auto& command : CommandRegistry::of(ModeEnum::LED)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
 }
 
 /*
@@ -324,10 +308,13 @@ void LedController::ensureConfigured() {
     if (!configured) {
         handleConfig();
         configured = true;
+        claimPins();
         return;
     }
 
-    // Reconfigure
+    // Reconfigure, if the pins were used elsewhere or the settings changed
+    if (!claimPins()) return;
+
     std::string protocol = state.getLedProtocol();
     uint8_t data = state.getLedDataPin();
     uint8_t clock = state.getLedClockPin();
@@ -336,6 +323,18 @@ void LedController::ensureConfigured() {
     ledService.configure(data, clock, length, protocol, brightness);
 }
 
+/*
+Claim Pins, true when another mode used them since or the settings changed
+*/
+bool LedController::claimPins() {
+    uint8_t data = state.getLedDataPin();
+    uint8_t clock = state.getLedClockPin();
+    uint32_t settings = PinOwnership::signature({
+        data, clock, state.getLedLength(), state.getLedBrightness(), PinOwnership::signature(state.getLedProtocol())
+    });
+    return state.getPinOwnership().claim(ModeEnum::LED, {data, clock}, settings);
+}
+
 /*
 Utils
 */
@@ -4,11 +4,12 @@
 #include "Interfaces/ITerminalView.h"
 #include "Interfaces/IInput.h"
 #include "Models/TerminalCommand.h"
-#include "Models/ByteCode.h"
+#include "Models/ByteCodeProgram.h"
 #include "Services/LedService.h"
 #include "Transformers/ArgTransformer.h"
 #include "Managers/UserInputManager.h"
 #include "States/GlobalState.h"
+#include "Dispatchers/CommandRouter.h"
 
 class LedController {
 public:
@@ -20,7 +21,7 @@ public:
     void handleCommand(const TerminalCommand& cmd);
 
     // Execute LED instruction from bytecode
-    void handleInstruction(const std::vector<ByteCode>& bytecodes);
+    void handleInstruction(const ByteCodeProgram& program);
 
     // Ensure LED mode is properly configured before use
     void ensureConfigured();
@@ -44,6 +45,9 @@ private:
     // Configure LED pin, length and protocol
     void handleConfig();
 
+    // Claim the mode's pins, true when they must be configured again
+    bool claimPins();
+
     // Change LED protocol interactively
     void handleSetProtocol();
 
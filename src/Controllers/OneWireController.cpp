@@ -13,22 +13,26 @@ OneWireController::OneWireController(ITerminalView& terminalView, IInput& termin
 Entry point for command
 */
 void OneWireController::handleCommand(const TerminalCommand& command) {
-    if (command.getRoot()      == "scan")   handleScan();
-    else if (command.getRoot() == "ping")   handlePing();
-    else if (command.getRoot() == "sniff")  handleSniff();
-    else if (command.getRoot() == "read")   handleRead();
-    else if (command.getRoot() == "write")  handleWrite(command);
-    else if (command.getRoot() == "ibutton")   handleIbutton(command);
-    else if (command.getRoot() == "temp")   handleTemperature();
-    else if (command.getRoot() == "config") handleConfig();
-    else                                    handleHelp();
+    static constexpr CommandRoute<OneWireController> routes[] = {
+        {"scan",    &OneWireController::handleScan},
+        {"ping",    &OneWireController::handlePing},
+        {"sniff",   &OneWireController::handleSniff},
+        {"read",    &OneWireController::handleRead},
+        {"write",   &OneWireController::handleWrite},
+        {"temp",    &OneWireController::handleTemperature},
+        {"ibutton", &OneWireController::handleIbutton},
+        {"config",  &OneWireController::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::OneWire, routes);
+
+    if (!router.dispatch(*this, command)) handleHelp();
 }
 
 /*
 Entry point for instructions
 */
-void OneWireController::handleInstruction(std::vector<ByteCode>& bytecodes) {
-    auto result = oneWireService.executeByteCode(bytecodes);
+void OneWireController::handleInstruction(const ByteCodeProgram& program) {
+    auto result = oneWireService.executeByteCode(program);
     if (!result.empty()) {
         terminalView.println("OneWire Read:\n");
         terminalView.println(result);
@@ -500,25 +504,28 @@ Help
 */
 void OneWireController::handleHelp() {
     terminalView.println("Unknown 1Wire command. Usage:");
-    terminalView.println("  scan");
-    terminalView.println("  ping");
-    terminalView.println("  sniff");
-    terminalView.println("  read");
-    terminalView.println("  write id [8 bytes]");
-    terminalView.println("  write sp [8 bytes]");
-    terminalView.println("  ibutton");
-    terminalView.println("  temp");
-    terminalView.println("  config");
-    terminalView.println("  raw instructions, [0X33 r:8] ...");
+    for (const auto& command : CommandRegistry::of(ModeEnum::OneWire)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
 }
 
 void OneWireController::ensureConfigured() {
     if (!configured) {
         handleConfig();
         configured = true;
+        claimPins();
         return;
     }
 
+    if (!claimPins()) return;
     uint8_t pin = state.getOneWirePin();
     oneWireService.configure(pin);
+}
+
+/*
+Claim Pins, true when another mode used them since or the settings changed
+*/
+bool OneWireController::claimPins() {
+    uint8_t pin = state.getOneWirePin();
+    return state.getPinOwnership().claim(ModeEnum::OneWire, {pin}, PinOwnership::signature({pin}));
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "Transformers/ArgTransformer.h"
 #include "Managers/UserInputManager.h"
 #include "Shells/IbuttonShell.h"
+#include "Dispatchers/CommandRouter.h"
 
 class OneWireController {
 public:
@@ -22,7 +23,7 @@ public:
     void handleCommand(const TerminalCommand& cmd);
 
     // Entry point for handle parsed bytecode instructions
-    void handleInstruction(std::vector<ByteCode>& bytecodes);
+    void handleInstruction(const ByteCodeProgram& program);
 
     // Ensure initialized/configured
     void ensureConfigured();
@@ -40,6 +41,9 @@ private:
   // Configure 1-Wire bus parameters
     void handleConfig();
 
+    // Claim the mode's pins, true when they must be configured again
+    bool claimPins();
+
     // Send reset pulse and check device presence
     void handlePing();
 
@@ -23,21 +23,24 @@ SpiController::SpiController(ITerminalView& terminalView, IInput& terminalInput,
 Entry point for command
 */
 void SpiController::handleCommand(const TerminalCommand& cmd) {
-    if      (cmd.getRoot() == "sniff")  handleSniff();
-    else if (cmd.getRoot() == "sdcard") handleSdCard();
-    else if (cmd.getRoot() == "slave")  handleSlave();
-    else if (cmd.getRoot() == "flash")  handleFlash(cmd);
-    else if (cmd.getRoot() == "eeprom") handleEeprom(cmd);
-    else if (cmd.getRoot() == "help")   handleHelp();
-    else if (cmd.getRoot() == "config") handleConfig();
-    else handleHelp();
+    static constexpr CommandRoute<SpiController> routes[] = {
+        {"sniff",  &SpiController::handleSniff},
+        {"sdcard", &SpiController::handleSdCard},
+        {"slave",  &SpiController::handleSlave},
+        {"flash",  &SpiController::handleFlash},
+        {"eeprom", &SpiController::handleEeprom},
+        {"config", &SpiController::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::SPI, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 /*
 Entry point for instructions
 */
-void SpiController::handleInstruction(const std::vector<ByteCode>& bytecodes) {
-    auto result = spiService.executeByteCode(bytecodes);
+void SpiController::handleInstruction(const ByteCodeProgram& program) {
+    auto result = spiService.executeByteCode(program);
     if (!result.empty()) {
         terminalView.println("SPI Read:\n");
         terminalView.println(result);
@@ -63,6 +66,7 @@ EEPROM
 */
 void SpiController::handleEeprom(const TerminalCommand& cmd) {
     spiEepromShell.run();
+    state.getPinOwnership().release(ModeEnum::SPI);
     ensureConfigured();
 }
 
@@ -141,6 +145,7 @@ void SpiController::handleSdCard() {
     // Reconfigure
     sdService.end();
     spiService.end();
+    state.getPinOwnership().release(ModeEnum::SPI);
     ensureConfigured();
 }
 
@@ -150,13 +155,9 @@ Help
 void SpiController::handleHelp() {
     terminalView.println("");
     terminalView.println("Unknown SPI command. Usage:");
-    terminalView.println("  sniff");
-    terminalView.println("  sdcard");
-    terminalView.println("  slave");
-    terminalView.println("  flash");
-    terminalView.println("  eeprom");
-    terminalView.println("  config");
-    terminalView.println("  raw instructions, e.g: [0x9F r:3]");
+    for (const auto& command : CommandRegistry::of(ModeEnum::SPI)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
     terminalView.println("");
 }
 
@@ -197,9 +198,11 @@ void SpiController::ensureConfigured() {
         configured = true;
     }
 
+    // Reconfigure, only if the pins or the bus were used for another mode
+    if (!claimPins()) return;
+
     spiService.end();
     sdService.end();
-    // Reconfigure, user could have used these pins for another mode
     uint8_t sclk = state.getSpiCLKPin();
     uint8_t miso = state.getSpiMISOPin();
     uint8_t mosi = state.getSpiMOSIPin();
@@ -207,3 +210,16 @@ void SpiController::ensureConfigured() {
     int freq   = state.getSpiFrequency();
     spiService.configure(mosi, miso, sclk, cs, freq);
 }
+
+/*
+Claim Pins, true when another mode used them since or the settings changed
+*/
+bool SpiController::claimPins() {
+    uint8_t sclk = state.getSpiCLKPin();
+    uint8_t miso = state.getSpiMISOPin();
+    uint8_t mosi = state.getSpiMOSIPin();
+    uint8_t cs   = state.getSpiCSPin();
+    uint32_t freq = state.getSpiFrequency();
+    return state.getPinOwnership().claim(ModeEnum::SPI, {sclk, miso, mosi, cs, PinOwnership::SPI_BUS},
+                                         PinOwnership::signature({sclk, miso, mosi, cs, freq}));
+}
@@ -6,7 +6,7 @@
 #include "Services/SdService.h"
 #include "Interfaces/IInput.h"
 #include "Models/TerminalCommand.h"
-#include "Models/ByteCode.h"
+#include "Models/ByteCodeProgram.h"
 #include "Transformers/ArgTransformer.h"
 #include "Managers/UserInputManager.h"
 #include "Shells/SdCardShell.h"
@@ -14,6 +14,7 @@
 #include "States/GlobalState.h"
 #include "Data/FlashDatabase.h"
 #include "Shells/SpiEepromShell.h"
+#include "Dispatchers/CommandRouter.h"
 
 class SpiController {
 public:
@@ -33,8 +34,8 @@ public:
     // Entry point for handle raw user command
     void handleCommand(const TerminalCommand& cmd);
 
-    // Entry point for handle parsed instruction bytecodes
-    void handleInstruction(const std::vector<ByteCode>& bytecodes);
+    // Entry point for handle parsed instruction program
+    void handleInstruction(const ByteCodeProgram& program);
 
     // Ensure SPI is properly configured before use
     void ensureConfigured();
@@ -71,6 +72,9 @@ private:
     // Configure SPI bus parameters
     void handleConfig();
 
+    // Claim the mode's pins, true when they must be configured again
+    bool claimPins();
+
     // Available commands
     void handleHelp();
 };
@@ -21,15 +21,19 @@ ThreeWireController::ThreeWireController(
 Entry point for command
 */
 void ThreeWireController::handleCommand(const TerminalCommand& cmd) {
-    if      (cmd.getRoot() == "config")  handleConfig();
-    else if (cmd.getRoot() == "eeprom")  handleEeprom(cmd);
-    else                                 handleHelp();
+    static constexpr CommandRoute<ThreeWireController> routes[] = {
+        {"eeprom", &ThreeWireController::handleEeprom},
+        {"config", &ThreeWireController::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::ThreeWire, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 /*
 Entry point for instructions
 */
-void ThreeWireController::handleInstruction(const std::vector<ByteCode>& bytecodes) {
+void ThreeWireController::handleInstruction(const ByteCodeProgram& program) {
     terminalView.println("Instruction handling not yet implemented");
 }
 
@@ -45,8 +49,9 @@ Help
 */
 void ThreeWireController::handleHelp() {
     terminalView.println("Unknown 3WIRE command. Usage:");
-    terminalView.println("  eeprom");
-    terminalView.println("  config");
+    for (const auto& command : CommandRegistry::of(ModeEnum::ThreeWire)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
 }
 
 /*
@@ -81,7 +86,9 @@ void ThreeWireController::ensureConfigured() {
         configured = true;
     }
 
-    // Pins could have been used elsewhere, reconfigure the service
+    // Pins could have been used elsewhere, reconfigure the service if so
+    if (!claimPins()) return;
+
     auto cs = state.getThreeWireCsPin();
     auto sk = state.getThreeWireSkPin();
     auto di = state.getThreeWireDiPin();
@@ -89,4 +96,18 @@ void ThreeWireController::ensureConfigured() {
     auto modelId = state.getThreeWireEepromModelIndex(); 
     auto org8 = state.isThreeWireOrg8();
     threeWireService.configure(cs, sk, di, doPin, modelId, org8);
+}
+
+/*
+Claim Pins, true when another mode used them since or the settings changed
+*/
+bool ThreeWireController::claimPins() {
+    uint8_t cs = state.getThreeWireCsPin();
+    uint8_t sk = state.getThreeWireSkPin();
+    uint8_t di = state.getThreeWireDiPin();
+    uint8_t doPin = state.getThreeWireDoPin();
+    uint32_t settings = PinOwnership::signature({
+        cs, sk, di, doPin, state.getThreeWireEepromModelIndex(), state.isThreeWireOrg8()
+    });
+    return state.getPinOwnership().claim(ModeEnum::ThreeWire, {cs, sk, di, doPin}, settings);
 }
\ No newline at end of file
@@ -9,10 +9,11 @@
 #include "Services/ThreeWireService.h"
 #include "Interfaces/IInput.h"
 #include "Models/TerminalCommand.h"
-#include "Models/ByteCode.h"
+#include "Models/ByteCodeProgram.h"
 #include "Managers/UserInputManager.h"
 #include "Transformers/ArgTransformer.h"
 #include "Shells/ThreeWireEepromShell.h"
+#include "Dispatchers/CommandRouter.h"
 
 class ThreeWireController {
 public:
@@ -29,7 +30,7 @@ public:
     void handleCommand(const TerminalCommand& cmd);
 
     // Entry point for instruction handling
-    void handleInstruction(const std::vector<ByteCode>& bytecodes);
+    void handleInstruction(const ByteCodeProgram& program);
 
     // Ensure configured before any action
     void ensureConfigured();
@@ -51,6 +52,9 @@ private:
     // Configuration handler for settings
     void handleConfig();
 
+    // Claim the mode's pins, true when they must be configured again
+    bool claimPins();
+
     // Available commands
     void handleHelp();
     
@@ -22,16 +22,20 @@ TwoWireController::TwoWireController(
 Entry point for 2WIRE command
 */
 void TwoWireController::handleCommand(const TerminalCommand& cmd) {
-    if      (cmd.getRoot() == "config")    handleConfig();
-    else if (cmd.getRoot() == "sniff")     handleSniff();
-    else if (cmd.getRoot() == "smartcard") handleSmartCard(cmd);
-    else                                   handleHelp();
+    static constexpr CommandRoute<TwoWireController> routes[] = {
+        {"sniff",     &TwoWireController::handleSniff},
+        {"smartcard", &TwoWireController::handleSmartCard},
+        {"config",    &TwoWireController::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::TwoWire, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 /*
 Entry point for 2WIRE instruction
 */
-void TwoWireController::handleInstruction(const std::vector<ByteCode>& bytecodes) {
+void TwoWireController::handleInstruction(const ByteCodeProgram& program) {
     terminalView.println("[TODO] Instruction support for 2WIRE not yet implemented.");
 }
 
@@ -153,10 +157,9 @@ Help
 */
 void TwoWireController::handleHelp() {
     terminalView.println("Unknown 2Wire command. Usage:");
-    terminalView.println("  config");
-    terminalView.println("  sniff");
-    terminalView.println("  smartcard ");
-    terminalView.println("  [0xAB r:4] Instruction syntax [NYI]");
+    for (const auto& command : CommandRegistry::of(ModeEnum::TwoWire)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
 }
 
 /*
@@ -166,9 +169,11 @@ void TwoWireController::ensureConfigured() {
     if (!configured) {
         handleConfig();
         configured = true;
+        claimPins();
         return;
     } 
 
+    if (!claimPins()) return;
     twoWireService.configure(
         state.getTwoWireClkPin(),
         state.getTwoWireIoPin(),
@@ -176,4 +181,14 @@ void TwoWireController::ensureConfigured() {
     );
 }
 
+/*
+Claim Pins, true when another mode used them since or the settings changed
+*/
+bool TwoWireController::claimPins() {
+    uint8_t clk = state.getTwoWireClkPin();
+    uint8_t io = state.getTwoWireIoPin();
+    uint8_t rst = state.getTwoWireRstPin();
+    return state.getPinOwnership().claim(ModeEnum::TwoWire, {clk, io, rst}, PinOwnership::signature({clk, io, rst}));
+}
+
 
@@ -5,11 +5,12 @@
 #include "Services/SpiService.h" 
 #include "Interfaces/IInput.h"
 #include "Models/TerminalCommand.h"
-#include "Models/ByteCode.h"
+#include "Models/ByteCodeProgram.h"
 #include "Services/TwoWireService.h"
 #include "Managers/UserInputManager.h"
 #include "States/GlobalState.h"
 #include "Shells/SmartCardShell.h"
+#include "Dispatchers/CommandRouter.h"
 
 class TwoWireController {
 public:
@@ -26,7 +27,7 @@ public:
     void handleCommand(const TerminalCommand& cmd);
 
     // Entry point for handle compiled bytecode instructions
-    void handleInstruction(const std::vector<ByteCode>& bytecodes);
+    void handleInstruction(const ByteCodeProgram& program);
 
     // Ensure 2WIRE is configured before use
     void ensureConfigured();
@@ -41,6 +42,9 @@ private:
     // User pin configuration
     void handleConfig();
 
+    // Claim the mode's pins, true when they must be configured again
+    bool claimPins();
+
     // Show available commands
     void handleHelp();
 
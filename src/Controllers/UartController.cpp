@@ -12,7 +12,8 @@ UartController::UartController(
     HdUartService& hdUartService,
     ArgTransformer& argTransformer,
     UserInputManager& userInputManager,
-    UartAtShell& uartAtShell
+    UartAtShell& uartAtShell,
+    JobManager& jobManager
 )
     : terminalView(terminalView),
       terminalInput(terminalInput),
@@ -22,7 +23,8 @@ UartController::UartController(
       hdUartService(hdUartService),
       argTransformer(argTransformer),
       userInputManager(userInputManager),
-      uartAtShell(uartAtShell) 
+      uartAtShell(uartAtShell),
+      jobManager(jobManager)
 {}
 
 
@@ -30,24 +32,28 @@ UartController::UartController(
 Entry point for command
 */
 void UartController::handleCommand(const TerminalCommand& cmd) {
-    if (cmd.getRoot() == "scan") handleScan();
-    else if (cmd.getRoot() == "ping") handlePing();
-    else if (cmd.getRoot() == "read") handleRead();
-    else if (cmd.getRoot() == "write") handleWrite(cmd);
-    else if (cmd.getRoot() == "bridge") handleBridge();
-    else if (cmd.getRoot() == "at") handleAtCommand(cmd);
-    else if (cmd.getRoot() == "spam") handleSpam(cmd);
-    else if (cmd.getRoot() == "glitch") handleGlitch();
-    else if (cmd.getRoot() == "xmodem") handleXmodem(cmd);
-    else if (cmd.getRoot() == "config") handleConfig();
-    else handleHelp();
+    static constexpr CommandRoute<UartController> routes[] = {
+        {"scan",   &UartController::handleScan},
+        {"ping",   &UartController::handlePing},
+        {"read",   &UartController::handleRead},
+        {"write",  &UartController::handleWrite},
+        {"bridge", &UartController::handleBridge},
+        {"at",     &UartController::handleAtCommand},
+        {"spam",   &UartController::handleSpam},
+        {"glitch", &UartController::handleGlitch},
+        {"xmodem", &UartController::handleXmodem},
+        {"config", &UartController::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::UART, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 /*
 Entry point for instructions
 */
-void UartController::handleInstruction(const std::vector<ByteCode>& bytecodes) {
-    auto result = uartService.executeByteCode(bytecodes);
+void UartController::handleInstruction(const ByteCodeProgram& program) {
+    auto result = uartService.executeByteCode(program);
     terminalView.println("");
     terminalView.print("UART Read: ");
     if (!result.empty()) {
@@ -92,24 +98,21 @@ void UartController::handleBridge() {
 Read
 */
 void UartController::handleRead() {
-    terminalView.println("UART Read: Streaming until [ENTER] is pressed...");
     uartService.flush();
 
-    while (true) {
-        // Stop if ENTER is pressed
-        char key = terminalInput.readChar();
-        if (key == '\r' || key == '\n') {
-            terminalView.println("");
-            terminalView.println("UART Read: Stopped by user.");
-            break;
+    jobManager.run("UART Read: Streaming", {state.getUartRxPin(), state.getUartTxPin()}, [this](IJobOutput& out) {
+        std::string chunk;
+        while (out.poll()) {
+            // Print UART data as it comes
+            chunk.clear();
+            while (uartService.available() > 0) {
+                chunk += uartService.read();
+            }
+            if (!chunk.empty()) out.print(chunk);
         }
-
-        // Print UART data as it comes
-        while (uartService.available() > 0) {
-            char c = uartService.read();
-            terminalView.print(std::string(1, c));
-        }
-    }
+        out.println("");
+        out.println("UART Read: Stopped by user.");
+    });
 }
 
 /*
@@ -122,7 +125,7 @@ void UartController::handleAtCommand(const TerminalCommand& cmd) {
 /*
 Write
 */
-void UartController::handleWrite(TerminalCommand cmd) {
+void UartController::handleWrite(const TerminalCommand& cmd) {
     std::string raw = cmd.getSubcommand() + cmd.getArgs();
     std::string decoded = argTransformer.decodeEscapes(raw);
     uartService.print(decoded);
@@ -445,6 +448,7 @@ void UartController::handleXmodemSend(const std::string& path) {
 
     // Close Xmodem
     uartService.end();
+    state.getPinOwnership().release(ModeEnum::UART);
     ensureConfigured();
 
     // Close SD
@@ -492,6 +496,7 @@ void UartController::handleXmodemReceive(const std::string& path) {
 
     // Close Xmodem
     uartService.end();
+    state.getPinOwnership().release(ModeEnum::UART);
     ensureConfigured();
 
     // Close SD
@@ -546,18 +551,9 @@ Help
 void UartController::handleHelp() {
     terminalView.println("");
     terminalView.println("Unknown UART command. Usage:");
-    terminalView.println("  scan");
-    terminalView.println("  ping");
-    terminalView.println("  read");
-    terminalView.println("  write <text>");
-    terminalView.println("  bridge");
-    terminalView.println("  at");
-    terminalView.println("  spam <text> <ms>");
-    terminalView.println("  glitch");
-    terminalView.println("  xmodem recv <dest path>");
-    terminalView.println("  xmodem send <file path>");
-    terminalView.println("  config");
-    terminalView.println("  raw instructions, ['AT' D:100 r:128]");
+    for (const auto& command : CommandRegistry::of(ModeEnum::UART)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
     terminalView.println("");
 }
 
@@ -577,12 +573,15 @@ void UartController::ensureConfigured() {
     if (!configured) {
         handleConfig();
         configured = true;
+        claimPins();
         return;
     }
 
     // User could have set the same pin to a different usage
     // eg. select UART, then select I2C, then select UART
-    // Always reconfigure pins before use
+    // Reconfigure only when that happened
+    if (!claimPins()) return;
+
     uartService.end();
 
     uint8_t rx = state.getUartRxPin();
@@ -592,4 +591,16 @@ void UartController::ensureConfigured() {
     bool inverted = state.isUartInverted();
 
     uartService.configure(baud, config, rx, tx, inverted);
+}
+
+/*
+Claim Pins, true when another mode used them since or the settings changed
+*/
+bool UartController::claimPins() {
+    uint8_t rx = state.getUartRxPin();
+    uint8_t tx = state.getUartTxPin();
+    uint32_t settings = PinOwnership::signature({
+        rx, tx, static_cast<uint32_t>(state.getUartBaudRate()), state.getUartConfig(), state.isUartInverted()
+    });
+    return state.getPinOwnership().claim(ModeEnum::UART, {rx, tx}, settings);
 }
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include <string>
 #include "HardwareSerial.h"
 #include "Models/TerminalCommand.h"
-#include "Models/ByteCode.h"
+#include "Models/ByteCodeProgram.h"
 #include "Services/UartService.h"
 #include "Services/HdUartService.h"
 #include "Services/SdService.h"
@@ -13,7 +13,9 @@
 #include "States/GlobalState.h"
 #include "Transformers/ArgTransformer.h"
 #include "Managers/UserInputManager.h"
+#include "Managers/JobManager.h"
 #include "Shells/UartAtShell.h"
+#include "Dispatchers/CommandRouter.h"
 
 class UartController {
 public:
@@ -26,13 +28,14 @@ public:
                    HdUartService& hdUartService, 
                    ArgTransformer& argTransformer,
                    UserInputManager& userInputManager,
-                   UartAtShell& uartAtShell);
+                   UartAtShell& uartAtShell,
+                   JobManager& jobManager);
     
     // Entry point for UART command
     void handleCommand(const TerminalCommand& cmd);
 
     //  Entry point for handle parsed bytecode instructions
-    void handleInstruction(const std::vector<ByteCode>& bytecodes);
+    void handleInstruction(const ByteCodeProgram& program);
     
     // Ensure UART is configured before use
     void ensureConfigured();
@@ -48,7 +51,7 @@ private:
     void handlePing();
     
     // Write data to UART
-    void handleWrite(TerminalCommand cmd);
+    void handleWrite(const TerminalCommand& cmd);
 
     // Handle AT commands
     void handleAtCommand(const TerminalCommand& cmd);
@@ -56,6 +59,9 @@ private:
     // Configure UART settings
     void handleConfig();
 
+    // Claim the mode's pins, true when they must be configured again
+    bool claimPins();
+
     // Display available commands
     void handleHelp();
 
@@ -104,6 +110,7 @@ private:
     ArgTransformer& argTransformer;
     UserInputManager& userInputManager;
     UartAtShell& uartAtShell;
+    JobManager& jobManager;
     GlobalState& state = GlobalState::getInstance();
     bool configured = false;
     bool scanCancelled = false;
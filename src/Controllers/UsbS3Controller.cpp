@@ -25,13 +25,17 @@ UsbS3Controller::UsbS3Controller(
 Entry point for command
 */
 void UsbS3Controller::handleCommand(const TerminalCommand& cmd) {
-    if (cmd.getRoot() == "stick") handleUsbStick();
-    else if (cmd.getRoot() == "keyboard") handleKeyboard(cmd);
-    else if (cmd.getRoot() == "mouse") handleMouse(cmd);
-    else if (cmd.getRoot() == "gamepad") handleGamepad(cmd);
-    else if (cmd.getRoot() == "reset") handleReset();
-    else if (cmd.getRoot() == "config") handleConfig();
-    else handleHelp();
+    static constexpr CommandRoute<UsbS3Controller> routes[] = {
+        {"stick",    &UsbS3Controller::handleUsbStick},
+        {"keyboard", &UsbS3Controller::handleKeyboard},
+        {"mouse",    &UsbS3Controller::handleMouse},
+        {"gamepad",  &UsbS3Controller::handleGamepad},
+        {"reset",    &UsbS3Controller::handleReset},
+        {"config",   &UsbS3Controller::handleConfig},
+    };
+    static constexpr CommandRouter router(ModeEnum::USB, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 /*
@@ -251,15 +255,9 @@ Help
 void UsbS3Controller::handleHelp() {
     terminalView.println("Unknown command.");
     terminalView.println("Usage:");
-    terminalView.println("  stick");
-    terminalView.println("  keyboard");
-    terminalView.println("  keyboard <text>");
-    terminalView.println("  mouse <x> <y>");
-    terminalView.println("  mouse click");
-    terminalView.println("  mouse jiggle [ms]");
-    terminalView.println("  gamepad <key>, eg. A, B, LEFT...");
-    terminalView.println("  reset");
-    terminalView.println("  config");
+    for (const auto& command : CommandRegistry::of(ModeEnum::USB)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
 }
 
 /*
@@ -7,12 +7,13 @@
 #include "Interfaces/ITerminalView.h"
 #include "Interfaces/IInput.h"
 #include "Models/TerminalCommand.h"
-#include "Models/ByteCode.h"
+#include "Models/ByteCodeProgram.h"
 #include "States/GlobalState.h"
 #include "Transformers/ArgTransformer.h"
 #include "Managers/UserInputManager.h"
 #include "Interfaces/IUsbController.h"
 #include "Interfaces/IUsbService.h"
+#include "Dispatchers/CommandRouter.h"
 
 class UsbS3Controller: public IUsbController {
 public:
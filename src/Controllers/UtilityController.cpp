@@ -8,29 +8,48 @@ UtilityController::UtilityController(
     IDeviceView& deviceView,
     IInput& terminalInput,
     PinService& pinService,
+    LogicCaptureService& logicCaptureService,
+    LogicCaptureManager& logicCaptureManager,
+    SumpManager& sumpManager,
     UserInputManager& userInputManager,
     ArgTransformer& argTransformer,
-    SysInfoShell& sysInfoShell
+    SysInfoShell& sysInfoShell,
+    JobManager& jobManager
 )
     : terminalView(terminalView),
       deviceView(deviceView),
       terminalInput(terminalInput),
       pinService(pinService),
+      logicCaptureService(logicCaptureService),
+      logicCaptureManager(logicCaptureManager),
+      sumpManager(sumpManager),
       userInputManager(userInputManager),
       argTransformer(argTransformer),
-      sysInfoShell(sysInfoShell)
+      sysInfoShell(sysInfoShell),
+      jobManager(jobManager)
 {}
 
 /*
 Entry point for command
 */
 void UtilityController::handleCommand(const TerminalCommand& cmd) {
-    if (cmd.getRoot() == "help" || cmd.getRoot() == "h" || cmd.getRoot() == "?") handleHelp();
-    else if (cmd.getRoot() == "P")                                               handleEnablePullups();
-    else if (cmd.getRoot() == "p")                                               handleDisablePullups();
-    else if (cmd.getRoot() == "logic")                                           handleLogicAnalyzer(cmd);
-    else if (cmd.getRoot() == "system")                                          handleSystem();
-    else {
+    static constexpr CommandRoute<UtilityController> routes[] = {
+        {"help",   &UtilityController::handleHelp},
+        {"h",      &UtilityController::handleHelp},
+        {"?",      &UtilityController::handleHelp},
+        {"P",      &UtilityController::handleEnablePullups},
+        {"p",      &UtilityController::handleDisablePullups},
+        {"logic",  &UtilityController::handleLogicAnalyzer},
+        {"system", &UtilityController::handleSystem},
+        {"trace",  &UtilityController::handleTrace},
+        {"timing", &UtilityController::handleTiming},
+        {"jobs",   &UtilityController::handleJobs},
+        {"fg",     &UtilityController::handleForeground},
+        {"kill",   &UtilityController::handleKill},
+    };
+    static constexpr CommandRouter router(ModeEnum::None, routes);
+
+    if (!router.dispatch(*this, cmd)) {
         terminalView.println("Unknown command. Try 'help'.");
     }
 }
@@ -207,8 +226,21 @@ void UtilityController::handleEnablePullups() {
 Logic
 */
 void UtilityController::handleLogicAnalyzer(const TerminalCommand& cmd) {
+    if (cmd.getSubcommand() == "capture") {
+        handleLogicCapture();
+        return;
+    }
+    if (cmd.getSubcommand() == "sump") {
+        handleLogicSump();
+        return;
+    }
+    if (cmd.getSubcommand() == "decode") {
+        handleLogicDecode();
+        return;
+    }
+
     if (cmd.getSubcommand().empty() || !argTransformer.isValidNumber(cmd.getSubcommand())) {
-        terminalView.println("Usage: logic <pin>");
+        terminalView.println("Usage: logic <pin> [sample rate]");
         return;
     }
 
@@ -220,15 +252,34 @@ void UtilityController::handleLogicAnalyzer(const TerminalCommand& cmd) {
         return;
     }
 
-    terminalView.println("\nLogic Analyzer: Monitoring pin " + std::to_string(pin) + "... Press [ENTER] to stop.");
-    terminalView.println("Displaying waveform on the ESP32 screen...\n");
-
+    // Sample rate
+    uint32_t rate = LOGIC_DEFAULT_RATE;
+    if (!cmd.getArgs().empty()) {
+        if (!argTransformer.isValidNumber(cmd.getArgs())) {
+            terminalView.println("Usage: logic <pin> [sample rate]");
+            return;
+        }
+        rate = argTransformer.toUint32(cmd.getArgs());
+    }
 
     pinService.setInput(pin);
-    std::vector<uint8_t> buffer;
-    buffer.reserve(240); // 240 samples
+    if (!logicCaptureService.start(pin, rate)) {
+        terminalView.println("Logic Analyzer: Sample rate must be between " + std::to_string(LogicCaptureService::MIN_SAMPLE_RATE) +
+                             " and " + std::to_string(LogicCaptureService::MAX_SAMPLE_RATE) + " S/s.");
+        return;
+    }
+
+    terminalView.println("\nLogic Analyzer: Sampling pin " + std::to_string(pin) + " at " +
+                         std::to_string(logicCaptureService.getSampleRate()) + " S/s... Press [ENTER] to stop.");
+    terminalView.println("Displaying waveform on the ESP32 screen...\n");
+
+    std::vector<uint32_t> block(LogicCaptureService::BLOCK_WORDS);
+    std::vector<uint8_t> trace(LOGIC_TRACE_SAMPLES);
+    size_t filled = 0;
+    uint64_t captured = 0;
 
     unsigned long lastCheck = millis();
+    unsigned long lastDraw = 0;
     deviceView.clear();
     deviceView.topBar("Logic Analyzer", false, false);
 
@@ -243,236 +294,441 @@ void UtilityController::handleLogicAnalyzer(const TerminalCommand& cmd) {
             }
         }
 
-        // Draw
-        if (buffer.size() >= 240) {
-            buffer.resize(240);
-            deviceView.drawLogicTrace(pin, buffer);
-            buffer.clear();
+        // Fill a DMA buffer worth of samples, they are not touched until drawn
+        size_t words = logicCaptureService.read(block.data() + filled, block.size() - filled, 20);
+        captured += words * LogicCaptureService::SAMPLES_PER_WORD;
+        filled += words;
+        if (filled < block.size()) continue;
+        filled = 0;
+        if (millis() - lastDraw < LOGIC_DRAW_INTERVAL_MS) continue;
+        lastDraw = millis();
+
+        // Draw, starting just before the first edge so an idle line still shows activity
+        size_t edge = LogicCaptureService::firstEdge(block.data(), block.size());
+        size_t start = edge > LOGIC_TRACE_LEAD ? edge - LOGIC_TRACE_LEAD : 0;
+        start = std::min(start, block.size() * LogicCaptureService::SAMPLES_PER_WORD - trace.size());
+        for (size_t i = 0; i < trace.size(); ++i) {
+            trace[i] = LogicCaptureService::sampleAt(block.data(), start + i);
         }
+        deviceView.drawLogicTrace(pin, trace);
+    }
+
+    uint32_t overruns = logicCaptureService.getOverruns();
+    logicCaptureService.stop();
+    terminalView.println("Logic Analyzer: " + std::to_string(captured) + " samples captured, " +
+                         std::to_string(overruns) + " DMA buffers skipped while drawing.");
+}
+
+/*
+Logic Capture
+*/
+void UtilityController::handleLogicCapture() {
+    terminalView.println("\nLogic Capture: Up to " + std::to_string(LogicCaptureService::MAX_CHANNELS) + " channels, bit n is the n-th pin.");
+
+    auto pins = userInputManager.readValidatedPinGroup("Channel pins", logicCaptureManager.getPins(), state.getProtectedPins());
+    if (pins.empty() || pins.size() > LogicCaptureService::MAX_CHANNELS) {
+        terminalView.println("Logic Capture: Select 1 to " + std::to_string(LogicCaptureService::MAX_CHANNELS) + " pins.");
+        return;
+    }
+
+    uint32_t rate = userInputManager.readValidatedUint32("Sample rate (S/s)", LOGIC_DEFAULT_RATE);
+    if (rate == 0 || rate > LogicCaptureManager::MAX_SAMPLE_RATE) {
+        terminalView.println("Logic Capture: Sample rate must be between 1 and " + std::to_string(LogicCaptureManager::MAX_SAMPLE_RATE) + " S/s.");
+        return;
+    }
+
+    LogicTrigger trigger;
+    if (!readLogicTrigger(pins.size(), rate, trigger)) return;
+
+    // Only the pre-trigger part is stored raw, the rest is bounded by memory
+    uint32_t depth = std::max<uint32_t>(1, userInputManager.readValidatedUint32("Samples to capture", 100000));
+    uint8_t prePercent = userInputManager.readValidatedUint8("Pre-trigger part (%)", 10, 0, 100);
+    size_t pre = std::min<size_t>(uint64_t(depth) * prePercent / 100, LogicCaptureManager::MAX_PRE_SAMPLES);
 
-        buffer.push_back(pinService.read(pin));
-        delayMicroseconds(500);
+    for (auto pin : pins) pinService.setInput(pin);
+    terminalView.println("\nLogic Capture: Waiting for trigger... Press [ENTER] to stop.");
+
+    bool complete = logicCaptureManager.capture(pins, rate, trigger, pre, depth - pre, [&]() {
+        char c = terminalInput.readChar();
+        return c == '\r' || c == '\n';
+    });
+
+    if (!complete && !logicCaptureManager.isTriggered()) {
+        terminalView.println("Logic Capture: Stopped by user before the trigger, showing the last samples.");
+    } else if (!complete) {
+        terminalView.println("Logic Capture: Stopped by user.");
+    } else if (logicCaptureManager.getCapture().isFull()) {
+        terminalView.println("Logic Capture: Memory full, the capture ends early.");
     }
+
+    const auto& capture = logicCaptureManager.getCapture();
+    uint32_t late = logicCaptureManager.getLateSamples();
+    terminalView.println("Logic Capture: " + std::to_string(capture.size()) + " samples at " +
+                         std::to_string(logicCaptureManager.getSampleRate()) + " S/s in " +
+                         std::to_string(capture.bytes()) + " bytes" +
+                         (late ? ", " + std::to_string(late) + " taken late, lower the rate for exact timing." : "."));
+    printLogicCapture();
 }
 
 /*
-System Information
+Logic SUMP
 */
-void UtilityController::handleSystem() {
-    sysInfoShell.run();
+void UtilityController::handleLogicSump() {
+    terminalView.println("\nLogic SUMP: Up to " + std::to_string(LogicCaptureService::MAX_CHANNELS) + " channels, bit n is the n-th pin.");
+
+    auto pins = userInputManager.readValidatedPinGroup("Channel pins", logicCaptureManager.getPins(), state.getProtectedPins());
+    if (pins.empty() || pins.size() > LogicCaptureService::MAX_CHANNELS) {
+        terminalView.println("Logic SUMP: Select 1 to " + std::to_string(LogicCaptureService::MAX_CHANNELS) + " pins.");
+        return;
+    }
+    for (auto pin : pins) pinService.setInput(pin);
+
+    // The client and the serial terminal share the port, [ENTER] comes from whichever is open
+    bool serialTerminal = state.getTerminalMode() == TerminalTypeEnum::Serial;
+    terminalView.println("\nLogic SUMP: Open the USB serial port in PulseView with the Openbench Logic Sniffer driver, up to " +
+                         std::to_string(LogicCaptureManager::MAX_SAMPLE_RATE) + " S/s and " +
+                         std::to_string(SumpManager::sampleMemory()) + " samples.");
+    terminalView.println(serialTerminal
+        ? "Logic SUMP: Close this terminal first. Reopen it and press [ENTER] to come back."
+        : "Logic SUMP: Press [ENTER] to stop.");
+
+    uint32_t captures = sumpManager.serve(pins, [&]() {
+        if (serialTerminal) return false;
+        char c = terminalInput.readChar();
+        return c == '\r' || c == '\n';
+    });
+
+    terminalView.println("Logic SUMP: Stopped, " + std::to_string(captures) + " captures sent.");
 }
 
 /*
-Help
+Logic Decode
 */
-void UtilityController::handleHelp() {
-    terminalView.println("");
-    terminalView.println("   +=== Help: Available Commands ===+");
-    terminalView.println("");
+void UtilityController::handleLogicDecode() {
+    const auto& capture = logicCaptureManager.getCapture();
+    const auto& pins = logicCaptureManager.getPins();
+    if (!capture.size()) {
+        terminalView.println("Logic Decode: No capture yet, run 'logic capture' first.");
+        return;
+    }
 
-    terminalView.println(" General:");
-    terminalView.println("  help                 - Show this help");
-    terminalView.println("  system               - Show system infos");
-    terminalView.println("  mode <name>          - Set active mode");
-    terminalView.println("  logic <pin>          - Logic analyzer");
-    terminalView.println("  P                    - Enable pull-up");
-    terminalView.println("  p                    - Disable pull-up");
+    auto protocol = static_cast<LogicDecoderEnum>(
+        userInputManager.readValidatedChoiceIndex("\nProtocol", LogicDecoderEnumMapper::getAll(), 0));
+    const uint8_t last = pins.size() - 1;
+    auto readChannel = [&](const std::string& role, uint8_t def) {
+        return userInputManager.readValidatedUint8(role + " channel", std::min(def, last), 0, last);
+    };
+    const uint32_t rate = logicCaptureManager.getSampleRate();
+
+    switch (protocol) {
+        case LogicDecoderEnum::Uart: {
+            uint8_t rx = readChannel("RX", 0);
+            uint32_t baud = userInputManager.readValidatedUint32("Baud rate (0 to detect)", 0);
+            UartDecoder decoder(rx, baud);
+            decoder.decode(capture, rate, LOGIC_DECODE_FRAMES);
+            if (!decoder.getBaud()) {
+                terminalView.println("Logic Decode: Not enough edges to find the baud rate.");
+                return;
+            }
+            terminalView.println("Logic Decode: " + std::to_string(decoder.getBaud()) + " baud" + (baud ? "." : ", detected."));
+            printLogicFrames(decoder.getFrames(), protocol);
+            break;
+        }
+        case LogicDecoderEnum::I2c: {
+            uint8_t scl = readChannel("SCL", 0);
+            uint8_t sda = readChannel("SDA", 1);
+            I2cDecoder decoder(scl, sda);
+            printLogicFrames(decoder.decode(capture, rate, LOGIC_DECODE_FRAMES), protocol);
+            break;
+        }
+        case LogicDecoderEnum::Spi: {
+            uint8_t clk = readChannel("CLK", 0);
+            uint8_t mosi = readChannel("MOSI", 1);
+            uint8_t miso = userInputManager.readYesNo("MISO recorded?", pins.size() > 2) ? readChannel("MISO", 2) : SpiDecoder::NO_CHANNEL;
+            uint8_t cs = userInputManager.readYesNo("CS recorded?", pins.size() > 3) ? readChannel("CS", 3) : SpiDecoder::NO_CHANNEL;
+            uint8_t mode = userInputManager.readValidatedUint8("SPI mode", 0, 0, 3);
+            uint8_t bits = userInputManager.readValidatedUint8("Bits per word", 8, 1, 32);
+            SpiDecoder decoder(clk, mosi, miso, cs, mode, bits);
+            printLogicFrames(decoder.decode(capture, rate, LOGIC_DECODE_FRAMES), protocol);
+            break;
+        }
+        case LogicDecoderEnum::OneWire: {
+            OneWireDecoder decoder(readChannel("Data", 0));
+            printLogicFrames(decoder.decode(capture, rate, LOGIC_DECODE_FRAMES), protocol);
+            break;
+        }
+    }
+}
 
-    terminalView.println("");
-    terminalView.println(" 1. HiZ:");
-    terminalView.println("  (default mode)       - All lines disabled");
+/*
+Print Logic Frames
+*/
+void UtilityController::printLogicFrames(const std::vector<LogicFrame>& frames, LogicDecoderEnum protocol) {
+    if (frames.empty()) {
+        terminalView.println("Logic Decode: No frames found.");
+        return;
+    }
 
-    terminalView.println("");
-    terminalView.println(" 2. 1WIRE:");
-    terminalView.println("  scan                 - Scan 1-Wire devices");
-    terminalView.println("  ping                 - Ping 1-Wire device");
-    terminalView.println("  sniff                - View 1-Wire traffic");
-    terminalView.println("  read                 - Read ID + SP");
-    terminalView.println("  write id [8 bytes]   - Write device ID");
-    terminalView.println("  write sp [8 bytes]   - Write scratchpad");
-    terminalView.println("  temp                 - Read temperature");
-    terminalView.println("  ibutton              - iButton operations");
-    terminalView.println("  config               - Configure settings");
-    terminalView.println("  [0xAA r:8] ...       - Instruction syntax");
+    const double usPerSample = 1e6 / logicCaptureManager.getSampleRate();
+    for (const auto& frame : frames) {
+        std::string line = argTransformer.formatFloat(frame.start * usPerSample, 2) + " us";
+        line.insert(0, line.size() < 14 ? 14 - line.size() : 0, ' ');
+        line += "  " + LogicFrameEnumMapper::toString(frame.type);
 
-    terminalView.println("");
-    terminalView.println(" 3. UART:");
-    terminalView.println("  scan                 - Auto baud detect");
-    terminalView.println("  ping                 - Send and expect reply");
-    terminalView.println("  read                 - Read at current baud");
-    terminalView.println("  write <text>         - Send at current baud");
-    terminalView.println("  bridge               - Full-duplex mode");
-    terminalView.println("  at                   - AT commands operations");
-    terminalView.println("  spam <text> <ms>     - Write text every ms");
-    terminalView.println("  glitch               - Timing attack");
-    terminalView.println("  xmodem <send> <path> - Send file via XMODEM");
-    terminalView.println("  xmodem <recv> <path> - Receive file via XMODEM");
-    terminalView.println("  config               - Configure settings");
-    terminalView.println("  ['Hello'] [r:64]...  - Instruction syntax");
- 
-    terminalView.println("");
-    terminalView.println(" 4. HDUART:");
-    terminalView.println("  bridge               - Half-duplex I/O");
-    terminalView.println("  config               - Configure settings");
-    terminalView.println("  [0x1 D:10 r:255]     - Instruction syntax");
+        switch (frame.type) {
+            case LogicFrameEnum::Address:
+                line += " 0x" + argTransformer.toHex(frame.value) + (frame.read ? " R" : " W") + (frame.ack ? " ACK" : " NACK");
+                break;
+            case LogicFrameEnum::Data:
+                if (protocol == LogicDecoderEnum::Spi) {
+                    line += " MOSI 0x" + argTransformer.toHex(frame.value) + " MISO 0x" + argTransformer.toHex(frame.miso);
+                    if (frame.error) line += " (cut by CS)";
+                    break;
+                }
+                line += " 0x" + argTransformer.toHex(frame.value);
+                if (frame.value >= 0x20 && frame.value < 0x7F) line += std::string(" '") + static_cast<char>(frame.value) + "'";
+                if (protocol == LogicDecoderEnum::I2c) line += frame.ack ? " ACK" : " NACK";
+                if (frame.error) line += " (framing error)";
+                break;
+            default:
+                break;
+        }
+        terminalView.println(line);
+    }
 
-    terminalView.println("");
-    terminalView.println(" 5. I2C:");
-    terminalView.println("  scan                 - Find devices");
-    terminalView.println("  ping <addr>          - Check ACK");
-    terminalView.println("  identify <addr>      - Identify device");
-    terminalView.println("  sniff                - View traffic");
-    terminalView.println("  slave <addr>         - Emulate I2C device");
-    terminalView.println("  read <addr> <reg>    - Read register");
-    terminalView.println("  write <a> <r> <val>  - Write register");
-    terminalView.println("  dump <addr> [len]    - Read all registers");
-    terminalView.println("  glitch <addr>        - Run attack sequence");
-    terminalView.println("  flood <addr>         - Saturate target I/O");
-    terminalView.println("  monitor <addr> [ms]  - Monitor register changes");
-    terminalView.println("  eeprom [addr]        - I2C EEPROM operations");
-    terminalView.println("  recover              - Attempt bus recovery");
-    terminalView.println("  config               - Configure settings");
-    terminalView.println("  [0x13 0x4B 0x1]      - Instruction syntax");
+    if (frames.size() >= LOGIC_DECODE_FRAMES) {
+        terminalView.println("Logic Decode: Stopped after " + std::to_string(LOGIC_DECODE_FRAMES) + " frames.");
+    }
+}
 
-    terminalView.println("");
-    terminalView.println(" 6. SPI:");
-    terminalView.println("  sniff                - View traffic");
-    terminalView.println("  sdcard               - SD operations");
-    terminalView.println("  slave                - Emulate SPI slave");
-    terminalView.println("  flash                - SPI Flash operations");
-    terminalView.println("  eeprom               - SPI EEPROM operations");
-    terminalView.println("  config               - Configure settings");
-    terminalView.println("  [0x9F r:3]           - Instruction syntax");
+/*
+Logic Trigger
+*/
+bool UtilityController::readLogicTrigger(size_t channels, uint32_t rate, LogicTrigger& trigger) {
+    int choice = userInputManager.readValidatedChoiceIndex("\nTrigger", LogicTriggerEnumMapper::getAll(), 1);
+    trigger.type = static_cast<LogicTriggerEnum>(choice);
+
+    switch (trigger.type) {
+        case LogicTriggerEnum::Rising:
+        case LogicTriggerEnum::Falling:
+            trigger.channel = userInputManager.readValidatedUint8("Trigger channel", 0, 0, channels - 1);
+            return true;
+
+        case LogicTriggerEnum::Pattern: {
+            // One char per channel, channel 0 first
+            terminalView.print("Pattern, channel 0 first, 1/0/x (eg. 10x1): ");
+            std::string pattern = argTransformer.toLower(userInputManager.getLine());
+            if (pattern.empty() || pattern.size() > channels) {
+                terminalView.println("Logic Capture: The pattern needs one char per channel at most.");
+                return false;
+            }
+            for (size_t i = 0; i < pattern.size(); ++i) {
+                if (pattern[i] == 'x') continue;
+                if (pattern[i] != '0' && pattern[i] != '1') {
+                    terminalView.println("Logic Capture: Use only 1, 0 or x in the pattern.");
+                    return false;
+                }
+                trigger.mask |= 1 << i;
+                if (pattern[i] == '1') trigger.value |= 1 << i;
+            }
+            return true;
+        }
 
-    terminalView.println("");
-    terminalView.println(" 7. 2WIRE:");
-    terminalView.println("  sniff                - View 2WIRE traffic");
-    terminalView.println("  smartcard            - Smartcard operations");
-    terminalView.println("  config               - Configure settings");
-    terminalView.println("  [0xAB r:4]           - Instruction syntax");
+        case LogicTriggerEnum::Pulse: {
+            trigger.channel = userInputManager.readValidatedUint8("Trigger channel", 0, 0, channels - 1);
+            trigger.level = userInputManager.readYesNo("High pulse?", true) ? 1 : 0;
+            uint32_t minNs = userInputManager.readValidatedUint32("Minimum width (ns)", 0);
+            uint32_t maxNs = userInputManager.readValidatedUint32("Maximum width (ns)", 1000000);
+            if (maxNs < minNs) {
+                terminalView.println("Logic Capture: The maximum width is below the minimum.");
+                return false;
+            }
+            // Widths in samples, a pulse shorter than a sample may still be seen as one
+            trigger.minWidth = static_cast<uint32_t>(uint64_t(minNs) * rate / 1000000000ULL);
+            trigger.maxWidth = std::max<uint32_t>(1, static_cast<uint32_t>((uint64_t(maxNs) * rate + 999999999ULL) / 1000000000ULL));
+            return true;
+        }
 
-    terminalView.println("");
-    terminalView.println(" 8. 3WIRE:");
-    terminalView.println("  eeprom               - 3WIRE EEPROM operations");
-    terminalView.println("  config               - Configure settings");
+        default:
+            return true;
+    }
+}
 
-    terminalView.println("");
-    terminalView.println(" 9. DIO:");
-    terminalView.println("  sniff <pin>          - Track toggle states");
-    terminalView.println("  read <pin>           - Get pin state");
-    terminalView.println("  set <pin> <H/L/I/O>  - Set pin state");
-    terminalView.println("  pullup <pin>         - Set pin pullup");
-    terminalView.println("  pwm <pin> freq <dut> - Set PWM on pin");
-    terminalView.println("  toggle <pin> <ms>    - Toggle pin periodically");
-    terminalView.println("  measure <pin> [ms]   - Calculate frequency");
-    terminalView.println("  analog <pin>         - Read analog value");
-    terminalView.println("  reset <pin>          - Reset to default");
+/*
+Print Logic Capture, each column sums up the same number of samples
+*/
+void UtilityController::printLogicCapture() {
+    const auto& capture = logicCaptureManager.getCapture();
+    const auto& pins = logicCaptureManager.getPins();
+    if (!capture.size()) return;
+
+    uint64_t step = (capture.size() + LOGIC_PRINT_COLUMNS - 1) / LOGIC_PRINT_COLUMNS;
+    size_t columns = (capture.size() + step - 1) / step;
+    size_t triggerColumn = logicCaptureManager.getTriggerIndex() / step;
+
+    // High samples per channel and column, a run at a time
+    std::vector<uint64_t> high(pins.size() * columns, 0);
+    LogicCapture::Reader reader(capture);
+    uint8_t value;
+    uint64_t length;
+    uint64_t position = 0;
+    while (reader.next(value, length)) {
+        for (uint64_t end = position + length; position < end;) {
+            size_t column = position / step;
+            uint64_t span = std::min(end, (column + 1) * step) - position;
+            for (size_t channel = 0; channel < pins.size(); ++channel) {
+                if ((value >> channel) & 1) high[channel * columns + column] += span;
+            }
+            position += span;
+        }
+    }
 
     terminalView.println("");
-    terminalView.println(" 10. LED:");
-    terminalView.println("  scan                 - Try to detect LEDs type");
-    terminalView.println("  fill <color>         - Fill all LEDs with a color");
-    terminalView.println("  set <index> <color>  - Set specific LED color");
-    terminalView.println("  blink                - Blink all LEDs");
-    terminalView.println("  rainbow              - Rainbow animation");
-    terminalView.println("  chase                - Chasing light effect");
-    terminalView.println("  cycle                - Cycle through colors");
-    terminalView.println("  wave                 - Wave animation");
-    terminalView.println("  reset                - Turn off all LEDs");
-    terminalView.println("  setprotocol          - Select LED protocol");
-    terminalView.println("  config               - Configure LED settings");
+    for (size_t channel = 0; channel < pins.size(); ++channel) {
+        std::string line = " CH" + std::to_string(channel) + " GPIO" + std::to_string(pins[channel]);
+        line.resize(12, ' ');
+        for (size_t column = 0; column < columns; ++column) {
+            uint64_t width = std::min<uint64_t>(step, capture.size() - column * step);
+            uint64_t count = high[channel * columns + column];
+            line += count == 0 ? "_" : count == width ? "‾" : "|";
+        }
+        terminalView.println(line);
+    }
 
-    terminalView.println("");
-    terminalView.println(" 11. INFRARED:");
-    terminalView.println("  send <dev> sub <cmd> - Send IR signal");
-    terminalView.println("  receive              - Receive IR signal");
-    terminalView.println("  setprotocol          - Set IR protocol type");
-    terminalView.println("  devicebgone          - OFF devices blast");
-    terminalView.println("  remote               - Universal remote commands");
-    terminalView.println("  replay [count]       - Replay recorded IR frames");
-    terminalView.println("  config               - Configure settings");
+    if (logicCaptureManager.isTriggered()) {
+        terminalView.println(std::string(12 + triggerColumn, ' ') + "^ trigger");
+    }
+    terminalView.println(" 1 column = " + std::to_string(step) + " samples, " +
+                         argTransformer.formatFloat(step * 1e6 / logicCaptureManager.getSampleRate(), 2) + " us\n");
+
+    // The screen shows the first channel around the trigger, expanded from the runs
+    std::vector<uint8_t> trace(LOGIC_TRACE_SAMPLES);
+    uint64_t triggerIndex = logicCaptureManager.getTriggerIndex();
+    uint64_t start = triggerIndex > trace.size() / 2 ? triggerIndex - trace.size() / 2 : 0;
+    start = std::min<uint64_t>(start, capture.size() > trace.size() ? capture.size() - trace.size() : 0);
+    trace.resize(capture.expand(start, trace.size(), trace.data()));
+    for (auto& sample : trace) sample &= 1;
+    deviceView.clear();
+    deviceView.topBar("Logic Capture", false, false);
+    deviceView.drawLogicTrace(pins[0], trace);
+}
 
-    terminalView.println("");
-    terminalView.println(" 12. USB:");
-    terminalView.println("  stick                - Mount SD as USB");
-    terminalView.println("  keyboard             - Start keyboard bridge");
-    terminalView.println("  mouse <x> <y>        - Move mouse cursor");
-    terminalView.println("  mouse click          - Left click");
-    terminalView.println("  mouse jiggle [ms]    - Random mouse moves");
-    terminalView.println("  gamepad <key>        - Press button");
-    terminalView.println("  reset                - Reset interface");
-    terminalView.println("  config               - Configure settings");
+/*
+System Information
+*/
+void UtilityController::handleSystem() {
+    sysInfoShell.run();
+}
 
-    terminalView.println("");
-    terminalView.println(" 13. BLUETOOTH:");
-    terminalView.println("  scan                 - Discover devices");
-    terminalView.println("  pair <mac>           - Pair with a device");
-    terminalView.println("  sniff                - Sniff Bluetooth data");
-    terminalView.println("  spoof <mac>          - Spoof mac address");
-    terminalView.println("  status               - Show current status");
-    terminalView.println("  server               - Create an HID server");
-    terminalView.println("  keyboard             - Start keyboard bridge");
-    terminalView.println("  mouse <x> <y>        - Move mouse cursor");
-    terminalView.println("  mouse click          - Mouse click");
-    terminalView.println("  mouse jiggle [ms]    - Random mouse moves");
-    terminalView.println("  reset                - Reset interface");
+/*
+Trace
+*/
+void UtilityController::handleTrace(const TerminalCommand& cmd) {
+    TraceModeEnum mode;
+    if (cmd.getSubcommand().empty()) {
+        terminalView.println("Trace: " + TraceModeEnumMapper::toString(state.getTraceMode()));
+        return;
+    }
+    if (!TraceModeEnumMapper::fromString(cmd.getSubcommand(), mode)) {
+        terminalView.println("Usage: trace [off|summary|full]");
+        return;
+    }
+    state.setTraceMode(mode);
+    terminalView.println("Trace set to " + TraceModeEnumMapper::toString(mode));
+}
 
-    terminalView.println("");
-    terminalView.println(" 14. WIFI:");
-    terminalView.println("  scan                 - List Wi-Fi networks");
-    terminalView.println("  connect              - Connect to a network");
-    terminalView.println("  ping <host>          - Ping a remote host");
-    terminalView.println("  discovery            - Discover network devices");
-    terminalView.println("  sniff                - Monitor Wi-Fi packets");
-    terminalView.println("  probe                - Search for net access");
-    terminalView.println("  spoof ap <mac>       - Spoof AP MAC");
-    terminalView.println("  spoof sta <mac>      - Spoof Station MAC");
-    terminalView.println("  status               - Show Wi-Fi status");
-    terminalView.println("  disconnect           - Disconnect from Wi-Fi");
-    terminalView.println("  ap <ssid> <password> - Set access point");
-    terminalView.println("  ap spam              - Spam random beacons");
-    terminalView.println("  ssh <h> <u> <p> [p]  - Open SSH session");
-    terminalView.println("  nc <host> <port>     - Open netcat session");
-    terminalView.println("  nmap <h> [-p ports]  - Scan host ports");
-    terminalView.println("  http get <url>       - HTTP(s) GET request");
-    terminalView.println("  deauth <ssid>        - Deauthenticate hosts");
-    terminalView.println("  webui                - Show the web UI IP");
-    terminalView.println("  reset                - Reset interface");
+/*
+Timing
+*/
+void UtilityController::handleTiming(const TerminalCommand& cmd) {
+    std::string sub = cmd.getSubcommand();
+    if (sub == "precise")     state.setPreciseTiming(true);
+    else if (sub == "normal") state.setPreciseTiming(false);
+    else if (!sub.empty()) {
+        terminalView.println("Usage: timing [precise|normal]");
+        return;
+    }
+    terminalView.println(std::string("Timing: ") + (state.isPreciseTiming() ? "precise" : "normal"));
+}
 
-    terminalView.println("");
-    terminalView.println(" 15. JTAG:");
-    terminalView.println("  scan swd             - Scan SWD pins");
-    terminalView.println("  scan jtag            - Scan JTAG pins");
-    terminalView.println("  config               - Configure settings");
+/*
+Jobs
+*/
+void UtilityController::handleJobs() {
+    auto jobs = jobManager.list();
+    if (jobs.empty()) {
+        terminalView.println("Jobs: None running. Start one with 'bg <command>'.");
+        return;
+    }
 
-    terminalView.println("");
-    terminalView.println(" 16. I2S:");
-    terminalView.println("  play <freq> [ms]     - Play sine wave for ms");
-    terminalView.println("  record               - Read mic continuously");
-    terminalView.println("  test <speaker|mic>   - Run basic audio tests");
-    terminalView.println("  reset                - Reset to default");
-    terminalView.println("  config               - Configure settings");
+    for (const auto& job : jobs) {
+        std::string line = " [" + std::to_string(job.id) + "] ";
+        line += job.running ? "Running  " : "Done     ";
+        line += ModeEnumMapper::toString(job.mode) + " " + job.command;
+        line += "  (" + std::to_string(job.seconds) + "s, " + std::to_string(job.buffered) + " bytes unread)";
+        terminalView.println(line);
+    }
+}
 
-    terminalView.println("");
-    terminalView.println(" 17. CAN:");
-    terminalView.println("  sniff                - Print all received frames");
-    terminalView.println("  send [id]            - Send frame with given ID");
-    terminalView.println("  receive [id]         - Capture frames with ID");
-    terminalView.println("  status               - State of the CAN controller");
-    terminalView.println("  config               - Configure settings");
+/*
+Foreground
+*/
+void UtilityController::handleForeground(const TerminalCommand& cmd) {
+    uint8_t id = cmd.getSubcommand().empty() ? jobManager.lastId() : parseJobId(cmd.getSubcommand());
+    if (id == 0 || !jobManager.attach(id)) {
+        terminalView.println("fg: No such job. Try 'jobs'.");
+    }
+}
+
+/*
+Kill
+*/
+void UtilityController::handleKill(const TerminalCommand& cmd) {
+    uint8_t id = parseJobId(cmd.getSubcommand());
+    if (id == 0) {
+        terminalView.println("Usage: kill <id>");
+        return;
+    }
+
+    if (jobManager.kill(id)) {
+        terminalView.println("[" + std::to_string(id) + "] Killed.");
+    } else {
+        terminalView.println("kill: No such job. Try 'jobs'.");
+    }
+}
 
+uint8_t UtilityController::parseJobId(const std::string& arg) {
+    std::string digits = (!arg.empty() && arg[0] == '%') ? arg.substr(1) : arg;
+    if (!argTransformer.isValidNumber(digits)) return 0;
+    uint32_t id = argTransformer.parseHexOrDec32(digits);
+    return id > 0 && id < 100 ? static_cast<uint8_t>(id) : 0;
+}
+
+/*
+Help
+*/
+void UtilityController::handleHelp() {
+    terminalView.println("");
+    terminalView.println("   +=== Help: Available Commands ===+");
     terminalView.println("");
-    terminalView.println(" 18. ETHERNET:");
-    terminalView.println("  connect              - Connect using DHCP");
-    terminalView.println("  status               - Show ETH status");
-    terminalView.println("  ping <host>          - Ping a remote host");
-    terminalView.println("  discovery            - Discover network devices");
-    terminalView.println("  ssh <h> <u> <p> [p]  - Open SSH session");
-    terminalView.println("  nc <host> <port>     - Open netcat session");
-    terminalView.println("  nmap <h> [-p ports]  - Scan host ports");
-    terminalView.println("  http get <url>       - HTTP(s) GET request");
-    terminalView.println("  reset                - Reset interface");
-    terminalView.println("  config               - Configure settings");
+
+    terminalView.println(" General:");
+    for (const auto& command : CommandRegistry::of(ModeEnum::None)) {
+        if (command.usage) terminalView.println(CommandRegistry::formatHelp(command));
+    }
+
+    // One section per mode, numbered in mode order
+    for (int i = 0; i < static_cast<int>(ModeEnum::COUNT); ++i) {
+        ModeEnum mode = static_cast<ModeEnum>(i);
+        auto commands = CommandRegistry::of(mode);
+        if (commands.empty()) continue;
+
+        terminalView.println("");
+        terminalView.println(" " + std::to_string(i + 1) + ". " + ModeEnumMapper::toString(mode) + ":");
+        for (const auto& command : commands) {
+            terminalView.println(CommandRegistry::formatHelp(command));
+        }
+    }
 
     terminalView.println("");
     terminalView.println(" Instructions (available in most modes):");
@@ -483,9 +739,5 @@ void UtilityController::handleHelp() {
 }
 
 bool UtilityController::isGlobalCommand(const TerminalCommand& cmd) {
-    std::string root = cmd.getRoot();
-    return (root == "help"  || root == "h" || root == "?" ||
-            root == "mode"  || root == "m" || root == "l" ||
-            root == "logic" || root == "P" || root == "p") || 
-            root == "system";
+    return CommandRegistry::find(ModeEnum::None, cmd.getRoot()) != nullptr;
 }
\ No newline at end of file
@@ -11,10 +11,21 @@
 #include "Interfaces/IDeviceView.h"
 #include "States/GlobalState.h"
 #include "Enums/ModeEnum.h"
+#include "Enums/TraceModeEnum.h"
+#include "Enums/LogicDecoderEnum.h"
 #include "Services/PinService.h"
+#include "Services/LogicCaptureService.h"
 #include "Managers/UserInputManager.h"
+#include "Managers/JobManager.h"
+#include "Managers/LogicCaptureManager.h"
+#include "Managers/SumpManager.h"
+#include "Decoders/UartDecoder.h"
+#include "Decoders/I2cDecoder.h"
+#include "Decoders/SpiDecoder.h"
+#include "Decoders/OneWireDecoder.h"
 #include "Transformers/ArgTransformer.h"
 #include "Shells/SysInfoShell.h"
+#include "Dispatchers/CommandRouter.h"
 
 class UtilityController {
 public:
@@ -24,9 +35,13 @@ public:
         IDeviceView& deviceView, 
         IInput& terminalInput, 
         PinService& pinService, 
+        LogicCaptureService& logicCaptureService,
+        LogicCaptureManager& logicCaptureManager,
+        SumpManager& sumpManager,
         UserInputManager& userInputManager, 
         ArgTransformer& argTransformer,
-        SysInfoShell& sysInfoShell
+        SysInfoShell& sysInfoShell,
+        JobManager& jobManager
     );
 
     // Entry point for global utility commands
@@ -54,15 +69,62 @@ private:
     // Disable internal pull-up resistors
     void handleDisablePullups();
 
+    // Triggered capture of up to 8 channels
+    void handleLogicCapture();
+
+    // Trigger condition from the user, false if invalid
+    bool readLogicTrigger(size_t channels, uint32_t rate, LogicTrigger& trigger);
+
+    // SUMP client such as PulseView on the USB serial port
+    void handleLogicSump();
+
+    // Protocol frames in the last capture
+    void handleLogicDecode();
+
+    // One line per frame, times from the capture start
+    void printLogicFrames(const std::vector<LogicFrame>& frames, LogicDecoderEnum protocol);
+
+    // Print the last capture as one line per channel
+    void printLogicCapture();
+
     // System information
     void handleSystem();
 
+    // Show or set the execution trace mode
+    void handleTrace(const TerminalCommand& cmd);
+
+    // Cycle counter delays with a jitter report
+    void handleTiming(const TerminalCommand& cmd);
+
+    // List background jobs
+    void handleJobs();
+
+    // Stream a background job output
+    void handleForeground(const TerminalCommand& cmd);
+
+    // Stop a background job
+    void handleKill(const TerminalCommand& cmd);
+
+    // Job id from "2" or "%2", 0 if invalid
+    uint8_t parseJobId(const std::string& arg);
+
     ITerminalView& terminalView;
     IDeviceView& deviceView;
     IInput& terminalInput;
     PinService& pinService;
+    LogicCaptureService& logicCaptureService;
+    LogicCaptureManager& logicCaptureManager;
+    SumpManager& sumpManager;
     UserInputManager& userInputManager;
     ArgTransformer& argTransformer;
     SysInfoShell& sysInfoShell;
+    JobManager& jobManager;
     GlobalState& state = GlobalState::getInstance();
+
+    static constexpr uint32_t LOGIC_DEFAULT_RATE = 1000000;
+    static constexpr uint32_t LOGIC_DRAW_INTERVAL_MS = 100;
+    static constexpr size_t LOGIC_TRACE_SAMPLES = 240;
+    static constexpr size_t LOGIC_TRACE_LEAD = 16; // samples shown before the first edge
+    static constexpr size_t LOGIC_PRINT_COLUMNS = 64;
+    static constexpr size_t LOGIC_DECODE_FRAMES = 512;
 };
\ No newline at end of file
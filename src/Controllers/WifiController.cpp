@@ -6,26 +6,28 @@ Entry point for command
 */
 void WifiController::handleCommand(const TerminalCommand &cmd)
 {
-    const auto &root = cmd.getRoot();
-
-    if (root == "connect") handleConnect(cmd);
-    else if (root == "disconnect") handleDisconnect(cmd);
-    else if (root == "status") handleStatus(cmd);
-    else if (root == "ap") handleAp(cmd);
-    else if (root == "spoof") handleSpoof(cmd);
-    else if (root == "scan") handleScan(cmd);
-    else if (root == "probe") handleProbe();
-    else if (root == "ping") handlePing(cmd);
-    else if (root == "sniff") handleSniff(cmd);
-    else if (root == "webui") handleWebUi(cmd);
-    else if (root == "ssh") handleSsh(cmd);
-    else if (root == "nc") handleNetcat(cmd);
-    else if (root == "nmap") handleNmap(cmd);
-    else if (root == "http") handleHttp(cmd);
-    else if (root == "discovery") handleDiscovery(cmd);
-    else if (root == "reset") handleReset();
-    else if (root == "deauth") handleDeauth(cmd);
-    else handleHelp();
+    static constexpr CommandRoute<WifiController> routes[] = {
+        {"scan",       &WifiController::handleScan},
+        {"connect",    &WifiController::handleConnect},
+        {"ping",       &WifiController::handlePing},
+        {"discovery",  &WifiController::handleDiscovery},
+        {"sniff",      &WifiController::handleSniff},
+        {"probe",      &WifiController::handleProbe},
+        {"spoof",      &WifiController::handleSpoof},
+        {"status",     &WifiController::handleStatus},
+        {"disconnect", &WifiController::handleDisconnect},
+        {"ap",         &WifiController::handleAp},
+        {"ssh",        &WifiController::handleSsh},
+        {"nc",         &WifiController::handleNetcat},
+        {"nmap",       &WifiController::handleNmap},
+        {"http",       &WifiController::handleHttp},
+        {"deauth",     &WifiController::handleDeauth},
+        {"webui",      &WifiController::handleWebUi},
+        {"reset",      &WifiController::handleReset},
+    };
+    static constexpr CommandRouter router(ModeEnum::WiFi, routes);
+
+    if (!router.dispatch(*this, cmd)) handleHelp();
 }
 
 /*
@@ -471,25 +473,9 @@ Help
 void WifiController::handleHelp()
 {
     terminalView.println("WiFi commands:");
-    terminalView.println("  scan");
-    terminalView.println("  connect");
-    terminalView.println("  ping <host>");
-    terminalView.println("  discovery [wifi|eth]");
-    terminalView.println("  sniff");
-    terminalView.println("  probe");
-    terminalView.println("  spoof sta <mac>");
-    terminalView.println("  spoof ap <mac>");
-    terminalView.println("  status");
-    terminalView.println("  disconnect");
-    terminalView.println("  ap <ssid> <password>");
-    terminalView.println("  ap spam");
-    terminalView.println("  ssh <host> <username> <password> [port]");
-    terminalView.println("  nc <host> <port>");
-    terminalView.println("  nmap <host> [port]");
-    terminalView.println("  http <get|post|put|delete> <url>");
-    terminalView.println("  webui");
-    terminalView.println("  reset");
-    terminalView.println("  deauth <ssid>");
+    for (const auto& command : CommandRegistry::of(ModeEnum::WiFi)) {
+        terminalView.println(CommandRegistry::formatHelp(command));
+    }
 }
 
 /*
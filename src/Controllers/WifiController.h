@@ -15,6 +15,7 @@
 #include <States/GlobalState.h>
 #include <Abstracts/ANetworkController.h>
 #include <Preferences.h>
+#include "Dispatchers/CommandRouter.h"
 
 class WifiController : public ANetworkController {
 public:
@@ -0,0 +1,316 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "Enums/ModeEnum.h"
+
+struct CommandDefinition {
+    ModeEnum mode;      // None for the global commands
+    const char* name;   // root keyword, empty for lines that only document syntax
+    const char* usage;  // nullptr for hidden aliases
+    const char* help;
+};
+
+// Every terminal command of every mode, the help, completion and the
+// controller routes all come from here. Rows of a mode stay together.
+inline constexpr CommandDefinition commandDefinitions[] = {
+    {ModeEnum::None,      "help",        "help",                 "Show this help"},
+    {ModeEnum::None,      "h",           nullptr,                nullptr},
+    {ModeEnum::None,      "?",           nullptr,                nullptr},
+    {ModeEnum::None,      "system",      "system",               "Show system infos"},
+    {ModeEnum::None,      "mode",        "mode <name>",          "Set active mode"},
+    {ModeEnum::None,      "m",           nullptr,                nullptr},
+    {ModeEnum::None,      "logic",       "logic <pin> [rate]",   "Logic analyzer"},
+    {ModeEnum::None,      "l",           nullptr,                nullptr},
+    {ModeEnum::None,      "logic",       "logic capture",        "Triggered capture, 8 ch"},
+    {ModeEnum::None,      "logic",       "logic sump",           "PulseView over USB"},
+    {ModeEnum::None,      "logic",       "logic decode",         "UART, I2C, SPI, 1-Wire"},
+    {ModeEnum::None,      "P",           "P",                    "Enable pull-up"},
+    {ModeEnum::None,      "p",           "p",                    "Disable pull-up"},
+    {ModeEnum::None,      "trace",       "trace <mode>",         "Trace off, summary, full"},
+    {ModeEnum::None,      "trace",       "trace full",           "Timing per bus operation"},
+    {ModeEnum::None,      "timing",      "timing <mode>",        "Delays precise, normal"},
+    {ModeEnum::None,      "bg",          "bg <command>",         "Run a capture in background"},
+    {ModeEnum::None,      "jobs",        "jobs",                 "List background jobs"},
+    {ModeEnum::None,      "fg",          "fg [id]",              "Watch a job output"},
+    {ModeEnum::None,      "kill",        "kill <id>",            "Stop a background job"},
+    {ModeEnum::None,      "",            "[D:1 d:10 n:250]",     "Delay ms, us, ns"},
+    {ModeEnum::None,      "",            "(name=[0x9F r:3])",    "Define a macro"},
+    {ModeEnum::None,      "",            "(name) (name 10)",     "Run a macro, n times"},
+    {ModeEnum::None,      "",            "() (-name)",           "List, delete macros"},
+    {ModeEnum::None,      "",            "(load /macros.txt)",   "Import macros from SD"},
+
+    {ModeEnum::HIZ,       "",            "(default mode)",       "All lines disabled"},
+
+    {ModeEnum::OneWire,   "scan",        "scan",                 "Scan 1-Wire devices"},
+    {ModeEnum::OneWire,   "ping",        "ping",                 "Ping 1-Wire device"},
+    {ModeEnum::OneWire,   "sniff",       "sniff",                "View 1-Wire traffic"},
+    {ModeEnum::OneWire,   "read",        "read",                 "Read ID + SP"},
+    {ModeEnum::OneWire,   "write",       "write id [8 bytes]",   "Write device ID"},
+    {ModeEnum::OneWire,   "write",       "write sp [8 bytes]",   "Write scratchpad"},
+    {ModeEnum::OneWire,   "temp",        "temp",                 "Read temperature"},
+    {ModeEnum::OneWire,   "ibutton",     "ibutton",              "iButton operations"},
+    {ModeEnum::OneWire,   "config",      "config",               "Configure settings"},
+    {ModeEnum::OneWire,   "",            "[0xAA r:8] ...",       "Instruction syntax"},
+
+    {ModeEnum::UART,      "scan",        "scan",                 "Auto baud detect"},
+    {ModeEnum::UART,      "ping",        "ping",                 "Send and expect reply"},
+    {ModeEnum::UART,      "read",        "read",                 "Read at current baud"},
+    {ModeEnum::UART,      "write",       "write <text>",         "Send at current baud"},
+    {ModeEnum::UART,      "bridge",      "bridge",               "Full-duplex mode"},
+    {ModeEnum::UART,      "at",          "at",                   "AT commands operations"},
+    {ModeEnum::UART,      "spam",        "spam <text> <ms>",     "Write text every ms"},
+    {ModeEnum::UART,      "glitch",      "glitch",               "Timing attack"},
+    {ModeEnum::UART,      "xmodem",      "xmodem <send> <path>", "Send file via XMODEM"},
+    {ModeEnum::UART,      "xmodem",      "xmodem <recv> <path>", "Receive file via XMODEM"},
+    {ModeEnum::UART,      "config",      "config",               "Configure settings"},
+    {ModeEnum::UART,      "",            "['Hello'] [r:64]...",  "Instruction syntax"},
+
+    {ModeEnum::HDUART,    "bridge",      "bridge",               "Half-duplex I/O"},
+    {ModeEnum::HDUART,    "config",      "config",               "Configure settings"},
+    {ModeEnum::HDUART,    "",            "[0x1 D:10 r:255]",     "Instruction syntax"},
+
+    {ModeEnum::I2C,       "scan",        "scan",                 "Find devices"},
+    {ModeEnum::I2C,       "ping",        "ping <addr>",          "Check ACK"},
+    {ModeEnum::I2C,       "identify",    "identify <addr>",      "Identify device"},
+    {ModeEnum::I2C,       "sniff",       "sniff",                "View traffic"},
+    {ModeEnum::I2C,       "slave",       "slave <addr>",         "Emulate I2C device"},
+    {ModeEnum::I2C,       "read",        "read <addr> <reg>",    "Read register"},
+    {ModeEnum::I2C,       "write",       "write <a> <r> <val>",  "Write register"},
+    {ModeEnum::I2C,       "dump",        "dump <addr> [len]",    "Read all registers"},
+    {ModeEnum::I2C,       "glitch",      "glitch <addr>",        "Run attack sequence"},
+    {ModeEnum::I2C,       "flood",       "flood <addr>",         "Saturate target I/O"},
+    {ModeEnum::I2C,       "monitor",     "monitor <addr> [ms]",  "Monitor register changes"},
+    {ModeEnum::I2C,       "eeprom",      "eeprom [addr]",        "I2C EEPROM operations"},
+    {ModeEnum::I2C,       "recover",     "recover",              "Attempt bus recovery"},
+    {ModeEnum::I2C,       "config",      "config",               "Configure settings"},
+    {ModeEnum::I2C,       "",            "[0x13 0x4B 0x1]",      "Instruction syntax"},
+
+    {ModeEnum::SPI,       "sniff",       "sniff",                "View traffic"},
+    {ModeEnum::SPI,       "sdcard",      "sdcard",               "SD operations"},
+    {ModeEnum::SPI,       "slave",       "slave",                "Emulate SPI slave"},
+    {ModeEnum::SPI,       "flash",       "flash",                "SPI Flash operations"},
+    {ModeEnum::SPI,       "eeprom",      "eeprom",               "SPI EEPROM operations"},
+    {ModeEnum::SPI,       "config",      "config",               "Configure settings"},
+    {ModeEnum::SPI,       "",            "[0x9F r:3]",           "Instruction syntax"},
+
+    {ModeEnum::TwoWire,   "sniff",       "sniff",                "View 2WIRE traffic"},
+    {ModeEnum::TwoWire,   "smartcard",   "smartcard",            "Smartcard operations"},
+    {ModeEnum::TwoWire,   "config",      "config",               "Configure settings"},
+    {ModeEnum::TwoWire,   "",            "[0xAB r:4]",           "Instruction syntax"},
+
+    {ModeEnum::ThreeWire, "eeprom",      "eeprom",               "3WIRE EEPROM operations"},
+    {ModeEnum::ThreeWire, "config",      "config",               "Configure settings"},
+
+    {ModeEnum::DIO,       "sniff",       "sniff <pin>",          "Track toggle states"},
+    {ModeEnum::DIO,       "read",        "read <pin>",           "Get pin state"},
+    {ModeEnum::DIO,       "set",         "set <pin> <H/L/I/O>",  "Set pin state"},
+    {ModeEnum::DIO,       "pullup",      "pullup <pin>",         "Set pin pullup"},
+    {ModeEnum::DIO,       "pwm",         "pwm <pin> freq <dut>", "Set PWM on pin"},
+    {ModeEnum::DIO,       "toggle",      "toggle <pin> <ms>",    "Toggle pin periodically"},
+    {ModeEnum::DIO,       "measure",     "measure <pin> [ms]",   "Calculate frequency"},
+    {ModeEnum::DIO,       "analog",      "analog <pin>",         "Read analog value"},
+    {ModeEnum::DIO,       "reset",       "reset <pin>",          "Reset to default"},
+
+    {ModeEnum::LED,       "scan",        "scan",                 "Try to detect LEDs type"},
+    {ModeEnum::LED,       "fill",        "fill <color>",         "Fill all LEDs with a color"},
+    {ModeEnum::LED,       "set",         "set <index> <color>",  "Set specific LED color"},
+    {ModeEnum::LED,       "blink",       "blink",                "Blink all LEDs"},
+    {ModeEnum::LED,       "rainbow",     "rainbow",              "Rainbow animation"},
+    {ModeEnum::LED,       "chase",       "chase",                "Chasing light effect"},
+    {ModeEnum::LED,       "cycle",       "cycle",                "Cycle through colors"},
+    {ModeEnum::LED,       "wave",        "wave",                 "Wave animation"},
+    {ModeEnum::LED,       "reset",       "reset",                "Turn off all LEDs"},
+    {ModeEnum::LED,       "setprotocol", "setprotocol",          "Select LED protocol"},
+    {ModeEnum::LED,       "config",      "config",               "Configure LED settings"},
+
+    {ModeEnum::Infrared,  "send",        "send <dev> sub <cmd>", "Send IR signal"},
+    {ModeEnum::Infrared,  "receive",     "receive",              "Receive IR signal"},
+    {ModeEnum::Infrared,  "setprotocol", "setprotocol",          "Set IR protocol type"},
+    {ModeEnum::Infrared,  "devicebgone", "devicebgone",          "OFF devices blast"},
+    {ModeEnum::Infrared,  "remote",      "remote",               "Universal remote commands"},
+    {ModeEnum::Infrared,  "replay",      "replay [count]",       "Replay recorded IR frames"},
+    {ModeEnum::Infrared,  "config",      "config",               "Configure settings"},
+
+    {ModeEnum::USB,       "stick",       "stick",                "Mount SD as USB"},
+    {ModeEnum::USB,       "keyboard",    "keyboard",             "Start keyboard bridge"},
+    {ModeEnum::USB,       "mouse",       "mouse <x> <y>",        "Move mouse cursor"},
+    {ModeEnum::USB,       "mouse",       "mouse click",          "Left click"},
+    {ModeEnum::USB,       "mouse",       "mouse jiggle [ms]",    "Random mouse moves"},
+    {ModeEnum::USB,       "gamepad",     "gamepad <key>",        "Press button"},
+    {ModeEnum::USB,       "reset",       "reset",                "Reset interface"},
+    {ModeEnum::USB,       "config",      "config",               "Configure settings"},
+
+    {ModeEnum::Bluetooth, "scan",        "scan",                 "Discover devices"},
+    {ModeEnum::Bluetooth, "pair",        "pair <mac>",           "Pair with a device"},
+    {ModeEnum::Bluetooth, "sniff",       "sniff",                "Sniff Bluetooth data"},
+    {ModeEnum::Bluetooth, "spoof",       "spoof <mac>",          "Spoof mac address"},
+    {ModeEnum::Bluetooth, "status",      "status",               "Show current status"},
+    {ModeEnum::Bluetooth, "server",      "server",               "Create an HID server"},
+    {ModeEnum::Bluetooth, "keyboard",    "keyboard",             "Start keyboard bridge"},
+    {ModeEnum::Bluetooth, "mouse",       "mouse <x> <y>",        "Move mouse cursor"},
+    {ModeEnum::Bluetooth, "mouse",       "mouse click",          "Mouse click"},
+    {ModeEnum::Bluetooth, "mouse",       "mouse jiggle [ms]",    "Random mouse moves"},
+    {ModeEnum::Bluetooth, "reset",       "reset",                "Reset interface"},
+
+    {ModeEnum::WiFi,      "scan",        "scan",                 "List Wi-Fi networks"},
+    {ModeEnum::WiFi,      "connect",     "connect",              "Connect to a network"},
+    {ModeEnum::WiFi,      "ping",        "ping <host>",          "Ping a remote host"},
+    {ModeEnum::WiFi,      "discovery",   "discovery",            "Discover network devices"},
+    {ModeEnum::WiFi,      "sniff",       "sniff",                "Monitor Wi-Fi packets"},
+    {ModeEnum::WiFi,      "probe",       "probe",                "Search for net access"},
+    {ModeEnum::WiFi,      "spoof",       "spoof ap <mac>",       "Spoof AP MAC"},
+    {ModeEnum::WiFi,      "spoof",       "spoof sta <mac>",      "Spoof Station MAC"},
+    {ModeEnum::WiFi,      "status",      "status",               "Show Wi-Fi status"},
+    {ModeEnum::WiFi,      "disconnect",  "disconnect",           "Disconnect from Wi-Fi"},
+    {ModeEnum::WiFi,      "ap",          "ap <ssid> <password>", "Set access point"},
+    {ModeEnum::WiFi,      "ap",          "ap spam",              "Spam random beacons"},
+    {ModeEnum::WiFi,      "ssh",         "ssh <h> <u> <p> [p]",  "Open SSH session"},
+    {ModeEnum::WiFi,      "nc",          "nc <host> <port>",     "Open netcat session"},
+    {ModeEnum::WiFi,      "nmap",        "nmap <h> [-p ports]",  "Scan host ports"},
+    {ModeEnum::WiFi,      "http",        "http get <url>",       "HTTP(s) GET request"},
+    {ModeEnum::WiFi,      "deauth",      "deauth <ssid>",        "Deauthenticate hosts"},
+    {ModeEnum::WiFi,      "webui",       "webui",                "Show the web UI IP"},
+    {ModeEnum::WiFi,      "reset",       "reset",                "Reset interface"},
+
+    {ModeEnum::JTAG,      "scan",        "scan swd",             "Scan SWD pins"},
+    {ModeEnum::JTAG,      "scan",        "scan jtag",            "Scan JTAG pins"},
+    {ModeEnum::JTAG,      "config",      "config",               "Configure settings"},
+
+    {ModeEnum::I2S,       "play",        "play <freq> [ms]",     "Play sine wave for ms"},
+    {ModeEnum::I2S,       "record",      "record",               "Read mic continuously"},
+    {ModeEnum::I2S,       "test",        "test <speaker|mic>",   "Run basic audio tests"},
+    {ModeEnum::I2S,       "reset",       "reset",                "Reset to default"},
+    {ModeEnum::I2S,       "config",      "config",               "Configure settings"},
+
+    {ModeEnum::CAN_,      "sniff",       "sniff",                "Print all received frames"},
+    {ModeEnum::CAN_,      "send",        "send [id]",            "Send frame with given ID"},
+    {ModeEnum::CAN_,      "receive",     "receive [id]",         "Capture frames with ID"},
+    {ModeEnum::CAN_,      "status",      "status",               "State of the CAN controller"},
+    {ModeEnum::CAN_,      "config",      "config",               "Configure settings"},
+
+    {ModeEnum::ETHERNET,  "connect",     "connect",              "Connect using DHCP"},
+    {ModeEnum::ETHERNET,  "status",      "status",               "Show ETH status"},
+    {ModeEnum::ETHERNET,  "ping",        "ping <host>",          "Ping a remote host"},
+    {ModeEnum::ETHERNET,  "discovery",   "discovery",            "Discover network devices"},
+    {ModeEnum::ETHERNET,  "ssh",         "ssh <h> <u> <p> [p]",  "Open SSH session"},
+    {ModeEnum::ETHERNET,  "nc",          "nc <host> <port>",     "Open netcat session"},
+    {ModeEnum::ETHERNET,  "nmap",        "nmap <h> [-p ports]",  "Scan host ports"},
+    {ModeEnum::ETHERNET,  "http",        "http get <url>",       "HTTP(s) GET request"},
+    {ModeEnum::ETHERNET,  "reset",       "reset",                "Reset interface"},
+    {ModeEnum::ETHERNET,  "config",      "config",               "Configure settings"},
+
+    {ModeEnum::CC1101,    "send",        "send <data>",          "Send data via CC1101"},
+    {ModeEnum::CC1101,    "sniff",       "sniff",                "Sniff raw RX frames"},
+    {ModeEnum::CC1101,    "rxraw",       "rxraw",                "Receive raw frames"},
+    {ModeEnum::CC1101,    "txraw",       "txraw",                "Transmit raw frames"},
+    {ModeEnum::CC1101,    "config",      "config",               "Configure CC1101 pins"},
+    {ModeEnum::CC1101,    "",            "[0x9F r:3]",           "Instruction syntax"},
+};
+
+inline constexpr size_t commandDefinitionCount = sizeof(commandDefinitions) / sizeof(commandDefinitions[0]);
+
+/*
+Hash index of the rows by mode and name, built at compile time so a
+lookup is one hash and a probe or two instead of a string compare chain.
+*/
+namespace CommandRegistry {
+
+constexpr uint32_t hash(ModeEnum mode, std::string_view name) {
+    // FNV-1a, the mode is folded in as the first byte
+    uint32_t h = 2166136261u;
+    h = (h ^ static_cast<uint8_t>(static_cast<int>(mode) + 1)) * 16777619u;
+    for (char c : name) h = (h ^ static_cast<uint8_t>(c)) * 16777619u;
+    return h;
+}
+
+constexpr size_t slotsFor(size_t entries) {
+    size_t slots = 1;
+    while (slots < entries * 2) slots <<= 1;
+    return slots;
+}
+
+inline constexpr size_t slotCount = slotsFor(commandDefinitionCount);
+inline constexpr uint16_t EMPTY = 0xFFFF;
+
+struct Index {
+    uint16_t slots[slotCount];
+};
+
+constexpr Index buildIndex() {
+    Index index{};
+    for (auto& slot : index.slots) slot = EMPTY;
+
+    for (size_t i = 0; i < commandDefinitionCount; ++i) {
+        const auto& def = commandDefinitions[i];
+        std::string_view name = def.name;
+        if (name.empty()) continue;
+
+        // Repeated names (write id, write sp) resolve to their first row
+        size_t slot = hash(def.mode, name) & (slotCount - 1);
+        bool seen = false;
+        while (index.slots[slot] != EMPTY) {
+            const auto& other = commandDefinitions[index.slots[slot]];
+            if (other.mode == def.mode && name == other.name) seen = true;
+            slot = (slot + 1) & (slotCount - 1);
+        }
+        if (!seen) index.slots[slot] = static_cast<uint16_t>(i);
+    }
+    return index;
+}
+
+inline constexpr Index index = buildIndex();
+
+constexpr bool isGrouped() {
+    for (size_t i = 1; i < commandDefinitionCount; ++i) {
+        for (size_t j = 0; j + 1 < i; ++j) {
+            if (commandDefinitions[j].mode == commandDefinitions[i].mode &&
+                commandDefinitions[i - 1].mode != commandDefinitions[i].mode) return false;
+        }
+    }
+    return true;
+}
+static_assert(isGrouped(), "Rows of a mode must stay together");
+
+constexpr const CommandDefinition* find(ModeEnum mode, std::string_view name) {
+    if (name.empty()) return nullptr;
+    size_t slot = hash(mode, name) & (slotCount - 1);
+    while (index.slots[slot] != EMPTY) {
+        const auto& def = commandDefinitions[index.slots[slot]];
+        if (def.mode == mode && name == def.name) return &def;
+        slot = (slot + 1) & (slotCount - 1);
+    }
+    return nullptr;
+}
+
+// Rows of one mode, in help order
+struct Range {
+    const CommandDefinition* first;
+    const CommandDefinition* last;
+    const CommandDefinition* begin() const { return first; }
+    const CommandDefinition* end() const { return last; }
+    bool empty() const { return first == last; }
+};
+
+inline Range of(ModeEnum mode) {
+    const CommandDefinition* it = commandDefinitions;
+    const CommandDefinition* end = commandDefinitions + commandDefinitionCount;
+    while (it != end && it->mode != mode) ++it;
+    const CommandDefinition* first = it;
+    while (it != end && it->mode == mode) ++it;
+    return {first, it};
+}
+
+// "  usage                - help", hidden aliases give an empty line
+inline std::string formatHelp(const CommandDefinition& def) {
+    if (!def.usage) return "";
+    std::string line = "  ";
+    line += def.usage;
+    if (line.size() < 22) line.append(22 - line.size(), ' ');
+    line += " - ";
+    line += def.help;
+    return line;
+}
+
+} // namespace CommandRegistry
@@ -0,0 +1,62 @@
+#include "I2cDecoder.h"
+
+/*
+Constructor
+*/
+I2cDecoder::I2cDecoder(uint8_t sclChannel, uint8_t sdaChannel)
+    : sclChannel(sclChannel), sdaChannel(sdaChannel) {}
+
+void I2cDecoder::begin() {
+    primed = false;
+    active = false;
+    address = false;
+    bits = 0;
+    shift = 0;
+}
+
+/*
+Run
+*/
+void I2cDecoder::onRun(uint64_t start, uint8_t value, uint64_t length) {
+    bool newScl = (value >> sclChannel) & 1;
+    bool newSda = (value >> sdaChannel) & 1;
+    if (!primed) {
+        scl = newScl;
+        sda = newSda;
+        primed = true;
+        return;
+    }
+
+    LogicFrame frame;
+    frame.start = start;
+    frame.end = start;
+
+    if (scl && newScl && sda != newSda) {
+        // Start or stop, a byte in progress is dropped
+        frame.type = newSda ? LogicFrameEnum::Stop : LogicFrameEnum::Start;
+        emit(frame);
+        active = !newSda;
+        address = active;
+        bits = 0;
+        shift = 0;
+    } else if (active && !scl && newScl) {
+        if (bits == 0) byteStart = start;
+        if (bits < 8) {
+            shift = (shift << 1) | newSda;
+            bits++;
+        } else {
+            frame.type = address ? LogicFrameEnum::Address : LogicFrameEnum::Data;
+            frame.start = byteStart;
+            frame.value = address ? shift >> 1 : shift;
+            frame.read = address && (shift & 1);
+            frame.ack = !newSda;
+            emit(frame);
+            address = false;
+            bits = 0;
+            shift = 0;
+        }
+    }
+
+    scl = newScl;
+    sda = newSda;
+}
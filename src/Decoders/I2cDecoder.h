@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include "Abstracts/ALogicDecoder.h"
+
+/*
+I2C on two channels.
+
+SDA moving while SCL stays high is a start (falling) or a stop (rising),
+otherwise SDA is read on each rising SCL edge, MSB first. The first byte
+after a start is the address with the R/W bit, the ninth bit of every
+byte is the ACK.
+*/
+class I2cDecoder : public ALogicDecoder {
+public:
+    I2cDecoder(uint8_t sclChannel, uint8_t sdaChannel);
+
+protected:
+    void begin() override;
+    void onRun(uint64_t start, uint8_t value, uint64_t length) override;
+
+private:
+    uint8_t sclChannel;
+    uint8_t sdaChannel;
+    bool primed = false;
+    bool scl = true;
+    bool sda = true;
+    bool active = false;     // between start and stop
+    bool address = false;    // next byte is the address
+    uint8_t bits = 0;
+    uint32_t shift = 0;
+    uint64_t byteStart = 0;
+};
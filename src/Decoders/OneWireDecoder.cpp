@@ -0,0 +1,74 @@
+#include "OneWireDecoder.h"
+
+/*
+Constructor
+*/
+OneWireDecoder::OneWireDecoder(uint8_t channel)
+    : channel(channel) {}
+
+void OneWireDecoder::begin() {
+    primed = false;
+    awaitingPresence = false;
+    bits = 0;
+    shift = 0;
+}
+
+/*
+Run, a low pulse is complete on its rising edge
+*/
+void OneWireDecoder::onRun(uint64_t start, uint8_t value, uint64_t length) {
+    bool now = (value >> channel) & 1;
+    if (!primed) {
+        // A capture starting low has no usable first pulse
+        level = now;
+        lowStart = UINT64_MAX;
+        primed = true;
+        return;
+    }
+    if (now == level) return;
+    level = now;
+
+    if (!now) {
+        lowStart = start;
+        return;
+    }
+    if (lowStart == UINT64_MAX) return;
+
+    LogicFrame frame;
+    frame.start = lowStart;
+    frame.end = start;
+    uint64_t lowUs = toMicros(start - lowStart);
+
+    if (lowUs >= RESET_MIN_US) {
+        frame.type = LogicFrameEnum::Reset;
+        emit(frame);
+        resetEnd = start;
+        awaitingPresence = true;
+        bits = 0;
+        shift = 0;
+        return;
+    }
+
+    if (awaitingPresence) {
+        awaitingPresence = false;
+        if (toMicros(lowStart - resetEnd) <= PRESENCE_WAIT_US) {
+            frame.type = LogicFrameEnum::Presence;
+            emit(frame);
+            return;
+        }
+    }
+
+    if (bits == 0) byteStart = lowStart;
+    if (lowUs < ONE_MAX_US) shift |= 1 << bits;
+    if (++bits == 8) {
+        frame.start = byteStart;
+        frame.value = shift;
+        emit(frame);
+        bits = 0;
+        shift = 0;
+    }
+}
+
+uint64_t OneWireDecoder::toMicros(uint64_t samples) const {
+    return sampleRate ? samples * 1000000ULL / sampleRate : 0;
+}
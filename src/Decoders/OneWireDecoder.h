@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include "Abstracts/ALogicDecoder.h"
+
+/*
+1-Wire on one channel, standard speed.
+
+Only the low pulses matter: a long one is a reset, a pulse starting soon
+after a reset is the presence answer, any other one is a time slot, a 1
+when the line came back up early and a 0 otherwise, for writes and
+reads alike. Bytes are LSB first and restart at each reset.
+*/
+class OneWireDecoder : public ALogicDecoder {
+public:
+    explicit OneWireDecoder(uint8_t channel);
+
+    static constexpr uint32_t RESET_MIN_US = 400;    // spec 480
+    static constexpr uint32_t PRESENCE_WAIT_US = 80; // after the reset, spec 15 to 60
+    static constexpr uint32_t ONE_MAX_US = 15;       // low time of a 1 slot
+
+protected:
+    void begin() override;
+    void onRun(uint64_t start, uint8_t value, uint64_t length) override;
+
+private:
+    uint64_t toMicros(uint64_t samples) const;
+
+    uint8_t channel;
+    bool primed = false;
+    bool level = true;
+    uint64_t lowStart = 0;
+    uint64_t resetEnd = 0;
+    bool awaitingPresence = false;
+    uint8_t bits = 0;
+    uint32_t shift = 0;
+    uint64_t byteStart = 0;
+};
@@ -0,0 +1,67 @@
+#include "SpiDecoder.h"
+
+/*
+Constructor
+*/
+SpiDecoder::SpiDecoder(uint8_t clkChannel, uint8_t mosiChannel, uint8_t misoChannel,
+                       uint8_t csChannel, uint8_t mode, uint8_t bitsPerWord)
+    : clkChannel(clkChannel),
+      mosiChannel(mosiChannel),
+      misoChannel(misoChannel),
+      csChannel(csChannel),
+      sampleOnRising(mode == 0 || mode == 3),
+      bitsPerWord(bitsPerWord < 1 ? 1 : bitsPerWord > 32 ? 32 : bitsPerWord) {}
+
+void SpiDecoder::begin() {
+    primed = false;
+    selected = false;
+    bits = 0;
+    mosi = 0;
+    miso = 0;
+}
+
+/*
+Run
+*/
+void SpiDecoder::onRun(uint64_t start, uint8_t value, uint64_t length) {
+    bool active = csChannel == NO_CHANNEL || !((value >> csChannel) & 1);
+    if (!primed) {
+        previous = value;
+        selected = active;
+        primed = true;
+        return;
+    }
+
+    // Deselect ends the word, select starts a new one
+    if (selected != active) {
+        if (!active && bits) emitWord(start, true);
+        bits = 0;
+        mosi = 0;
+        miso = 0;
+        selected = active;
+    }
+
+    bool wasHigh = (previous >> clkChannel) & 1;
+    bool isHigh = (value >> clkChannel) & 1;
+    if (selected && wasHigh != isHigh && isHigh == sampleOnRising) {
+        if (bits == 0) wordStart = start;
+        mosi = (mosi << 1) | ((previous >> mosiChannel) & 1);
+        if (misoChannel != NO_CHANNEL) miso = (miso << 1) | ((previous >> misoChannel) & 1);
+        if (++bits == bitsPerWord) emitWord(start, false);
+    }
+
+    previous = value;
+}
+
+void SpiDecoder::emitWord(uint64_t end, bool error) {
+    LogicFrame frame;
+    frame.start = wordStart;
+    frame.end = end;
+    frame.value = mosi;
+    frame.miso = miso;
+    frame.error = error;
+    emit(frame);
+    bits = 0;
+    mosi = 0;
+    miso = 0;
+}
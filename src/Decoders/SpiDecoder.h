@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include "Abstracts/ALogicDecoder.h"
+
+/*
+SPI on up to four channels, MSB first.
+
+Data is read on the leading clock edge in modes 0 and 3 (rising) and on
+the falling one in modes 1 and 2, with the levels held just before the
+edge. A low CS frames the words, a word cut by CS going high is kept and
+marked. Without CS the words are counted from the first clock edge.
+*/
+class SpiDecoder : public ALogicDecoder {
+public:
+    SpiDecoder(uint8_t clkChannel, uint8_t mosiChannel, uint8_t misoChannel = NO_CHANNEL,
+               uint8_t csChannel = NO_CHANNEL, uint8_t mode = 0, uint8_t bitsPerWord = 8);
+
+    static constexpr uint8_t NO_CHANNEL = 0xFF;
+
+protected:
+    void begin() override;
+    void onRun(uint64_t start, uint8_t value, uint64_t length) override;
+
+private:
+    // Word so far, error if it is not complete
+    void emitWord(uint64_t end, bool error);
+
+    uint8_t clkChannel;
+    uint8_t mosiChannel;
+    uint8_t misoChannel;
+    uint8_t csChannel;
+    bool sampleOnRising;
+    uint8_t bitsPerWord;
+    bool primed = false;
+    bool selected = false;
+    uint8_t previous = 0;
+    uint8_t bits = 0;
+    uint32_t mosi = 0;
+    uint32_t miso = 0;
+    uint64_t wordStart = 0;
+};
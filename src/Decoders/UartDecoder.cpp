@@ -0,0 +1,113 @@
+#include "UartDecoder.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/*
+Constructor
+*/
+UartDecoder::UartDecoder(uint8_t channel, uint32_t baud)
+    : channel(channel), wantedBaud(baud) {}
+
+uint32_t UartDecoder::getBaud() const {
+    return baud;
+}
+
+/*
+Detect Baud
+*/
+uint32_t UartDecoder::detectBaud(const LogicCapture& capture, uint32_t sampleRate, uint8_t channel) {
+    // Widths between edges, the partial first and last pulses left out
+    std::vector<uint64_t> widths;
+    LogicCapture::Reader reader(capture);
+    uint8_t value;
+    uint64_t length;
+    uint64_t position = 0;
+    uint64_t lastEdge = 0;
+    bool level = true;
+    bool seenEdge = false;
+    bool primed = false;
+    while (widths.size() < DETECT_PULSES && reader.next(value, length)) {
+        bool now = (value >> channel) & 1;
+        if (primed && now != level) {
+            if (seenEdge) widths.push_back(position - lastEdge);
+            seenEdge = true;
+            lastEdge = position;
+        }
+        level = now;
+        primed = true;
+        position += length;
+    }
+    if (widths.size() < 2) return 0;
+
+    // Shortest pulse as a first guess, then each width as a whole number of bits
+    uint64_t shortest = *std::min_element(widths.begin(), widths.end());
+    uint64_t totalSamples = 0, totalBits = 0;
+    for (uint64_t width : widths) {
+        uint64_t bits = (width + shortest / 2) / shortest;
+        if (bits >= 1 && bits <= 10) {
+            totalSamples += width;
+            totalBits += bits;
+        }
+    }
+    double measured = double(sampleRate) * totalBits / totalSamples;
+
+    static constexpr uint32_t standard[] = {
+        300, 600, 1200, 2400, 4800, 9600, 14400, 19200, 28800, 38400, 57600,
+        115200, 230400, 250000, 460800, 500000, 921600, 1000000, 2000000
+    };
+    for (uint32_t rate : standard) {
+        if (std::fabs(measured - rate) * 100 <= double(rate) * SNAP_PERCENT) return rate;
+    }
+    return static_cast<uint32_t>(measured + 0.5);
+}
+
+void UartDecoder::prepare(const LogicCapture& capture) {
+    baud = wantedBaud ? wantedBaud : detectBaud(capture, sampleRate, channel);
+    bitSamples = baud ? double(sampleRate) / baud : 0;
+}
+
+void UartDecoder::begin() {
+    level = true;
+    inFrame = false;
+    bit = 0;
+    shift = 0;
+}
+
+/*
+Run, start bit 0, data bits 1 to 8, stop bit 9
+*/
+void UartDecoder::onRun(uint64_t start, uint8_t value, uint64_t length) {
+    if (bitSamples < 1) return;
+
+    bool now = (value >> channel) & 1;
+    if (!inFrame && level && !now) {
+        inFrame = true;
+        frameStart = start;
+        bit = 0;
+        shift = 0;
+    }
+    level = now;
+
+    const uint64_t end = start + length;
+    while (inFrame) {
+        double point = frameStart + bitSamples * (bit + 0.5);
+        if (point >= end) break;
+
+        if (bit == 0 && now) {
+            // Glitch, the start bit did not last
+            inFrame = false;
+        } else if (bit == 9) {
+            LogicFrame frame;
+            frame.start = frameStart;
+            frame.end = frameStart + static_cast<uint64_t>(bitSamples * 10);
+            frame.value = shift;
+            frame.error = !now;
+            emit(frame);
+            inFrame = false;
+        } else {
+            if (bit > 0 && now) shift |= 1 << (bit - 1);
+            bit++;
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include "Abstracts/ALogicDecoder.h"
+
+/*
+UART 8N1 on one channel, idle high, LSB first.
+
+Without a baud rate it is measured first: every pulse on the line lasts
+a whole number of bits, the shortest ones give the bit time and all of
+them together refine it, then the nearest standard rate is taken when
+close enough. Bits are read in the middle of their slot, counted from
+the falling edge of the start bit.
+*/
+class UartDecoder : public ALogicDecoder {
+public:
+    // Baud 0 detects it from the capture
+    explicit UartDecoder(uint8_t channel, uint32_t baud = 0);
+
+    // Baud used by the last decode, 0 if none could be found
+    uint32_t getBaud() const;
+
+    // Baud from the pulse widths of a channel, 0 with too few edges
+    static uint32_t detectBaud(const LogicCapture& capture, uint32_t sampleRate, uint8_t channel);
+
+    static constexpr size_t DETECT_PULSES = 4096;    // widths looked at
+    static constexpr uint32_t SNAP_PERCENT = 4;      // off a standard rate by at most
+
+protected:
+    void prepare(const LogicCapture& capture) override;
+    void begin() override;
+    void onRun(uint64_t start, uint8_t value, uint64_t length) override;
+
+private:
+    uint8_t channel;
+    uint32_t wantedBaud;
+    uint32_t baud = 0;
+    double bitSamples = 0;
+    bool level = true;
+    bool inFrame = false;
+    uint64_t frameStart = 0;
+    uint8_t bit = 0;
+    uint32_t shift = 0;
+};
@@ -45,25 +45,25 @@ Dispatch
 */
 void ActionDispatcher::dispatch(const std::string& raw) {    
     if (raw.empty()) return;
+    releaseEndedJobs();
     
     char first = raw[0];
 
     // Instructions
     if (first == '[' || first == '>' || first == '{') {
-        std::vector<Instruction> instructions = provider.getInstructionTransformer().transform(raw);
-        dispatchInstructions(instructions);
+        dispatchInstructions(raw);
         return;
     }
 
     // Macros
     if (first == '(') {
-        provider.getTerminalView().println("Macros Not Yet Implemented.");
+        dispatchMacro(raw);
         return;
     }
 
     // Terminal Command
-    TerminalCommand cmd = provider.getCommandTransformer().transform(raw);
-    dispatchCommand(cmd);
+    provider.getCommandTransformer().transform(raw, command);
+    dispatchCommand(command);
 }
 
 /*
@@ -79,6 +79,12 @@ void ActionDispatcher::dispatchCommand(const TerminalCommand& cmd) {
         return;
     }
 
+    // Background job, the capture of the command becomes a task
+    if (cmd.getRoot() == "bg") {
+        dispatchBackground(cmd);
+        return;
+    }
+
     // Global command (help, logic, mode, P, p...)
     if (provider.getUtilityController().isGlobalCommand(cmd)) {
         provider.getUtilityController().handleCommand(cmd);
@@ -90,6 +96,7 @@ void ActionDispatcher::dispatchCommand(const TerminalCommand& cmd) {
     }
 
     // Mode specific command
+    if (isModeBusy()) return;
     switch (state.getCurrentMode()) {
         case ModeEnum::HIZ:
             provider.getTerminalView().println("Type 'help' or 'mode'");
@@ -156,55 +163,248 @@ void ActionDispatcher::dispatchCommand(const TerminalCommand& cmd) {
    } 
 }
 
+/*
+Dispatch Background
+*/
+void ActionDispatcher::dispatchBackground(const TerminalCommand& cmd) {
+    if (cmd.getSubcommand().empty() || cmd.getSubcommand() == "bg") {
+        provider.getTerminalView().println("Usage: bg <command>, e.g. 'bg sniff'");
+        return;
+    }
+
+    std::string line = cmd.getSubcommand();
+    if (!cmd.getArgs().empty()) line += " " + cmd.getArgs();
+
+    TerminalCommand inner;
+    provider.getCommandTransformer().transform(line, inner);
+
+    if (isModeBusy()) return;
+    auto& jobs = provider.getJobManager();
+    jobs.requestBackground(line);
+    dispatchCommand(inner);
+
+    // The command ran in the foreground and did not capture anything
+    if (jobs.cancelBackground()) {
+        provider.getTerminalView().println("bg: '" + inner.getRoot() + "' is not a capture, it cannot run in background.");
+    }
+}
+
+/*
+Busy Mode
+*/
+bool ActionDispatcher::isModeBusy() {
+    if (!provider.getJobManager().isBusy(state.getCurrentMode())) return false;
+    provider.getTerminalView().println("A background job is using " + ModeEnumMapper::toString(state.getCurrentMode()) +
+                                       ". Use 'fg' to watch it or 'kill' to stop it.");
+    return true;
+}
+
+/*
+Release Ended Jobs
+*/
+void ActionDispatcher::releaseEndedJobs() {
+    for (ModeEnum mode : provider.getJobManager().releaseEnded()) {
+        if (mode == state.getCurrentMode()) {
+            setCurrentMode(mode);
+            return;
+        }
+    }
+}
+
 /*
 Dispatch Instructions
 */
-void ActionDispatcher::dispatchInstructions(const std::vector<Instruction>& instructions) {
-    // Convert raw instructions into bytecodes vector
-    auto bytecodes = provider.getInstructionTransformer().transformByteCodes(instructions);
+void ActionDispatcher::dispatchInstructions(const std::string& raw) {
+    if (isModeBusy()) return;
+    // Compile the raw line into the reused bytecode program
+    provider.getInstructionTransformer().transform(raw, program);
 
     switch (state.getCurrentMode()) {
         case ModeEnum::OneWire:
-            provider.getOneWireController().handleInstruction(bytecodes);
+            provider.getOneWireController().handleInstruction(program);
             break;
         case ModeEnum::UART:
-            provider.getUartController().handleInstruction(bytecodes);
+            provider.getUartController().handleInstruction(program);
             break;
         case ModeEnum::HDUART:
-            provider.getHdUartController().handleInstruction(bytecodes);
+            provider.getHdUartController().handleInstruction(program);
             break;
         case ModeEnum::I2C:
-            provider.getI2cController().handleInstruction(bytecodes);
+            provider.getI2cController().handleInstruction(program);
             break;
         case ModeEnum::SPI:
-            provider.getSpiController().handleInstruction(bytecodes);
+            provider.getSpiController().handleInstruction(program);
             break;
         case ModeEnum::TwoWire:
-            provider.getTwoWireController().handleInstruction(bytecodes);
+            provider.getTwoWireController().handleInstruction(program);
             break;
         case ModeEnum::ThreeWire:
-            provider.getThreeWireController().handleInstruction(bytecodes);
+            provider.getThreeWireController().handleInstruction(program);
             break;
         case ModeEnum::LED:
-            provider.getLedController().handleInstruction(bytecodes);
+            provider.getLedController().handleInstruction(program);
             break;
         default:
             provider.getTerminalView().println("Cannot execute instruction in this mode.");
             return;
     }
 
-    // Line by line bytecode
-    provider.getTerminalView().println("");
-    provider.getTerminalView().println("ByteCode Sequence:");
-    for (const auto& code : bytecodes) {
-        provider.getTerminalView().println(
-            ByteCodeEnumMapper::toString(code.getCommand()) +
-            " | data=" + std::to_string(code.getData()) +
-            " | bits=" + std::to_string(code.getBits()) +
-            " | repeat=" + std::to_string(code.getRepeat())
-        );
+    // Execution trace, off by default on slow terminals
+    std::string trace = formatTrace(program);
+    if (!trace.empty()) {
+        provider.getTerminalView().println(trace);
+        provider.getTerminalView().println("");
+    }
+
+    // Measured delays, to check a timing sensitive sequence
+    std::string jitter = state.isPreciseTiming() ? formatJitter() : "";
+    if (!jitter.empty()) {
+        provider.getTerminalView().println(jitter);
+        provider.getTerminalView().println("");
+    }
+}
+
+/*
+Dispatch Macro
+*/
+void ActionDispatcher::dispatchMacro(const std::string& raw) {
+    auto& view = provider.getTerminalView();
+    auto& macros = provider.getMacroManager();
+    std::string error;
+
+    // Strip ( and )
+    std::string inner = raw.substr(1);
+    if (!inner.empty() && inner.back() == ')') inner.pop_back();
+    auto args = provider.getArgTransformer().splitArgs(inner);
+
+    // (), list
+    if (args.empty()) {
+        auto names = macros.list();
+        if (names.empty()) view.println("No macro saved. Define one with (name=[0x9F r:3])");
+        for (const auto& name : names) view.println("  " + name + " = " + macros.getBody(name));
+        return;
+    }
+
+    // (name=body), define
+    size_t equal = inner.find('=');
+    if (equal != std::string::npos) {
+        auto nameArgs = provider.getArgTransformer().splitArgs(inner.substr(0, equal));
+        std::string name = nameArgs.size() == 1 ? nameArgs[0] : "";
+        if (!macros.define(name, inner.substr(equal + 1), error)) {
+            view.println("Macro error: " + error);
+            return;
+        }
+        view.println("Macro '" + name + "' saved.");
+        return;
+    }
+
+    // (-name), delete
+    if (args[0][0] == '-') {
+        std::string name = args[0].substr(1);
+        view.println(macros.remove(name) ? "Macro '" + name + "' deleted." : "Unknown macro: " + name);
+        return;
+    }
+
+    // (load path), import from SD
+    if (args[0] == "load") {
+        if (args.size() != 2) {
+            view.println("Usage: (load /macros.txt)");
+            return;
+        }
+        size_t count = macros.importFile(args[1], error);
+        view.println("Imported " + std::to_string(count) + " macro(s).");
+        if (!error.empty()) view.println("Macro error: " + error);
+        return;
+    }
+
+    // (name [times]), run
+    uint32_t times = 1;
+    if (args.size() > 1) {
+        if (!provider.getArgTransformer().isValidNumber(args[1])) {
+            view.println("Usage: (name [times])");
+            return;
+        }
+        times = provider.getArgTransformer().parseHexOrDec32(args[1]);
+    }
+
+    auto mode = state.getCurrentMode();
+    if (mode != ModeEnum::OneWire && mode != ModeEnum::UART && mode != ModeEnum::HDUART &&
+        mode != ModeEnum::I2C && mode != ModeEnum::SPI) {
+        view.println("Cannot execute instruction in this mode.");
+        return;
+    }
+    if (isModeBusy()) return;
+
+    // Reads printed as they come, [ENTER] stops the macro
+    auto execute = [this](const ByteCodeProgram& program) { return executeProgram(program); };
+    auto output = [this, &view](const std::string& result) {
+        if (!result.empty()) view.println(result);
+        char c = provider.getTerminalInput().readChar();
+        return c != '\r' && c != '\n';
+    };
+
+    MacroRunStats stats;
+    if (!macros.run(args[0], times, execute, output, stats, error)) {
+        view.println("Macro error: " + error);
+        return;
+    }
+
+    view.println("");
+    view.println("Macro '" + args[0] + "': " + std::to_string(stats.executed) + " lines in " +
+                 std::to_string(stats.elapsedUs) + " us" + (stats.stopped ? " (stopped)" : ""));
+}
+
+/*
+Execute Program, on the current bus without controller output
+*/
+std::string ActionDispatcher::executeProgram(const ByteCodeProgram& program) {
+    switch (state.getCurrentMode()) {
+        case ModeEnum::OneWire: return provider.getOneWireService().executeByteCode(program);
+        case ModeEnum::UART:    return provider.getUartService().executeByteCode(program);
+        case ModeEnum::HDUART:  return provider.getHdUartService().executeByteCode(program);
+        case ModeEnum::I2C:     return provider.getI2cService().executeByteCode(program);
+        case ModeEnum::SPI:     return provider.getSpiService().executeByteCode(program);
+        default:                return "";
+    }
+}
+
+/*
+Format Trace, from the service that ran the last program
+*/
+std::string ActionDispatcher::formatTrace(const ByteCodeProgram& program) {
+    auto mode = state.getTraceMode();
+    if (mode == TraceModeEnum::Off) return "";
+
+    switch (state.getCurrentMode()) {
+        case ModeEnum::OneWire: return provider.getOneWireService().formatTrace(mode);
+        case ModeEnum::UART:    return provider.getUartService().formatTrace(mode);
+        case ModeEnum::HDUART:  return provider.getHdUartService().formatTrace(mode);
+        case ModeEnum::I2C:     return provider.getI2cService().formatTrace(mode);
+        case ModeEnum::SPI:     return provider.getSpiService().formatTrace(mode);
+        default: break;
+    }
+
+    // Bit-banged modes are not timed, list the ops only
+    std::string out = "Trace: " + std::to_string(program.size()) + " ops";
+    if (mode == TraceModeEnum::Summary) return out;
+    for (const auto& op : program.getOps()) {
+        out += "\n  " + ByteCodeEnumMapper::toString(op.command) + "  " + std::to_string(op.length);
+    }
+    return out;
+}
+
+/*
+Format Jitter, delays of the last program against the requested time
+*/
+std::string ActionDispatcher::formatJitter() {
+    switch (state.getCurrentMode()) {
+        case ModeEnum::OneWire: return provider.getOneWireService().formatJitter();
+        case ModeEnum::UART:    return provider.getUartService().formatJitter();
+        case ModeEnum::HDUART:  return provider.getHdUartService().formatJitter();
+        case ModeEnum::I2C:     return provider.getI2cService().formatJitter();
+        case ModeEnum::SPI:     return provider.getSpiService().formatJitter();
+        default:                return "";
     }
-    provider.getTerminalView().println("");
 }
 
 /*
@@ -216,12 +416,14 @@ std::string ActionDispatcher::getUserAction() {
     size_t cursorIndex = 0;
 
     while (true) {
-        provider.getDeviceInput().readChar(); // to check shutdown request for T-Embeds
-        char c = provider.getTerminalInput().readChar();
+        // Sleep until a key or the timeout, the device is still polled for T-Embed shutdown
+        char c = provider.getTerminalInput().waitChar(INPUT_WAIT_MS);
+        provider.getDeviceInput().readChar();
         if (c == KEY_NONE) continue;
 
         if (handleEscapeSequence(c, inputLine, cursorIndex, mode)) continue;
         if (handleEnterKey(c, inputLine)) return inputLine;
+        if (handleTabKey(c, inputLine, cursorIndex, mode)) continue;
         if (handleBackspace(c, inputLine, cursorIndex, mode)) continue;
         if (handlePrintableChar(c, inputLine, cursorIndex, mode));
     }
@@ -276,6 +478,48 @@ bool ActionDispatcher::handleEnterKey(char c, const std::string& inputLine) {
     return true;
 }
 
+/*
+User Action: Tab
+*/
+bool ActionDispatcher::handleTabKey(char c, std::string& inputLine, size_t& cursorIndex, const std::string& mode) {
+    if (c != '\t') return false;
+
+    // Only the command name, with the cursor at its end
+    if (cursorIndex != inputLine.size() || inputLine.find(' ') != std::string::npos) return true;
+
+    std::vector<std::string_view> matches;
+    for (ModeEnum scope : {ModeEnum::None, state.getCurrentMode()}) {
+        for (const auto& command : CommandRegistry::of(scope)) {
+            std::string_view name = command.name;
+            if (!command.usage || name.empty() || name.compare(0, inputLine.size(), inputLine) != 0) continue;
+            if (std::find(matches.begin(), matches.end(), name) == matches.end()) matches.push_back(name);
+        }
+    }
+    if (matches.empty()) return true;
+
+    // Extend to the common prefix, list the candidates when still ambiguous
+    std::string_view common = matches[0];
+    for (auto name : matches) {
+        size_t i = 0;
+        while (i < common.size() && i < name.size() && common[i] == name[i]) ++i;
+        common = common.substr(0, i);
+    }
+
+    if (matches.size() == 1) {
+        inputLine = std::string(common) + " ";
+    } else {
+        std::string list;
+        for (auto name : matches) list += std::string(name) + "  ";
+        provider.getTerminalView().println("");
+        provider.getTerminalView().println(list);
+        inputLine = std::string(common);
+    }
+
+    cursorIndex = inputLine.size();
+    provider.getTerminalView().print("\r" + mode + "> " + inputLine + "\033[K");
+    return true;
+}
+
 /*
 User Action: Backspace
 */
@@ -319,7 +563,18 @@ bool ActionDispatcher::handlePrintableChar(char c, std::string& inputLine, size_
 Set Mode
 */
 void ActionDispatcher::setCurrentMode(ModeEnum newMode) {
+    auto& jobs = provider.getJobManager();
+    auto& ownership = state.getPinOwnership();
+
+    // HIZ ends every service, the ones of background jobs too
+    if (newMode == ModeEnum::HIZ && jobs.isBusy()) {
+        provider.getTerminalView().println("Mode: Background jobs are running, 'kill' them first.");
+        return;
+    }
+
     PinoutConfig config;
+    ModeEnum previous = state.getCurrentMode();
+    ownership.takeRefusal();
     state.setCurrentMode(newMode);
     config.setMode(ModeEnumMapper::toString(newMode));
     auto proto = InfraredProtocolMapper::toString(state.getInfraredProtocol());
@@ -466,6 +721,14 @@ void ActionDispatcher::setCurrentMode(ModeEnum newMode) {
             break;
     }
 
+    // A claim touched pins of a background job, the mode was not configured
+    uint8_t holder = ownership.takeRefusal();
+    if (holder) {
+        provider.getTerminalView().println("Mode: Pins in use by background job [" + std::to_string(holder) + "], 'kill' it first.");
+        state.setCurrentMode(previous);
+        return;
+    }
+
     // Show the new mode pinout
     provider.getDeviceView().show(config);
 }
@@ -3,13 +3,14 @@
 #include <string>
 #include <vector>
 #include "Models/TerminalCommand.h"
-#include "Models/ByteCode.h"
+#include "Models/ByteCodeProgram.h"
 #include "Transformers/InstructionTransformer.h"
 #include "Enums/ModeEnum.h"
 #include "Providers/DependencyProvider.h"
 #include "Enums/ByteCodeEnum.h"
 #include "Enums/TerminalTypeEnum.h"
 #include "Interfaces/ITerminalView.h"
+#include "Data/CommandRegistry.h"
 
 class ActionDispatcher {
 public:
@@ -28,12 +29,34 @@ public:
 private:
     DependencyProvider& provider;
     GlobalState& state = GlobalState::getInstance();
+    ByteCodeProgram program; // reused between instruction lines
+    TerminalCommand command; // reused between command lines
+
+    // Longest wait on the terminal before polling the device input
+    static constexpr uint32_t INPUT_WAIT_MS = 50;
 
     // Handle a command
     void dispatchCommand(const TerminalCommand& cmd);
 
+    // Run a command's capture as a background job
+    void dispatchBackground(const TerminalCommand& cmd);
+
+    // A background job uses the services of the current mode, prints why
+    bool isModeBusy();
+
+    // Configure again the current mode once its jobs have given their pins back
+    void releaseEndedJobs();
+
     // Handle a sequence of bytecode instructions
-    void dispatchInstructions(const std::vector<Instruction>& instructions);
+    void dispatchInstructions(const std::string& raw);
+
+    // Handle a macro line: define, list, delete, load or run
+    void dispatchMacro(const std::string& raw);
+
+    // Run a compiled program on the current mode's service
+    std::string executeProgram(const ByteCodeProgram& program);
+    std::string formatTrace(const ByteCodeProgram& program);
+    std::string formatJitter();
 
     // Read user input with cursor support
     std::string getUserAction();
@@ -50,6 +73,9 @@ private:
     // Handle Enter key and dispatch line
     bool handleEnterKey(char c, const std::string& inputLine);
 
+    // Complete the command name from the registry
+    bool handleTabKey(char c, std::string& inputLine, size_t& cursorIndex, const std::string& mode);
+
     // Switch to a different input mode
     void setCurrentMode(ModeEnum newMode);
 };
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "Models/TerminalCommand.h"
+#include "Data/CommandRegistry.h"
+
+/*
+Compile time routing of a controller's commands.
+
+Routes are member functions, with or without the command. The router
+hashes their names into a constant table, a command then costs one hash
+and usually one compare. Every route must be documented in the registry
+for its mode, an undocumented route does not compile.
+*/
+template <typename Controller>
+struct CommandRoute {
+    using Plain = void (Controller::*)();
+    using WithCommand = void (Controller::*)(const TerminalCommand&);
+
+    constexpr CommandRoute(const char* name, Plain handler)
+        : name(name), plain(handler), withCommand(nullptr) {}
+    constexpr CommandRoute(const char* name, WithCommand handler)
+        : name(name), plain(nullptr), withCommand(handler) {}
+
+    const char* name;
+    Plain plain;
+    WithCommand withCommand;
+};
+
+// Not constexpr on purpose, reaching it while building a router is a compile error
+inline void commandRouteNotInRegistry() {}
+
+template <typename Controller, size_t N>
+class CommandRouter {
+public:
+    constexpr CommandRouter(ModeEnum mode, const CommandRoute<Controller> (&routes)[N])
+        : routes(routes), slots{}, mode(mode) {
+        for (auto& slot : slots) slot = EMPTY;
+
+        for (size_t i = 0; i < N; ++i) {
+            std::string_view name = routes[i].name;
+            if (!CommandRegistry::find(mode, name)) commandRouteNotInRegistry();
+
+            size_t slot = CommandRegistry::hash(mode, name) & (SLOTS - 1);
+            while (slots[slot] != EMPTY) slot = (slot + 1) & (SLOTS - 1);
+            slots[slot] = static_cast<uint8_t>(i);
+        }
+    }
+
+    // False when the root is not a route of this controller
+    bool dispatch(Controller& controller, const TerminalCommand& cmd) const {
+        const std::string& root = cmd.getRoot();
+        std::string_view name(root);
+
+        size_t slot = CommandRegistry::hash(mode, name) & (SLOTS - 1);
+        while (slots[slot] != EMPTY) {
+            const auto& route = routes[slots[slot]];
+            if (name == route.name) {
+                if (route.plain) (controller.*route.plain)();
+                else (controller.*route.withCommand)(cmd);
+                return true;
+            }
+            slot = (slot + 1) & (SLOTS - 1);
+        }
+        return false;
+    }
+
+private:
+    static constexpr size_t SLOTS = CommandRegistry::slotsFor(N);
+    static constexpr uint8_t EMPTY = 0xFF;
+    static_assert(N < EMPTY, "Too many routes for one controller");
+
+    const CommandRoute<Controller>* routes;
+    uint8_t slots[SLOTS];
+    ModeEnum mode;
+};
@@ -1,13 +1,15 @@
 #pragma once
 #include <string>
+#include <cstdint>
 
-enum class ByteCodeEnum {
+enum class ByteCodeEnum : uint8_t {
     Write,
     Read,
     Start,
     Stop,
     DelayUs,
     DelayMs,
+    DelayNs,
     SetClkHigh,
     SetClkLow,
     SetDatHigh,
@@ -33,6 +35,7 @@ public:
             case ByteCodeEnum::Stop:         return "Stop      ";
             case ByteCodeEnum::DelayUs:      return "DelayUs   ";
             case ByteCodeEnum::DelayMs:      return "DelayMs   ";
+            case ByteCodeEnum::DelayNs:      return "DelayNs   ";
             case ByteCodeEnum::SetClkHigh:   return "SetClkHigh";
             case ByteCodeEnum::SetClkLow:    return "SetClkLow ";
             case ByteCodeEnum::SetDatHigh:   return "SetDatHigh";
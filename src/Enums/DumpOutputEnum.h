@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Where a memory dump goes
+enum class DumpOutputEnum {
+    HexLines,
+    RawSd,
+    RawTerminal
+};
+
+class DumpOutputEnumMapper {
+public:
+    static std::string toString(DumpOutputEnum output) {
+        switch (output) {
+            case DumpOutputEnum::HexLines:    return " Hex lines";
+            case DumpOutputEnum::RawSd:       return " Raw binary to SD card";
+            case DumpOutputEnum::RawTerminal: return " Raw binary to terminal (USB Serial)";
+            default:                          return "Unknown";
+        }
+    }
+
+    // Labels in enum order, for choice prompts
+    static std::vector<std::string> getAll() {
+        return {
+            toString(DumpOutputEnum::HexLines),
+            toString(DumpOutputEnum::RawSd),
+            toString(DumpOutputEnum::RawTerminal)
+        };
+    }
+};
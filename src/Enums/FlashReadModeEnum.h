@@ -0,0 +1,37 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+// SPI flash read commands, from the slowest to the widest
+enum class FlashReadModeEnum {
+    Standard,    // 0x03, no dummy cycle, lowest max clock
+    Fast,        // 0x0B, 8 dummy clocks
+    DualOutput,  // 0x3B, 8 dummy clocks, data on IO0/IO1
+    QuadOutput   // 0x6B, 8 dummy clocks, data on IO0..IO3
+};
+
+class FlashReadModeEnumMapper {
+public:
+    static std::string toString(FlashReadModeEnum mode) {
+        switch (mode) {
+            case FlashReadModeEnum::Standard:   return "Standard (0x03)";
+            case FlashReadModeEnum::Fast:       return "Fast (0x0B)";
+            case FlashReadModeEnum::DualOutput: return "Dual Output (0x3B)";
+            case FlashReadModeEnum::QuadOutput: return "Quad Output (0x6B)";
+            default:                            return "Unknown";
+        }
+    }
+
+    static uint8_t toOpcode(FlashReadModeEnum mode) {
+        switch (mode) {
+            case FlashReadModeEnum::Fast:       return 0x0B;
+            case FlashReadModeEnum::DualOutput: return 0x3B;
+            case FlashReadModeEnum::QuadOutput: return 0x6B;
+            default:                            return 0x03;
+        }
+    }
+
+    static uint8_t dummyBytes(FlashReadModeEnum mode) {
+        return mode == FlashReadModeEnum::Standard ? 0 : 1;
+    }
+};
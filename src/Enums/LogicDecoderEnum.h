@@ -0,0 +1,34 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Protocols decoded from a logic capture
+enum class LogicDecoderEnum {
+    Uart,
+    I2c,
+    Spi,
+    OneWire
+};
+
+class LogicDecoderEnumMapper {
+public:
+    static std::string toString(LogicDecoderEnum decoder) {
+        switch (decoder) {
+            case LogicDecoderEnum::Uart:    return " UART, 8N1, baud detected";
+            case LogicDecoderEnum::I2c:     return " I2C";
+            case LogicDecoderEnum::Spi:     return " SPI";
+            case LogicDecoderEnum::OneWire: return " 1-Wire";
+            default:                        return "Unknown";
+        }
+    }
+
+    // Labels in enum order, for choice prompts
+    static std::vector<std::string> getAll() {
+        return {
+            toString(LogicDecoderEnum::Uart),
+            toString(LogicDecoderEnum::I2c),
+            toString(LogicDecoderEnum::Spi),
+            toString(LogicDecoderEnum::OneWire)
+        };
+    }
+};
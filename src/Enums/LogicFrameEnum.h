@@ -0,0 +1,27 @@
+#pragma once
+#include <string>
+
+// Kind of a frame decoded from a logic capture
+enum class LogicFrameEnum {
+    Start,     // I2C start or repeated start
+    Stop,      // I2C stop
+    Address,   // I2C address byte
+    Data,      // UART byte, I2C data byte, SPI word, 1-Wire byte
+    Reset,     // 1-Wire reset pulse
+    Presence   // 1-Wire presence pulse
+};
+
+class LogicFrameEnumMapper {
+public:
+    static std::string toString(LogicFrameEnum frame) {
+        switch (frame) {
+            case LogicFrameEnum::Start:    return "START";
+            case LogicFrameEnum::Stop:     return "STOP";
+            case LogicFrameEnum::Address:  return "ADDR";
+            case LogicFrameEnum::Data:     return "DATA";
+            case LogicFrameEnum::Reset:    return "RESET";
+            case LogicFrameEnum::Presence: return "PRESENCE";
+            default:                       return "Unknown";
+        }
+    }
+};
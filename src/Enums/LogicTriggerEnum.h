@@ -0,0 +1,37 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Condition that ends the pre-trigger part of a logic capture
+enum class LogicTriggerEnum {
+    None,     // first sample
+    Rising,   // channel goes low to high
+    Falling,  // channel goes high to low
+    Pattern,  // masked channels match the given levels
+    Pulse     // a pulse on a channel ends with its width in range
+};
+
+class LogicTriggerEnumMapper {
+public:
+    static std::string toString(LogicTriggerEnum trigger) {
+        switch (trigger) {
+            case LogicTriggerEnum::None:    return " None, capture now";
+            case LogicTriggerEnum::Rising:  return " Rising edge";
+            case LogicTriggerEnum::Falling: return " Falling edge";
+            case LogicTriggerEnum::Pattern: return " Pattern";
+            case LogicTriggerEnum::Pulse:   return " Pulse width";
+            default:                        return "Unknown";
+        }
+    }
+
+    // Labels in enum order, for choice prompts
+    static std::vector<std::string> getAll() {
+        return {
+            toString(LogicTriggerEnum::None),
+            toString(LogicTriggerEnum::Rising),
+            toString(LogicTriggerEnum::Falling),
+            toString(LogicTriggerEnum::Pattern),
+            toString(LogicTriggerEnum::Pulse)
+        };
+    }
+};
@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+// Steps of a compiled macro
+enum class MacroStepEnum : uint8_t {
+    Run,      // execute one compiled instruction line
+    Set,      // variable = value
+    Add,      // variable += value
+    Repeat,   // loop head, value is the count
+    End       // loop tail, jumps back while the count lasts
+};
+
+class MacroStepEnumMapper {
+public:
+    static std::string toString(MacroStepEnum step) {
+        switch (step) {
+            case MacroStepEnum::Run:    return "run";
+            case MacroStepEnum::Set:    return "set";
+            case MacroStepEnum::Add:    return "add";
+            case MacroStepEnum::Repeat: return "repeat";
+            case MacroStepEnum::End:    return "end";
+            default:                    return "unknown";
+        }
+    }
+};
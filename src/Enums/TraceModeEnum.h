@@ -0,0 +1,29 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+// What is printed after an instruction line
+enum class TraceModeEnum : uint8_t {
+    Off,       // reads only
+    Summary,   // one line, ops, bus operations and total time
+    Full       // every op with its cycle counter timestamp
+};
+
+class TraceModeEnumMapper {
+public:
+    static std::string toString(TraceModeEnum mode) {
+        switch (mode) {
+            case TraceModeEnum::Off:     return "off";
+            case TraceModeEnum::Summary: return "summary";
+            case TraceModeEnum::Full:    return "full";
+            default:                     return "unknown";
+        }
+    }
+
+    static bool fromString(const std::string& name, TraceModeEnum& mode) {
+        if (name == "off")     { mode = TraceModeEnum::Off;     return true; }
+        if (name == "summary") { mode = TraceModeEnum::Summary; return true; }
+        if (name == "full")    { mode = TraceModeEnum::Full;    return true; }
+        return false;
+    }
+};
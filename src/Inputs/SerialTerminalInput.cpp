@@ -1,14 +1,16 @@
 #include "SerialTerminalInput.h"
 #include <Arduino.h>
 
+std::atomic<TaskHandle_t> SerialTerminalInput::reader{nullptr};
+
 char SerialTerminalInput::handler() {
-    while (!Serial.available()) {}
-    return Serial.read();
+    char c;
+    while ((c = waitChar(portMAX_DELAY)) == KEY_NONE) {}
+    return c;
 }
 
 void SerialTerminalInput::waitPress() {
-    while (!Serial.available()) {}
-    Serial.read(); // discard
+    handler(); // discard
 }
 
 char SerialTerminalInput::readChar() {
@@ -16,4 +18,56 @@ char SerialTerminalInput::readChar() {
         return Serial.read();
     }
     return KEY_NONE;
-}
\ No newline at end of file
+}
+
+/*
+Wait Char, sleeps on a task notification given by the RX event
+*/
+char SerialTerminalInput::waitChar(uint32_t timeoutMs) {
+    if (!listening) listen();
+
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = timeoutMs == portMAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+
+    while (!Serial.available()) {
+        TickType_t waited = xTaskGetTickCount() - start;
+        if (timeout != portMAX_DELAY && waited >= timeout) {
+            reader.store(nullptr, std::memory_order_relaxed);
+            return KEY_NONE;
+        }
+
+        // Register before the last check, a byte after it notifies us
+        reader.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+        if (Serial.available()) break;
+
+        // Bounded sleep, a missed event costs one poll period at worst
+        TickType_t left = timeout == portMAX_DELAY ? MAX_SLEEP_TICKS : timeout - waited;
+        ulTaskNotifyTake(pdTRUE, left < MAX_SLEEP_TICKS ? left : MAX_SLEEP_TICKS);
+    }
+
+    reader.store(nullptr, std::memory_order_relaxed);
+    return Serial.read();
+}
+
+/*
+Listen
+*/
+void SerialTerminalInput::listen() {
+    listening = true;
+
+#if ARDUINO_USB_CDC_ON_BOOT && ARDUINO_USB_MODE
+    // HWCDC, USB Serial/JTAG peripheral
+    Serial.onEvent(ARDUINO_HW_CDC_RX_EVENT, [](void*, esp_event_base_t, int32_t, void*) { wake(); });
+#elif ARDUINO_USB_CDC_ON_BOOT
+    // TinyUSB CDC
+    Serial.onEvent(ARDUINO_USB_CDC_RX_EVENT, [](void*, esp_event_base_t, int32_t, void*) { wake(); });
+#else
+    // UART, called from the driver event task
+    Serial.onReceive(wake);
+#endif
+}
+
+void SerialTerminalInput::wake() {
+    TaskHandle_t waiting = reader.exchange(nullptr, std::memory_order_acq_rel);
+    if (waiting) xTaskNotifyGive(waiting);
+}
@@ -2,11 +2,28 @@
 
 #include <Interfaces/IInput.h>
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include <vector>
+#include <atomic>
 
 class SerialTerminalInput : public IInput {
 public:
     char handler() override;
     void waitPress() override;
     char readChar() override;
+    char waitChar(uint32_t timeoutMs) override;
+
+private:
+    // Register the RX event once Serial is running
+    void listen();
+
+    // RX event, wakes the task blocked in waitChar
+    static void wake();
+
+    static std::atomic<TaskHandle_t> reader;
+    bool listening = false;
+
+    // Longest sleep between two checks, should an RX event get lost
+    static constexpr TickType_t MAX_SLEEP_TICKS = pdMS_TO_TICKS(100);
 };
@@ -13,3 +13,7 @@ char WebTerminalInput::readChar() {
 void WebTerminalInput::waitPress() {
     server.readCharBlocking();
 }
+
+char WebTerminalInput::waitChar(uint32_t timeoutMs) {
+    return server.readCharBlocking(pdMS_TO_TICKS(timeoutMs));
+}
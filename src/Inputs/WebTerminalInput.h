@@ -9,6 +9,7 @@ public:
     char handler() override;
     char readChar() override;
     void waitPress() override;
+    char waitChar(uint32_t timeoutMs) override;
 
 private:
     WebSocketServer& server;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <Arduino.h>
 #include "Inputs/InputKeys.h"
 
 // Interface for terminal input
@@ -19,5 +20,17 @@ public:
 
     // Wait an inpout
     virtual void waitPress() = 0;
-    
-};
\ No newline at end of file
+
+    // Read waiting at most timeoutMs, KEY_NONE on timeout. Inputs with an
+    // RX event sleep until it fires, the others poll and yield in between.
+    virtual char waitChar(uint32_t timeoutMs) {
+        uint32_t start = millis();
+        while (true) {
+            char c = readChar();
+            if (c != KEY_NONE || millis() - start >= timeoutMs) return c;
+            delay(POLL_INTERVAL_MS);
+        }
+    }
+
+    static constexpr uint32_t POLL_INTERVAL_MS = 5;
+};
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+
+// Interface for the output of a long running capture (sniff, monitor, read).
+// In the foreground it is the terminal, in the background the ring buffer
+// of a job, so a capture loop is written once for both.
+
+class IJobOutput {
+public:
+    virtual ~IJobOutput() = default;
+
+    // Print capture output
+    virtual void print(const std::string& text) = 0;
+    virtual void println(const std::string& text) = 0;
+
+    // Call once per loop, false when the capture must stop ([ENTER] or kill)
+    virtual bool poll() = 0;
+};
@@ -6,18 +6,41 @@
 #include "Interfaces/IInput.h"
 #include "Interfaces/ITerminalView.h"
 
+struct FileSignature;
+
 struct BinaryBlockStats {
     float entropy;
     uint32_t printable;
     uint32_t nulls;
     uint32_t ff;
-    const char* signature;
+    const FileSignature* signature;
+    size_t signatureOffset; // where the magic was found in the block
+};
+
+struct SensitiveHit {
+    uint32_t offset;
+    const char* label;
+};
+
+struct FirmwareRegion {
+    uint32_t start;
+    uint32_t length;     // 0 when the header does not tell
+    std::string name;
+    std::string detail;
+    bool payload;        // opaque content, no signature scan inside
+    uint8_t depth;       // 1 for entries of a table (partitions)
 };
 
+// Validate the header at data[0] (the start of the structure, not of the magic),
+// fill the region and add any sub regions. False for a false positive
+using HeaderParser = bool (*)(const uint8_t* data, size_t size, FirmwareRegion& region, std::vector<FirmwareRegion>& children);
+
 struct FileSignature {
     const char* name;
     const uint8_t* pattern;
     size_t length;
+    uint32_t magicOffset;   // magic position from the start of the structure
+    HeaderParser parser;    // nullptr when only the magic is checked
 };
 
 class BinaryAnalyzeManager {
@@ -31,8 +54,14 @@ public:
         uint32_t ffTotal;
         std::vector<std::string> foundFiles;
         std::vector<std::string> foundSecrets;
+        uint32_t startAddress;
+        std::vector<uint8_t> entropyMap; // one per REGION_SIZE bytes, entropy * 32
+        std::vector<FirmwareRegion> layout;
     };
 
+    // Granularity of the entropy map
+    static constexpr uint32_t REGION_SIZE = 4096;
+
     BinaryAnalyzeManager(ITerminalView& view, IInput& input);
 
     AnalysisResult analyze(
@@ -43,14 +72,45 @@ public:
     );
     
     std::string formatAnalysis(const AnalysisResult& result);
+
+    // Heat strip of the entropy map, one char per region (or group of regions)
+    // and the address ranges that look compressed or encrypted
+    std::string formatEntropyMap(const AnalysisResult& result, uint8_t columns = 64);
+
+    // Partition map from the parsed headers
+    std::string formatLayout(const AnalysisResult& result);
+
+    // Single pass over buf (address is its stream offset), state carries
+    // partial matches to the next call, start it at 0
+    static void detectSensitivePatterns(
+        const uint8_t* buf,
+        size_t size,
+        uint32_t address,
+        uint16_t& state,
+        std::vector<SensitiveHit>& hits
+    );
+
 private:
+    static constexpr size_t MAX_REPORTED_SECRETS = 256;
+    static constexpr size_t HEADER_READ_SIZE = 4096;
+
     IInput& terminalInput;
     ITerminalView& terminalView;
 
-    BinaryBlockStats analyzeBlock(const uint8_t* buffer, size_t size);
-    const char* detectFileSignature(const uint8_t* buf, size_t size);
-    const char* detectSensitivePattern(const uint8_t* buf, size_t size);
+    BinaryBlockStats analyzeBlock(const uint8_t* buffer, size_t size, uint32_t* counts, const std::vector<float>& cLogC, bool scanSignatures);
+    static float entropyFromCounts(const uint32_t* counts, uint32_t total, const std::vector<float>& cLogC);
+    const FileSignature* detectFileSignature(const uint8_t* buf, size_t size, size_t& offset);
     std::vector<std::string> extractPrintableStrings(const uint8_t* buf, size_t size, size_t minLen = 8);
+
+    // Header parsers of the known signatures
+    static bool parseElf(const uint8_t* data, size_t size, FirmwareRegion& region, std::vector<FirmwareRegion>& children);
+    static bool parseUImage(const uint8_t* data, size_t size, FirmwareRegion& region, std::vector<FirmwareRegion>& children);
+    static bool parseGzip(const uint8_t* data, size_t size, FirmwareRegion& region, std::vector<FirmwareRegion>& children);
+    static bool parseSquashFs(const uint8_t* data, size_t size, FirmwareRegion& region, std::vector<FirmwareRegion>& children);
+    static bool parseExt(const uint8_t* data, size_t size, FirmwareRegion& region, std::vector<FirmwareRegion>& children);
+    static bool parseRiff(const uint8_t* data, size_t size, FirmwareRegion& region, std::vector<FirmwareRegion>& children);
+    static bool parsePartitionTable(const uint8_t* data, size_t size, FirmwareRegion& region, std::vector<FirmwareRegion>& children);
+
     static const FileSignature knownSignatures[];
     static const size_t knownSignaturesCount;
 };
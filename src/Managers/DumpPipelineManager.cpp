@@ -0,0 +1,375 @@
+#include "DumpPipelineManager.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+
+constexpr uint8_t DumpPipelineManager::FRAME_SYNC[2];
+
+DumpPipelineManager::DumpPipelineManager(ITerminalView& view, IInput& input, SdService& sdService)
+    : terminalView(view), terminalInput(input), sdService(sdService) {}
+
+/*
+Dump
+*/
+bool DumpPipelineManager::dump(uint32_t startAddress, uint32_t totalLength, FetchFn fetchFn, uint32_t chunk, uint8_t wordSize) {
+    const uint32_t bytesPerLine = 16;
+    std::string text;
+    text.reserve((chunk / bytesPerLine + 1) * LINE_MAX);
+    char line[LINE_MAX];
+
+    return stream(startAddress, totalLength, fetchFn, chunk, [&](uint32_t address, const uint8_t* data, uint32_t len) {
+        // One print per chunk
+        text.clear();
+        for (uint32_t i = 0; i < len; i += bytesPerLine) {
+            uint32_t n = std::min(bytesPerLine, len - i);
+            if (i) text += '\n';
+            text.append(line, formatLine(line, address + i, data + i, n, wordSize));
+        }
+        terminalView.println(text);
+
+        if (stopPressed()) {
+            terminalView.println("\nDump interrupted by user.");
+            return false;
+        }
+        return true;
+    });
+}
+
+/*
+Dump To SD
+*/
+bool DumpPipelineManager::dumpToSd(
+    uint32_t startAddress,
+    uint32_t totalLength,
+    FetchFn fetchFn,
+    const std::string& path,
+    uint8_t sdCsPin,
+    uint32_t chunk,
+    const std::vector<uint8_t>& devicePins
+) {
+    // The device cannot be read while the card is written on the same pins,
+    // read it all first then write it from memory
+    if (sharesSdBus(devicePins, sdCsPin)) {
+        auto* image = static_cast<uint8_t*>(heap_caps_malloc(totalLength ? totalLength : 1, MALLOC_CAP_8BIT));
+        if (!image) {
+            terminalView.println("Raw Dump: Not enough memory to read the device before writing.");
+            return false;
+        }
+
+        bool done = readImage(startAddress, totalLength, fetchFn, chunk, image);
+        if (done) {
+            done = dumpToSd(startAddress, totalLength, [&](uint32_t address, uint8_t* buffer, uint32_t len) {
+                memcpy(buffer, image + (address - startAddress), len);
+                return true;
+            }, path, sdCsPin, chunk);
+        }
+        heap_caps_free(image);
+        return done;
+    }
+
+    if (!sdService.configure(state.getSpiCLKPin(), state.getSpiMISOPin(), state.getSpiMOSIPin(), sdCsPin)) {
+        terminalView.println("Raw Dump: No SD card detected. Check SPI pins.");
+        return false;
+    }
+
+    if (!sdService.openFileStream(path)) {
+        terminalView.println("Raw Dump: Could not create " + path);
+        sdService.end();
+        return false;
+    }
+
+    terminalView.println("Raw Dump: Writing " + std::to_string(totalLength) + " bytes to " + path + "... Press [ENTER] to stop.");
+
+    uint32_t crc = 0;
+    uint32_t written = 0;
+    uint32_t lastProgress = 0;
+    bool done = stream(startAddress, totalLength, fetchFn, chunk, [&](uint32_t address, const uint8_t* data, uint32_t len) {
+        if (!sdService.writeFileStream(data, len)) {
+            terminalView.println("\nRaw Dump: SD write failed.");
+            return false;
+        }
+        crc = crc32(crc, data, len);
+        written += len;
+
+        // A dot every 64 KB
+        if (written - lastProgress >= 64 * 1024) {
+            lastProgress = written;
+            terminalView.print(".");
+        }
+
+        if (stopPressed()) {
+            terminalView.println("\nRaw Dump: Interrupted by user.");
+            return false;
+        }
+        return true;
+    });
+
+    bool closed = sdService.closeFileStream();
+    sdService.end();
+
+    char summary[64];
+    snprintf(summary, sizeof(summary), "\nRaw Dump: %u bytes, CRC32 %08X", (unsigned)written, (unsigned)crc);
+    terminalView.println(summary);
+
+    return done && closed;
+}
+
+/*
+Dump To Terminal
+*/
+bool DumpPipelineManager::dumpToTerminal(uint32_t startAddress, uint32_t totalLength, FetchFn fetchFn, uint32_t chunk) {
+    // Binary does not survive the web terminal text frames
+    if (state.getTerminalMode() != TerminalTypeEnum::Serial) {
+        terminalView.println("Raw Dump: Binary output is only available on the USB serial terminal.");
+        return false;
+    }
+
+    chunk = std::min<uint32_t>(chunk, 0xFFFF);
+    terminalView.println("Raw Dump: " + std::to_string(totalLength) + " bytes as binary frames (A5 5A | offset | len | data), CRC32 trailer.");
+    terminalView.println("Raw Dump: Start the capture on the host, then press any key.");
+    terminalInput.handler();
+
+    uint32_t crc = 0;
+    uint32_t sent = 0;
+    bool done = stream(startAddress, totalLength, fetchFn, chunk, [&](uint32_t address, const uint8_t* data, uint32_t len) {
+        writeFrameHeader(address - startAddress, len);
+        Serial.write(data, len);
+        crc = crc32(crc, data, len);
+        sent += len;
+        return !stopPressed();
+    });
+
+    // Trailer, also sent on stop so the host knows what it got
+    writeFrameHeader(sent, 0);
+    uint8_t crcBytes[4] = {
+        static_cast<uint8_t>(crc & 0xFF),
+        static_cast<uint8_t>((crc >> 8) & 0xFF),
+        static_cast<uint8_t>((crc >> 16) & 0xFF),
+        static_cast<uint8_t>((crc >> 24) & 0xFF)
+    };
+    Serial.write(crcBytes, sizeof(crcBytes));
+    Serial.flush();
+
+    char summary[64];
+    snprintf(summary, sizeof(summary), "\r\nRaw Dump: %u bytes, CRC32 %08X", (unsigned)sent, (unsigned)crc);
+    terminalView.println(summary);
+
+    return done;
+}
+
+void DumpPipelineManager::writeFrameHeader(uint32_t offset, uint16_t len) {
+    uint8_t header[8] = {
+        FRAME_SYNC[0], FRAME_SYNC[1],
+        static_cast<uint8_t>(offset & 0xFF),
+        static_cast<uint8_t>((offset >> 8) & 0xFF),
+        static_cast<uint8_t>((offset >> 16) & 0xFF),
+        static_cast<uint8_t>((offset >> 24) & 0xFF),
+        static_cast<uint8_t>(len & 0xFF),
+        static_cast<uint8_t>((len >> 8) & 0xFF)
+    };
+    Serial.write(header, sizeof(header));
+}
+
+/*
+Shares SD Bus
+*/
+bool DumpPipelineManager::sharesSdBus(const std::vector<uint8_t>& devicePins, uint8_t sdCsPin) const {
+    const uint8_t sdPins[] = { state.getSpiCLKPin(), state.getSpiMISOPin(), state.getSpiMOSIPin(), sdCsPin };
+    for (uint8_t pin : devicePins) {
+        if (std::find(std::begin(sdPins), std::end(sdPins), pin) != std::end(sdPins)) return true;
+    }
+    return false;
+}
+
+/*
+Read Image, on the calling task
+*/
+bool DumpPipelineManager::readImage(uint32_t startAddress, uint32_t totalLength, FetchFn fetchFn, uint32_t chunk, uint8_t* image) {
+    terminalView.println("Raw Dump: Device on the SD pins, reading " + std::to_string(totalLength) + " bytes before writing...");
+
+    for (uint32_t offset = 0; offset < totalLength; offset += chunk) {
+        uint32_t len = std::min(chunk, totalLength - offset);
+        if (!fetchFn(startAddress + offset, image + offset, len)) {
+            char message[48];
+            snprintf(message, sizeof(message), "\nRead failed at 0x%06X", (unsigned)(startAddress + offset));
+            terminalView.println(message);
+            return false;
+        }
+
+        if (stopPressed()) {
+            terminalView.println("\nRaw Dump: Interrupted by user.");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DumpPipelineManager::stopPressed() {
+    char c = terminalInput.readChar();
+    return c == '\r' || c == '\n';
+}
+
+/*
+Pipeline
+*/
+bool DumpPipelineManager::stream(uint32_t startAddress, uint32_t totalLength, FetchFn fetchFn, uint32_t chunk, ConsumeFn consume) {
+    if (totalLength == 0) return true;
+
+    // Job
+    fetch = fetchFn;
+    start = startAddress;
+    length = totalLength;
+    chunkSize = chunk;
+    stopRequested = false;
+    buffers.assign(SLOT_COUNT * chunkSize, 0);
+
+    freeSlots = xQueueCreate(SLOT_COUNT, sizeof(uint8_t));
+    readySlots = xQueueCreate(SLOT_COUNT + 1, sizeof(uint8_t));
+    if (!freeSlots || !readySlots) {
+        terminalView.println("\nDump failed: Not enough memory for the read queues.");
+        releaseJob();
+        return false;
+    }
+    for (uint8_t i = 0; i < SLOT_COUNT; ++i) {
+        xQueueSend(freeSlots, &i, 0);
+    }
+
+    // Reader on the other core, this task consumes
+    if (xTaskCreatePinnedToCore(readerTask, "DumpReader", READER_STACK, this, 1, nullptr, READER_CORE) != pdPASS) {
+        terminalView.println("\nDump failed: Could not start the reader task.");
+        releaseJob();
+        return false;
+    }
+
+    bool completed = true;
+    while (true) {
+        uint8_t index;
+        xQueueReceive(readySlots, &index, portMAX_DELAY);
+        if (index == END_OF_DUMP) break;
+
+        // Drain without consuming once stopped, the reader owns the buffers until it ends
+        const Slot& slot = slots[index];
+        if (!stopRequested) {
+            if (!slot.ok) {
+                char message[48];
+                snprintf(message, sizeof(message), "\nRead failed at 0x%06X", (unsigned)slot.address);
+                terminalView.println(message);
+                stopRequested = true;
+                completed = false;
+            } else if (!consume(slot.address, &buffers[index * chunkSize], slot.length)) {
+                stopRequested = true;
+                completed = false;
+            }
+        }
+
+        xQueueSend(freeSlots, &index, portMAX_DELAY);
+    }
+
+    // Reader is done
+    releaseJob();
+    return completed;
+}
+
+void DumpPipelineManager::releaseJob() {
+    if (freeSlots) vQueueDelete(freeSlots);
+    if (readySlots) vQueueDelete(readySlots);
+    freeSlots = nullptr;
+    readySlots = nullptr;
+    fetch = nullptr;
+    std::vector<uint8_t>().swap(buffers);
+}
+
+/*
+Reader Task
+*/
+void DumpPipelineManager::readerTask(void* param) {
+    auto* self = static_cast<DumpPipelineManager*>(param);
+    self->readChunks();
+    vTaskDelete(nullptr);
+}
+
+void DumpPipelineManager::readChunks() {
+    uint32_t offset = 0;
+
+    while (offset < length && !stopRequested) {
+        uint8_t index;
+        xQueueReceive(freeSlots, &index, portMAX_DELAY);
+
+        Slot& slot = slots[index];
+        slot.address = start + offset;
+        slot.length = std::min(chunkSize, length - offset);
+        slot.ok = fetch(slot.address, &buffers[index * chunkSize], slot.length);
+        offset += slot.length;
+
+        xQueueSend(readySlots, &index, portMAX_DELAY);
+        if (!slot.ok) break;
+    }
+
+    uint8_t end = END_OF_DUMP;
+    xQueueSend(readySlots, &end, portMAX_DELAY);
+}
+
+/*
+Format Line
+*/
+size_t DumpPipelineManager::formatLine(char* out, uint32_t address, const uint8_t* data, size_t len, uint8_t wordSize) {
+    static const char hex[] = "0123456789ABCDEF";
+    char* p = out;
+
+    // Address
+    for (int shift = 20; shift >= 0; shift -= 4) {
+        *p++ = hex[(address >> shift) & 0x0F];
+    }
+    *p++ = ':';
+    *p++ = ' ';
+
+    // Hex, 16 bytes or 8 words per line
+    const size_t columns = wordSize == 2 ? 8 : 16;
+    const size_t count = wordSize == 2 ? len / 2 : len;
+    for (size_t i = 0; i < columns; ++i) {
+        if (i < count) {
+            for (size_t b = 0; b < wordSize; ++b) {
+                uint8_t v = data[i * wordSize + b];
+                *p++ = hex[v >> 4];
+                *p++ = hex[v & 0x0F];
+            }
+            *p++ = ' ';
+        } else {
+            for (size_t b = 0; b < wordSize * 2u + 1; ++b) *p++ = ' ';
+        }
+    }
+
+    // ASCII
+    *p++ = ' ';
+    for (size_t i = 0; i < count * wordSize; ++i) {
+        uint8_t c = data[i];
+        *p++ = (c >= 32 && c <= 126) ? static_cast<char>(c) : '.';
+    }
+
+    return p - out;
+}
+
+/*
+CRC32
+*/
+uint32_t DumpPipelineManager::crc32(uint32_t crc, const uint8_t* data, size_t len) {
+    static uint32_t table[256];
+    static bool tableReady = false;
+    if (!tableReady) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            table[i] = c;
+        }
+        tableReady = true;
+    }
+
+    crc = ~crc;
+    for (size_t i = 0; i < len; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
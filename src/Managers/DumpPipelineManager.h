@@ -0,0 +1,111 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <functional>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <esp_heap_caps.h>
+#include "Interfaces/IInput.h"
+#include "Interfaces/ITerminalView.h"
+#include "Services/SdService.h"
+#include "States/GlobalState.h"
+#include "Enums/DumpOutputEnum.h"
+
+/*
+Memory dump pipeline shared by the memory shells.
+
+A reader task fills a ring of chunks from the bus while the calling
+task formats and prints (or writes) the previous ones, so bus time and
+output time overlap instead of adding up.
+*/
+class DumpPipelineManager {
+public:
+    // Read len bytes at address into buffer, false on bus error
+    using FetchFn = std::function<bool(uint32_t address, uint8_t* buffer, uint32_t len)>;
+
+    DumpPipelineManager(ITerminalView& view, IInput& input, SdService& sdService);
+
+    // Hex lines, wordSize 2 prints big endian 16-bit words.
+    // Returns false when stopped with ENTER or on read error
+    bool dump(
+        uint32_t start,
+        uint32_t length,
+        FetchFn fetch,
+        uint32_t chunkSize = 1024,
+        uint8_t wordSize = 1
+    );
+
+    // Raw image to a file on the SD card (mounted on the SPI pins with sdCsPin).
+    // devicePins are the pins fetch drives, when one of them is an SD pin the
+    // image is read in full before the card is mounted
+    bool dumpToSd(
+        uint32_t start,
+        uint32_t length,
+        FetchFn fetch,
+        const std::string& path,
+        uint8_t sdCsPin,
+        uint32_t chunkSize = 4096,
+        const std::vector<uint8_t>& devicePins = {}
+    );
+
+    // True when one of the pins is used by the SD card
+    bool sharesSdBus(const std::vector<uint8_t>& devicePins, uint8_t sdCsPin) const;
+
+    // Raw image to the USB serial terminal as binary frames:
+    //   frame   A5 5A | offset u32 LE | len u16 LE | payload
+    //   trailer A5 5A | total u32 LE  | 00 00      | crc32 u32 LE
+    bool dumpToTerminal(uint32_t start, uint32_t length, FetchFn fetch, uint32_t chunkSize = 1024);
+
+    // Format one line of up to 16 bytes (8 words), returns the line length
+    static size_t formatLine(char* out, uint32_t address, const uint8_t* data, size_t len, uint8_t wordSize = 1);
+
+    // CRC-32 (IEEE, zlib compatible), chain calls by passing the previous result
+    static uint32_t crc32(uint32_t crc, const uint8_t* data, size_t len);
+
+    // Consume one chunk, false to stop the dump
+    using ConsumeFn = std::function<bool(uint32_t address, const uint8_t* data, uint32_t len)>;
+
+    // Generic pipelined read, chunks are handed to consume in address order.
+    // Returns false when consume stops it or on read error
+    bool stream(uint32_t start, uint32_t length, FetchFn fetch, uint32_t chunkSize, ConsumeFn consume);
+
+private:
+    struct Slot {
+        uint32_t address;
+        uint32_t length;
+        bool ok;
+    };
+
+    static constexpr uint8_t SLOT_COUNT = 4;
+    static constexpr uint8_t END_OF_DUMP = 0xFF;
+    static constexpr uint32_t READER_STACK = 6144;
+    static constexpr BaseType_t READER_CORE = 0;
+    static constexpr size_t LINE_MAX = 96;
+    static constexpr uint8_t FRAME_SYNC[2] = { 0xA5, 0x5A };
+
+    ITerminalView& terminalView;
+    IInput& terminalInput;
+    SdService& sdService;
+    GlobalState& state = GlobalState::getInstance();
+
+    // Current job, only valid during stream()
+    FetchFn fetch;
+    uint32_t start = 0;
+    uint32_t length = 0;
+    uint32_t chunkSize = 0;
+    std::vector<uint8_t> buffers;
+    Slot slots[SLOT_COUNT];
+    QueueHandle_t freeSlots = nullptr;
+    QueueHandle_t readySlots = nullptr;
+    std::atomic<bool> stopRequested{false};
+
+    bool stopPressed();
+    bool readImage(uint32_t start, uint32_t length, FetchFn fetch, uint32_t chunkSize, uint8_t* image);
+    void writeFrameHeader(uint32_t offset, uint16_t len);
+    static void readerTask(void* param);
+    void readChunks();
+    void releaseJob(); // queues and buffers of the current job
+};
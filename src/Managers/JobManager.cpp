@@ -0,0 +1,330 @@
+#include "JobManager.h"
+
+/*
+Job
+*/
+Job::Job(uint8_t id, const std::string& command, ModeEnum mode, size_t capacity)
+    : id(id), command(command), mode(mode), startedMs(millis()), ring(capacity) {}
+
+/*
+Job Print, overwrites the oldest output when the ring is full
+*/
+void Job::print(const std::string& text) {
+    write(text.data(), text.size());
+}
+
+void Job::println(const std::string& text) {
+    write(text.data(), text.size());
+    write("\n", 1);
+}
+
+void Job::write(const char* data, uint32_t length) {
+    const uint32_t size = ring.size();
+
+    // Only the end of a chunk larger than the ring can survive
+    uint32_t skipped = 0;
+    if (length > size) {
+        skipped = length - size;
+        data += skipped;
+        length = size;
+    }
+
+    portENTER_CRITICAL(&mux);
+    dropped += skipped;
+    uint32_t overflow = head + length - tail;
+    if (overflow > size) {
+        dropped += overflow - size;
+        tail += overflow - size;
+    }
+    for (uint32_t i = 0; i < length; ++i) ring[(head + i) % size] = data[i];
+    head += length;
+    portEXIT_CRITICAL(&mux);
+}
+
+/*
+Job Poll
+*/
+bool Job::poll() {
+    // Capture loops spin, a real wait lets the idle task and the radio stacks of this core run
+    uint32_t now = millis();
+    if (now - lastBlockMs >= BUSY_SLICE_MS) {
+        vTaskDelay(1);
+        lastBlockMs = millis();
+    }
+    return !stopping.load(std::memory_order_relaxed);
+}
+
+/*
+Job Drain
+*/
+uint32_t Job::drain(std::string& out) {
+    const uint32_t size = ring.size();
+
+    portENTER_CRITICAL(&mux);
+    uint32_t count = head - tail;
+    size_t start = out.size();
+    out.resize(start + count);
+    for (uint32_t i = 0; i < count; ++i) out[start + i] = ring[(tail + i) % size];
+    tail = head;
+    uint32_t lost = dropped;
+    dropped = 0;
+    portEXIT_CRITICAL(&mux);
+
+    return lost;
+}
+
+size_t Job::buffered() {
+    portENTER_CRITICAL(&mux);
+    size_t count = head - tail;
+    portEXIT_CRITICAL(&mux);
+    return count;
+}
+
+/*
+Foreground output, the terminal until [ENTER]
+*/
+class TerminalJobOutput : public IJobOutput {
+public:
+    TerminalJobOutput(ITerminalView& view, IInput& input) : view(view), input(input) {}
+
+    void print(const std::string& text) override { view.print(text); }
+    void println(const std::string& text) override { view.println(text); }
+
+    // Input is checked every INPUT_CHECK_MS, fast capture loops stay fast
+    bool poll() override {
+        uint32_t now = millis();
+        if (now - lastCheck < INPUT_CHECK_MS) return true;
+        lastCheck = now;
+        char c = input.readChar();
+        return c != '\r' && c != '\n';
+    }
+
+private:
+    static constexpr uint32_t INPUT_CHECK_MS = 10;
+    ITerminalView& view;
+    IInput& input;
+    uint32_t lastCheck = millis();
+};
+
+/*
+Constructor
+*/
+JobManager::JobManager(ITerminalView& terminalView, IInput& terminalInput)
+    : terminalView(terminalView), terminalInput(terminalInput) {}
+
+/*
+Run
+*/
+bool JobManager::run(const std::string& title, const std::vector<uint8_t>& resources, const Body& body) {
+    if (backgroundRequested) {
+        backgroundRequested = false;
+        start(title, resources, body);
+        return false;
+    }
+
+    terminalView.println(title + "... Press [ENTER] to stop.\n");
+    TerminalJobOutput output(terminalView, terminalInput);
+    body(output);
+    return true;
+}
+
+/*
+Background Request
+*/
+void JobManager::requestBackground(const std::string& command) {
+    pendingCommand = command;
+    backgroundRequested = true;
+}
+
+bool JobManager::cancelBackground() {
+    bool pending = backgroundRequested;
+    backgroundRequested = false;
+    pendingCommand.clear();
+    return pending;
+}
+
+/*
+Start a job task
+*/
+void JobManager::start(const std::string& title, const std::vector<uint8_t>& resources, const Body& body) {
+    // Forget killed jobs whose task has ended since
+    releaseEnded();
+    for (size_t i = jobs.size(); i-- > 0;) {
+        if (jobs[i]->stopping && jobs[i]->finished) jobs.erase(jobs.begin() + i);
+    }
+
+    if (jobs.size() >= MAX_JOBS) {
+        terminalView.println("bg: Too many jobs, kill one first.");
+        return;
+    }
+
+    auto& ownership = state.getPinOwnership();
+    uint8_t holder = ownership.holderOf(resources);
+    if (holder) {
+        terminalView.println("bg: Pins in use by job [" + std::to_string(holder) + "], kill it first.");
+        return;
+    }
+
+    std::unique_ptr<Job> job(new Job(nextId, pendingCommand, state.getCurrentMode(), RING_SIZE));
+    job->body = body;
+    job->resources = resources;
+
+    std::string name = "Job" + std::to_string(job->id);
+    if (xTaskCreatePinnedToCore(jobTask, name.c_str(), JOB_STACK, job.get(), JOB_PRIORITY, nullptr, JOB_CORE) != pdPASS) {
+        terminalView.println("bg: Failed to start the job task.");
+        return;
+    }
+    ownership.hold(job->id, job->resources);
+    job->holding = true;
+
+    terminalView.println("[" + std::to_string(job->id) + "] " + title + ", running in background.");
+    terminalView.println("Use 'fg " + std::to_string(job->id) + "' to watch it, 'kill " + std::to_string(job->id) + "' to stop it.");
+    jobs.push_back(std::move(job));
+
+    // Ids stay short, skipping the ones still in use
+    do {
+        nextId = nextId == 99 ? 1 : nextId + 1;
+    } while (find(nextId));
+}
+
+/*
+Job task, runs the capture then ends
+*/
+void JobManager::jobTask(void* param) {
+    auto* job = static_cast<Job*>(param);
+    job->body(*job);
+    job->body = nullptr;
+    job->finished.store(true); // the job may be freed from here
+    vTaskDelete(nullptr);
+}
+
+/*
+Attach
+*/
+bool JobManager::attach(uint8_t id) {
+    Job* job = find(id);
+    if (!job) return false;
+
+    std::string label = "[" + std::to_string(id) + "] ";
+    terminalView.println(label + ModeEnumMapper::toString(job->mode) + " " + job->command + "... Press [ENTER] to detach.\n");
+
+    std::string chunk;
+    while (true) {
+        // Checked before draining, so the last output is printed
+        bool done = job->finished.load();
+
+        chunk.clear();
+        uint32_t lost = job->drain(chunk);
+        if (lost) terminalView.println("\n" + label + std::to_string(lost) + " bytes dropped while detached");
+        if (!chunk.empty()) terminalView.print(chunk);
+
+        if (done) {
+            terminalView.println("\n" + label + "Done.");
+            remove(job);
+            return true;
+        }
+
+        char c = terminalInput.waitChar(ATTACH_WAIT_MS);
+        if (c == '\r' || c == '\n') {
+            terminalView.println("\n" + label + "Still running in background.");
+            return true;
+        }
+    }
+}
+
+/*
+Kill
+*/
+bool JobManager::kill(uint8_t id) {
+    Job* job = find(id);
+    if (!job) return false;
+
+    job->stopping.store(true);
+    uint32_t start = millis();
+    while (!job->finished.load() && millis() - start < KILL_TIMEOUT_MS) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+
+    // A capture stuck in a blocking call is forgotten once its task ends
+    if (job->finished.load()) remove(job);
+    return true;
+}
+
+/*
+List
+*/
+std::vector<JobStatus> JobManager::list() {
+    std::vector<JobStatus> statuses;
+    uint32_t now = millis();
+    for (auto& job : jobs) {
+        if (job->stopping) continue;
+        statuses.push_back({
+            job->id,
+            job->command,
+            job->mode,
+            !job->finished.load(),
+            job->buffered(),
+            (now - job->startedMs) / 1000
+        });
+    }
+    return statuses;
+}
+
+/*
+Busy
+*/
+bool JobManager::isBusy(ModeEnum mode) {
+    for (auto& job : jobs) {
+        if (job->mode == mode && job->holding && !job->finished.load()) return true;
+    }
+    return false;
+}
+
+bool JobManager::isBusy() {
+    for (auto& job : jobs) {
+        if (job->holding && !job->finished.load()) return true;
+    }
+    return false;
+}
+
+/*
+Release Ended, resources go back once the task is gone
+*/
+std::vector<ModeEnum> JobManager::releaseEnded() {
+    for (auto& job : jobs) {
+        if (job->holding && job->finished.load()) release(*job);
+    }
+    std::vector<ModeEnum> modes;
+    modes.swap(endedModes);
+    return modes;
+}
+
+void JobManager::release(Job& job) {
+    state.getPinOwnership().unhold(job.id);
+    job.holding = false;
+    endedModes.push_back(job.mode);
+}
+
+uint8_t JobManager::lastId() {
+    for (size_t i = jobs.size(); i-- > 0;) {
+        if (!jobs[i]->stopping) return jobs[i]->id;
+    }
+    return 0;
+}
+
+Job* JobManager::find(uint8_t id) {
+    for (auto& job : jobs) {
+        if (job->id == id && !job->stopping) return job.get();
+    }
+    return nullptr;
+}
+
+void JobManager::remove(Job* job) {
+    if (job->holding) release(*job);
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        if (jobs[i].get() == job) {
+            jobs.erase(jobs.begin() + i);
+            return;
+        }
+    }
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Interfaces/IJobOutput.h"
+#include "Interfaces/ITerminalView.h"
+#include "Interfaces/IInput.h"
+#include "Enums/ModeEnum.h"
+#include "States/GlobalState.h"
+
+/*
+A capture running as a background task. Its output goes to a ring
+buffer, the oldest bytes are overwritten while nobody reads it.
+*/
+class Job : public IJobOutput {
+public:
+    Job(uint8_t id, const std::string& command, ModeEnum mode, size_t capacity);
+
+    void print(const std::string& text) override;
+    void println(const std::string& text) override;
+
+    // Blocks a tick every BUSY_SLICE_MS of running, false once a kill was requested
+    bool poll() override;
+
+    // Move the buffered output into out, returns the bytes lost since the last drain
+    uint32_t drain(std::string& out);
+    size_t buffered();
+
+    const uint8_t id;
+    const std::string command;
+    const ModeEnum mode;
+    const uint32_t startedMs;
+
+    std::function<void(IJobOutput&)> body;
+    std::vector<uint8_t> resources; // pins and buses held while the task runs
+    bool holding = false;           // shell side only
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> finished{false};
+
+private:
+    std::vector<char> ring;
+    uint32_t head = 0; // free running indexes
+    uint32_t tail = 0;
+    uint32_t dropped = 0;
+    uint32_t lastBlockMs = 0;
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+    static constexpr uint32_t BUSY_SLICE_MS = 5;
+
+    void write(const char* data, uint32_t length);
+};
+
+struct JobStatus {
+    uint8_t id;
+    std::string command;
+    ModeEnum mode;
+    bool running;
+    size_t buffered;
+    uint32_t seconds;
+};
+
+/*
+Background jobs of the shell.
+
+Controllers hand their capture loops to run() with the pins and buses
+they drive. After 'bg <command>'
+the loop becomes a task pinned to JOB_CORE, the core the Arduino loop
+and its shell do not run on, writing into its job ring. Otherwise it
+runs on the shell until [ENTER] as before.
+
+A background job holds its resources in PinOwnership until it ends, and
+the shell refuses the commands of its mode meanwhile: the services are
+not shared between tasks.
+*/
+class JobManager {
+public:
+    using Body = std::function<void(IJobOutput&)>;
+
+    JobManager(ITerminalView& terminalView, IInput& terminalInput);
+
+    // Run a capture, in the background when bg asked for it.
+    // Returns true when it ran in the foreground and has ended
+    bool run(const std::string& title, const std::vector<uint8_t>& resources, const Body& body);
+
+    // The next run goes to the background, under this command line
+    void requestBackground(const std::string& command);
+
+    // Drop a request no capture consumed, true if there was one
+    bool cancelBackground();
+
+    // Stream a job output until [ENTER], the job keeps running
+    bool attach(uint8_t id);
+
+    // Stop a job and forget it, false for an unknown id
+    bool kill(uint8_t id);
+
+    // Running and finished jobs
+    std::vector<JobStatus> list();
+
+    // A job still runs in this mode, its services are in use
+    bool isBusy(ModeEnum mode);
+
+    // A job still runs in any mode
+    bool isBusy();
+
+    // Give back the resources of the jobs ended since the last call, returns their modes
+    std::vector<ModeEnum> releaseEnded();
+
+    // Most recent job, 0 for none
+    uint8_t lastId();
+
+    static constexpr size_t MAX_JOBS = 4;
+    static constexpr size_t RING_SIZE = 4096;
+
+private:
+    ITerminalView& terminalView;
+    IInput& terminalInput;
+    GlobalState& state = GlobalState::getInstance();
+    std::vector<std::unique_ptr<Job>> jobs;
+    std::string pendingCommand;
+    std::vector<ModeEnum> endedModes; // released, not reported yet
+    bool backgroundRequested = false;
+    uint8_t nextId = 1;
+
+    static constexpr BaseType_t JOB_CORE = 0; // the loop task is on core 1
+    static constexpr uint32_t JOB_STACK = 8192;
+    static constexpr UBaseType_t JOB_PRIORITY = 1;
+    static constexpr uint32_t ATTACH_WAIT_MS = 20;
+    static constexpr uint32_t KILL_TIMEOUT_MS = 1000;
+
+    static void jobTask(void* param);
+    Job* find(uint8_t id);
+    void remove(Job* job);
+    void release(Job& job);
+    void start(const std::string& title, const std::vector<uint8_t>& resources, const Body& body);
+};
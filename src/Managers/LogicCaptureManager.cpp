@@ -0,0 +1,117 @@
+#include "LogicCaptureManager.h"
+
+/*
+Constructor
+*/
+LogicCaptureManager::LogicCaptureManager(LogicCaptureService& captureService)
+    : captureService(captureService) {}
+
+/*
+Capture
+*/
+bool LogicCaptureManager::capture(const std::vector<uint8_t>& pins, uint32_t rate, const LogicTrigger& trigger,
+                                  size_t preSamples, uint64_t postSamples, const std::function<bool()>& shouldStop) {
+    if (rate == 0 || rate > MAX_SAMPLE_RATE || !captureService.setChannels(pins)) return false;
+
+    // Paced on the cycle counter, late samples catch up so sample n stays at n / rate
+    const uint32_t cyclesPerSecond = ESP.getCpuFreqMHz() * 1000000;
+    const uint32_t period = cyclesPerSecond / rate;
+    this->pins = pins;
+    sampleRate = cyclesPerSecond / period;
+    lateSamples = 0;
+    begin(trigger, preSamples, postSamples);
+
+    // shouldStop runs every STOP_CHECK_MS of samples whatever the rate
+    const uint32_t checkEvery = std::max<uint32_t>(1, sampleRate / (1000 / STOP_CHECK_MS));
+    uint32_t next = ESP.getCycleCount();
+    uint32_t sinceCheck = 0;
+    while (true) {
+        while (static_cast<int32_t>(ESP.getCycleCount() - next) < 0) {
+        }
+        if (static_cast<int32_t>(ESP.getCycleCount() - next) >= static_cast<int32_t>(period)) lateSamples++;
+        next += period;
+
+        if (!push(captureService.readChannels())) return true;
+
+        if (++sinceCheck == checkEvery) {
+            sinceCheck = 0;
+            if (shouldStop()) break;
+        }
+    }
+
+    // Stopped, keep what was captured
+    if (!triggered) {
+        unroll();
+        triggerIndex = result.size();
+    }
+    return false;
+}
+
+/*
+Begin
+*/
+void LogicCaptureManager::begin(const LogicTrigger& trigger, size_t preSamples, uint64_t postSamples) {
+    result.reset(captureBudget());
+
+    condition = trigger;
+    ring.assign(std::min(preSamples, MAX_PRE_SAMPLES), 0);
+    ringPos = 0;
+    ringFill = 0;
+    expected = std::max<uint64_t>(1, postSamples);
+    triggerIndex = 0;
+    primed = false;
+    triggered = false;
+    pulseStarted = false;
+    pulseWidth = 0;
+}
+
+/*
+Trigger, the ring becomes the start of the capture
+*/
+void LogicCaptureManager::trigger(uint8_t sample) {
+    unroll();
+    triggerIndex = result.size();
+    expected += triggerIndex;
+    result.append(sample);
+    triggered = true;
+}
+
+void LogicCaptureManager::unroll() {
+    size_t start = ringFill < ring.size() ? 0 : ringPos;
+    for (size_t i = 0; i < ringFill; ++i) {
+        size_t index = start + i;
+        result.append(ring[index < ring.size() ? index : index - ring.size()]);
+    }
+}
+
+/*
+Capture Budget, records in PSRAM when the board has some, a share of the internal heap otherwise
+*/
+size_t LogicCaptureManager::captureBudget() {
+    size_t psram = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    return psram ? std::min(psram / 2, MAX_PSRAM_BYTES) : INTERNAL_BYTES;
+}
+
+bool LogicCaptureManager::isTriggered() const {
+    return triggered;
+}
+
+const LogicCapture& LogicCaptureManager::getCapture() const {
+    return result;
+}
+
+uint64_t LogicCaptureManager::getTriggerIndex() const {
+    return triggerIndex;
+}
+
+const std::vector<uint8_t>& LogicCaptureManager::getPins() const {
+    return pins;
+}
+
+uint32_t LogicCaptureManager::getSampleRate() const {
+    return sampleRate;
+}
+
+uint32_t LogicCaptureManager::getLateSamples() const {
+    return lateSamples;
+}
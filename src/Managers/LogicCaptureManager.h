@@ -0,0 +1,122 @@
+#pragma once
+
+#include <Arduino.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Models/LogicTrigger.h"
+#include "Models/LogicCapture.h"
+#include "Services/LogicCaptureService.h"
+
+/*
+Triggered capture of up to 8 logic channels.
+
+Samples are one byte, bit n for channel n. Until the trigger fires they
+go round a ring as deep as the pre-trigger part, then the post-trigger
+part is appended as runs, so the capture shows what led to the trigger
+and an idle bus can be recorded for long.
+*/
+class LogicCaptureManager {
+public:
+    explicit LogicCaptureManager(LogicCaptureService& captureService);
+
+    // Sample the pins at rate until the capture is complete or memory is full, false if stopped
+    bool capture(const std::vector<uint8_t>& pins, uint32_t rate, const LogicTrigger& trigger,
+                 size_t preSamples, uint64_t postSamples, const std::function<bool()>& shouldStop);
+
+    // Start a capture fed by push(), eg. from recorded samples
+    void begin(const LogicTrigger& trigger, size_t preSamples, uint64_t postSamples);
+
+    // Add one sample, false once the capture is complete
+    bool push(uint8_t sample) {
+        if (triggered) {
+            return result.append(sample) && result.size() < expected;
+        }
+
+        if (!primed) {
+            previous = sample;
+            primed = true;
+        }
+
+        if (fires(sample)) {
+            trigger(sample);
+            return result.size() < expected;
+        }
+
+        if (!ring.empty()) {
+            ring[ringPos] = sample;
+            ringPos = ringPos + 1 == ring.size() ? 0 : ringPos + 1;
+            if (ringFill < ring.size()) ringFill++;
+        }
+        previous = sample;
+        return true;
+    }
+
+    bool isTriggered() const;
+
+    // Samples in time order, the trigger sample at getTriggerIndex()
+    const LogicCapture& getCapture() const;
+    uint64_t getTriggerIndex() const;
+    const std::vector<uint8_t>& getPins() const;
+    uint32_t getSampleRate() const;
+
+    // Bytes of runs a capture may use on this board
+    static size_t captureBudget();
+
+    // Samples taken after their slot during the last capture()
+    uint32_t getLateSamples() const;
+
+    static constexpr size_t MAX_PRE_SAMPLES = 65536;        // raw ring
+    static constexpr size_t MAX_PSRAM_BYTES = 4 * 1024 * 1024;
+    static constexpr size_t INTERNAL_BYTES = 48 * 1024;     // boards without PSRAM
+    static constexpr uint32_t MAX_SAMPLE_RATE = 2000000;
+    static constexpr uint32_t STOP_CHECK_MS = 10;
+
+private:
+    // Trigger condition against the previous sample, inlined in push()
+    bool fires(uint8_t sample) {
+        const uint8_t bit = 1 << condition.channel;
+        switch (condition.type) {
+            case LogicTriggerEnum::None:    return true;
+            case LogicTriggerEnum::Rising:  return (~previous & sample & bit) != 0;
+            case LogicTriggerEnum::Falling: return (previous & ~sample & bit) != 0;
+            case LogicTriggerEnum::Pattern: return (sample & condition.mask) == condition.value;
+            case LogicTriggerEnum::Pulse:   return pulseEnds(sample, bit);
+            default:                        return false;
+        }
+    }
+
+    // A pulse only counts once its start was seen
+    bool pulseEnds(uint8_t sample, uint8_t bit) {
+        if (((previous ^ sample) & bit) == 0) {
+            pulseWidth++;
+            return false;
+        }
+        bool fire = pulseStarted && ((previous & bit) != 0) == (condition.level != 0) &&
+                    pulseWidth >= condition.minWidth && pulseWidth <= condition.maxWidth;
+        pulseStarted = true;
+        pulseWidth = 1;
+        return fire;
+    }
+
+    void trigger(uint8_t sample);
+    void unroll();
+
+    LogicCaptureService& captureService;
+    LogicTrigger condition;
+    std::vector<uint8_t> ring;
+    size_t ringPos = 0;
+    size_t ringFill = 0;
+    LogicCapture result;
+    uint64_t expected = 0;
+    uint64_t triggerIndex = 0;
+    uint8_t previous = 0;
+    bool primed = false;
+    bool triggered = false;
+    bool pulseStarted = false;
+    uint32_t pulseWidth = 0;
+    std::vector<uint8_t> pins;
+    uint32_t sampleRate = 0;
+    uint32_t lateSamples = 0;
+};
@@ -0,0 +1,383 @@
+#include "MacroManager.h"
+#include <Arduino.h>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+
+MacroManager::MacroManager(NvsService& nvsService, SdService& sdService, InstructionTransformer& instructionTransformer)
+    : nvsService(nvsService), sdService(sdService), instructionTransformer(instructionTransformer) {}
+
+/*
+Define
+*/
+bool MacroManager::define(const std::string& name, const std::string& body, std::string& error) {
+    if (!isValidName(name)) {
+        error = "Invalid name, use up to 12 letters, digits or _";
+        return false;
+    }
+
+    MacroProgram program;
+    if (!compile(body, program, error)) return false;
+    cache[name] = std::move(program);
+
+    auto names = list();
+    if (std::find(names.begin(), names.end(), name) == names.end()) names.push_back(name);
+
+    nvsService.open();
+    nvsService.saveString(KEY_PREFIX + name, body);
+    nvsService.close();
+    saveIndex(names);
+    return true;
+}
+
+/*
+Remove
+*/
+bool MacroManager::remove(const std::string& name) {
+    auto names = list();
+    auto it = std::find(names.begin(), names.end(), name);
+    if (it == names.end()) return false;
+    names.erase(it);
+    cache.erase(name);
+
+    nvsService.open();
+    nvsService.remove(KEY_PREFIX + name);
+    nvsService.close();
+    saveIndex(names);
+    return true;
+}
+
+/*
+List
+*/
+std::vector<std::string> MacroManager::list() {
+    nvsService.open();
+    std::string index = nvsService.getString(KEY_INDEX, "");
+    nvsService.close();
+
+    std::vector<std::string> names;
+    size_t start = 0;
+    while (start < index.size()) {
+        size_t comma = index.find(',', start);
+        if (comma == std::string::npos) comma = index.size();
+        if (comma > start) names.push_back(index.substr(start, comma - start));
+        start = comma + 1;
+    }
+    return names;
+}
+
+std::string MacroManager::getBody(const std::string& name) {
+    nvsService.open();
+    std::string body = nvsService.getString(KEY_PREFIX + name, "");
+    nvsService.close();
+    return body;
+}
+
+void MacroManager::saveIndex(const std::vector<std::string>& names) {
+    std::string index;
+    for (const auto& name : names) {
+        if (!index.empty()) index += ",";
+        index += name;
+    }
+    nvsService.open();
+    nvsService.saveString(KEY_INDEX, index);
+    nvsService.close();
+}
+
+/*
+Import
+*/
+size_t MacroManager::importFile(const std::string& path, std::string& error) {
+    if (!sdService.isFile(path)) {
+        error = "File not found: " + path;
+        return 0;
+    }
+
+    std::string content = sdService.readFile(path);
+    size_t imported = 0;
+    size_t start = 0;
+    size_t lineNumber = 0;
+
+    while (start < content.size()) {
+        size_t end = content.find('\n', start);
+        if (end == std::string::npos) end = content.size();
+        std::string line = content.substr(start, end - start);
+        start = end + 1;
+        lineNumber++;
+
+        // Skip blanks and # comments
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t equal = line.find('=');
+        if (equal == std::string::npos) {
+            error = "Line " + std::to_string(lineNumber) + ": expected name=body";
+            return imported;
+        }
+
+        std::string lineError;
+        if (!define(line.substr(0, equal), line.substr(equal + 1), lineError)) {
+            error = "Line " + std::to_string(lineNumber) + ": " + lineError;
+            return imported;
+        }
+        imported++;
+    }
+    return imported;
+}
+
+/*
+Load, from the cache or compiled from NVS
+*/
+MacroProgram* MacroManager::load(const std::string& name, std::string& error) {
+    auto it = cache.find(name);
+    if (it != cache.end()) return &it->second;
+
+    nvsService.open();
+    bool exists = nvsService.hasKey(KEY_PREFIX + name);
+    std::string body = exists ? nvsService.getString(KEY_PREFIX + name, "") : "";
+    nvsService.close();
+
+    if (!exists) {
+        error = "Unknown macro: " + name;
+        return nullptr;
+    }
+
+    MacroProgram program;
+    if (!compile(body, program, error)) return nullptr;
+    return &(cache[name] = std::move(program));
+}
+
+/*
+Run
+*/
+bool MacroManager::run(const std::string& name, uint32_t times, const ExecuteFn& execute, const OutputFn& output,
+                       MacroRunStats& stats, std::string& error) {
+    MacroProgram* macro = load(name, error);
+    if (!macro) return false;
+
+    uint32_t values[MAX_VARIABLES] = {};
+    uint32_t counters[MAX_DEPTH];
+    const auto& steps = macro->steps;
+    uint32_t start = micros();
+
+    for (uint32_t round = 0; round < times && !stats.stopped; ++round) {
+        size_t depth = 0;
+        size_t pc = 0;
+
+        while (pc < steps.size()) {
+            const MacroStep& step = steps[pc];
+
+            switch (step.kind) {
+                case MacroStepEnum::Run: {
+                    ByteCodeProgram& program = macro->programs[step.target];
+                    if (program.hasVariables()) program.bind(values);
+                    stats.executed++;
+                    if (!output(execute(program))) {
+                        stats.stopped = true;
+                        pc = steps.size();
+                        continue;
+                    }
+                    break;
+                }
+
+                case MacroStepEnum::Set:
+                    values[step.variable] = step.value;
+                    break;
+
+                case MacroStepEnum::Add:
+                    values[step.variable] += step.value;
+                    break;
+
+                case MacroStepEnum::Repeat:
+                    if (step.value <= 0) {
+                        pc = step.target + 1;
+                        continue;
+                    }
+                    counters[depth++] = step.value;
+                    break;
+
+                case MacroStepEnum::End:
+                    if (--counters[depth - 1] > 0) {
+                        pc = step.target + 1;
+                        continue;
+                    }
+                    depth--;
+                    break;
+            }
+            pc++;
+        }
+    }
+
+    stats.elapsedUs = micros() - start;
+    return true;
+}
+
+/*
+Compile
+*/
+bool MacroManager::compile(const std::string& body, MacroProgram& program, std::string& error) const {
+    program = MacroProgram();
+    std::vector<uint16_t> open;
+    size_t number = 0;
+
+    for (std::string_view statement : splitStatements(body)) {
+        number++;
+        auto fail = [&](const std::string& message) {
+            error = "Statement " + std::to_string(number) + ": " + message;
+            return false;
+        };
+
+        if (program.steps.size() >= MAX_STEPS) return fail("macro too long");
+
+        // Instruction line
+        char first = statement[0];
+        if (first == '[' || first == '{' || first == '>') {
+            // Every $name must be declared, the transformer drops unknown ones
+            char quote = 0;
+            for (size_t i = 0; i < statement.size(); ++i) {
+                char c = statement[i];
+                if (quote) {
+                    if (c == quote) quote = 0;
+                    continue;
+                }
+                if (c == '\'' || c == '"') quote = c;
+                if (c != '$') continue;
+
+                size_t end = i + 1;
+                while (end < statement.size() && (std::isalnum(static_cast<unsigned char>(statement[end])) || statement[end] == '_')) end++;
+                if (findVariable(program.variables, statement.substr(i + 1, end - i - 1)) < 0) {
+                    return fail("unknown variable " + std::string(statement.substr(i, end - i)));
+                }
+            }
+
+            program.programs.emplace_back();
+            instructionTransformer.transform(statement, program.programs.back(), &program.variables);
+            program.steps.push_back({MacroStepEnum::Run, 0, static_cast<uint16_t>(program.programs.size() - 1), 0});
+            continue;
+        }
+
+        // Keyword statement, split in words
+        std::string_view words[3];
+        size_t count = 0;
+        size_t i = 0;
+        while (i < statement.size()) {
+            while (i < statement.size() && std::isspace(static_cast<unsigned char>(statement[i]))) i++;
+            size_t end = i;
+            while (end < statement.size() && !std::isspace(static_cast<unsigned char>(statement[end]))) end++;
+            if (end > i) {
+                if (count == 3) return fail("too many arguments");
+                words[count++] = statement.substr(i, end - i);
+            }
+            i = end;
+        }
+
+        std::string_view keyword = words[0];
+        int32_t value = 0;
+
+        if (keyword == "repeat") {
+            if (count != 2 || !parseValue(words[1], value) || value < 0) return fail("usage: repeat <count>");
+            if (open.size() >= MAX_DEPTH) return fail("loops nested too deep");
+            open.push_back(program.steps.size());
+            program.steps.push_back({MacroStepEnum::Repeat, 0, 0, value});
+        }
+
+        else if (keyword == "end") {
+            if (count != 1) return fail("usage: end");
+            if (open.empty()) return fail("end without repeat");
+            uint16_t head = open.back();
+            open.pop_back();
+            program.steps[head].target = program.steps.size();
+            program.steps.push_back({MacroStepEnum::End, 0, head, 0});
+        }
+
+        else if (keyword == "set" || keyword == "add") {
+            if (count != 3 || !parseValue(words[2], value)) return fail("usage: " + std::string(keyword) + " <variable> <value>");
+            int index = findVariable(program.variables, words[1]);
+            if (index < 0) {
+                if (keyword == "add") return fail("unknown variable " + std::string(words[1]));
+                if (!isValidName(std::string(words[1]))) return fail("invalid variable name");
+                if (program.variables.size() >= MAX_VARIABLES) return fail("too many variables");
+                program.variables.emplace_back(words[1]);
+                index = program.variables.size() - 1;
+            }
+            MacroStepEnum kind = keyword == "set" ? MacroStepEnum::Set : MacroStepEnum::Add;
+            program.steps.push_back({kind, static_cast<uint8_t>(index), 0, value});
+        }
+
+        else {
+            return fail("unknown statement '" + std::string(keyword) + "'");
+        }
+    }
+
+    if (!open.empty()) {
+        error = "repeat without end";
+        return false;
+    }
+    if (program.programs.empty()) {
+        error = "Macro has no instruction";
+        return false;
+    }
+    return true;
+}
+
+/*
+Helpers
+*/
+std::vector<std::string_view> MacroManager::splitStatements(std::string_view body) {
+    std::vector<std::string_view> statements;
+    char quote = 0;
+    size_t start = 0;
+
+    for (size_t i = 0; i <= body.size(); ++i) {
+        char c = i < body.size() ? body[i] : ';';
+        if (quote) {
+            if (c == quote) quote = 0;
+            if (i < body.size()) continue;
+        }
+        if (c == '\'' || c == '"') {
+            quote = c;
+            continue;
+        }
+        if (c != ';' && c != '\n') continue;
+
+        // Trimmed, empty statements dropped
+        std::string_view statement = body.substr(start, i - start);
+        while (!statement.empty() && std::isspace(static_cast<unsigned char>(statement.front()))) statement.remove_prefix(1);
+        while (!statement.empty() && std::isspace(static_cast<unsigned char>(statement.back()))) statement.remove_suffix(1);
+        if (!statement.empty()) statements.push_back(statement);
+        start = i + 1;
+    }
+    return statements;
+}
+
+bool MacroManager::parseValue(std::string_view text, int32_t& value) {
+    bool negative = !text.empty() && text[0] == '-';
+    if (negative) text.remove_prefix(1);
+
+    int base = 10;
+    if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        text.remove_prefix(2);
+        base = 16;
+    }
+
+    uint32_t parsed = 0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), parsed, base);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size() || text.empty()) return false;
+
+    value = negative ? -static_cast<int32_t>(parsed) : static_cast<int32_t>(parsed);
+    return true;
+}
+
+int MacroManager::findVariable(const std::vector<std::string>& variables, std::string_view name) {
+    for (size_t i = 0; i < variables.size(); ++i) {
+        if (variables[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+bool MacroManager::isValidName(const std::string& name) {
+    if (name.empty() || name.size() > MAX_NAME_LENGTH) return false;
+    return std::all_of(name.begin(), name.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    });
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Models/MacroProgram.h"
+#include "Services/NvsService.h"
+#include "Services/SdService.h"
+#include "Transformers/InstructionTransformer.h"
+
+/*
+Named macros, saved in NVS and compiled once into bytecode programs.
+
+Body statements are separated by ';' or new lines:
+  [0x9F r:3]         instruction line, $var and $var.1-3 write variable bytes
+  set addr 0x1000    assign a variable
+  add addr 256       add to a variable, negative allowed
+  repeat 16 ... end  counted loop, nestable
+*/
+class MacroManager {
+public:
+    // Runs one compiled line on the current bus, returns the read bytes
+    using ExecuteFn = std::function<std::string(const ByteCodeProgram&)>;
+
+    // Receives each read result, false stops the macro
+    using OutputFn = std::function<bool(const std::string&)>;
+
+    MacroManager(NvsService& nvsService, SdService& sdService, InstructionTransformer& instructionTransformer);
+
+    // Compile, cache and save a macro
+    bool define(const std::string& name, const std::string& body, std::string& error);
+
+    // Remove from NVS and the cache
+    bool remove(const std::string& name);
+
+    // Saved names, with their bodies
+    std::vector<std::string> list();
+    std::string getBody(const std::string& name);
+
+    // Define every "name=body" line of a text file on the SD card
+    size_t importFile(const std::string& path, std::string& error);
+
+    // Run a macro times times, variables start at 0
+    bool run(const std::string& name, uint32_t times, const ExecuteFn& execute, const OutputFn& output,
+             MacroRunStats& stats, std::string& error);
+
+    // Compile a body without saving it
+    bool compile(const std::string& body, MacroProgram& program, std::string& error) const;
+
+    static bool isValidName(const std::string& name);
+
+private:
+    NvsService& nvsService;
+    SdService& sdService;
+    InstructionTransformer& instructionTransformer;
+    std::map<std::string, MacroProgram> cache;
+
+    static constexpr size_t MAX_NAME_LENGTH = 12;   // NVS keys are 15 chars, "m." prefix
+    static constexpr size_t MAX_VARIABLES = 8;
+    static constexpr size_t MAX_DEPTH = 8;
+    static constexpr size_t MAX_STEPS = 512;
+    static constexpr const char* KEY_PREFIX = "m.";
+    static constexpr const char* KEY_INDEX = "m.index";
+
+    MacroProgram* load(const std::string& name, std::string& error);
+    void saveIndex(const std::vector<std::string>& names);
+    static std::vector<std::string_view> splitStatements(std::string_view body);
+    static bool parseValue(std::string_view text, int32_t& value);
+    static int findVariable(const std::vector<std::string>& variables, std::string_view name);
+};
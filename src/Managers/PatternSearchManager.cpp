@@ -0,0 +1,258 @@
+#include "PatternSearchManager.h"
+#include <algorithm>
+#include <cctype>
+
+/*
+Patterns
+*/
+bool PatternSearchManager::addPattern(const std::string& spec, bool caseInsensitive) {
+    std::vector<int16_t> bytes;
+
+    for (size_t i = 0; i < spec.size(); ++i) {
+        if (spec[i] != '{') {
+            bytes.push_back(static_cast<uint8_t>(spec[i]));
+            continue;
+        }
+
+        // Hex group
+        size_t close = spec.find('}', i);
+        if (close == std::string::npos) return false;
+
+        std::string digits;
+        for (size_t j = i + 1; j < close; ++j) {
+            if (!std::isspace(static_cast<unsigned char>(spec[j]))) digits += spec[j];
+        }
+        if (digits.empty() || digits.size() % 2) return false;
+
+        for (size_t j = 0; j < digits.size(); j += 2) {
+            if (digits[j] == '?' && digits[j + 1] == '?') {
+                bytes.push_back(WILDCARD);
+            } else if (std::isxdigit(static_cast<unsigned char>(digits[j])) && std::isxdigit(static_cast<unsigned char>(digits[j + 1]))) {
+                bytes.push_back(static_cast<int16_t>(std::stoi(digits.substr(j, 2), nullptr, 16)));
+            } else {
+                return false;
+            }
+        }
+        i = close;
+    }
+
+    return addBytes(bytes, caseInsensitive, spec);
+}
+
+bool PatternSearchManager::addBytes(const std::vector<int16_t>& bytes, bool caseInsensitive, const std::string& label) {
+    if (bytes.empty() || bytes.size() > MAX_PATTERN_LENGTH) return false;
+
+    // Longest fixed run
+    size_t bestStart = 0, bestLength = 0;
+    for (size_t i = 0; i < bytes.size();) {
+        if (bytes[i] == WILDCARD) { ++i; continue; }
+        size_t j = i;
+        while (j < bytes.size() && bytes[j] != WILDCARD) ++j;
+        if (j - i > bestLength) {
+            bestStart = i;
+            bestLength = j - i;
+        }
+        i = j;
+    }
+    if (bestLength == 0) return false;
+
+    bool hasWildcard = bestLength != bytes.size();
+    bool hasLetter = std::any_of(bytes.begin(), bytes.end(), [](int16_t b) {
+        return b != WILDCARD && std::isalpha(b);
+    });
+
+    Pattern pattern;
+    pattern.label = label;
+    pattern.bytes = bytes;
+    pattern.caseInsensitive = caseInsensitive;
+    pattern.verify = hasWildcard || (!caseInsensitive && hasLetter);
+    pattern.keyStart = bestStart;
+    pattern.keyLength = bestLength;
+    patterns.push_back(pattern);
+    return true;
+}
+
+void PatternSearchManager::clear() {
+    patterns.clear();
+    transitions.clear();
+    firstOutput.clear();
+    outputs.clear();
+    classOf.fill(0);
+    classCount = 1;
+    reset();
+}
+
+/*
+Compile
+*/
+bool PatternSearchManager::compile() {
+    // Byte classes, case folded, bytes absent from every key share class 0
+    std::array<uint8_t, 256> foldedClass{};
+    classCount = 1;
+    for (const auto& p : patterns) {
+        for (size_t i = 0; i < p.keyLength; ++i) {
+            uint8_t b = fold(static_cast<uint8_t>(p.bytes[p.keyStart + i]));
+            if (!foldedClass[b]) foldedClass[b] = classCount++;
+        }
+    }
+    for (int b = 0; b < 256; ++b) {
+        classOf[b] = foldedClass[fold(static_cast<uint8_t>(b))];
+    }
+
+    // Trie of the keys
+    std::vector<int32_t> go(classCount, -1);
+    std::vector<int32_t> own(1, -1);
+    outputs.clear();
+
+    for (uint16_t index = 0; index < patterns.size(); ++index) {
+        const auto& p = patterns[index];
+        int32_t node = 0;
+        for (size_t i = 0; i < p.keyLength; ++i) {
+            uint8_t c = classOf[static_cast<uint8_t>(p.bytes[p.keyStart + i])];
+            int32_t& child = go[node * classCount + c];
+            if (child < 0) {
+                child = static_cast<int32_t>(own.size());
+                own.push_back(-1);
+                go.resize(go.size() + classCount, -1);
+            }
+            node = go[node * classCount + c];
+        }
+        outputs.push_back({index, own[node]});
+        own[node] = static_cast<int32_t>(outputs.size() - 1);
+    }
+
+    size_t states = own.size();
+    if (states > 0xFFFF) return false;
+
+    // Failure links in BFS order, completing the DFA and chaining outputs
+    std::vector<int32_t> fail(states, 0);
+    std::vector<int32_t> queue;
+    queue.reserve(states);
+    firstOutput.assign(states, -1);
+    firstOutput[0] = own[0];
+
+    for (uint16_t c = 0; c < classCount; ++c) {
+        int32_t& child = go[c];
+        if (child < 0) {
+            child = 0;
+        } else {
+            fail[child] = 0;
+            queue.push_back(child);
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int32_t node = queue[head];
+
+        // Own outputs first, then the ones of the longest proper suffix
+        if (own[node] >= 0) {
+            int32_t last = own[node];
+            while (outputs[last].next >= 0) last = outputs[last].next;
+            outputs[last].next = firstOutput[fail[node]];
+            firstOutput[node] = own[node];
+        } else {
+            firstOutput[node] = firstOutput[fail[node]];
+        }
+
+        for (uint16_t c = 0; c < classCount; ++c) {
+            int32_t& child = go[node * classCount + c];
+            if (child < 0) {
+                child = go[fail[node] * classCount + c];
+            } else {
+                fail[child] = go[fail[node] * classCount + c];
+                queue.push_back(child);
+            }
+        }
+    }
+
+    transitions.assign(go.begin(), go.end());
+
+    // History long enough to verify the longest pattern
+    size_t longest = 1;
+    for (const auto& p : patterns) longest = std::max(longest, p.bytes.size());
+    size_t historySize = 1;
+    while (historySize < longest) historySize <<= 1;
+    history.assign(historySize, 0);
+    historyMask = historySize - 1;
+
+    reset(streamStart);
+    return true;
+}
+
+/*
+Stream
+*/
+void PatternSearchManager::reset(uint32_t startOffset) {
+    state = 0;
+    position = startOffset;
+    streamStart = startOffset;
+    pending.clear();
+}
+
+void PatternSearchManager::feed(const uint8_t* data, size_t len, const MatchFn& onMatch) {
+    if (firstOutput.empty()) return;
+
+    const uint16_t* table = transitions.data();
+    const int32_t* out = firstOutput.data();
+    uint8_t* ring = history.data();
+    const uint16_t classes = classCount;
+    uint16_t s = state;
+
+    for (size_t i = 0; i < len; ++i) {
+        uint8_t b = data[i];
+        ring[position & historyMask] = b;
+        s = table[s * classes + classOf[b]];
+
+        if (out[s] >= 0) emit(out[s], onMatch);
+        if (!pending.empty()) resolvePending(onMatch);
+        ++position;
+    }
+
+    state = s;
+}
+
+void PatternSearchManager::emit(int32_t output, const MatchFn& onMatch) {
+    for (; output >= 0; output = outputs[output].next) {
+        const auto& p = patterns[outputs[output].pattern];
+
+        // Key ends at the current byte
+        uint32_t keyEnd = position;
+        if (keyEnd - streamStart < static_cast<uint32_t>(p.keyStart + p.keyLength - 1)) continue;
+        uint32_t start = keyEnd - (p.keyStart + p.keyLength - 1);
+        uint32_t end = start + p.bytes.size() - 1;
+
+        if (!p.verify) {
+            onMatch({outputs[output].pattern, start, static_cast<uint16_t>(p.bytes.size())});
+        } else if (end == position) {
+            if (verify(p, start)) onMatch({outputs[output].pattern, start, static_cast<uint16_t>(p.bytes.size())});
+        } else {
+            // Trailing wildcards, wait for the rest of the pattern
+            pending.push_back({outputs[output].pattern, start, end});
+        }
+    }
+}
+
+void PatternSearchManager::resolvePending(const MatchFn& onMatch) {
+    for (size_t i = 0; i < pending.size();) {
+        if (pending[i].end != position) {
+            ++i;
+            continue;
+        }
+        const auto& p = patterns[pending[i].pattern];
+        if (verify(p, pending[i].start)) {
+            onMatch({pending[i].pattern, pending[i].start, static_cast<uint16_t>(p.bytes.size())});
+        }
+        pending[i] = pending.back();
+        pending.pop_back();
+    }
+}
+
+bool PatternSearchManager::verify(const Pattern& p, uint32_t start) const {
+    for (size_t i = 0; i < p.bytes.size(); ++i) {
+        if (p.bytes[i] == WILDCARD) continue;
+        uint8_t b = history[(start + i) & historyMask];
+        uint8_t expected = static_cast<uint8_t>(p.bytes[i]);
+        if (p.caseInsensitive ? fold(b) != fold(expected) : b != expected) return false;
+    }
+    return true;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+struct PatternMatch {
+    uint16_t pattern;  // index, in insertion order
+    uint32_t offset;   // stream offset of the first matched byte
+    uint16_t length;
+};
+
+/*
+Multi-pattern streaming search (Aho-Corasick).
+
+All patterns are compiled into one DFA over byte classes, then the
+input is scanned once, in chunks of any size: the automaton state
+carries over chunk boundaries.
+
+Pattern syntax: plain text, hex bytes in braces, ?? as a one byte
+wildcard inside braces. E.g. "ssh-rsa", "{7F 45 4C 46}", "key={?? 00}".
+Wildcard and case sensitive patterns are matched on their longest
+fixed run, then verified against the recent input.
+*/
+class PatternSearchManager {
+public:
+    using MatchFn = std::function<void(const PatternMatch& match)>;
+
+    static constexpr int16_t WILDCARD = -1;
+    static constexpr size_t MAX_PATTERN_LENGTH = 256;
+
+    // Parse and add one pattern, false on syntax error
+    bool addPattern(const std::string& spec, bool caseInsensitive = false);
+
+    // Add raw bytes, WILDCARD for any byte
+    bool addBytes(const std::vector<int16_t>& bytes, bool caseInsensitive = false, const std::string& label = "");
+
+    // Build the automaton, false if it would not fit 16-bit states
+    bool compile();
+    void clear();
+
+    // Start a new stream, offsets are reported from startOffset
+    void reset(uint32_t startOffset = 0);
+    void feed(const uint8_t* data, size_t len, const MatchFn& onMatch);
+
+    size_t patternCount() const { return patterns.size(); }
+    size_t patternLength(uint16_t index) const { return patterns[index].bytes.size(); }
+    const std::string& patternLabel(uint16_t index) const { return patterns[index].label; }
+    size_t stateCount() const { return firstOutput.size(); }
+
+private:
+    struct Pattern {
+        std::string label;
+        std::vector<int16_t> bytes;
+        bool caseInsensitive;
+        bool verify;       // wildcards or case sensitive letters
+        uint16_t keyStart; // longest fixed run, the part in the automaton
+        uint16_t keyLength;
+    };
+
+    struct Output {
+        uint16_t pattern;
+        int32_t next;
+    };
+
+    struct Pending {
+        uint16_t pattern;
+        uint32_t start;
+        uint32_t end;
+    };
+
+    std::vector<Pattern> patterns;
+
+    // Automaton
+    std::array<uint8_t, 256> classOf{};
+    uint16_t classCount = 1;
+    std::vector<uint16_t> transitions;  // state * classCount + class
+    std::vector<int32_t> firstOutput;   // per state, -1 without output
+    std::vector<Output> outputs;
+
+    // Stream
+    uint16_t state = 0;
+    uint32_t position = 0;
+    uint32_t streamStart = 0;
+    std::vector<uint8_t> history;
+    uint32_t historyMask = 0;
+    std::vector<Pending> pending;
+
+    static uint8_t fold(uint8_t c) { return (c >= 'A' && c <= 'Z') ? c + 32 : c; }
+    void emit(int32_t output, const MatchFn& onMatch);
+    void resolvePending(const MatchFn& onMatch);
+    bool verify(const Pattern& pattern, uint32_t start) const;
+};
@@ -0,0 +1,225 @@
+#include "SumpManager.h"
+
+/*
+Constructor
+*/
+SumpManager::SumpManager(LogicCaptureManager& captureManager)
+    : captureManager(captureManager) {
+    reset();
+}
+
+/*
+Serve
+*/
+uint32_t SumpManager::serve(const std::vector<uint8_t>& pins, const std::function<bool()>& shouldExit) {
+    reset();
+    uint32_t captures = 0;
+
+    while (!shouldExit()) {
+        if (!Serial.available()) {
+            delay(1);
+            continue;
+        }
+
+        uint8_t command = Serial.read();
+        if (command & 0x80) {
+            uint32_t argument;
+            if (readArgument(argument)) applyLong(command, argument);
+            continue;
+        }
+
+        switch (command) {
+            case CMD_RESET:
+                reset();
+                break;
+            case CMD_RUN:
+                if (run(pins, shouldExit)) captures++;
+                break;
+            case CMD_ID:
+                sendId();
+                break;
+            case CMD_METADATA:
+                sendMetadata(pins.size());
+                break;
+            case '\r':
+            case '\n':
+                // Not a SUMP command, someone typing in a terminal
+                return captures;
+            default:
+                // XON, XOFF, self test and unknown ones
+                break;
+        }
+    }
+    return captures;
+}
+
+/*
+Sample Memory, a run of one sample is the largest record per sample
+*/
+uint32_t SumpManager::sampleMemory() {
+    size_t samples = (LogicCaptureManager::captureBudget() - LogicCapture::MAX_RECORD) / 2;
+    return static_cast<uint32_t>(std::min<size_t>(samples, UINT32_MAX) & ~size_t(3));
+}
+
+void SumpManager::reset() {
+    divider = CLOCK_RATE / LogicCaptureManager::MAX_SAMPLE_RATE - 1;
+    readCount = 4096;
+    delayCount = 4096;
+    flags = 0;
+    triggerMask = 0;
+    triggerValue = 0;
+}
+
+bool SumpManager::readArgument(uint32_t& argument) {
+    argument = 0;
+    unsigned long start = millis();
+    for (int i = 0; i < 4;) {
+        if (Serial.available()) {
+            argument |= uint32_t(Serial.read() & 0xFF) << (8 * i++);
+        } else if (millis() - start > LONG_TIMEOUT_MS) {
+            return false;
+        } else {
+            delay(1);
+        }
+    }
+    return true;
+}
+
+/*
+Long Commands, counts are in units of 4 samples
+*/
+void SumpManager::applyLong(uint8_t command, uint32_t argument) {
+    switch (command) {
+        case CMD_DIVIDER:
+            divider = argument & 0xFFFFFF;
+            break;
+        case CMD_CAPTURE_SIZE:
+            readCount = ((argument & 0xFFFF) + 1ULL) * 4;
+            delayCount = ((argument >> 16) + 1ULL) * 4;
+            break;
+        case CMD_READ_COUNT:
+            readCount = uint64_t(argument) * 4;
+            break;
+        case CMD_DELAY_COUNT:
+            delayCount = uint64_t(argument) * 4;
+            break;
+        case CMD_FLAGS:
+            flags = argument;
+            break;
+        case CMD_TRIGGER_MASK:
+            triggerMask = argument & 0xFF;
+            break;
+        case CMD_TRIGGER_VALUE:
+            triggerValue = argument & 0xFF;
+            break;
+        default:
+            // Later trigger stages, stage configs and the serial trigger are not supported
+            break;
+    }
+}
+
+void SumpManager::sendId() {
+    Serial.write(reinterpret_cast<const uint8_t*>("1ALS"), 4);
+    Serial.flush();
+}
+
+/*
+Metadata, strings end with a zero, 32 bit values are big endian
+*/
+void SumpManager::sendMetadata(size_t channels) {
+    std::vector<uint8_t> data;
+    auto text = [&](uint8_t key, const std::string& value) {
+        data.push_back(key);
+        data.insert(data.end(), value.begin(), value.end());
+        data.push_back(0);
+    };
+    auto u32 = [&](uint8_t key, uint32_t value) {
+        data.push_back(key);
+        for (int shift = 24; shift >= 0; shift -= 8) data.push_back((value >> shift) & 0xFF);
+    };
+
+    text(0x01, "ESP32 Bus Pirate");
+    text(0x02, state.getVersion());
+    u32(0x21, sampleMemory());
+    u32(0x23, LogicCaptureManager::MAX_SAMPLE_RATE);
+    data.push_back(0x40);
+    data.push_back(static_cast<uint8_t>(channels));
+    data.push_back(0x41);
+    data.push_back(2); // protocol version
+    data.push_back(0x00);
+
+    Serial.write(data.data(), data.size());
+    Serial.flush();
+}
+
+/*
+Run
+*/
+bool SumpManager::run(const std::vector<uint8_t>& pins, const std::function<bool()>& shouldExit) {
+    uint64_t samples = std::max<uint64_t>(4, readCount);
+    uint64_t post = std::min(delayCount, samples);
+
+    LogicTrigger trigger;
+    if (triggerMask) {
+        trigger.type = LogicTriggerEnum::Pattern;
+        trigger.mask = triggerMask;
+        trigger.value = triggerValue & triggerMask;
+    } else {
+        // Untriggered, the client expects the samples from now on
+        trigger.type = LogicTriggerEnum::None;
+        post = samples;
+    }
+
+    uint32_t rate = std::min(CLOCK_RATE / (divider + 1), LogicCaptureManager::MAX_SAMPLE_RATE);
+
+    // Any reset from the client aborts the capture, the command is kept for the loop
+    bool complete = captureManager.capture(pins, rate, trigger, samples - post, std::min<uint64_t>(post, sampleMemory()), [&]() {
+        return (Serial.available() && Serial.peek() == CMD_RESET) || shouldExit();
+    });
+    if (!complete) return false;
+
+    sendCapture(samples, post);
+    return true;
+}
+
+/*
+Send Capture, newest sample first
+*/
+void SumpManager::sendCapture(uint64_t readCount, uint64_t delayCount) {
+    const auto& capture = captureManager.getCapture();
+    if (!capture.size()) return;
+
+    // Samples before the trigger missing from the ring repeat the first one,
+    // samples lost to a full memory repeat the last one
+    uint64_t lead = readCount - delayCount - std::min(captureManager.getTriggerIndex(), readCount - delayCount);
+    uint8_t first = 0, last = 0;
+    capture.expand(0, 1, &first);
+    capture.expand(capture.size() - 1, 1, &last);
+
+    // One byte per enabled group, only the first one has channels
+    size_t groups = 0;
+    for (int group = 0; group < 4; ++group) {
+        if (!(flags & (1 << (2 + group)))) groups++;
+    }
+    groups = std::max<size_t>(groups, 1);
+
+    std::vector<uint8_t> window(SEND_CHUNK);
+    std::vector<uint8_t> out(SEND_CHUNK * groups, 0);
+    for (uint64_t end = readCount; end > 0;) {
+        uint64_t begin = end > SEND_CHUNK ? end - SEND_CHUNK : 0;
+        size_t count = static_cast<size_t>(end - begin);
+
+        // Window in time order, padded on both sides
+        size_t filled = 0;
+        while (filled < count && begin + filled < lead) window[filled++] = first;
+        if (filled < count && begin + filled - lead < capture.size()) {
+            filled += capture.expand(begin + filled - lead, count - filled, window.data() + filled);
+        }
+        while (filled < count) window[filled++] = last;
+
+        for (size_t i = 0; i < count; ++i) out[i * groups] = window[count - 1 - i];
+        Serial.write(out.data(), count * groups);
+        end = begin;
+    }
+    Serial.flush();
+}
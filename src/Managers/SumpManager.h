@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Managers/LogicCaptureManager.h"
+#include "States/GlobalState.h"
+
+/*
+SUMP / Openbench Logic Sniffer protocol on the USB serial port.
+
+PulseView and the other sigrok clients drive the capture: they set the
+rate as a divider of a 100 MHz clock, the sample and post-trigger counts
+in units of 4 and a stage 0 mask/value trigger, then arm. The capture is
+made by LogicCaptureManager and sent back newest sample first, one byte
+per enabled channel group, as a real OLS does.
+*/
+class SumpManager {
+public:
+    explicit SumpManager(LogicCaptureManager& captureManager);
+
+    // Answer the client until [ENTER] is received or shouldExit, returns the captures sent
+    uint32_t serve(const std::vector<uint8_t>& pins, const std::function<bool()>& shouldExit);
+
+    // Samples a capture can hold for sure, any data
+    static uint32_t sampleMemory();
+
+    // The last capture padded to readCount, the trigger readCount - delayCount from the start
+    void sendCapture(uint64_t readCount, uint64_t delayCount);
+
+    // Commands, the long ones (bit 7 set) carry 4 bytes, little endian
+    static constexpr uint8_t CMD_RESET = 0x00;
+    static constexpr uint8_t CMD_RUN = 0x01;
+    static constexpr uint8_t CMD_ID = 0x02;
+    static constexpr uint8_t CMD_METADATA = 0x04;
+    static constexpr uint8_t CMD_XON = 0x11;
+    static constexpr uint8_t CMD_XOFF = 0x13;
+    static constexpr uint8_t CMD_DIVIDER = 0x80;
+    static constexpr uint8_t CMD_CAPTURE_SIZE = 0x81;   // read - 1 and delay - 1, 16 bits each
+    static constexpr uint8_t CMD_FLAGS = 0x82;
+    static constexpr uint8_t CMD_DELAY_COUNT = 0x83;    // 32 bit variants
+    static constexpr uint8_t CMD_READ_COUNT = 0x84;
+    static constexpr uint8_t CMD_TRIGGER_MASK = 0xC0;   // stage 0
+    static constexpr uint8_t CMD_TRIGGER_VALUE = 0xC1;
+
+    static constexpr uint32_t CLOCK_RATE = 100000000;
+    static constexpr uint32_t LONG_TIMEOUT_MS = 100;
+    static constexpr size_t SEND_CHUNK = 4096;          // samples per write
+
+private:
+    // Defaults after a reset
+    void reset();
+
+    // Arguments of a long command, false if they did not come
+    bool readArgument(uint32_t& argument);
+    void applyLong(uint8_t command, uint32_t argument);
+
+    void sendId();
+    void sendMetadata(size_t channels);
+
+    // Capture with the client settings, false if the client stopped it
+    bool run(const std::vector<uint8_t>& pins, const std::function<bool()>& shouldExit);
+
+    LogicCaptureManager& captureManager;
+    GlobalState& state = GlobalState::getInstance();
+
+    uint32_t divider = 0;
+    uint64_t readCount = 0;
+    uint64_t delayCount = 0;
+    uint32_t flags = 0;
+    uint8_t triggerMask = 0;
+    uint8_t triggerValue = 0;
+};
@@ -306,4 +306,21 @@ int UserInputManager::readValidatedChoiceIndex(const std::string& label, const s
     }
 
     return index - 1; // Convert to 0 based index
-}
\ No newline at end of file
+}
+
+std::string UserInputManager::readValidatedFilePath(const std::string& label, const std::string& def) {
+    while (true) {
+        terminalView.print(label + " [" + def + "]: ");
+        std::string input = argTransformer.filterPrintable(getLine());
+        if (input.empty()) return def;
+
+        if (input.find("..") != std::string::npos) {
+            terminalView.println("Invalid path.");
+            continue;
+        }
+
+        // Absolute paths only
+        if (input[0] != '/') input = "/" + input;
+        return input;
+    }
+}
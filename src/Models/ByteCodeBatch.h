@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include "Enums/ByteCodeEnum.h"
+
+/*
+A run of consecutive program ops executed as one bus operation.
+Write and Read runs are merged, every other command stays alone.
+*/
+struct ByteCodeBatch {
+    ByteCodeEnum command;   // Write, Read or the single command of the batch
+    uint32_t first;         // index of the first op of the run
+    uint32_t count;         // ops in the run
+    uint32_t offset;        // position of the run bytes in the staged payload
+    uint32_t length;        // bytes moved on the bus, or the repeat count
+    uint32_t reads;         // bytes clocked in for the caller
+    uint32_t startCycle;    // CPU cycle counter when the service started it
+    uint32_t cycles;        // cycles taken, filled once executed
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "Enums/ByteCodeEnum.h"
+
+/*
+One operation of a compiled instruction line.
+Write bytes live in the program payload, consecutive writes share one op.
+*/
+struct ByteCodeOp {
+    ByteCodeEnum command;
+    uint32_t length;   // payload bytes for Write, repeat count otherwise
+    uint32_t offset;   // first payload byte of a Write
+};
+
+// Payload byte filled from a variable before each run (macros)
+struct ByteCodePatch {
+    uint32_t offset;
+    uint8_t variable;
+    uint8_t shift;     // 0, 8, 16 or 24, which byte of the value
+};
+
+/*
+Compiled instructions, ops plus one contiguous payload for all written bytes
+*/
+class ByteCodeProgram {
+public:
+    void clear() {
+        ops.clear();
+        payload.clear();
+        patches.clear();
+    }
+
+    void emit(ByteCodeEnum command, uint32_t repeat = 1) {
+        ops.push_back({command, repeat, 0});
+    }
+
+    void emitWrite(uint8_t byte) {
+        openWrite().length++;
+        payload.push_back(byte);
+    }
+
+    void emitWrite(const uint8_t* data, size_t length) {
+        openWrite().length += length;
+        payload.insert(payload.end(), data, data + length);
+    }
+
+    // Placeholder write, bound to a variable value at run time
+    void emitVariable(uint8_t variable, uint8_t shift) {
+        patches.push_back({static_cast<uint32_t>(payload.size()), variable, shift});
+        emitWrite(0x00);
+    }
+
+    void bind(const uint32_t* values) {
+        for (const auto& patch : patches) {
+            payload[patch.offset] = static_cast<uint8_t>(values[patch.variable] >> patch.shift);
+        }
+    }
+
+    bool hasVariables() const { return !patches.empty(); }
+    const std::vector<ByteCodeOp>& getOps() const { return ops; }
+    const uint8_t* data(const ByteCodeOp& op) const { return payload.data() + op.offset; }
+    size_t payloadSize() const { return payload.size(); }
+    size_t size() const { return ops.size(); }
+    bool empty() const { return ops.empty(); }
+
+private:
+    std::vector<ByteCodeOp> ops;
+    std::vector<uint8_t> payload;
+    std::vector<ByteCodePatch> patches;
+
+    // Trailing Write op, created when the last op is something else
+    ByteCodeOp& openWrite() {
+        if (ops.empty() || ops.back().command != ByteCodeEnum::Write) {
+            ops.push_back({ByteCodeEnum::Write, 0, static_cast<uint32_t>(payload.size())});
+        }
+        return ops.back();
+    }
+};
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+#include <esp_heap_caps.h>
+
+/*
+Logic samples stored as runs, one byte per sample value.
+
+Each change of value is a record: the value, then the length of its run
+as a LEB128 varint, so an idle line costs a few bytes per second at any
+rate. Records go into fixed chunks taken from PSRAM when the board has
+some, and a sparse index of record starts lets a window be expanded
+without decoding the whole capture.
+*/
+class LogicCapture {
+public:
+    LogicCapture() = default;
+    LogicCapture(const LogicCapture&) = delete;
+    LogicCapture& operator=(const LogicCapture&) = delete;
+    ~LogicCapture() { clear(); }
+
+    // Drop the samples, budget is the most bytes of records kept
+    void reset(size_t budget) {
+        clear();
+        maxBytes = budget;
+    }
+
+    // Add one sample, false once the budget is used
+    bool append(uint8_t sample) {
+        if (runLength && sample == runValue) {
+            runLength++;
+            return true;
+        }
+        if (runLength && !flush()) return false;
+        runValue = sample;
+        runLength = 1;
+        return true;
+    }
+
+    // Samples stored, the open run included
+    uint64_t size() const { return stored + runLength; }
+
+    // Bytes used by the records
+    size_t bytes() const { return used; }
+    bool isFull() const { return full; }
+
+    /*
+    Runs in time order, from any sample
+    */
+    class Reader {
+    public:
+        explicit Reader(const LogicCapture& capture, uint64_t from = 0) : capture(capture) {
+            // Last indexed record at or before from, then skip whole runs
+            auto entry = std::upper_bound(capture.index.begin(), capture.index.end(), from,
+                [](uint64_t sample, const IndexEntry& e) { return sample < e.sample; });
+            if (entry != capture.index.begin()) {
+                --entry;
+                offset = entry->offset;
+                sample = entry->sample;
+            }
+            while (decode(pendingValue, pendingLength)) {
+                if (sample + pendingLength > from) {
+                    pending = true;
+                    pendingLength -= from - sample;
+                    sample = from;
+                    break;
+                }
+                sample += pendingLength;
+            }
+        }
+
+        // Next run, false at the end
+        bool next(uint8_t& value, uint64_t& length) {
+            if (pending) {
+                pending = false;
+                value = pendingValue;
+                length = pendingLength;
+            } else if (!decode(value, length)) {
+                return false;
+            }
+            sample += length;
+            return true;
+        }
+
+        // Sample index where the next run starts
+        uint64_t position() const { return sample; }
+
+    private:
+        // Record at offset, then the open run
+        bool decode(uint8_t& value, uint64_t& length) {
+            if (offset < capture.used) {
+                value = capture.byteAt(offset++);
+                length = 0;
+                for (int shift = 0;; shift += 7) {
+                    uint8_t byte = capture.byteAt(offset++);
+                    length |= uint64_t(byte & 0x7F) << shift;
+                    if (!(byte & 0x80)) break;
+                }
+                return true;
+            }
+            if (openDone || !capture.runLength) return false;
+            openDone = true;
+            value = capture.runValue;
+            length = capture.runLength;
+            return true;
+        }
+
+        const LogicCapture& capture;
+        size_t offset = 0;
+        uint64_t sample = 0;
+        bool openDone = false;
+        bool pending = false;
+        uint8_t pendingValue = 0;
+        uint64_t pendingLength = 0;
+    };
+
+    // Expand count samples from first into out, returns the samples written
+    size_t expand(uint64_t first, size_t count, uint8_t* out) const {
+        Reader reader(*this, first);
+        size_t written = 0;
+        uint8_t value;
+        uint64_t length;
+        while (written < count && reader.next(value, length)) {
+            size_t n = length < count - written ? static_cast<size_t>(length) : count - written;
+            for (size_t i = 0; i < n; ++i) out[written + i] = value;
+            written += n;
+        }
+        return written;
+    }
+
+    static constexpr size_t CHUNK_SIZE = 16384;
+    static constexpr size_t INDEX_SPACING = 1024; // bytes of records between index entries
+    static constexpr size_t MAX_RECORD = 11;      // value and a 64 bit varint
+
+private:
+    struct IndexEntry {
+        uint64_t sample;
+        size_t offset;
+    };
+
+    // Write the open run as a record
+    bool flush() {
+        if (used + MAX_RECORD > maxBytes || !reserve(MAX_RECORD)) {
+            full = true;
+            return false;
+        }
+        if (used >= nextIndex) {
+            index.push_back({stored, used});
+            nextIndex = used + INDEX_SPACING;
+        }
+        put(runValue);
+        uint64_t length = runLength;
+        do {
+            uint8_t byte = length & 0x7F;
+            length >>= 7;
+            put(length ? byte | 0x80 : byte);
+        } while (length);
+        stored += runLength;
+        runLength = 0;
+        return true;
+    }
+
+    // Chunks for count more bytes, PSRAM first, internal RAM on boards without it
+    bool reserve(size_t count) {
+        while (chunks.size() * CHUNK_SIZE < used + count) {
+            auto* chunk = static_cast<uint8_t*>(heap_caps_malloc(CHUNK_SIZE, MALLOC_CAP_SPIRAM));
+            if (!chunk) chunk = static_cast<uint8_t*>(malloc(CHUNK_SIZE));
+            if (!chunk) return false;
+            chunks.push_back(chunk);
+        }
+        return true;
+    }
+
+    void put(uint8_t byte) {
+        chunks[used / CHUNK_SIZE][used % CHUNK_SIZE] = byte;
+        used++;
+    }
+
+    uint8_t byteAt(size_t offset) const {
+        return chunks[offset / CHUNK_SIZE][offset % CHUNK_SIZE];
+    }
+
+    void clear() {
+        for (auto* chunk : chunks) free(chunk);
+        chunks.clear();
+        index.clear();
+        used = 0;
+        nextIndex = 0;
+        stored = 0;
+        runLength = 0;
+        full = false;
+    }
+
+    std::vector<uint8_t*> chunks;
+    std::vector<IndexEntry> index;
+    size_t used = 0;
+    size_t nextIndex = 0;
+    size_t maxBytes = 0;
+    uint64_t stored = 0;     // samples in records
+    uint8_t runValue = 0;
+    uint64_t runLength = 0;  // open run, not written yet
+    bool full = false;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include "Enums/LogicFrameEnum.h"
+
+// Frame decoded from a logic capture, sample indexes from the capture start
+struct LogicFrame {
+    LogicFrameEnum type = LogicFrameEnum::Data;
+    uint64_t start = 0;
+    uint64_t end = 0;
+    uint32_t value = 0;     // byte, 7 bit address or MOSI word
+    uint32_t miso = 0;      // SPI
+    bool read = false;      // I2C address, R/W bit set
+    bool ack = false;       // I2C, ninth bit low
+    bool error = false;     // UART framing, SPI partial word
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include "Enums/LogicTriggerEnum.h"
+
+// Trigger of a multi channel logic capture, channels are sample bits
+struct LogicTrigger {
+    LogicTriggerEnum type = LogicTriggerEnum::None;
+    uint8_t channel = 0;            // Rising, Falling, Pulse
+    uint8_t mask = 0;               // Pattern, channels compared
+    uint8_t value = 0;              // Pattern, their levels
+    uint8_t level = 1;              // Pulse, level during the pulse
+    uint32_t minWidth = 0;          // Pulse, in samples
+    uint32_t maxWidth = UINT32_MAX;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Enums/MacroStepEnum.h"
+#include "Models/ByteCodeProgram.h"
+
+struct MacroStep {
+    MacroStepEnum kind;
+    uint8_t variable;   // Set, Add
+    uint16_t target;    // Run: program index, Repeat: its End, End: its Repeat
+    int32_t value;      // Repeat count, Set value, Add delta
+};
+
+/*
+A macro compiled once: control steps plus the bytecode programs they run
+*/
+struct MacroProgram {
+    std::vector<MacroStep> steps;
+    std::vector<ByteCodeProgram> programs;
+    std::vector<std::string> variables;
+};
+
+struct MacroRunStats {
+    uint32_t executed = 0;    // bytecode programs run
+    uint32_t elapsedUs = 0;
+    bool stopped = false;     // interrupted by the output callback
+};
@@ -1,20 +1,21 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 class TerminalCommand {
 public:
     TerminalCommand(const std::string& root = "", const std::string& sub = "", const std::string& args = "")
         : root(root), subcommand(sub), args(args) {}
 
-    std::string getRoot() const { return root; }
-    void setRoot(const std::string& r) { root = r; }
+    const std::string& getRoot() const { return root; }
+    void setRoot(std::string_view r) { root.assign(r.data(), r.size()); }
 
-    std::string getSubcommand() const { return subcommand; }
-    void setSubcommand(const std::string& s) { subcommand = s; }
+    const std::string& getSubcommand() const { return subcommand; }
+    void setSubcommand(std::string_view s) { subcommand.assign(s.data(), s.size()); }
 
-    std::string getArgs() const { return args; }
-    void setArgs(const std::string& a) { args = a; }
+    const std::string& getArgs() const { return args; }
+    void setArgs(std::string_view a) { args.assign(a.data(), a.size()); }
 
 private:
     std::string root;
@@ -33,6 +33,7 @@ DependencyProvider::DependencyProvider(ITerminalView &terminalView, IDeviceView
       ethernetService(),
       cc1101Service(),
       httpService(),
+      logicCaptureService(),
 
       // Transformers
       commandTransformer(),
@@ -43,18 +44,23 @@ DependencyProvider::DependencyProvider(ITerminalView &terminalView, IDeviceView
       // Managers
       commandHistoryManager(),
       binaryAnalyzeManager(terminalView, terminalInput),
+      dumpPipelineManager(terminalView, terminalInput, sdService),
       userInputManager(terminalView, terminalInput, argTransformer),
+      macroManager(nvsService, sdService, instructionTransformer),
+      jobManager(terminalView, terminalInput),
+      logicCaptureManager(logicCaptureService),
+      sumpManager(logicCaptureManager),
 
       // Shells
       sdCardShell(sdService, terminalView, terminalInput, argTransformer),
-      spiFlashShell(spiService, terminalView, terminalInput, argTransformer, userInputManager, binaryAnalyzeManager),
-      spiEepromShell(spiService, terminalView, terminalInput, argTransformer, userInputManager, binaryAnalyzeManager),
+      spiFlashShell(spiService, terminalView, terminalInput, argTransformer, userInputManager, binaryAnalyzeManager, dumpPipelineManager),
+      spiEepromShell(spiService, terminalView, terminalInput, argTransformer, userInputManager, binaryAnalyzeManager, dumpPipelineManager),
       smartCardShell(twoWireService, terminalView, terminalInput, argTransformer, userInputManager),
       universalRemoteShell(terminalView, terminalInput, infraredService, argTransformer, userInputManager),
       ibuttonShell(terminalView, terminalInput, userInputManager, argTransformer, oneWireService),
-      i2cEepromShell(terminalView, terminalInput, i2cService, argTransformer, userInputManager, binaryAnalyzeManager),
+      i2cEepromShell(terminalView, terminalInput, i2cService, argTransformer, userInputManager, binaryAnalyzeManager, dumpPipelineManager),
       uartAtShell(terminalView, terminalInput, userInputManager, argTransformer, uartService),
-      threeWireEepromShell(terminalView, terminalInput, userInputManager, threeWireService, argTransformer),
+      threeWireEepromShell(terminalView, terminalInput, userInputManager, threeWireService, argTransformer, dumpPipelineManager),
       sysInfoShell(terminalView, terminalInput, userInputManager, argTransformer, systemService, wifiService),
 
       // Selectors
@@ -64,22 +70,22 @@ DependencyProvider::DependencyProvider(ITerminalView &terminalView, IDeviceView
       terminalTypeConfigurator(horizontalSelector),
 
       // Controllers
-      uartController(terminalView, terminalInput, deviceInput, uartService, sdService, hdUartService, argTransformer, userInputManager, uartAtShell),
-      i2cController(terminalView, terminalInput, i2cService, argTransformer, userInputManager, i2cEepromShell),
+      uartController(terminalView, terminalInput, deviceInput, uartService, sdService, hdUartService, argTransformer, userInputManager, uartAtShell, jobManager),
+      i2cController(terminalView, terminalInput, i2cService, argTransformer, userInputManager, i2cEepromShell, jobManager),
       oneWireController(terminalView, terminalInput, oneWireService, argTransformer, userInputManager, ibuttonShell),
       infraredController(terminalView, terminalInput, infraredService, argTransformer, userInputManager, universalRemoteShell),
-      utilityController(terminalView, deviceView, terminalInput, pinService, userInputManager, argTransformer, sysInfoShell),
+      utilityController(terminalView, deviceView, terminalInput, pinService, logicCaptureService, logicCaptureManager, sumpManager, userInputManager, argTransformer, sysInfoShell, jobManager),
       hdUartController(terminalView, terminalInput, deviceInput, hdUartService, uartService, argTransformer, userInputManager),
       spiController(terminalView, terminalInput, spiService, sdService, argTransformer, userInputManager, binaryAnalyzeManager, sdCardShell, spiFlashShell, spiEepromShell),
       jtagController(terminalView, terminalInput, jtagService, userInputManager),
       twoWireController(terminalView, terminalInput, userInputManager, twoWireService, smartCardShell),
       threeWireController(terminalView, terminalInput, userInputManager, threeWireService, argTransformer, threeWireEepromShell),
-      dioController(terminalView, terminalInput, pinService, argTransformer),
+      dioController(terminalView, terminalInput, pinService, argTransformer, jobManager),
       ledController(terminalView, terminalInput, ledService, argTransformer, userInputManager),
       bluetoothController(terminalView, terminalInput, deviceInput, bluetoothService, argTransformer, userInputManager),
       i2sController(terminalView, terminalInput, i2sService, argTransformer, userInputManager),
       wifiController(terminalView, terminalInput, deviceInput, wifiService, wifiScannerService, ethernetService, sshService, netcatService, nmapService, icmpService, nvsService, httpService, argTransformer, userInputManager),
-      canController(terminalView, terminalInput, userInputManager, canService, argTransformer),
+      canController(terminalView, terminalInput, userInputManager, canService, argTransformer, jobManager),
       ethernetController(terminalView, terminalInput, deviceInput, wifiService, wifiScannerService, ethernetService, sshService, netcatService, nmapService, icmpService, nvsService, httpService, argTransformer, userInputManager),
       cc1101Controller(terminalView, terminalInput, cc1101Service, argTransformer, userInputManager)
 {
@@ -117,6 +123,7 @@ CanService &DependencyProvider::getCanService() { return canService; }
 SystemService &DependencyProvider::getSystemService() { return systemService; }
 EthernetService &DependencyProvider::getEthernetService() { return ethernetService; }
 CC1101Service &DependencyProvider::getCC1101Service() { return cc1101Service; }
+LogicCaptureService &DependencyProvider::getLogicCaptureService() { return logicCaptureService; }
 
 // Controllers
 UartController &DependencyProvider::getUartController() { return uartController; }
@@ -149,6 +156,11 @@ WebRequestTransformer &DependencyProvider::getWebRequestTransformer() { return w
 CommandHistoryManager &DependencyProvider::getCommandHistoryManager() { return commandHistoryManager; }
 UserInputManager &DependencyProvider::getUserInputManager() { return userInputManager; }
 BinaryAnalyzeManager &DependencyProvider::getBinaryAnalyzeManager() { return binaryAnalyzeManager; }
+DumpPipelineManager &DependencyProvider::getDumpPipelineManager() { return dumpPipelineManager; }
+MacroManager &DependencyProvider::getMacroManager() { return macroManager; }
+JobManager &DependencyProvider::getJobManager() { return jobManager; }
+LogicCaptureManager &DependencyProvider::getLogicCaptureManager() { return logicCaptureManager; }
+SumpManager &DependencyProvider::getSumpManager() { return sumpManager; }
 
 // Shells
 SdCardShell &DependencyProvider::getSdCardShell() { return sdCardShell; }
@@ -34,6 +34,7 @@ and injecting shared instances of core components
 #include "Services/EthernetService.h"
 #include "Services/Cc1101Service.h"
 #include "Services/HttpService.h"
+#include "Services/LogicCaptureService.h"
 #include "Controllers/UartController.h"
 #include "Controllers/I2cController.h"
 #include "Controllers/OneWireController.h"
@@ -59,7 +60,12 @@ and injecting shared instances of core components
 #include "Transformers/WebRequestTransformer.h"
 #include "Managers/CommandHistoryManager.h"
 #include "Managers/BinaryAnalyzeManager.h"
+#include "Managers/DumpPipelineManager.h"
 #include "Managers/UserInputManager.h"
+#include "Managers/MacroManager.h"
+#include "Managers/JobManager.h"
+#include "Managers/LogicCaptureManager.h"
+#include "Managers/SumpManager.h"
 #include "Shells/SdCardShell.h"
 #include "Shells/UniversalRemoteShell.h"
 #include "Shells/I2cEepromShell.h"
@@ -115,6 +121,7 @@ public:
     EthernetService &getEthernetService();
     CC1101Service &getCC1101Service();
     HttpService &getHttpService();
+    LogicCaptureService &getLogicCaptureService();
 
     // Controllers
     UartController &getUartController();
@@ -147,6 +154,11 @@ public:
     CommandHistoryManager &getCommandHistoryManager();
     UserInputManager &getUserInputManager();
     BinaryAnalyzeManager &getBinaryAnalyzeManager();
+    DumpPipelineManager &getDumpPipelineManager();
+    MacroManager &getMacroManager();
+    JobManager &getJobManager();
+    LogicCaptureManager &getLogicCaptureManager();
+    SumpManager &getSumpManager();
 
     // Shells
     SdCardShell &getSdCardShell();
@@ -205,6 +217,7 @@ private:
     EthernetService ethernetService;
     CC1101Service cc1101Service;
     HttpService httpService;
+    LogicCaptureService logicCaptureService;
 
     // Controllers
     UartController uartController;
@@ -236,6 +249,11 @@ private:
     CommandHistoryManager commandHistoryManager;
     UserInputManager userInputManager;
     BinaryAnalyzeManager binaryAnalyzeManager;
+    DumpPipelineManager dumpPipelineManager;
+    MacroManager macroManager;
+    JobManager jobManager;
+    LogicCaptureManager logicCaptureManager;
+    SumpManager sumpManager;
 
     // Shells
     SdCardShell sdCardShell;
@@ -4,7 +4,7 @@
 static const char* TAG = "WebSocketServer";
 
 WebSocketServer::WebSocketServer(httpd_handle_t sharedServer)
-    : server(sharedServer) {}
+    : server(sharedServer), ring(OUTPUT_RING_SIZE), frame(MAX_FRAME_SIZE) {}
 
 void WebSocketServer::setupRoutes() {
     static httpd_uri_t ws_uri = {
@@ -16,6 +16,10 @@ void WebSocketServer::setupRoutes() {
     };
 
     httpd_register_uri_handler(server, &ws_uri);
+
+    if (!flusher) {
+        xTaskCreatePinnedToCore(flusherTask, "WsFlusher", 4096, this, 2, &flusher, tskNO_AFFINITY);
+    }
 }
 
 
@@ -46,87 +50,261 @@ esp_err_t WebSocketServer::wsHandler(httpd_req_t *req) {
         return ret;
     }
 
-    frame.payload = (uint8_t*)malloc(frame.len + 1);
-    if (!frame.payload) return ESP_ERR_NO_MEM;
+    // Receive buffer reused across frames, only this task touches it
+    if (self->received.size() < frame.len) self->received.resize(frame.len);
+    frame.payload = self->received.data();
 
     ret = httpd_ws_recv_frame(req, &frame, frame.len);
     if (ret != ESP_OK) {
-        free(frame.payload);
         return ret;
     }
-    frame.payload[frame.len] = '\0';
-    
-    // Push chars one by one into buffer
-    for (size_t i = 0; i < frame.len; ++i) {
-        self->buffer.push_back(((char*)frame.payload)[i]);
-    }
 
-    free(frame.payload);
+    self->pushInput(frame.payload, frame.len);
     return ESP_OK;
 }
 
-char WebSocketServer::readCharBlocking() {
-    while (buffer.empty()) {
-        delay(10);
+void WebSocketServer::pushInput(const uint8_t* data, size_t len) {
+    TickType_t waited = 0;
+
+    while (len) {
+        uint32_t h = inputHead.load(std::memory_order_relaxed);
+        size_t space = INPUT_RING_SIZE - (h - inputTail.load(std::memory_order_acquire));
+
+        // Full, give the reader some time before dropping the rest
+        if (space == 0) {
+            if (waited++ >= pdMS_TO_TICKS(INPUT_FULL_TIMEOUT_MS)) return;
+            vTaskDelay(1);
+            continue;
+        }
+
+        size_t n = std::min(len, space);
+        size_t index = h & (INPUT_RING_SIZE - 1);
+        size_t first = std::min(n, INPUT_RING_SIZE - index);
+        memcpy(&input[index], data, first);
+        memcpy(&input[0], data + first, n - first);
+        inputHead.store(h + n, std::memory_order_release);
+
+        data += n;
+        len -= n;
+
+        // Wake the reader
+        TaskHandle_t waiting = reader.exchange(nullptr, std::memory_order_acq_rel);
+        if (waiting) xTaskNotifyGive(waiting);
     }
-    char c = buffer.front();
-    buffer.pop_front();
-    return c;
 }
 
-char WebSocketServer::readCharNonBlocking() {
-    if (buffer.empty()) return KEY_NONE;
+bool WebSocketServer::popInput(char& c) {
+    uint32_t t = inputTail.load(std::memory_order_relaxed);
+    if (t == inputHead.load(std::memory_order_acquire)) return false;
 
-    char c = buffer.front();
-    buffer.pop_front();
+    c = input[t & (INPUT_RING_SIZE - 1)];
+    inputTail.store(t + 1, std::memory_order_release);
+    return true;
+}
 
+char WebSocketServer::readCharBlocking(TickType_t timeout) {
+    char c;
+    TickType_t start = xTaskGetTickCount();
+    while (!popInput(c)) {
+        TickType_t waited = xTaskGetTickCount() - start;
+        if (timeout != portMAX_DELAY && waited >= timeout) {
+            reader.store(nullptr, std::memory_order_relaxed);
+            return KEY_NONE;
+        }
+
+        // Register before the last check, a push after it notifies us
+        reader.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+        if (inputTail.load(std::memory_order_relaxed) != inputHead.load(std::memory_order_acquire)) continue;
+        ulTaskNotifyTake(pdTRUE, timeout == portMAX_DELAY ? portMAX_DELAY : timeout - waited);
+    }
+    reader.store(nullptr, std::memory_order_relaxed);
     return c;
 }
 
+char WebSocketServer::readCharNonBlocking() {
+    char c;
+    return popInput(c) ? c : KEY_NONE;
+}
+
 void WebSocketServer::sendText(const std::string& msg) {
+    sendText(msg.data(), msg.size());
+}
+
+void WebSocketServer::sendText(const char* data, size_t len) {
     if (clientFd < 0) return;
 
-    // Sanitize UTF8
-    std::string safeMsg = sanitizeUtf8(msg);
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+    size_t i = 0;
+
+    // Complete the sequence cut by the previous call
+    while (partialLength && i < len) {
+        partial[partialLength++] = p[i++];
+        int n = utf8Sequence(partial, partialLength);
+        if (n > 0) {
+            write(partial, n);
+            partialLength = 0;
+        } else if (n == 0) {
+            // Not a continuation, it may start the next sequence
+            partialLength = 0;
+            i--;
+        }
+    }
+
+    // Copy valid runs, skip invalid bytes
+    size_t run = i;
+    while (i < len) {
+        if (p[i] < 0x80) {
+            i++;
+            continue;
+        }
+        int n = utf8Sequence(p + i, len - i);
+        if (n > 0) {
+            i += n;
+            continue;
+        }
 
-    httpd_ws_frame_t ws_pkt = {};
-    ws_pkt.type = HTTPD_WS_TYPE_TEXT;
-    ws_pkt.payload = (uint8_t*) safeMsg.c_str();
-    ws_pkt.len = safeMsg.length();
+        write(p + run, i - run);
+        if (n < 0) {
+            partialLength = len - i;
+            memcpy(partial, p + i, partialLength);
+            i = len;
+        } else {
+            i++;
+        }
+        run = i;
+    }
+    write(p + run, i - run);
 
-    httpd_ws_send_frame_async(server, clientFd, &ws_pkt);
+    xTaskNotifyGive(flusher);
 }
 
-std::string WebSocketServer::sanitizeUtf8(const std::string& input) {
-    std::string output;
-    size_t i = 0;
+void WebSocketServer::write(const uint8_t* data, size_t len) {
+    while (len && clientFd >= 0) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        size_t space = OUTPUT_RING_SIZE - (h - tail.load(std::memory_order_acquire));
+
+        // Full, wait for the flusher to drain a frame
+        if (space == 0) {
+            writer.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+            xTaskNotifyGive(flusher);
+            ulTaskNotifyTake(pdTRUE, 1);
+            continue;
+        }
 
-    while (i < input.size()) {
-        unsigned char c = input[i];
+        size_t n = std::min(len, space);
+        size_t index = h & (OUTPUT_RING_SIZE - 1);
+        size_t first = std::min(n, OUTPUT_RING_SIZE - index);
+        memcpy(&ring[index], data, first);
+        memcpy(&ring[0], data + first, n - first);
+        head.store(h + n, std::memory_order_release);
 
-        if (c <= 0x7F) {  // ASCII
-            output += c;
-            i++;
-        } else if ((c & 0xE0) == 0xC0 && i + 1 < input.size() &&
-                   (input[i+1] & 0xC0) == 0x80) {
-            output += input.substr(i, 2);
-            i += 2;
-        } else if ((c & 0xF0) == 0xE0 && i + 2 < input.size() &&
-                   (input[i+1] & 0xC0) == 0x80 &&
-                   (input[i+2] & 0xC0) == 0x80) {
-            output += input.substr(i, 3);
-            i += 3;
-        } else if ((c & 0xF8) == 0xF0 && i + 3 < input.size() &&
-                   (input[i+1] & 0xC0) == 0x80 &&
-                   (input[i+2] & 0xC0) == 0x80 &&
-                   (input[i+3] & 0xC0) == 0x80) {
-            output += input.substr(i, 4);
-            i += 4;
-        } else {
-            // Invalid byte or sequence, skip it
+        data += n;
+        len -= n;
+    }
+}
+
+void WebSocketServer::flush() {
+    while (clientFd >= 0 && tail.load(std::memory_order_acquire) != head.load(std::memory_order_acquire)) {
+        xTaskNotifyGive(flusher);
+        vTaskDelay(1);
+    }
+}
+
+void WebSocketServer::flusherTask(void* param) {
+    auto* self = static_cast<WebSocketServer*>(param);
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Coalesce until the threshold or the interval, whichever first
+        TickType_t start = xTaskGetTickCount();
+        while (xTaskGetTickCount() - start < pdMS_TO_TICKS(FLUSH_INTERVAL_MS) &&
+               self->head.load(std::memory_order_acquire) - self->tail.load(std::memory_order_relaxed) < FLUSH_THRESHOLD) {
+            ulTaskNotifyTake(pdTRUE, 1);
+        }
+
+        self->sendPending();
+    }
+}
+
+void WebSocketServer::sendPending() {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    uint32_t h = head.load(std::memory_order_acquire);
+
+    while (t != h) {
+        size_t n = std::min<size_t>(h - t, MAX_FRAME_SIZE);
+        size_t index = t & (OUTPUT_RING_SIZE - 1);
+        size_t first = std::min(n, OUTPUT_RING_SIZE - index);
+        memcpy(frame.data(), &ring[index], first);
+        memcpy(frame.data() + first, &ring[0], n - first);
+
+        // Frames must hold whole sequences, keep a cut one for the next frame
+        size_t lead = n;
+        while (lead > 0 && (frame[lead - 1] & 0xC0) == 0x80 && n - lead < 3) lead--;
+        if (lead > 0 && frame[lead - 1] >= 0xC0 && utf8Sequence(&frame[lead - 1], n - lead + 1) < 0) {
+            n = lead - 1;
+        }
+        if (n == 0) break;
+
+        if (clientFd >= 0) {
+            httpd_ws_frame_t ws_pkt = {};
+            ws_pkt.type = HTTPD_WS_TYPE_TEXT;
+            ws_pkt.payload = frame.data();
+            ws_pkt.len = n;
+
+            // Client gone, drop the output
+            if (httpd_ws_send_frame_async(server, clientFd, &ws_pkt) != ESP_OK) {
+                clientFd = -1;
+            }
+        }
+
+        t += n;
+        tail.store(t, std::memory_order_release);
+        h = head.load(std::memory_order_acquire);
+
+        // Wake a writer blocked on a full ring
+        TaskHandle_t blocked = writer.exchange(nullptr, std::memory_order_acq_rel);
+        if (blocked) xTaskNotifyGive(blocked);
+    }
+}
+
+int WebSocketServer::utf8Sequence(const uint8_t* p, size_t len) {
+    uint8_t c = p[0];
+    size_t n;
+    if (c <= 0x7F) return 1;
+    else if ((c & 0xE0) == 0xC0) n = 2;
+    else if ((c & 0xF0) == 0xE0) n = 3;
+    else if ((c & 0xF8) == 0xF0) n = 4;
+    else return 0;
+
+    for (size_t k = 1; k < n; ++k) {
+        if (k >= len) return -1;
+        if ((p[k] & 0xC0) != 0x80) return 0;
+    }
+    return n;
+}
+
+size_t WebSocketServer::sanitizeUtf8(char* data, size_t len) {
+    uint8_t* p = reinterpret_cast<uint8_t*>(data);
+    size_t out = 0, i = 0;
+
+    while (i < len) {
+        int n = p[i] < 0x80 ? 1 : utf8Sequence(p + i, len - i);
+        if (n <= 0) {
+            // Invalid byte or cut sequence, skip it
             i++;
+            continue;
         }
+        if (out != i) memmove(p + out, p + i, n);
+        out += n;
+        i += n;
     }
 
+    return out;
+}
+
+std::string WebSocketServer::sanitizeUtf8(const std::string& input) {
+    std::string output = input;
+    output.resize(sanitizeUtf8(&output[0], output.size()));
     return output;
-}
\ No newline at end of file
+}
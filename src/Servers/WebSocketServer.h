@@ -1,27 +1,87 @@
 #pragma once
-#include <deque>
 #include <esp_http_server.h>
 #include <vector>
 #include <string>
+#include <atomic>
 #include <Inputs/InputKeys.h>
 #include <Arduino.h>
 #include <esp_log.h>
 #include <cstring>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
+/*
+Websocket terminal transport.
+
+Input frames are pushed by the httpd task into a lock-free single
+producer, single consumer ring, the reader sleeps on a task notification
+until a frame arrives.
+
+Output goes through a ring buffer drained by a flusher task, which
+coalesces it into frames of up to MAX_FRAME_SIZE bytes: a frame is sent
+once FLUSH_THRESHOLD bytes are waiting or FLUSH_INTERVAL_MS after the
+first one. Writers block while the ring is full (backpressure).
+The ring has a single producer, the task running the shells.
+*/
 class WebSocketServer {
 public:
     WebSocketServer(httpd_handle_t sharedServer);
     void begin();
     void setupRoutes();
 
-    char readCharBlocking();
+    // KEY_NONE when nothing came within timeout ticks
+    char readCharBlocking(TickType_t timeout = portMAX_DELAY);
     char readCharNonBlocking();
+
+    // Queue text for the client, invalid UTF-8 is dropped
     void sendText(const std::string& msg);
+    void sendText(const char* data, size_t len);
+
+    // Wait until everything queued is sent
+    void flush();
+
+    // Drop invalid UTF-8 sequences in place, returns the new length
+    static size_t sanitizeUtf8(char* data, size_t len);
     std::string sanitizeUtf8(const std::string& input);
 
+    static constexpr size_t OUTPUT_RING_SIZE = 8192; // power of 2
+    static constexpr size_t FLUSH_THRESHOLD = 1024;
+    static constexpr uint32_t FLUSH_INTERVAL_MS = 2;
+    static constexpr size_t MAX_FRAME_SIZE = 2048;
+    static constexpr size_t INPUT_RING_SIZE = 2048;  // power of 2
+    static constexpr uint32_t INPUT_FULL_TIMEOUT_MS = 200;
+
 private:
     static esp_err_t wsHandler(httpd_req_t *req);
+    static void flusherTask(void* param);
+
+    // Length of the valid sequence at p, 0 if invalid, -1 if cut by the end
+    static int utf8Sequence(const uint8_t* p, size_t len);
+
+    void pushInput(const uint8_t* data, size_t len);
+    bool popInput(char& c);
+    void write(const uint8_t* data, size_t len);
+    void sendPending();
+
     httpd_handle_t server;
-    static inline std::deque<char> buffer;
     static inline int clientFd = -1; 
+
+    // Input ring, free running indexes
+    char input[INPUT_RING_SIZE];
+    std::atomic<uint32_t> inputHead{0};
+    std::atomic<uint32_t> inputTail{0};
+    std::atomic<TaskHandle_t> reader{nullptr}; // waiting for input
+    std::vector<uint8_t> received;
+
+    // Output ring, free running indexes
+    std::vector<uint8_t> ring;
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint32_t> tail{0};
+    std::vector<uint8_t> frame;
+    TaskHandle_t flusher = nullptr;
+    std::atomic<TaskHandle_t> writer{nullptr}; // blocked on a full ring
+
+    // Sequence cut between two sendText calls (byte per byte bridges)
+    uint8_t partial[4];
+    size_t partialLength = 0;
 };
@@ -57,48 +57,54 @@ char HdUartService::read() {
     return (len == 1) ? static_cast<char>(c) : '\0';
 }
 
-std::string HdUartService::executeByteCode(const std::vector<ByteCode>& bytecodes) {
+std::string HdUartService::executeByteCode(const ByteCodeProgram& program) {
     std::string result;
     uint32_t timeout = 2000;
-    uint32_t received = 0;
-    uint32_t start;
 
-    for (const ByteCode& code : bytecodes) {
-        switch (code.getCommand()) {
+    // One uart_write_bytes per run of writes, one uart_read_bytes per run of reads
+    const auto& batches = batcher.transform(program);
+
+    for (size_t b = 0; b < batches.size(); ++b) {
+        const ByteCodeBatch& batch = batches[b];
+        uint32_t start = ESP.getCycleCount();
+
+        switch (batch.command) {
             case ByteCodeEnum::Write:
-                for (uint32_t i = 0; i < code.getRepeat(); ++i) {
-                    write(code.getData());
-                }
+                uart_write_bytes(HD_UART_PORT, batcher.payload(batch), batch.length);
+                uart_wait_tx_done(HD_UART_PORT, pdMS_TO_TICKS(100));
                 break;
 
-            case ByteCodeEnum::Read:
-                start = millis();
-                while (received < code.getRepeat() && (millis() - start < timeout)) {
-                    if (available()) {
-                        result += read();
-                        ++received;
-                    } else {
-                        delay(1);
-                    }
-                }
+            case ByteCodeEnum::Read: {
+                uint8_t* rx = batcher.received();
+                int len = uart_read_bytes(HD_UART_PORT, rx, batch.length, pdMS_TO_TICKS(timeout));
+                if (len > 0) result.append(reinterpret_cast<const char*>(rx), len);
                 break;
+            }
 
             case ByteCodeEnum::DelayMs:
-                delay(code.getRepeat());
-                break;
-
             case ByteCodeEnum::DelayUs:
-                delayMicroseconds(code.getRepeat());
+            case ByteCodeEnum::DelayNs:
+                timing.wait(batch.command, batch.length);
                 break;
 
             default:
                 break;
         }
+
+        batcher.record(b, start, ESP.getCycleCount());
     }
 
     return result;
 }
 
+std::string HdUartService::formatTrace(TraceModeEnum mode) const {
+    return batcher.formatTrace(mode);
+}
+
+std::string HdUartService::formatJitter() const {
+    return batcher.formatJitter();
+}
+
 uart_config_t HdUartService::buildUartConfig(unsigned long baud, uint8_t bits, char parity, uint8_t stop) {
     uart_word_length_t dataBits;
     uart_parity_t parityMode;
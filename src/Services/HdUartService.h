@@ -7,7 +7,8 @@
 #include "esp_rom_gpio.h"
 #include "hal/uart_types.h"
 #include "soc/uart_periph.h"
-#include "Models/ByteCode.h"
+#include "Transformers/ByteCodeBatchTransformer.h"
+#include "Services/TimingService.h"
 
 #define HD_UART_PORT UART_NUM_2
 #define UART_RX_BUFFER_SIZE 256
@@ -20,7 +21,9 @@ public:
     bool available() const;
     char read();
     std::string readLine();
-    std::string executeByteCode(const std::vector<ByteCode>& bytecodes);
+    std::string executeByteCode(const ByteCodeProgram& program);
+    std::string formatTrace(TraceModeEnum mode) const;
+    std::string formatJitter() const;
     void flush();
     uart_config_t buildUartConfig(unsigned long baud, uint8_t bits, char parity, uint8_t stop);
     void end();
@@ -30,5 +33,7 @@ private:
     unsigned long baudRate;
     uint32_t serialConfig;
     bool isInverted;
+    ByteCodeBatchTransformer batcher;
+    TimingService timing;
 
 };
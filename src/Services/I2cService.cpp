@@ -34,14 +34,20 @@ bool I2cService::end() const {
     return Wire.end();
 }
 
-std::string I2cService::executeByteCode(const std::vector<ByteCode>& bytecodes) {
+std::string I2cService::executeByteCode(const ByteCodeProgram& program) {
     std::string result;
     uint8_t currentAddress = 0;
     bool transmissionStarted = false;
     bool expectAddress = false;
 
-    for (const auto& code : bytecodes) {
-        switch (code.getCommand()) {
+    // Writes fill one transmission, reads one requestFrom
+    const auto& batches = batcher.transform(program);
+
+    for (size_t b = 0; b < batches.size(); ++b) {
+        const ByteCodeBatch& batch = batches[b];
+        uint32_t start = ESP.getCycleCount();
+
+        switch (batch.command) {
             case ByteCodeEnum::Start:
                 expectAddress = true;
                 break;
@@ -53,54 +59,63 @@ std::string I2cService::executeByteCode(const std::vector<ByteCode>& bytecodes)
                 }
                 break;
 
-            case ByteCodeEnum::Write:
+            case ByteCodeEnum::Write: {
+                const uint8_t* data = batcher.payload(batch);
+                uint32_t length = batch.length;
+
+                // First byte after a start is the address
                 if (expectAddress) {
-                    currentAddress = code.getData();
+                    currentAddress = data[0];
                     Wire.beginTransmission(currentAddress);
                     transmissionStarted = true;
                     expectAddress = false;
-                } else {
-                    if (!transmissionStarted) {
-                        Wire.beginTransmission(currentAddress);
-                        transmissionStarted = true;
-                    }
-                    for (uint32_t i = 0; i < code.getRepeat(); ++i) {
-                        Wire.write(code.getData());
-                    }
+                    data++;
+                    length--;
+                }
+                if (length == 0) break;
+
+                if (!transmissionStarted) {
+                    Wire.beginTransmission(currentAddress);
+                    transmissionStarted = true;
                 }
+                Wire.write(data, length);
                 break;
+            }
 
-                case ByteCodeEnum::Read: {
-                    if (transmissionStarted) {
-                        Wire.endTransmission(false);  // release bus
-                        transmissionStarted = false;
-                    }
+            case ByteCodeEnum::Read: {
+                if (transmissionStarted) {
+                    Wire.endTransmission(false);  // release bus
+                    transmissionStarted = false;
+                }
 
-                    uint8_t toRead = code.getRepeat();
-                    uint8_t readAddr = currentAddress;
+                // requestFrom takes at most 255 bytes
+                uint32_t remaining = batch.length;
+                while (remaining > 0) {
+                    uint8_t toRead = remaining > 255 ? 255 : remaining;
+                    remaining -= toRead;
 
-                    Wire.requestFrom(readAddr, toRead);
-                    
+                    Wire.requestFrom(currentAddress, toRead);
                     for (uint8_t i = 0; i < toRead && Wire.available(); ++i) {
                         uint8_t val = Wire.read();
                         char hex[5];
                         snprintf(hex, sizeof(hex), "%02X ", val);
                         result += hex;
                     }
-                    break;
                 }
-
-            case ByteCodeEnum::DelayMs:
-                delay(code.getRepeat());
                 break;
+            }
 
+            case ByteCodeEnum::DelayMs:
             case ByteCodeEnum::DelayUs:
-                delayMicroseconds(code.getRepeat());
+            case ByteCodeEnum::DelayNs:
+                timing.wait(batch.command, batch.length);
                 break;
 
             default:
                 break;
         }
+
+        batcher.record(b, start, ESP.getCycleCount());
     }
 
     // If no end stop
@@ -111,6 +126,14 @@ std::string I2cService::executeByteCode(const std::vector<ByteCode>& bytecodes)
     return result;
 }
 
+std::string I2cService::formatTrace(TraceModeEnum mode) const {
+    return batcher.formatTrace(mode);
+}
+
+std::string I2cService::formatJitter() const {
+    return batcher.formatJitter();
+}
+
 bool I2cService::isReadableDevice(uint8_t addr, uint8_t startReg) {
     beginTransmission(addr);
     write(startReg);
@@ -484,6 +507,11 @@ uint8_t I2cService::eepromReadByte(uint16_t address) {
     return eeprom.read(address);
 }
 
+void I2cService::eepromReadBuffer(uint32_t address, uint8_t* buffer, uint16_t length) {
+    // Sequential read, the library splits it into I2C buffer sized requests
+    eeprom.read(address, buffer, length);
+}
+
 bool I2cService::eepromPutString(uint32_t address, const std::string& str) {
     String arduinoStr(str.c_str());
     return eeprom.putString(address, arduinoStr) > 0;
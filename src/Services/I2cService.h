@@ -3,7 +3,8 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <vector>
-#include "Models/ByteCode.h"
+#include "Transformers/ByteCodeBatchTransformer.h"
+#include "Services/TimingService.h"
 #include <SparkFun_External_EEPROM.h>
 
 class I2cService {
@@ -50,12 +51,15 @@ public:
     void glitchAckInjection(uint8_t address, uint32_t freqHz, uint8_t sclPin, uint8_t sdaPin);
 
     // Instructions
-    std::string executeByteCode(const std::vector<ByteCode>& bytecodes);
+    std::string executeByteCode(const ByteCodeProgram& program);
+    std::string formatTrace(TraceModeEnum mode) const;
+    std::string formatJitter() const;
 
     // EEPROM
     bool initEeprom(uint16_t chipSizeKb = 512, uint8_t addr=0x50);
     bool eepromWriteByte(uint16_t address, uint8_t value);
     uint8_t eepromReadByte(uint16_t address);
+    void eepromReadBuffer(uint32_t address, uint8_t* buffer, uint16_t length);
     bool eepromPutString(uint32_t address, const std::string& str);
     bool eepromGetString(uint32_t address, std::string& outStr);
     uint32_t eepromLength();
@@ -73,6 +77,8 @@ public:
 
 
 private:
+    ByteCodeBatchTransformer batcher;
+    TimingService timing;
     static std::vector<std::string> slaveLog;
     static portMUX_TYPE slaveLogMux;
     static uint8_t slaveResponseBuffer[16];
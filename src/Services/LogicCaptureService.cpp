@@ -0,0 +1,117 @@
+#include "LogicCaptureService.h"
+
+/*
+Start
+*/
+bool LogicCaptureService::start(uint8_t pin, uint32_t rate) {
+    if (running) stop();
+    if (rate < MIN_SAMPLE_RATE || rate > MAX_SAMPLE_RATE) return false;
+
+    // Each I2S frame is two 32 bit slots, one bit clock per sample
+    i2s_config_t config = {
+        .mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX),
+        .sample_rate = rate / FRAME_BITS,
+        .bits_per_sample = I2S_BITS_PER_SAMPLE_32BIT,
+        .channel_format = I2S_CHANNEL_FMT_RIGHT_LEFT,
+        .communication_format = I2S_COMM_FORMAT_I2S,
+        .intr_alloc_flags = ESP_INTR_FLAG_LEVEL1,
+        .dma_buf_count = DMA_BUF_COUNT,
+        .dma_buf_len = DMA_BUF_LEN,
+        .use_apll = false,
+        .tx_desc_auto_clear = false,
+        .fixed_mclk = 0
+    };
+
+    // Clocks stay internal, only the data input is routed
+    i2s_pin_config_t pins = {
+        .mck_io_num = I2S_PIN_NO_CHANGE,
+        .bck_io_num = I2S_PIN_NO_CHANGE,
+        .ws_io_num = I2S_PIN_NO_CHANGE,
+        .data_out_num = I2S_PIN_NO_CHANGE,
+        .data_in_num = pin
+    };
+
+    if (i2s_driver_install(port, &config, EVENT_QUEUE_LEN, &events) != ESP_OK) return false;
+    if (i2s_set_pin(port, &pins) != ESP_OK) {
+        i2s_driver_uninstall(port);
+        return false;
+    }
+
+    sampleRate = config.sample_rate * FRAME_BITS;
+    overruns = 0;
+    running = true;
+    return true;
+}
+
+/*
+Stop
+*/
+void LogicCaptureService::stop() {
+    if (!running) return;
+    i2s_driver_uninstall(port);
+    events = nullptr;
+    running = false;
+}
+
+bool LogicCaptureService::isRunning() const {
+    return running;
+}
+
+/*
+Read
+*/
+size_t LogicCaptureService::read(uint32_t* words, size_t count, uint32_t timeoutMs) {
+    if (!running) return 0;
+
+    size_t bytesRead = 0;
+    i2s_read(port, words, count * sizeof(uint32_t), &bytesRead, pdMS_TO_TICKS(timeoutMs));
+    drainEvents();
+    return bytesRead / sizeof(uint32_t);
+}
+
+/*
+Overruns
+*/
+uint32_t LogicCaptureService::getOverruns() {
+    drainEvents();
+    return overruns;
+}
+
+void LogicCaptureService::drainEvents() {
+    if (!events) return;
+    i2s_event_t event;
+    while (xQueueReceive(events, &event, 0) == pdPASS) {
+        if (event.type == I2S_EVENT_RX_Q_OVF) overruns++;
+    }
+}
+
+/*
+Channels
+*/
+bool LogicCaptureService::setChannels(const std::vector<uint8_t>& pins) {
+    if (pins.empty() || pins.size() > MAX_CHANNELS) return false;
+    channelCount = pins.size();
+    highBank = false;
+    for (size_t i = 0; i < pins.size(); ++i) {
+        channelPins[i] = pins[i];
+        if (pins[i] >= 32) highBank = true;
+    }
+    return true;
+}
+
+/*
+First Edge, compares whole words against the idle level
+*/
+size_t LogicCaptureService::firstEdge(const uint32_t* words, size_t count) {
+    if (!count) return 0;
+    const uint32_t idle = sampleAt(words, 0) ? 0xFFFFFFFF : 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t diff = words[i] ^ idle;
+        if (diff) return i * SAMPLES_PER_WORD + __builtin_clz(diff);
+    }
+    return count * SAMPLES_PER_WORD;
+}
+
+uint32_t LogicCaptureService::getSampleRate() const {
+    return sampleRate;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "driver/i2s.h"
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
+
+/*
+Logic capture through the I2S peripheral.
+
+The probed pin is the I2S data input and the bit clock runs at the
+sample rate, so the DMA stores one bit per sample, first sample in the
+MSB of each 32 bit word, and the CPU only handles full blocks.
+
+Several channels are read together from the GPIO input registers
+instead, one byte per sample, paced by the caller.
+*/
+class LogicCaptureService {
+public:
+    // Start sampling pin, the rate is rounded down to a multiple of FRAME_BITS
+    bool start(uint8_t pin, uint32_t sampleRate);
+    void stop();
+    bool isRunning() const;
+
+    // Copy up to count words of samples as the DMA fills them, returns the words read
+    size_t read(uint32_t* words, size_t count, uint32_t timeoutMs);
+
+    // DMA buffers lost since start because read() was late, a lower bound
+    // once the driver dropped events too (stalls over EVENT_QUEUE_LEN buffers)
+    uint32_t getOverruns();
+    uint32_t getSampleRate() const;
+
+    // Level of a sample in words returned by read()
+    static uint8_t sampleAt(const uint32_t* words, size_t index) {
+        return (words[index / SAMPLES_PER_WORD] >> (SAMPLES_PER_WORD - 1 - index % SAMPLES_PER_WORD)) & 1;
+    }
+
+    // Index of the first sample that differs from the first one, count * 32 if none
+    static size_t firstEdge(const uint32_t* words, size_t count);
+
+    // Pins read by readChannels(), bit n of a sample is pins[n]
+    bool setChannels(const std::vector<uint8_t>& pins);
+
+    // One sample of every channel, both input registers are read at once
+    uint8_t readChannels() const {
+        uint32_t low = REG_READ(GPIO_IN_REG);
+        uint32_t high = highBank ? REG_READ(GPIO_IN1_REG) : 0;
+        uint8_t sample = 0;
+        for (uint8_t i = 0; i < channelCount; ++i) {
+            uint32_t bank = channelPins[i] < 32 ? low : high;
+            sample |= ((bank >> (channelPins[i] & 31)) & 1) << i;
+        }
+        return sample;
+    }
+
+    static constexpr size_t MAX_CHANNELS = 8;
+    static constexpr uint32_t MIN_SAMPLE_RATE = 160000;    // I2S clock divider limit
+    static constexpr uint32_t MAX_SAMPLE_RATE = 10000000;
+    static constexpr size_t SAMPLES_PER_WORD = 32;
+    static constexpr uint32_t FRAME_BITS = 64;             // left and right 32 bit slots
+    static constexpr int DMA_BUF_COUNT = 8;
+    static constexpr int DMA_BUF_LEN = 512;                // frames, 32768 samples per buffer
+    static constexpr size_t BLOCK_WORDS = DMA_BUF_LEN * 2; // one DMA buffer
+    static constexpr int EVENT_QUEUE_LEN = 64;
+
+private:
+    void drainEvents();
+
+    i2s_port_t port = I2S_NUM_1; // I2S_NUM_0 belongs to the I2S mode
+    QueueHandle_t events = nullptr;
+    bool running = false;
+    uint32_t sampleRate = 0;
+    uint32_t overruns = 0;
+    uint8_t channelPins[MAX_CHANNELS] = {};
+    uint8_t channelCount = 0;
+    bool highBank = false; // a channel is on GPIO 32 or above
+};
@@ -96,47 +96,61 @@ uint8_t OneWireService::crc8(const uint8_t* data, uint8_t len) {
     return OneWire::crc8(data, len);
 }
 
-std::string OneWireService::executeByteCode(const std::vector<ByteCode>& bytecodes) {
+std::string OneWireService::executeByteCode(const ByteCodeProgram& program) {
     std::string result;
+    if (!oneWire) return result;
 
-    for (const auto& code : bytecodes) {
-        switch (code.getCommand()) {
+    // Bit-banged bus, batching only saves the per-byte call overhead
+    const auto& batches = batcher.transform(program);
+
+    for (size_t b = 0; b < batches.size(); ++b) {
+        const ByteCodeBatch& batch = batches[b];
+        uint32_t start = ESP.getCycleCount();
+
+        switch (batch.command) {
             case ByteCodeEnum::Start:
             case ByteCodeEnum::Stop:
                 reset();
                 break;
 
-            case ByteCodeEnum::Write: {
-                uint8_t byte = static_cast<uint8_t>(code.getData());
-                oneWire->write(byte);
+            case ByteCodeEnum::Write:
+                oneWire->write_bytes(batcher.payload(batch), batch.length);
                 break;
-            }
 
             case ByteCodeEnum::Read: {
-                for (uint32_t i = 0; i < code.getRepeat(); ++i) {
-                    uint8_t value = read();
+                uint8_t* rx = batcher.received();
+                oneWire->read_bytes(rx, batch.length);
+                for (uint32_t i = 0; i < batch.length; ++i) {
                     char hex[4];
-                    snprintf(hex, sizeof(hex), "%02X ", value);
+                    snprintf(hex, sizeof(hex), "%02X ", rx[i]);
                     result += hex;
                 }
                 break;
             }
 
             case ByteCodeEnum::DelayMs:
-                delay(code.getRepeat());
-                break;
-
             case ByteCodeEnum::DelayUs:
-                delayMicroseconds(code.getRepeat());
+            case ByteCodeEnum::DelayNs:
+                timing.wait(batch.command, batch.length);
                 break;
 
             default:
                 break;
         }
+
+        batcher.record(b, start, ESP.getCycleCount());
     }
     return result;
 }
 
+std::string OneWireService::formatTrace(TraceModeEnum mode) const {
+    return batcher.formatTrace(mode);
+}
+
+std::string OneWireService::formatJitter() const {
+    return batcher.formatJitter();
+}
+
 void OneWireService::resetSearch() {
     if (oneWire) oneWire->reset_search();
 }
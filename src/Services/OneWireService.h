@@ -2,7 +2,8 @@
 
 #include <OneWire.h>
 #include <vector>
-#include "Models/ByteCode.h"
+#include "Transformers/ByteCodeBatchTransformer.h"
+#include "Services/TimingService.h"
 
 class OneWireService {
 public:
@@ -18,11 +19,15 @@ public:
     void skip();
     void select(const uint8_t rom[8]);
     uint8_t crc8(const uint8_t* data, uint8_t len);
-    std::string executeByteCode(const std::vector<ByteCode>& bytecodes);
+    std::string executeByteCode(const ByteCodeProgram& program);
+    std::string formatTrace(TraceModeEnum mode) const;
+    std::string formatJitter() const;
     void resetSearch();
     bool search(uint8_t* rom);
 
 private:
     OneWire* oneWire = nullptr;
     uint8_t oneWirePin = 0;
+    ByteCodeBatchTransformer batcher;
+    TimingService timing;
 };
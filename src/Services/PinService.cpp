@@ -1,14 +1,17 @@
 #include "PinService.h"
 
 void PinService::setInput(uint8_t pin) {
+    state.getPinOwnership().take(pin);
     pinMode(pin, INPUT);
 }
 
 void PinService::setInputPullup(uint8_t pin) {
+    state.getPinOwnership().take(pin);
     pinMode(pin, INPUT_PULLUP);
 }
 
 void PinService::setOutput(uint8_t pin) {
+    state.getPinOwnership().take(pin);
     pinMode(pin, OUTPUT);
 }
 
@@ -39,6 +42,7 @@ void PinService::togglePullup(uint8_t pin) {
 }
 
 int PinService::readAnalog(uint8_t pin) {
+    state.getPinOwnership().take(pin);
     pinMode(pin, INPUT); 
     return analogRead(pin);
 }
@@ -55,6 +59,7 @@ bool PinService::setupPwm(uint8_t pin, uint32_t freq, uint8_t dutyPercent) {
     bool ok = ledcSetup(channel, freq, resolution);
     if (!ok) return false;
 
+    state.getPinOwnership().take(pin);
     ledcAttachPin(pin, channel);
     uint32_t dutyVal = (dutyPercent * ((1 << resolution) - 1)) / 100;
     ledcWrite(channel, dutyVal);
@@ -2,6 +2,7 @@
 
 #include <Arduino.h>
 #include <unordered_map>
+#include "States/GlobalState.h"
 
 class PinService {
 public:
@@ -17,4 +18,5 @@ public:
 private:
     bool isPwmFeasible(uint32_t freq, uint8_t resolutionBits);
     std::unordered_map<uint8_t, bool> pullupState; // true = INPUT_PULLUP, false = INPUT
+    GlobalState& state = GlobalState::getInstance(); // pins set here are taken from their mode
 };
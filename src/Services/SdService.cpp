@@ -8,6 +8,10 @@ bool SdService::configure(uint8_t clkPin, uint8_t misoPin, uint8_t mosiPin, uint
     SPI.begin(clkPin, misoPin, mosiPin, csPin);
     delay(10);
 
+    // The SPI bus now belongs to the card, whichever mode asked for it
+    auto& ownership = GlobalState::getInstance().getPinOwnership();
+    for (uint8_t pin : {clkPin, misoPin, mosiPin, csPin, PinOwnership::SPI_BUS}) ownership.take(pin);
+
     if (!SD.begin(csPin, SPI)) {
         sdCardMounted = false;
         return false;
@@ -266,6 +270,56 @@ File SdService::openFileWrite(const std::string& path) {
     return SD.open(path.c_str(), FILE_WRITE);
 }
 
+bool SdService::openFileStream(const std::string& path) {
+    if (!sdCardMounted) return false;
+
+    streamFile = SD.open(path.c_str(), FILE_WRITE);
+    if (!streamFile) return false;
+
+    streamBuffer.clear();
+    streamBuffer.reserve(STREAM_BUFFER_SIZE);
+    return true;
+}
+
+bool SdService::writeFileStream(const uint8_t* data, size_t len) {
+    if (!streamFile) return false;
+
+    while (len > 0) {
+        // Full blocks go straight to the file when nothing is pending
+        if (streamBuffer.empty() && len >= STREAM_BUFFER_SIZE) {
+            size_t blockLen = len - (len % STREAM_BUFFER_SIZE);
+            if (streamFile.write(data, blockLen) != blockLen) return false;
+            data += blockLen;
+            len -= blockLen;
+            continue;
+        }
+
+        size_t n = std::min(len, STREAM_BUFFER_SIZE - streamBuffer.size());
+        streamBuffer.insert(streamBuffer.end(), data, data + n);
+        data += n;
+        len -= n;
+
+        if (streamBuffer.size() == STREAM_BUFFER_SIZE && !flushFileStream()) return false;
+    }
+    return true;
+}
+
+bool SdService::flushFileStream() {
+    if (streamBuffer.empty()) return true;
+    bool ok = streamFile.write(streamBuffer.data(), streamBuffer.size()) == streamBuffer.size();
+    streamBuffer.clear();
+    return ok;
+}
+
+bool SdService::closeFileStream() {
+    if (!streamFile) return false;
+
+    bool ok = flushFileStream();
+    streamFile.close();
+    std::vector<uint8_t>().swap(streamBuffer);
+    return ok;
+}
+
 bool SdService::deleteDirectory(const std::string& dirPath) {
     if (!sdCardMounted) return false;
     File dir = SD.open(dirPath.c_str());
@@ -6,11 +6,18 @@
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include "States/GlobalState.h"
 
 class SdService {
 private:
     bool sdCardMounted = false;
     std::unordered_map<std::string, std::vector<std::string>> cachedDirectoryElements;
+
+    // Streamed file, kept open across writes
+    static constexpr size_t STREAM_BUFFER_SIZE = 4096; // multiple of the 512 bytes sector
+    File streamFile;
+    std::vector<uint8_t> streamBuffer;
+    bool flushFileStream();
 public:
     SdService();
 
@@ -41,6 +48,11 @@ public:
     File openFileRead(const std::string& path);
     File openFileWrite(const std::string& path);
 
+    // Large sequential writes, buffered into sector aligned blocks
+    bool openFileStream(const std::string& path);
+    bool writeFileStream(const uint8_t* data, size_t len);
+    bool closeFileStream();
+
 };
 
 #endif // SD_SERVICE_H
@@ -1,10 +1,21 @@
 #include "Services/SpiService.h"
 #include <ESP32SPISlave.h>
+#include <algorithm>
+
+// Host used by the Arduino SPI instance
+#if CONFIG_IDF_TARGET_ESP32
+    #define FLASH_SPI_HOST SPI3_HOST
+#else
+    #define FLASH_SPI_HOST SPI2_HOST
+#endif
 
 
 void SpiService::configure(uint8_t mosi, uint8_t miso, uint8_t sclk, uint8_t cs, uint32_t frequency) {
     end();
     csPin = cs;
+    sclkPin = sclk;
+    misoPin = miso;
+    mosiPin = mosi;
     spiFrequency = frequency;
     SPI.begin(sclk, miso, mosi, cs);
     pinMode(cs, OUTPUT);
@@ -12,6 +23,12 @@ void SpiService::configure(uint8_t mosi, uint8_t miso, uint8_t sclk, uint8_t cs,
 }
 
 void SpiService::end() {
+    // A wide session still holds the host
+    if (wideDevice) {
+        spi_bus_remove_device(wideDevice);
+        spi_bus_free(FLASH_SPI_HOST);
+        wideDevice = nullptr;
+    }
     SPI.end();
 }
 
@@ -61,19 +78,102 @@ uint32_t SpiService::calculateFlashCapacity(uint8_t code) {
     return 0; // Non standard
 }
 
-void SpiService::readFlashData(uint32_t address, uint8_t* buffer, size_t length) {
+void SpiService::readFlashData(uint32_t address, uint8_t* buffer, size_t length, FlashReadModeEnum mode) {
+    if (length == 0) return;
+
+    // The IDF driver owns the host during a wide session, a failed read ends it
+    if (wideDevice) {
+        if (readFlashDataWide(address, buffer, length)) return;
+        endWideRead();
+    }
+    if (mode == FlashReadModeEnum::DualOutput || mode == FlashReadModeEnum::QuadOutput) {
+        mode = FlashReadModeEnum::Fast;
+    }
+
+    uint8_t header[5] = {
+        FlashReadModeEnumMapper::toOpcode(mode),
+        static_cast<uint8_t>((address >> 16) & 0xFF),
+        static_cast<uint8_t>((address >> 8) & 0xFF),
+        static_cast<uint8_t>(address & 0xFF),
+        0x00 // dummy byte for fast read
+    };
+    size_t headerLength = 4 + FlashReadModeEnumMapper::dummyBytes(mode);
+
     beginTransaction();
-    SPI.transfer(0x03);  // Read Data command
-    SPI.transfer((address >> 16) & 0xFF);
-    SPI.transfer((address >> 8) & 0xFF);
-    SPI.transfer(address & 0xFF);
+    SPI.writeBytes(header, headerLength);
 
-    for (size_t i = 0; i < length; ++i) {
-        buffer[i] = SPI.transfer(0x00);
+    // Clock data straight into the caller buffer through the hardware FIFO,
+    // MOSI stays high when no tx data is given
+    size_t offset = 0;
+    while (offset < length) {
+        size_t chunk = std::min(FLASH_FIFO_CHUNK, length - offset);
+        SPI.transferBytes(nullptr, buffer + offset, chunk);
+        offset += chunk;
     }
     endTransaction();
 }
 
+bool SpiService::beginWideRead() {
+    if (wideDevice) return true;
+
+    // The IDF driver owns the host for the whole session, the Arduino SPI is restored after
+    SPI.end();
+
+    // Only MOSI/MISO are routed on the supported boards (no WP/HOLD as IO2/IO3),
+    // so quad capable chips are read with dual output (0x3B)
+    spi_bus_config_t busConfig = {};
+    busConfig.mosi_io_num = mosiPin; // IO0
+    busConfig.miso_io_num = misoPin; // IO1
+    busConfig.sclk_io_num = sclkPin;
+    busConfig.quadwp_io_num = -1;
+    busConfig.quadhd_io_num = -1;
+    busConfig.max_transfer_sz = FLASH_DMA_CHUNK;
+
+    spi_device_interface_config_t deviceConfig = {};
+    deviceConfig.command_bits = 8;
+    deviceConfig.address_bits = 24;
+    deviceConfig.dummy_bits = 8;
+    deviceConfig.mode = 0;
+    deviceConfig.clock_speed_hz = spiFrequency;
+    deviceConfig.spics_io_num = csPin;
+    deviceConfig.flags = SPI_DEVICE_HALFDUPLEX;
+    deviceConfig.queue_size = 1;
+
+    bool busReady = spi_bus_initialize(FLASH_SPI_HOST, &busConfig, SPI_DMA_CH_AUTO) == ESP_OK;
+    if (busReady && spi_bus_add_device(FLASH_SPI_HOST, &deviceConfig, &wideDevice) == ESP_OK) return true;
+
+    wideDevice = nullptr;
+    if (busReady) spi_bus_free(FLASH_SPI_HOST);
+    configure(mosiPin, misoPin, sclkPin, csPin, spiFrequency);
+    return false;
+}
+
+void SpiService::endWideRead() {
+    // Configuring ends the session
+    if (wideDevice) configure(mosiPin, misoPin, sclkPin, csPin, spiFrequency);
+}
+
+bool SpiService::readFlashDataWide(uint32_t address, uint8_t* buffer, size_t length) {
+    // DMA writes in place when the buffer is DMA capable, the driver bounces otherwise
+    bool ok = true;
+    size_t offset = 0;
+    while (ok && offset < length) {
+        size_t chunk = std::min(FLASH_DMA_CHUNK, length - offset);
+
+        spi_transaction_t transaction = {};
+        transaction.flags = SPI_TRANS_MODE_DIO; // cmd and addr on 1 line, data on 2
+        transaction.cmd = FlashReadModeEnumMapper::toOpcode(FlashReadModeEnum::DualOutput);
+        transaction.addr = address + offset;
+        transaction.length = 0;
+        transaction.rxlength = chunk * 8;
+        transaction.rx_buffer = buffer + offset;
+
+        ok = spi_device_polling_transmit(wideDevice, &transaction) == ESP_OK;
+        offset += chunk;
+    }
+    return ok;
+}
+
 void SpiService::eraseFlashSector(uint32_t address, uint32_t freq) {
     enableFlashWrite(freq);  // 0x06
 
@@ -174,12 +274,18 @@ void SpiService::writeFlashPatch(uint32_t address, const std::vector<uint8_t>& d
     }
 }
 
-std::string SpiService::executeByteCode(const std::vector<ByteCode>& bytecodes) {
+std::string SpiService::executeByteCode(const ByteCodeProgram& program) {
     std::string result;
     bool inTransaction = false;
 
-    for (const auto& code : bytecodes) {
-        switch (code.getCommand()) {
+    // Full duplex, a run of writes and reads is a single transferBytes
+    const auto& batches = batcher.transform(program, true);
+
+    for (size_t b = 0; b < batches.size(); ++b) {
+        const ByteCodeBatch& batch = batches[b];
+        uint32_t start = ESP.getCycleCount();
+
+        switch (batch.command) {
             case ByteCodeEnum::Start:
                 if (!inTransaction) {
                     beginTransaction();
@@ -195,31 +301,32 @@ std::string SpiService::executeByteCode(const std::vector<ByteCode>& bytecodes)
                 break;
 
             case ByteCodeEnum::Write:
-                for (uint32_t i = 0; i < code.getRepeat(); ++i) {
-                    transfer(code.getData());
-                }
+                SPI.writeBytes(batcher.payload(batch), batch.length);
                 break;
 
-            case ByteCodeEnum::Read:
-                for (uint32_t i = 0; i < code.getRepeat(); ++i) {
-                    uint8_t val = transfer(0x00);  // dummy byte
+            case ByteCodeEnum::Read: {
+                uint8_t* rx = batcher.received();
+                SPI.transferBytes(batcher.payload(batch), rx, batch.length);
+                for (uint32_t i = 0; i < batch.length; ++i) {
+                    if (!batcher.isRead(batch.offset + i)) continue;
                     char hex[5];
-                    snprintf(hex, sizeof(hex), "%02X ", val);
+                    snprintf(hex, sizeof(hex), "%02X ", rx[i]);
                     result += hex;
                 }
                 break;
+            }
 
             case ByteCodeEnum::DelayMs:
-                delay(code.getRepeat());
-                break;
-
             case ByteCodeEnum::DelayUs:
-                delayMicroseconds(code.getRepeat());
+            case ByteCodeEnum::DelayNs:
+                timing.wait(batch.command, batch.length);
                 break;
 
             default:
                 break;
         }
+
+        batcher.record(b, start, ESP.getCycleCount());
     }
 
     // Close transaction if left open
@@ -230,6 +337,14 @@ std::string SpiService::executeByteCode(const std::vector<ByteCode>& bytecodes)
     return result;
 }
 
+std::string SpiService::formatTrace(TraceModeEnum mode) const {
+    return batcher.formatTrace(mode);
+}
+
+std::string SpiService::formatJitter() const {
+    return batcher.formatJitter();
+}
+
 // #### SPI SLAVE ######
 
 static ESP32SPISlave spiSlave;
@@ -7,8 +7,11 @@
 #include <Arduino.h>
 #include <EEPROM_SPI_WE.h>
 #include <SPI.h>
+#include <driver/spi_master.h>
 #include <Data/FlashDatabase.h>
-#include <Models/ByteCode.h>
+#include <Transformers/ByteCodeBatchTransformer.h>
+#include <Services/TimingService.h>
+#include <Enums/FlashReadModeEnum.h>
 
 class SpiService {
 public:
@@ -22,7 +25,11 @@ public:
     // Flash
     std::string readFlashID();
     void readFlashIdRaw(uint8_t* buffer);
-    void readFlashData(uint32_t address, uint8_t* buffer, size_t length);
+    void readFlashData(uint32_t address, uint8_t* buffer, size_t length, FlashReadModeEnum mode = FlashReadModeEnum::Standard);
+    // Dual output reads go through the IDF driver between these calls, the Arduino SPI
+    // is ended meanwhile. Dual/Quad reads outside of a session are done in Fast mode
+    bool beginWideRead();
+    void endWideRead();
     uint32_t calculateFlashCapacity(uint8_t code);
     void eraseFlashSector(uint32_t address, uint32_t freq);
     void enableFlashWrite(uint32_t freq);
@@ -55,15 +62,27 @@ public:
     std::vector<std::vector<uint8_t>> getSlaveData();
 
     // Instructions
-    std::string executeByteCode(const std::vector<ByteCode>& bytecodes);
+    std::string executeByteCode(const ByteCodeProgram& program);
+    std::string formatTrace(TraceModeEnum mode) const;
+    std::string formatJitter() const;
 private:
     uint8_t csPin;
+    uint8_t sclkPin;
+    uint8_t misoPin;
+    uint8_t mosiPin;
     uint32_t spiFrequency = 1000000;
     bool slaveConfigured = false;
     EEPROM_SPI_WE eeprom = EEPROM_SPI_WE(&SPI, SPI_CS_PIN, 999, 8000000);
     bool eepromInitialized = false;
     uint32_t eepromFrequency = 8000000;
+    ByteCodeBatchTransformer batcher;
+    TimingService timing;
 
+    // Flash bulk read
+    static constexpr size_t FLASH_FIFO_CHUNK = 4096;     // bytes per transferBytes call
+    static constexpr size_t FLASH_DMA_CHUNK = 4092;      // bytes per DMA transaction
+    spi_device_handle_t wideDevice = nullptr;
+    bool readFlashDataWide(uint32_t address, uint8_t* buffer, size_t length);
 };
 
 
@@ -23,6 +23,7 @@ public:
 
     std::vector<uint8_t> dump8();
     std::vector<uint16_t> dump16();
+    uint16_t getSizeBytes() const;
 
     void writeEnable();
     void writeDisable();
@@ -0,0 +1,56 @@
+#include "TimingService.h"
+
+/*
+Wait
+*/
+void TimingService::wait(ByteCodeEnum command, uint32_t count) {
+    uint64_t ns = requestedNs(command, count);
+    if (!ns) return;
+
+    // Sub-microsecond delays can only be done on the cycle counter
+    if (!state.isPreciseTiming() && command != ByteCodeEnum::DelayNs) {
+        if (command == ByteCodeEnum::DelayMs) delay(count);
+        else delayMicroseconds(count);
+        return;
+    }
+
+    uint64_t cycles = ns * ESP.getCpuFreqMHz() / 1000;
+    if (ns > uint64_t(CRITICAL_LIMIT_US) * 1000) {
+        // The counter wraps every 2^32 cycles (17.9 s at 240 MHz), long waits go in chunks
+        while (cycles > CYCLE_CHUNK) {
+            waitCycles(CYCLE_CHUNK);
+            cycles -= CYCLE_CHUNK;
+        }
+        waitCycles(static_cast<uint32_t>(cycles));
+        return;
+    }
+
+    portENTER_CRITICAL(&mux);
+    waitCycles(static_cast<uint32_t>(cycles));
+    portEXIT_CRITICAL(&mux);
+}
+
+/*
+Requested
+*/
+uint64_t TimingService::requestedNs(ByteCodeEnum command, uint32_t count) {
+    switch (command) {
+        case ByteCodeEnum::DelayNs: return count;
+        case ByteCodeEnum::DelayUs: return uint64_t(count) * 1000;
+        case ByteCodeEnum::DelayMs: return uint64_t(count) * 1000000;
+        default:                    return 0;
+    }
+}
+
+bool TimingService::isDelay(ByteCodeEnum command) {
+    return requestedNs(command, 1) != 0;
+}
+
+/*
+Wait Cycles
+*/
+void IRAM_ATTR TimingService::waitCycles(uint32_t cycles) {
+    uint32_t start = ESP.getCycleCount();
+    while (ESP.getCycleCount() - start < cycles) {
+    }
+}
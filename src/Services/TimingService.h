@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstdint>
+#include "Enums/ByteCodeEnum.h"
+#include "States/GlobalState.h"
+
+/*
+Delays of the bytecode executor.
+
+Precise mode spins on the CPU cycle counter instead of delay() and
+delayMicroseconds(), short waits run with interrupts masked so an ISR
+or a task switch can not stretch them.
+*/
+class TimingService {
+public:
+    // Run a delay op of count units
+    void wait(ByteCodeEnum command, uint32_t count);
+
+    // Requested duration of a delay op, 0 for other ops
+    static uint64_t requestedNs(ByteCodeEnum command, uint32_t count);
+    static bool isDelay(ByteCodeEnum command);
+
+    // Busy wait on the cycle counter, wraps safely
+    static void waitCycles(uint32_t cycles);
+
+    // Longest wait done with interrupts masked
+    static constexpr uint32_t CRITICAL_LIMIT_US = 100;
+
+    // Longest single spin, well below a counter wrap
+    static constexpr uint32_t CYCLE_CHUNK = 1u << 30;
+
+private:
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+    GlobalState& state = GlobalState::getInstance();
+};
@@ -1,4 +1,5 @@
 #include "UartService.h"
+#include <algorithm>
 
 void UartService::configure(unsigned long baud, uint32_t config, uint8_t rx, uint8_t tx, bool inverted) {
     Serial1.end(); // stop before reconfigure
@@ -71,49 +72,63 @@ void UartService::write(const std::string& str) {
     Serial1.write(reinterpret_cast<const uint8_t*>(str.c_str()), str.length());
 }
 
-std::string UartService::executeByteCode(const std::vector<ByteCode>& bytecodes) {
+std::string UartService::executeByteCode(const ByteCodeProgram& program) {
     std::string result;
     uint32_t timeout = 2000; // 2 secondes
-    uint32_t start;
-    uint32_t received = 0;
 
-    for (const ByteCode& code : bytecodes) {
-        switch (code.getCommand()) {
+    // Writes go out in one call, reads drain what is buffered
+    const auto& batches = batcher.transform(program);
+
+    for (size_t b = 0; b < batches.size(); ++b) {
+        const ByteCodeBatch& batch = batches[b];
+        uint32_t start = ESP.getCycleCount();
+
+        switch (batch.command) {
             case ByteCodeEnum::Write:
-                for (uint32_t i = 0; i < code.getRepeat(); ++i) {
-                    Serial1.write(code.getData());
-                }
+                Serial1.write(batcher.payload(batch), batch.length);
                 break;
 
-            case ByteCodeEnum::Read:
-                start = millis();
-                while (received < code.getRepeat() && (millis() - start < timeout)) {
-                    if (Serial1.available()) {
-                        char c = Serial1.read();
-                        result += c;
-                        ++received;
+            case ByteCodeEnum::Read: {
+                uint8_t* rx = batcher.received();
+                uint32_t received = 0;
+                uint32_t begin = millis();
+                while (received < batch.length && (millis() - begin < timeout)) {
+                    size_t pending = Serial1.available();
+                    if (pending) {
+                        size_t count = std::min<size_t>(pending, batch.length - received);
+                        received += Serial1.read(rx + received, count);
                     } else {
                         delay(10);
                     }
                 }
+                result.append(reinterpret_cast<const char*>(rx), received);
                 break;
+            }
 
             case ByteCodeEnum::DelayMs:
-                delay(code.getRepeat());
-                break;
-
             case ByteCodeEnum::DelayUs:
-                delayMicroseconds(code.getRepeat());
+            case ByteCodeEnum::DelayNs:
+                timing.wait(batch.command, batch.length);
                 break;
 
             default:
                 break;
         }
+
+        batcher.record(b, start, ESP.getCycleCount());
     }
 
     return result;
 }
 
+std::string UartService::formatTrace(TraceModeEnum mode) const {
+    return batcher.formatTrace(mode);
+}
+
+std::string UartService::formatJitter() const {
+    return batcher.formatJitter();
+}
+
 void UartService::switchBaudrate(unsigned long newBaud) {
     Serial1.updateBaudRate(newBaud);
 }
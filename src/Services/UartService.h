@@ -8,7 +8,8 @@
 #include "esp_rom_gpio.h"
 #include "hal/uart_types.h"
 #include "soc/uart_periph.h"
-#include "Models/ByteCode.h"
+#include "Transformers/ByteCodeBatchTransformer.h"
+#include "Services/TimingService.h"
 #include <SD.h>
 
 #define UART_PORT UART_NUM_1
@@ -23,7 +24,9 @@ public:
     bool available() const;
     void write(char c);
     void write(const std::string& str);
-    std::string executeByteCode(const std::vector<ByteCode>& bytecodes);
+    std::string executeByteCode(const ByteCodeProgram& program);
+    std::string formatTrace(TraceModeEnum mode) const;
+    std::string formatJitter() const;
     void switchBaudrate(unsigned long newBaud);
     void flush();
     void clearUartBuffer();
@@ -43,6 +46,8 @@ public:
     int8_t getXmodemIdSize() const;
 
 private:
+    ByteCodeBatchTransformer batcher;
+    TimingService timing;
     XModem xmodem;
     static File* currentFile;
     int32_t xmodemBlockSize = 128;
@@ -6,13 +6,15 @@ I2cEepromShell::I2cEepromShell(
     I2cService& i2cService,
     ArgTransformer& argTransformer,
     UserInputManager& userInputManager,
-    BinaryAnalyzeManager& binaryAnalyzeManager
+    BinaryAnalyzeManager& binaryAnalyzeManager,
+    DumpPipelineManager& dumpPipelineManager
 ) : terminalView(view),
     terminalInput(input),
     i2cService(i2cService),
     argTransformer(argTransformer),
     userInputManager(userInputManager),
-    binaryAnalyzeManager(binaryAnalyzeManager) {}
+    binaryAnalyzeManager(binaryAnalyzeManager),
+    dumpPipelineManager(dumpPipelineManager) {}
 
 void I2cEepromShell::run(uint8_t addr) {
 
@@ -87,6 +89,8 @@ void I2cEepromShell::cmdAnalyze() {
     // Format and print the analysis result
     auto summary = binaryAnalyzeManager.formatAnalysis(result);
     terminalView.println(summary);
+    terminalView.println(binaryAnalyzeManager.formatEntropyMap(result));
+    terminalView.println(binaryAnalyzeManager.formatLayout(result));
 
     // Files
     if (!result.foundFiles.empty()) {
@@ -148,21 +152,42 @@ void I2cEepromShell::cmdWrite() {
 }
 
 void I2cEepromShell::cmdDump() {
-    uint32_t addr = 0;
     uint32_t count = i2cService.eepromLength();
 
+    // Output
     terminalView.println("");
-
-    const uint8_t bytesPerLine = 16;
-    for (uint32_t i = 0; i < count; i += bytesPerLine) {
-        std::vector<uint8_t> line;
-        for (uint8_t j = 0; j < bytesPerLine && (i + j) < count; ++j) {
-            line.push_back(i2cService.eepromReadByte(addr + i + j));
+    auto output = static_cast<DumpOutputEnum>(
+        userInputManager.readValidatedChoiceIndex("Dump output", DumpOutputEnumMapper::getAll(), 0)
+    );
+    auto fetch = [&](uint32_t addr, uint8_t* buf, uint32_t len) {
+        i2cService.eepromReadBuffer(addr, buf, len);
+        return true;
+    };
+
+    // Raw to SD, mounted on the SPI pins with its own CS
+    if (output == DumpOutputEnum::RawSd) {
+        auto path = userInputManager.readValidatedFilePath("SD file path", "/eeprom.bin");
+        std::vector<uint8_t> pins = { state.getI2cSdaPin(), state.getI2cSclPin() };
+        uint8_t sdCs = userInputManager.readValidatedPinNumber("SD card CS pin", SPI_CS_PIN, pins);
+        dumpPipelineManager.dumpToSd(0, count, fetch, path, sdCs, 1024, pins);
+
+        // Unmounting the SD reset the shared pins
+        if (dumpPipelineManager.sharesSdBus(pins, sdCs)) {
+            i2cService.configure(pins[0], pins[1], state.getI2cFrequency());
         }
+        return;
+    }
 
-        std::string formatted = argTransformer.toAsciiLine(addr + i, line);
-        terminalView.println(formatted);
+    // Raw to terminal
+    if (output == DumpOutputEnum::RawTerminal) {
+        dumpPipelineManager.dumpToTerminal(0, count, fetch, 256);
+        return;
     }
+
+    terminalView.println("");
+
+    // Read next chunks while the previous ones are displayed
+    dumpPipelineManager.dump(0, count, fetch, 256);
 }
 
 void I2cEepromShell::cmdErase() {
@@ -6,6 +6,8 @@
 #include "Transformers/ArgTransformer.h"
 #include "Services/I2cService.h"
 #include "Managers/BinaryAnalyzeManager.h"
+#include "Managers/DumpPipelineManager.h"
+#include "States/GlobalState.h"
 
 class I2cEepromShell {
 public:
@@ -15,7 +17,8 @@ public:
         I2cService& i2cService,
         ArgTransformer& argTransformer,
         UserInputManager& userInputManager,
-        BinaryAnalyzeManager & binaryAnalyzeManager
+        BinaryAnalyzeManager & binaryAnalyzeManager,
+        DumpPipelineManager& dumpPipelineManager
     );
 
     void run(uint8_t addr = 0x50);
@@ -60,6 +63,8 @@ private:
     ArgTransformer& argTransformer;
     UserInputManager& userInputManager;
     BinaryAnalyzeManager& binaryAnalyzeManager;
+    DumpPipelineManager& dumpPipelineManager;
+    GlobalState& state = GlobalState::getInstance();
     std::string selectedModel = "Unknown";
     uint32_t selectedLength = 0;
     bool initialized = false;
@@ -6,14 +6,16 @@ SpiEepromShell::SpiEepromShell(
     IInput& input,
     ArgTransformer& argTransformer,
     UserInputManager& userInputManager,
-    BinaryAnalyzeManager& binaryAnalyzeManager
+    BinaryAnalyzeManager& binaryAnalyzeManager,
+    DumpPipelineManager& dumpPipelineManager
 ) :
     spiService(spiService),
     terminalView(view),
     terminalInput(input),
     argTransformer(argTransformer),
     userInputManager(userInputManager),
-    binaryAnalyzeManager(binaryAnalyzeManager)
+    binaryAnalyzeManager(binaryAnalyzeManager),
+    dumpPipelineManager(dumpPipelineManager)
 {
 }
 
@@ -147,34 +149,38 @@ void SpiEepromShell::cmdWrite() {
 }
 
 void SpiEepromShell::cmdDump() {
-    terminalView.println("\n🗃️ EEPROM Dump: Reading entire memory...");
-
-    const uint32_t totalSize = eepromSize;
-    const uint32_t lineSize = 16;
-    uint8_t buffer[lineSize];
+    // Output
+    terminalView.println("");
+    auto output = static_cast<DumpOutputEnum>(
+        userInputManager.readValidatedChoiceIndex("Dump output", DumpOutputEnumMapper::getAll(), 0)
+    );
+    auto fetch = [&](uint32_t addr, uint8_t* buf, uint32_t len) {
+        return spiService.readEepromBuffer(addr, buf, len);
+    };
+
+    // Raw to SD, the card sits on the same SPI bus with its own CS
+    if (output == DumpOutputEnum::RawSd) {
+        auto path = userInputManager.readValidatedFilePath("SD file path", "/eeprom.bin");
+        uint8_t sdCs = userInputManager.readValidatedPinNumber("SD card CS pin", SPI_CS_PIN, { state.getSpiCSPin() });
+        dumpPipelineManager.dumpToSd(0, eepromSize, fetch, path, sdCs, 1024);
+
+        // Unmounting the SD ended the bus
+        spiService.configure(state.getSpiMOSIPin(), state.getSpiMISOPin(), state.getSpiCLKPin(), state.getSpiCSPin(), state.getSpiFrequency());
+        return;
+    }
 
-    for (uint32_t addr = 0; addr < totalSize; addr += lineSize) {
-        // Read line
-        bool ok = spiService.readEepromBuffer(addr, buffer, lineSize);
-        if (!ok) {
-            terminalView.println("\n ❌ Read failed at 0x" + argTransformer.toHex(addr, 6));
-            return;
-        }
+    // Raw to terminal
+    if (output == DumpOutputEnum::RawTerminal) {
+        dumpPipelineManager.dumpToTerminal(0, eepromSize, fetch, 256);
+        return;
+    }
 
-        // Format and print line
-        std::vector<uint8_t> line(buffer, buffer + lineSize);
-        std::string formattedLine = argTransformer.toAsciiLine(addr, line);
-        terminalView.println(formattedLine);
+    terminalView.println("\n🗃️ EEPROM Dump: Reading entire memory...");
 
-        // Quit
-        char c = terminalInput.readChar();
-        if (c == '\r' || c == '\n') {
-            terminalView.println("\n ❌ Dump cancelled by user.");
-            return;
-        }
-    }
+    // Read next chunks while the previous ones are displayed
+    bool done = dumpPipelineManager.dump(0, eepromSize, fetch, 256);
 
-    terminalView.println("\n ✅ EEPROM Dump Done.");
+    if (done) terminalView.println("\n ✅ EEPROM Dump Done.");
 }
 
 void SpiEepromShell::cmdErase() {
@@ -227,6 +233,8 @@ void SpiEepromShell::cmdAnalyze() {
     // Summary
     auto summary = binaryAnalyzeManager.formatAnalysis(result);
     terminalView.println(summary);
+    terminalView.println(binaryAnalyzeManager.formatEntropyMap(result));
+    terminalView.println(binaryAnalyzeManager.formatLayout(result));
 
     // Secrets
     if (!result.foundSecrets.empty()) {
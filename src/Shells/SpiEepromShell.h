@@ -6,6 +6,7 @@
 #include "Transformers/ArgTransformer.h"
 #include "Managers/UserInputManager.h"
 #include "Managers/BinaryAnalyzeManager.h"
+#include "Managers/DumpPipelineManager.h"
 #include "States/GlobalState.h"
 
 class SpiEepromShell {
@@ -16,7 +17,8 @@ public:
         IInput& input,
         ArgTransformer& argTransformer,
         UserInputManager& userInputManager,
-        BinaryAnalyzeManager& binaryAnalyzeManager
+        BinaryAnalyzeManager& binaryAnalyzeManager,
+        DumpPipelineManager& dumpPipelineManager
     );
 
     void run();
@@ -28,6 +30,7 @@ private:
     ArgTransformer& argTransformer;
     UserInputManager& userInputManager;
     BinaryAnalyzeManager& binaryAnalyzeManager;
+    DumpPipelineManager& dumpPipelineManager;
     GlobalState& state = GlobalState::getInstance();
     uint32_t eepromSize = 8192; // default
     uint16_t pageSize = 64; // default
@@ -6,14 +6,16 @@ SpiFlashShell::SpiFlashShell(
     IInput& input,
     ArgTransformer& argTransformer,
     UserInputManager& userInputManager,
-    BinaryAnalyzeManager& binaryAnalyzeManager
+    BinaryAnalyzeManager& binaryAnalyzeManager,
+    DumpPipelineManager& dumpPipelineManager
 )
     : spiService(spiService),
       terminalView(view),
       terminalInput(input),
       argTransformer(argTransformer),
       userInputManager(userInputManager),
-      binaryAnalyzeManager(binaryAnalyzeManager)
+      binaryAnalyzeManager(binaryAnalyzeManager),
+      dumpPipelineManager(dumpPipelineManager)
 {
     // Nothing
 }
@@ -77,6 +79,7 @@ void SpiFlashShell::cmdProbe() {
     if (chip) {
         terminalView.println("Manufacturer: " + std::string(chip->manufacturerName));
         terminalView.println("Model: " + std::string(chip->modelName));
+        terminalView.println("Read mode: " + FlashReadModeEnumMapper::toString(chip->readMode));
         terminalView.println("Capacity: " +
             std::to_string(chip->capacityBytes / (1024UL * 1024UL)) + " MB\n");
         return;
@@ -115,17 +118,21 @@ void SpiFlashShell::cmdAnalyze() {
     uint32_t flashSize = chip ? chip->capacityBytes : spiService.calculateFlashCapacity(id[2]);
 
     // Analyze
+    beginWideRead();
     BinaryAnalyzeManager::AnalysisResult result = binaryAnalyzeManager.analyze(
         0,
         flashSize,
         [&](uint32_t addr, uint8_t* buf, uint32_t len) {
-            spiService.readFlashData(addr, buf, len);
+            spiService.readFlashData(addr, buf, len, readMode);
         }
     );
+    endWideRead();
 
     // Calculate Summary
     auto summary = binaryAnalyzeManager.formatAnalysis(result);
     terminalView.println(summary);
+    terminalView.println(binaryAnalyzeManager.formatEntropyMap(result));
+    terminalView.println(binaryAnalyzeManager.formatLayout(result));
 
     // Secrets
     if (!result.foundSecrets.empty()) {
@@ -175,8 +182,9 @@ void SpiFlashShell::cmdStrings() {
     uint32_t flashSize = chip ? chip->capacityBytes : spiService.calculateFlashCapacity(id[2]);
 
     // Read flash in chuncks
+    beginWideRead();
     for (uint32_t addr = 0; addr < flashSize; addr += blockSize) {
-        spiService.readFlashData(addr, buffer, blockSize);
+        spiService.readFlashData(addr, buffer, blockSize, readMode);
 
         // Read blocks
         for (uint32_t i = 0; i < blockSize; ++i) {
@@ -202,11 +210,13 @@ void SpiFlashShell::cmdStrings() {
             // Quit if user presses ENTER
             char c = terminalInput.readChar();
             if (c == '\r' || c == '\n') {
+                endWideRead();
                 terminalView.println("\nSPI Flash: Extraction cancelled by user.");
                 return;
             }
         }
     }
+    endWideRead();
 
     // if remaining string
     if (inString && currentStr.length() >= minStringLen) {
@@ -225,17 +235,32 @@ void SpiFlashShell::cmdSearch() {
     // Check chip presence
     if (!checkFlashPresent()) return;
 
-    auto startAddr = 0;
+    uint32_t startAddr = 0;
+    PatternSearchManager search;
 
-    // Search pattern
-    terminalView.print("Enter string search pattern: ");
-    std::string pattern = userInputManager.getLine();
-
-    terminalView.println("\nSearching for \"" + pattern + "\" in SPI flash from 0x" + argTransformer.toHex(startAddr, 6) + "... Press [ENTER] to stop.\n");
-
-    const uint32_t blockSize = 512;
-    const uint32_t contextSize = 16;  // characters before and after
-    uint8_t buffer[blockSize + 32];
+    // Case only matters for the text parts
+    terminalView.println("");
+    bool ignoreCase = userInputManager.readYesNo("Ignore case", false);
+
+    // Search patterns, all found in one pass
+    terminalView.println("\nPatterns: text, hex bytes in braces, ?? for any byte (e.g. ssh-rsa, {7F 45 4C 46}, key={?? 00}).");
+    terminalView.println("One per line, empty line to start.");
+    while (search.patternCount() < MAX_SEARCH_PATTERNS) {
+        terminalView.print("Pattern " + std::to_string(search.patternCount() + 1) + ": ");
+        std::string pattern = userInputManager.getLine();
+        if (pattern.empty()) break;
+        if (!search.addPattern(pattern, ignoreCase)) {
+            terminalView.println("Invalid pattern.");
+        }
+    }
+    if (search.patternCount() == 0) {
+        terminalView.println("No pattern, search aborted.\n");
+        return;
+    }
+    if (!search.compile()) {
+        terminalView.println("Too many patterns.\n");
+        return;
+    }
 
     // Get flash size
     uint8_t id[3];
@@ -243,62 +268,87 @@ void SpiFlashShell::cmdSearch() {
     const FlashChipInfo* chip = findFlashInfo(id[0], id[1], id[2]);
     uint32_t flashSize = chip ? chip->capacityBytes : spiService.calculateFlashCapacity(id[2]);
 
-    // Read flash in chunks
-    for (uint32_t addr = startAddr; addr < flashSize; addr += blockSize - pattern.size()) {
-        spiService.readFlashData(addr, buffer, blockSize + pattern.size() - 1);
-        
-        // Read block
-        for (uint32_t i = 0; i <= blockSize; ++i) {
-            if (i + pattern.size() > blockSize + pattern.size() - 1) break;
-
-            bool match = true;
-            for (size_t j = 0; j < pattern.size(); ++j) {
-                if (buffer[i + j] != pattern[j]) {
-                    match = false;
-                    break;
-                }
-            }
-            
-            // Found a matching string
-            if (match) {
-                uint32_t matchAddr = addr + i;
-                std::string context;
-
-                // Before the pattern
-                for (int j = (int)i - (int)contextSize; j < (int)i; ++j) {
-                    if (j >= 0) {
-                        char c = (char)buffer[j];
-                        context += (isprint(c) ? c : '.');
-                    }
-                }
+    terminalView.println("\nSearching " + std::to_string(search.patternCount()) + " pattern(s) in SPI flash from 0x" + argTransformer.toHex(startAddr, 6) + "... Press [ENTER] to stop.\n");
 
-                // Pattern
-                context += "[";
-                for (size_t j = 0; j < pattern.size(); ++j) {
-                    char c = (char)buffer[i + j];
-                    context += (isprint(c) ? c : '.');
-                }
-                context += "]";
+    const uint32_t contextSize = 16;  // characters before and after
+    size_t longest = 0;
+    for (uint16_t i = 0; i < search.patternCount(); ++i) {
+        longest = std::max(longest, search.patternLength(i));
+    }
+    const uint32_t keep = 2 * contextSize + longest;
+
+    // Sliding window over the stream, matches wait for their trailing context
+    std::vector<uint8_t> window;
+    uint32_t windowStart = startAddr;
+    std::vector<PatternMatch> waiting;
+    uint32_t found = 0;
+
+    auto printMatch = [&](const PatternMatch& m) {
+        uint32_t windowEnd = windowStart + window.size();
+        uint32_t from = std::max(windowStart, m.offset >= contextSize ? m.offset - contextSize : 0);
+        uint32_t to = std::min(windowEnd, m.offset + m.length + contextSize);
+
+        std::string context;
+        for (uint32_t a = from; a < to; ++a) {
+            if (a == m.offset) context += "[";
+            char c = (char)window[a - windowStart];
+            context += (isprint((unsigned char)c) ? c : '.');
+            if (a + 1 == m.offset + m.length) context += "]";
+        }
 
-                // After the pattern
-                for (uint32_t j = i + pattern.size(); j < i + pattern.size() + contextSize && j < blockSize + pattern.size(); ++j) {
-                    char c = (char)buffer[j];
-                    context += (isprint(c) ? c : '.');
-                }
+        std::string line = "0x" + argTransformer.toHex(m.offset, 6) + ": " + context;
+        if (search.patternCount() > 1) line += "  (" + search.patternLabel(m.pattern) + ")";
+        terminalView.println(line);
+        found++;
+    };
+
+    search.reset(startAddr);
+    beginWideRead();
+    bool completed = dumpPipelineManager.stream(
+        startAddr,
+        flashSize - startAddr,
+        [&](uint32_t addr, uint8_t* buf, uint32_t len) {
+            spiService.readFlashData(addr, buf, len, readMode);
+            return true;
+        },
+        4096,
+        [&](uint32_t address, const uint8_t* data, uint32_t len) {
+            window.insert(window.end(), data, data + len);
+            search.feed(data, len, [&](const PatternMatch& m) { waiting.push_back(m); });
+
+            // Print the matches with their context available
+            uint32_t windowEnd = windowStart + window.size();
+            size_t kept = 0;
+            for (const auto& m : waiting) {
+                if (m.offset + m.length + contextSize <= windowEnd) printMatch(m);
+                else waiting[kept++] = m;
+            }
+            waiting.resize(kept);
 
-                terminalView.println("0x" + argTransformer.toHex(matchAddr, 6) + ": " + context);
+            // Only keep what a later match can show as context
+            if (window.size() > keep) {
+                size_t drop = window.size() - keep;
+                window.erase(window.begin(), window.begin() + drop);
+                windowStart += drop;
             }
 
             // Allow user to interrupt
             char c = terminalInput.readChar();
             if (c == '\r' || c == '\n') {
                 terminalView.println("\nSPI Flash Search: Cancelled by user.\n");
-                return;
+                return false;
             }
+            return true;
         }
-    }
+    );
 
-    terminalView.println("\nSearch complete.");
+    endWideRead();
+
+    // End of flash, print the rest with a shorter context
+    if (completed) {
+        for (const auto& m : waiting) printMatch(m);
+        terminalView.println("\nSearch complete, " + std::to_string(found) + " match(es).");
+    }
 }
 
 /*
@@ -323,10 +373,6 @@ void SpiFlashShell::cmdRead() {
 Flash Read In Chunks
 */
 void SpiFlashShell::readFlashInChunks(uint32_t address, uint32_t length) {
-    uint8_t buffer[1024];
-    uint32_t remaining = length;
-    uint32_t currentAddr = address;
-
     // Verify flash capacity
     uint8_t id[3];
     spiService.readFlashIdRaw(id);
@@ -341,48 +387,17 @@ void SpiFlashShell::readFlashInChunks(uint32_t address, uint32_t length) {
         terminalView.println(capStr.str());
     }
 
-    // Display chunks
-    while (remaining > 0) {
-        uint32_t chunkSize = (remaining > 1024) ? 1024 : remaining;
-        spiService.readFlashData(currentAddr, buffer, chunkSize);
-
-        for (uint32_t i = 0; i < chunkSize; i += 16) {
-            std::stringstream line;
-
-            // Address
-            line << std::hex << std::uppercase << std::setfill('0')
-                 << std::setw(6) << (currentAddr + i) << ": ";
-
-            // Hex
-            for (uint32_t j = 0; j < 16; ++j) {
-                if (i + j < chunkSize) {
-                    line << std::setw(2) << (int)buffer[i + j] << " ";
-                } else {
-                    line << "   ";
-                }
-            }
-
-            // ASCII
-            line << " ";
-            for (uint32_t j = 0; j < 16; ++j) {
-                if (i + j < chunkSize) {
-                    char c = static_cast<char>(buffer[i + j]);
-                    line << (isprint(c) ? c : '.');
-                }
-            }
-            terminalView.println(line.str());
-
-            // Check user ENTER to stop
-            char c = terminalInput.readChar();
-            if (c == '\r' || c == '\n') {
-                terminalView.println("\nRead interrupted by user.");
-                return;
-            }
+    // Read next chunks while the previous ones are displayed
+    beginWideRead();
+    dumpPipelineManager.dump(
+        address,
+        length,
+        [&](uint32_t addr, uint8_t* buf, uint32_t len) {
+            spiService.readFlashData(addr, buf, len, readMode);
+            return true;
         }
-
-        currentAddr += chunkSize;
-        remaining -= chunkSize;
-    }
+    );
+    endWideRead();
 }
 
 /*
@@ -484,20 +499,64 @@ Flash Dump
 void SpiFlashShell::cmdDump() {
     if (!checkFlashPresent()) return;
 
-    terminalView.println("\nSPI Flash: Full dump from 0x000000... Press [ENTER] to stop.\n");
-
     // Obtenir la capacité
     uint8_t id[3];
     spiService.readFlashIdRaw(id);
     const FlashChipInfo* chip = findFlashInfo(id[0], id[1], id[2]);
     uint32_t flashSize = chip ? chip->capacityBytes : spiService.calculateFlashCapacity(id[2]);
 
+    // Output
+    terminalView.println("");
+    int outputIndex = userInputManager.readValidatedChoiceIndex("Dump output", DumpOutputEnumMapper::getAll(), 0);
+    if (outputIndex < 0) return;
+    auto output = static_cast<DumpOutputEnum>(outputIndex);
+
     // Lecture par morceaux
-    readFlashInChunks(0, flashSize);
+    if (output == DumpOutputEnum::HexLines) {
+        terminalView.println("\nSPI Flash: Full dump from 0x000000... Press [ENTER] to stop.\n");
+        readFlashInChunks(0, flashSize);
+        terminalView.println("\nSPI Flash Dump: Done.\n");
+        return;
+    }
 
-    terminalView.println("\nSPI Flash Dump: Done.\n");
+    auto fetch = [&](uint32_t addr, uint8_t* buf, uint32_t len) {
+        spiService.readFlashData(addr, buf, len, readMode);
+        return true;
+    };
+
+    if (output == DumpOutputEnum::RawTerminal) {
+        beginWideRead();
+        dumpPipelineManager.dumpToTerminal(0, flashSize, fetch);
+        endWideRead();
+        terminalView.println("");
+        return;
+    }
+
+    // The SD card sits on the same SPI bus, with its own CS
+    auto path = userInputManager.readValidatedFilePath("SD file path", "/flash.bin");
+    uint8_t sdCs = userInputManager.readValidatedPinNumber("SD card CS pin", SPI_CS_PIN, { state.getSpiCSPin() });
+
+    // No wide session, the card needs the Arduino SPI: Dual/Quad chips are read in Fast mode
+    dumpPipelineManager.dumpToSd(0, flashSize, fetch, path, sdCs);
+
+    // Unmounting the SD ended the bus
+    spiService.configure(state.getSpiMOSIPin(), state.getSpiMISOPin(), state.getSpiCLKPin(), state.getSpiCSPin(), state.getSpiFrequency());
+    terminalView.println("");
+}
+
+
+/*
+Wide Read
+*/
+void SpiFlashShell::beginWideRead() {
+    if (readMode == FlashReadModeEnum::DualOutput || readMode == FlashReadModeEnum::QuadOutput) {
+        spiService.beginWideRead();
+    }
 }
 
+void SpiFlashShell::endWideRead() {
+    spiService.endWideRead();
+}
 
 /*
 Check Chip
@@ -514,5 +573,9 @@ bool SpiFlashShell::checkFlashPresent() {
         return false;
     }
 
+    // Widest read known for this chip, unknown chips stay on plain 0x03
+    const FlashChipInfo* chip = findFlashInfo(id[0], id[1], id[2]);
+    readMode = chip ? chip->readMode : FlashReadModeEnum::Standard;
+
     return true;
 }
\ No newline at end of file
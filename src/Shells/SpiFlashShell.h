@@ -6,6 +6,8 @@
 #include "Transformers/ArgTransformer.h"
 #include "Services/SpiService.h"
 #include "Managers/BinaryAnalyzeManager.h"
+#include "Managers/DumpPipelineManager.h"
+#include "Managers/PatternSearchManager.h"
 #include "Models/TerminalCommand.h"
 #include "States/GlobalState.h"
 
@@ -17,7 +19,8 @@ public:
         IInput& input,
         ArgTransformer& argTransformer,
         UserInputManager& userInputManager,
-        BinaryAnalyzeManager& binaryAnalyzeManager
+        BinaryAnalyzeManager& binaryAnalyzeManager,
+        DumpPipelineManager& dumpPipelineManager
     );
 
     void run();
@@ -26,7 +29,7 @@ private:
     const std::vector<std::string> actions = {
         " 🔍 Probe Flash",
         " 📊 Analyze Flash",
-        " 🔎 Search string",
+        " 🔎 Search patterns",
         " 📜 Extract strings",
         " 📖 Read bytes",
         " ✏️  Write bytes",
@@ -35,13 +38,17 @@ private:
         " 🚪 Exit Shell"
     };
 
+    static constexpr size_t MAX_SEARCH_PATTERNS = 16;
+
     SpiService& spiService;
     ITerminalView& terminalView;
     IInput& terminalInput;
     ArgTransformer& argTransformer;
     UserInputManager& userInputManager;
     BinaryAnalyzeManager& binaryAnalyzeManager;
+    DumpPipelineManager& dumpPipelineManager;
     GlobalState& state = GlobalState::getInstance();
+    FlashReadModeEnum readMode = FlashReadModeEnum::Standard;
 
     void cmdProbe();
     void cmdAnalyze();
@@ -51,6 +58,10 @@ private:
     void cmdWrite();
     void cmdErase();
     void cmdDump();
+
+    // Dual/Quad chips keep the IDF driver for a whole read command
+    void beginWideRead();
+    void endWideRead();
     void readFlashInChunks(uint32_t address, uint32_t length);
     bool checkFlashPresent();
 };
@@ -5,12 +5,14 @@ ThreeWireEepromShell::ThreeWireEepromShell(
     IInput& terminalInput,
     UserInputManager& userInputManager,
     ThreeWireService& threeWireService,
-    ArgTransformer& argTransformer)
+    ArgTransformer& argTransformer,
+    DumpPipelineManager& dumpPipelineManager)
     : terminalView(terminalView),
       terminalInput(terminalInput),
       userInputManager(userInputManager),
       threeWireService(threeWireService),
-      argTransformer(argTransformer) {}
+      argTransformer(argTransformer),
+      dumpPipelineManager(dumpPipelineManager) {}
 
 void ThreeWireEepromShell::run() {
 
@@ -188,26 +190,57 @@ EEPROM Dump
 */
 void ThreeWireEepromShell::cmdDump() {
     bool isOrg8 = state.isThreeWireOrg8();
-    uint16_t start = 0;
+    uint32_t size = threeWireService.getSizeBytes();
 
-    terminalView.println("");
-    if (isOrg8) {
-        auto data = threeWireService.dump8();
-        for (size_t i = start; i < data.size(); i += 16) {
-            uint32_t addr = i;
-            size_t chunkSize = std::min<size_t>(16, data.size() - i);
-            std::vector<uint8_t> chunk(data.begin() + i, data.begin() + i + chunkSize);
-            terminalView.println(argTransformer.toAsciiLine(addr, chunk));
+    // 16-bit words as big endian pairs
+    auto fetch = [&](uint32_t addr, uint8_t* buf, uint32_t len) {
+        if (isOrg8) {
+            for (uint32_t i = 0; i < len; ++i) buf[i] = threeWireService.read8(addr + i);
+        } else {
+            for (uint32_t i = 0; i + 1 < len; i += 2) {
+                uint16_t word = threeWireService.read16((addr + i) / 2);
+                buf[i] = word >> 8;
+                buf[i + 1] = word & 0xFF;
+            }
         }
-    } else {
-        auto data = threeWireService.dump16();
-        for (size_t i = start; i < data.size(); i += 8) {
-            uint32_t addr = i * 2;
-            size_t chunkSize = std::min<size_t>(8, data.size() - i);
-            std::vector<uint16_t> chunk(data.begin() + i, data.begin() + i + chunkSize);
-            terminalView.println(argTransformer.toAsciiLine(addr, chunk));
+        return true;
+    };
+
+    // Output
+    terminalView.println("");
+    auto output = static_cast<DumpOutputEnum>(
+        userInputManager.readValidatedChoiceIndex("Dump output", DumpOutputEnumMapper::getAll(), 0)
+    );
+
+    // Raw to SD, mounted on the SPI pins with its own CS
+    if (output == DumpOutputEnum::RawSd) {
+        auto path = userInputManager.readValidatedFilePath("SD file path", "/eeprom.bin");
+        uint8_t sdCs = userInputManager.readValidatedPinNumber("SD card CS pin", SPI_CS_PIN, { state.getThreeWireCsPin() });
+        std::vector<uint8_t> pins = {
+            state.getThreeWireCsPin(), state.getThreeWireSkPin(), state.getThreeWireDiPin(), state.getThreeWireDoPin()
+        };
+        dumpPipelineManager.dumpToSd(0, size, fetch, path, sdCs, 1024, pins);
+
+        // Unmounting the SD reset the shared pins
+        if (dumpPipelineManager.sharesSdBus(pins, sdCs)) {
+            auto models = threeWireService.getSupportedModels();
+            int modelId = threeWireService.resolveModelId(models[state.getThreeWireEepromModelIndex()]);
+            threeWireService.configure(pins[0], pins[1], pins[2], pins[3], modelId, isOrg8);
         }
+        terminalView.println("");
+        return;
     }
+
+    // Raw to terminal
+    if (output == DumpOutputEnum::RawTerminal) {
+        dumpPipelineManager.dumpToTerminal(0, size, fetch, 128);
+        terminalView.println("");
+        return;
+    }
+
+    // Read next chunks while the previous ones are displayed
+    terminalView.println("");
+    dumpPipelineManager.dump(0, size, fetch, 128, isOrg8 ? 1 : 2);
     terminalView.println("");
 }
 
@@ -4,6 +4,7 @@
 #include "Interfaces/ITerminalView.h"
 #include "Interfaces/IInput.h"
 #include "Managers/UserInputManager.h"
+#include "Managers/DumpPipelineManager.h"
 #include "Services/ThreeWireService.h"
 #include "Transformers/ArgTransformer.h"
 #include "States/GlobalState.h"
@@ -15,7 +16,8 @@ public:
         IInput& terminalInput,
         UserInputManager& userInputManager,
         ThreeWireService& threeWireService,
-        ArgTransformer& argTransformer);
+        ArgTransformer& argTransformer,
+        DumpPipelineManager& dumpPipelineManager);
 
     void run();
 
@@ -32,5 +34,6 @@ private:
     UserInputManager& userInputManager;
     ThreeWireService& threeWireService;
     ArgTransformer& argTransformer;
+    DumpPipelineManager& dumpPipelineManager;
     GlobalState& state = GlobalState::getInstance();
 };
@@ -6,6 +6,8 @@
 #include "Enums/InfraredProtocolEnum.h"
 #include "Enums/ModeEnum.h"
 #include "Enums/TerminalTypeEnum.h"
+#include "Enums/TraceModeEnum.h"
+#include "States/PinOwnership.h"
 
 class GlobalState {
 private:
@@ -40,9 +42,16 @@ private:
     // Terminal transmission mode
     TerminalTypeEnum terminalMode = TerminalTypeEnum::Serial;
 
+    // Instruction trace
+    TraceModeEnum traceMode = TraceModeEnum::Summary;
+    bool preciseTiming = false; // cycle counter delays
+
     //  Current selected mode
     ModeEnum currentMode = ModeEnum::HIZ;
 
+    // Last mode or GPIO use of each pin
+    PinOwnership pinOwnership;
+
     // PC Terminal Serial Configuration
     unsigned long serialTerminalBaudRate = 115200;
 
@@ -182,10 +191,18 @@ public:
     TerminalTypeEnum getTerminalMode() const { return terminalMode; }
     void setTerminalMode(TerminalTypeEnum mode) { terminalMode = mode; }
 
+    TraceModeEnum getTraceMode() const { return traceMode; }
+    void setTraceMode(TraceModeEnum mode) { traceMode = mode; }
+    bool isPreciseTiming() const { return preciseTiming; }
+    void setPreciseTiming(bool precise) { preciseTiming = precise; }
+
     // Current Mode
     ModeEnum getCurrentMode() const { return currentMode; }
     void setCurrentMode(ModeEnum mode) { currentMode = mode; }
 
+    // Pin ownership
+    PinOwnership& getPinOwnership() { return pinOwnership; }
+
     // Serial Terminal Baud
     unsigned long getSerialTerminalBaudRate() const { return serialTerminalBaudRate; }
     void setSerialTerminalBaudRate(unsigned long rate) { serialTerminalBaudRate = rate; }
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <initializer_list>
+#include <string_view>
+#include <vector>
+#include "Enums/ModeEnum.h"
+
+/*
+Which mode configured each GPIO and shared peripheral last.
+
+A mode claims its pins and peripherals with a signature of its settings
+when it is entered. The claim only asks for a reconfiguration when
+something else took one of them since, or when the settings changed,
+so going back to a mode does not tear down and glitch an intact bus.
+Resources held by a background job refuse such a reconfiguration.
+*/
+class PinOwnership {
+public:
+    // Peripheral units shared by several modes, claimed like pins
+    static constexpr uint8_t I2C_BUS = 64; // Wire
+    static constexpr uint8_t SPI_BUS = 65; // SPI, used by SPI, SD, CAN and CC1101
+
+    PinOwnership() {
+        for (auto& owner : owners) owner = ModeEnum::None;
+    }
+
+    // True when owner must configure its service, the claim is recorded either way
+    bool claim(ModeEnum owner, std::initializer_list<uint8_t> resources, uint32_t settings) {
+        return claim(owner, resources.begin(), resources.size(), settings);
+    }
+
+    bool claim(ModeEnum owner, const std::vector<uint8_t>& resources, uint32_t settings) {
+        return claim(owner, resources.data(), resources.size(), settings);
+    }
+
+    bool claim(ModeEnum owner, const uint8_t* resources, size_t count, uint32_t settings) {
+        size_t index = indexOf(owner);
+        bool stale = !valid[index] || signatures[index] != settings;
+        for (size_t i = 0; i < count; ++i) {
+            if (resources[i] < RESOURCE_COUNT && owners[resources[i]] != owner) stale = true;
+        }
+
+        if (!stale) {
+            skipped++;
+            return false;
+        }
+
+        // A background job still drives one of them, nothing may be reconfigured
+        refusedBy = holderOf(resources, count);
+        if (refusedBy) return false;
+
+        // Pins moved by a config go back to nobody
+        for (auto& current : owners) {
+            if (current == owner) current = ModeEnum::None;
+        }
+        for (size_t i = 0; i < count; ++i) take(resources[i], owner);
+
+        valid[index] = true;
+        signatures[index] = settings;
+        reconfigured++;
+        return true;
+    }
+
+    // Used outside of any bus (DIO, pull-ups, logic analyzer)
+    void take(uint8_t resource) {
+        take(resource, ModeEnum::None);
+    }
+
+    // The owner's service was ended or driven by a shell, its next claim configures
+    void release(ModeEnum owner) {
+        valid[indexOf(owner)] = false;
+    }
+
+    // Resources of a background job, kept until the job ends
+    void hold(uint8_t job, const std::vector<uint8_t>& resources) {
+        for (uint8_t resource : resources) {
+            if (resource < RESOURCE_COUNT) holders[resource] = job;
+        }
+    }
+
+    void unhold(uint8_t job) {
+        for (auto& holder : holders) {
+            if (holder == job) holder = 0;
+        }
+    }
+
+    // Job holding one of the resources, 0 for none
+    uint8_t holderOf(const uint8_t* resources, size_t count) const {
+        for (size_t i = 0; i < count; ++i) {
+            if (resources[i] < RESOURCE_COUNT && holders[resources[i]]) return holders[resources[i]];
+        }
+        return 0;
+    }
+
+    uint8_t holderOf(const std::vector<uint8_t>& resources) const {
+        return holderOf(resources.data(), resources.size());
+    }
+
+    // Job that refused the last claim, 0 when none did. Reading it clears it
+    uint8_t takeRefusal() {
+        uint8_t job = refusedBy;
+        refusedBy = 0;
+        return job;
+    }
+
+    ModeEnum ownerOf(uint8_t resource) const {
+        return resource < RESOURCE_COUNT ? owners[resource] : ModeEnum::None;
+    }
+
+    // FNV-1a of the settings a service is configured with
+    static uint32_t signature(std::initializer_list<uint32_t> values) {
+        uint32_t h = 2166136261u;
+        for (uint32_t value : values) {
+            for (int shift = 0; shift < 32; shift += 8) h = (h ^ ((value >> shift) & 0xFF)) * 16777619u;
+        }
+        return h;
+    }
+
+    static uint32_t signature(std::string_view text) {
+        uint32_t h = 2166136261u;
+        for (char c : text) h = (h ^ static_cast<uint8_t>(c)) * 16777619u;
+        return h;
+    }
+
+    // Claims that configured and that were skipped
+    uint32_t getReconfigured() const { return reconfigured; }
+    uint32_t getSkipped() const { return skipped; }
+
+private:
+    static constexpr size_t RESOURCE_COUNT = 66;
+    static constexpr size_t OWNER_COUNT = static_cast<size_t>(ModeEnum::COUNT);
+
+    ModeEnum owners[RESOURCE_COUNT];
+    uint8_t holders[RESOURCE_COUNT] = {}; // job ids, 0 for none
+    uint8_t refusedBy = 0;
+    uint32_t signatures[OWNER_COUNT] = {};
+    bool valid[OWNER_COUNT] = {};
+    uint32_t reconfigured = 0;
+    uint32_t skipped = 0;
+
+    void take(uint8_t resource, ModeEnum owner) {
+        if (resource >= RESOURCE_COUNT) return; // unused pin, eg. 0xFF
+        ModeEnum previous = owners[resource];
+        if (previous != owner && previous != ModeEnum::None) valid[indexOf(previous)] = false;
+        owners[resource] = owner;
+    }
+
+    static size_t indexOf(ModeEnum mode) {
+        return static_cast<size_t>(mode) < OWNER_COUNT ? static_cast<size_t>(mode) : 0;
+    }
+};
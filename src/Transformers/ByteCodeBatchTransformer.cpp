@@ -0,0 +1,178 @@
+#include "ByteCodeBatchTransformer.h"
+#include <cstdio>
+#include <Arduino.h>
+#include "Services/TimingService.h"
+
+/*
+Transform
+*/
+const std::vector<ByteCodeBatch>& ByteCodeBatchTransformer::transform(const ByteCodeProgram& program, bool duplex) {
+    this->program = &program;
+    batches.clear();
+    tx.clear();
+    readMask.clear();
+    size_t largest = 0;
+
+    const auto& ops = program.getOps();
+    for (uint32_t i = 0; i < ops.size(); ++i) {
+        const ByteCodeOp& op = ops[i];
+
+        // Extend the previous run when the direction allows it
+        bool extend = false;
+        if (isTransfer(op.command) && !batches.empty()) {
+            ByteCodeEnum previous = batches.back().command;
+            extend = previous == op.command || (duplex && isTransfer(previous));
+        }
+
+        if (!extend) {
+            batches.push_back({op.command, i, 0, static_cast<uint32_t>(tx.size()), 0, 0, 0, 0});
+        }
+
+        ByteCodeBatch& batch = batches.back();
+        batch.count++;
+        batch.length += op.length;
+        if (op.command == ByteCodeEnum::Read) {
+            // A duplex run reports as Read as soon as it brings data back
+            batch.command = ByteCodeEnum::Read;
+            batch.reads += op.length;
+        }
+        if (batch.command == ByteCodeEnum::Read && batch.length > largest) largest = batch.length;
+
+        // Writes are sent straight from the program, only duplex runs are staged
+        if (duplex && isTransfer(op.command)) {
+            if (op.command == ByteCodeEnum::Write) {
+                tx.insert(tx.end(), program.data(op), program.data(op) + op.length);
+            } else {
+                tx.insert(tx.end(), op.length, 0x00);
+            }
+            readMask.insert(readMask.end(), op.length, op.command == ByteCodeEnum::Read);
+        }
+    }
+
+    if (rx.size() < largest) rx.resize(largest);
+    return batches;
+}
+
+/*
+Payload
+*/
+const uint8_t* ByteCodeBatchTransformer::payload(const ByteCodeBatch& batch) const {
+    if (batch.command == ByteCodeEnum::Write) {
+        return program->data(program->getOps()[batch.first]);
+    }
+    return tx.data() + batch.offset;
+}
+
+bool ByteCodeBatchTransformer::isRead(uint32_t index) const {
+    return index < readMask.size() && readMask[index];
+}
+
+uint8_t* ByteCodeBatchTransformer::received() {
+    return rx.data();
+}
+
+bool ByteCodeBatchTransformer::isTransfer(ByteCodeEnum command) {
+    return command == ByteCodeEnum::Write || command == ByteCodeEnum::Read;
+}
+
+/*
+Trace
+*/
+void ByteCodeBatchTransformer::record(size_t batchIndex, uint32_t startCycle, uint32_t endCycle) {
+    if (batchIndex >= batches.size()) return;
+    batches[batchIndex].startCycle = startCycle;
+    batches[batchIndex].cycles = endCycle - startCycle;
+}
+
+double ByteCodeBatchTransformer::toMicros(uint32_t cycles) {
+    return static_cast<double>(cycles) / ESP.getCpuFreqMHz();
+}
+
+std::string ByteCodeBatchTransformer::formatTrace(TraceModeEnum mode) const {
+    if (mode == TraceModeEnum::Off || batches.empty() || !program) return "";
+
+    // Wall time from the first batch start to the last batch end
+    uint32_t origin = batches.front().startCycle;
+    uint32_t span = batches.back().startCycle + batches.back().cycles - origin;
+    uint32_t busy = 0;
+    for (const auto& batch : batches) busy += batch.cycles;
+
+    char line[112];
+    if (mode == TraceModeEnum::Summary) {
+        snprintf(line, sizeof(line), "Trace: %lu ops, %lu bus operations, %.1f us (%.1f us on the bus)",
+                 (unsigned long)program->size(), (unsigned long)batches.size(), toMicros(span), toMicros(busy));
+        return line;
+    }
+
+    // Merged ops go out in one transfer, the bus gives no time between them
+    snprintf(line, sizeof(line), "Trace (%lu MHz cycle counter), timed per bus operation:\n", (unsigned long)ESP.getCpuFreqMHz());
+    std::string out = line;
+    out += "  op     start us   duration us   command     bytes   (| same bus operation as above)\n";
+
+    const auto& ops = program->getOps();
+    for (const auto& batch : batches) {
+        for (uint32_t i = batch.first; i < batch.first + batch.count; ++i) {
+            const ByteCodeOp& op = ops[i];
+
+            // Timestamp on the first op, the others were on the same bus operation
+            if (i == batch.first) {
+                snprintf(line, sizeof(line), "  #%-4lu %10.3f %13.3f   %s",
+                         (unsigned long)i + 1, toMicros(batch.startCycle - origin), toMicros(batch.cycles),
+                         ByteCodeEnumMapper::toString(op.command).c_str());
+            } else {
+                snprintf(line, sizeof(line), "  #%-4lu %10s %13s   %s",
+                         (unsigned long)i + 1, "|", "|", ByteCodeEnumMapper::toString(op.command).c_str());
+            }
+            out += line;
+
+            if (isTransfer(op.command)) {
+                snprintf(line, sizeof(line), "  %5lu", (unsigned long)op.length);
+                out += line;
+            } else if (TimingService::isDelay(op.command)) {
+                snprintf(line, sizeof(line), "  x%lu", (unsigned long)op.length);
+                out += line;
+            }
+            out += "\n";
+        }
+    }
+
+    snprintf(line, sizeof(line), "  %lu bus operations, %.3f us total, %.3f us on the bus",
+             (unsigned long)batches.size(), toMicros(span), toMicros(busy));
+    out += line;
+    return out;
+}
+
+/*
+Jitter
+*/
+std::string ByteCodeBatchTransformer::formatJitter() const {
+    if (!program) return "";
+
+    std::string out;
+    char line[96];
+    double worst = 0;
+    double total = 0;
+    size_t delays = 0;
+
+    for (const auto& batch : batches) {
+        uint64_t requested = TimingService::requestedNs(batch.command, batch.length);
+        if (!requested) continue;
+
+        double measured = toMicros(batch.cycles) * 1000.0;
+        double error = measured - static_cast<double>(requested);
+        if (!delays) out += "  op     requested ns   measured ns     error ns\n";
+        snprintf(line, sizeof(line), "  #%-4lu %12llu %13.0f %+12.0f\n",
+                 (unsigned long)batch.first + 1, (unsigned long long)requested, measured, error);
+        out += line;
+
+        if (error < 0) error = -error;
+        if (error > worst) worst = error;
+        total += error;
+        delays++;
+    }
+
+    if (!delays) return "";
+    snprintf(line, sizeof(line), "  %lu delays, mean error %.0f ns, worst %.0f ns",
+             (unsigned long)delays, total / delays, worst);
+    return "Timing:\n" + out + line;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Models/ByteCodeProgram.h"
+#include "Models/ByteCodeBatch.h"
+#include "Enums/TraceModeEnum.h"
+
+class ByteCodeBatchTransformer {
+public:
+    // Group runs of Write/Read, duplex also merges Write with Read (SPI)
+    const std::vector<ByteCodeBatch>& transform(const ByteCodeProgram& program, bool duplex = false);
+
+    // Bytes to send, dummy 0x00 for the reads of a duplex batch
+    const uint8_t* payload(const ByteCodeBatch& batch) const;
+
+    // True when the staged byte at index is clocked for a read
+    bool isRead(uint32_t index) const;
+
+    // Scratch buffer for received bytes, sized to the largest read batch
+    uint8_t* received();
+
+    // Cycle counter around the batch, recorded for the trace
+    void record(size_t batchIndex, uint32_t startCycle, uint32_t endCycle);
+
+    // Summary line, or every op with the timestamp of its bus operation
+    std::string formatTrace(TraceModeEnum mode) const;
+
+    // Requested against measured time of every delay op
+    std::string formatJitter() const;
+
+private:
+    const ByteCodeProgram* program = nullptr;
+    std::vector<ByteCodeBatch> batches;
+    std::vector<uint8_t> tx;
+    std::vector<uint8_t> readMask;
+    std::vector<uint8_t> rx;
+
+    static bool isTransfer(ByteCodeEnum command);
+    static double toMicros(uint32_t cycles);
+};
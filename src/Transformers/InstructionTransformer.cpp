@@ -1,277 +1,219 @@
 #include "InstructionTransformer.h"
+#include <cctype>
+#include <charconv>
+#include <algorithm>
 
-std::vector<Instruction> InstructionTransformer::transform(const std::string& raw) {
-    std::vector<Instruction> instructions;
-    if (raw.empty()) return instructions;
+/*
+Transform
 
-    bool inChar = false;
-    bool inBlock = false;
-    bool inString = false;
-    std::string token;
-    std::string currentRaw;
-    Instruction* currentInstruction = nullptr;
-
-    for (char c : raw) {
-        if (inChar) {
-            token += c;
-            currentRaw += c;
-            if (c == '\'') {
-                if (currentInstruction) {
-                    currentInstruction->addToken(token);
-                }
-                token.clear();
-                inChar = false;
-            }
-            continue;
-        }
-
-        if (inString) {
-            token += c;
-            currentRaw += c;
-            if (c == '"') {
-                if (currentInstruction) {
-                    currentInstruction->addToken(token);
-                }
-                token.clear();
-                inString = false;
-                continue;
-            }
-            continue;
-        }
-
-
-        if (c == '\'') {
-            token = "'";
-            currentRaw += c;
-            inChar = true;
-            continue;
-        }
+Single pass over the line, tokens are views into raw and are compiled
+as soon as they end. '[' blocks are wrapped in Start/Stop, a block is
+closed by ']' or '}', or by the end of the line.
+*/
+void InstructionTransformer::transform(std::string_view raw, ByteCodeProgram& program, const std::vector<std::string>* variables) const {
+    program.clear();
 
-        if (c == '"') {
-            token = "\"";
-            currentRaw += c;
-            inString = true;
+    bool inBlock = false;
+    bool bracket = false;
+    size_t i = 0;
+
+    while (i < raw.size()) {
+        char c = raw[i];
+
+        // Quoted literal, kept whole with its quotes
+        if (c == '\'' || c == '"') {
+            size_t close = raw.find(c, i + 1);
+            if (close == std::string_view::npos) break;
+            if (inBlock) compileToken(raw.substr(i, close - i + 1), program, variables);
+            i = close + 1;
             continue;
         }
 
         if (c == '[' || c == '{' || c == '>') {
+            if (inBlock && bracket) program.emit(ByteCodeEnum::Stop);
             inBlock = true;
-            currentRaw = std::string(1, c);
-            currentInstruction = new Instruction(currentRaw);
-            currentInstruction->prefix = c;
+            bracket = c == '[';
+            if (bracket) program.emit(ByteCodeEnum::Start);
+            ++i;
             continue;
         }
 
-        if (c == ']') {
-            if (!token.empty() && currentInstruction) {
-                currentInstruction->addToken(token);
-                token.clear();
-            }
-            if (currentInstruction) {
-                currentRaw += c;
-                currentInstruction->raw = currentRaw;
-                instructions.push_back(*currentInstruction);
-                delete currentInstruction;
-                currentInstruction = nullptr;
-            }
+        if (c == ']' || c == '}') {
+            if (inBlock && bracket) program.emit(ByteCodeEnum::Stop);
             inBlock = false;
+            ++i;
             continue;
         }
 
-        if (inBlock) {
-            currentRaw += c;
-            if (std::isspace(c)) {
-                if (!token.empty() && currentInstruction) {
-                    currentInstruction->addToken(token);
-                    token.clear();
-                }
-            } else {
-                token += c;
-            }
+        if (!inBlock || std::isspace(static_cast<unsigned char>(c))) {
+            ++i;
+            continue;
         }
+
+        // Plain token, up to the next space, bracket or quote
+        size_t end = i + 1;
+        while (end < raw.size() && !isDelimiter(raw[end])) ++end;
+        compileToken(raw.substr(i, end - i), program, variables);
+        i = end;
     }
 
-    return instructions;
+    if (inBlock && bracket) {
+        program.emit(ByteCodeEnum::Stop);
+    }
 }
 
-std::vector<ByteCode> InstructionTransformer::transformByteCode(const Instruction& instruction) {
-    std::vector<ByteCode> bytecodes;
+/*
+Compile Token
+*/
+void InstructionTransformer::compileToken(std::string_view tok, ByteCodeProgram& program, const std::vector<std::string>* variables) const {
+    uint32_t value = 0;
 
-    if (instruction.prefix == '[') {
-        bytecodes.emplace_back(ByteCodeEnum::Start);
+    if (tok[0] == '$') {
+        if (variables) compileVariable(tok, program, *variables);
     }
 
-    for (const auto& tok : instruction.tokens) {
-        if (isCharLiteral(tok)) {
-            bytecodes.emplace_back(ByteCodeEnum::Write, parseCharLiteral(tok));
-        } 
-        
-        else if (isStringLiteral(tok)) {
-            for (char c : tok.substr(1, tok.size() - 2)) {
-                bytecodes.emplace_back(ByteCodeEnum::Write, static_cast<uint8_t>(c));
-            }
-        } 
-        
-        else if (isHex(tok)) {
-            bytecodes.emplace_back(ByteCodeEnum::Write, parseHex(tok));
-        } 
-        
-        else if (isDecimal(tok)) {
-            bytecodes.emplace_back(ByteCodeEnum::Write, parseDecimal(tok));
-        } 
-        
-        else if (isSymbolWithRepeat(tok)) {
-            std::pair<ByteCodeEnum, uint8_t> result = parseSymbolWithRepeat(tok);
-            ByteCodeEnum sym = result.first;
-            uint8_t repeat = result.second;
-            bytecodes.emplace_back(sym, 0, 8, repeat);
-        }
+    else if (isCharLiteral(tok)) {
+        program.emitWrite(static_cast<uint8_t>(tok[1]));
+    }
 
-        else if (isRepeatedSymbol(tok)) {
-            char symbol = tok[0];
-            uint8_t repeat = tok.size();
-            bytecodes.emplace_back(parseSymbol(symbol).getCommand(), 0, 8, repeat);
-        }
-        
-        else if (isSymbol(tok)) {
-            bytecodes.push_back(parseSymbol(tok[0]));
-        }
+    else if (isStringLiteral(tok)) {
+        program.emitWrite(reinterpret_cast<const uint8_t*>(tok.data() + 1), tok.size() - 2);
     }
 
-    if (instruction.prefix == '[') {
-        bytecodes.emplace_back(ByteCodeEnum::Stop);
+    else if (isHex(tok)) {
+        if (parseNumber(tok.substr(2), 16, value)) program.emitWrite(static_cast<uint8_t>(value));
     }
 
-    return bytecodes;
-}
+    else if (isDecimal(tok)) {
+        if (parseNumber(tok, 10, value)) program.emitWrite(static_cast<uint8_t>(value));
+    }
+
+    else if (isSymbolWithRepeat(tok)) {
+        // Repeat capped to 255, an overflowing count is capped too
+        if (!parseNumber(tok.substr(tok.find(':') + 1), 10, value)) value = 255;
+        program.emit(parseSymbol(tok[0]), std::min<uint32_t>(value, 255));
+    }
+
+    else if (isRepeatedSymbol(tok)) {
+        program.emit(parseSymbol(tok[0]), std::min<size_t>(tok.size(), 255));
+    }
 
-std::vector<ByteCode> InstructionTransformer::transformByteCodes(const std::vector<Instruction>& instructions) {
-    std::vector<ByteCode> allByteCodes;
+    else if (isSymbol(tok)) {
+        program.emit(parseSymbol(tok[0]));
+    }
+}
 
-    for (auto& inst : instructions) {
-        std::vector<ByteCode> bytecodes = transformByteCode(inst);
-        allByteCodes.insert(allByteCodes.end(), bytecodes.begin(), bytecodes.end());
+/*
+Compile Variable
+*/
+bool InstructionTransformer::compileVariable(std::string_view tok, ByteCodeProgram& program, const std::vector<std::string>& variables) const {
+    std::string_view name = tok.substr(1);
+    uint8_t shift = 0;
+
+    // Optional byte selector, $addr.2 is bits 16-23
+    size_t dot = name.find('.');
+    if (dot != std::string_view::npos) {
+        if (dot + 2 != name.size() || name[dot + 1] < '0' || name[dot + 1] > '3') return false;
+        shift = (name[dot + 1] - '0') * 8;
+        name = name.substr(0, dot);
     }
 
-    return allByteCodes;
+    for (size_t i = 0; i < variables.size(); ++i) {
+        if (variables[i] == name) {
+            program.emitVariable(static_cast<uint8_t>(i), shift);
+            return true;
+        }
+    }
+    return false;
 }
 
-bool InstructionTransformer::isHex(const std::string& token) const {
+/*
+Token classes
+*/
+bool InstructionTransformer::isHex(std::string_view token) const {
     return token.size() > 2 &&
            token[0] == '0' &&
-           std::tolower(token[1]) == 'x';
+           std::tolower(static_cast<unsigned char>(token[1])) == 'x';
 }
 
-bool InstructionTransformer::isDecimal(const std::string& token) const {
-    return !token.empty() && std::all_of(token.begin(), token.end(), ::isdigit);
+bool InstructionTransformer::isDecimal(std::string_view token) const {
+    return !token.empty() && std::all_of(token.begin(), token.end(), [](char c) {
+        return std::isdigit(static_cast<unsigned char>(c));
+    });
 }
 
-bool InstructionTransformer::isCharLiteral(const std::string& token) const {
+bool InstructionTransformer::isCharLiteral(std::string_view token) const {
     return token.size() == 3 && token.front() == '\'' && token.back() == '\'';
 }
 
-bool InstructionTransformer::isStringLiteral(const std::string& token) const {
+bool InstructionTransformer::isStringLiteral(std::string_view token) const {
     return token.size() >= 2 &&
            ((token.front() == '"' && token.back() == '"') ||
             (token.front() == '\'' && token.back() == '\''));
 }
 
-bool InstructionTransformer::isSymbol(const std::string& token) const {
+bool InstructionTransformer::isSymbol(std::string_view token) const {
     if (token.size() != 1) return false;
-    char c = token[0];
-    switch (c) {
-        case 'r':
-        case 'd':
-        case 'D':
-        case 's':
-        case 'S':
-        case 'h':
-        case 'l':
-            return true;
-        default:
-            return std::ispunct(c);
-    }
+    return isRepeatable(token[0]) || std::ispunct(static_cast<unsigned char>(token[0]));
 }
 
-bool InstructionTransformer::isSymbolWithRepeat(const std::string& token) const {
+bool InstructionTransformer::isSymbolWithRepeat(std::string_view token) const {
     auto pos = token.find(':');
-    if (pos == std::string::npos) return false;
+    if (pos == std::string_view::npos) return false;
     if (pos == 0 || pos == token.size() - 1) return false;
-
-    char symbol = token[0];
-    switch (symbol) {
-        case 'r':
-        case 'd':
-        case 'D':
-        case 's':
-        case 'S':
-        case 'h':
-        case 'l':
-            break;
-        default:
-            return false;
-    }
-
-    std::string repeatStr = token.substr(pos + 1);
-    return std::all_of(repeatStr.begin(), repeatStr.end(), ::isdigit);
+    if (!isRepeatable(token[0])) return false;
+    return isDecimal(token.substr(pos + 1));
 }
 
-
-uint8_t InstructionTransformer::parseHex(const std::string& token) const {
-    return static_cast<uint8_t>(std::stoul(token, nullptr, 16));
-}
-
-uint8_t InstructionTransformer::parseDecimal(const std::string& token) const {
-    return static_cast<uint8_t>(std::stoul(token));
+bool InstructionTransformer::isRepeatedSymbol(std::string_view token) const {
+    if (token.empty() || !isRepeatable(token[0])) return false;
+    char first = token[0];
+    return std::all_of(token.begin(), token.end(), [first](char c) {
+        return c == first;
+    });
 }
 
-uint8_t InstructionTransformer::parseCharLiteral(const std::string& token) const {
-    return static_cast<uint8_t>(token[1]);
+/*
+Parsing
+*/
+bool InstructionTransformer::parseNumber(std::string_view digits, int base, uint32_t& value) const {
+    // Stops at the first invalid digit like stoul, fails on no digit or overflow
+    auto result = std::from_chars(digits.data(), digits.data() + digits.size(), value, base);
+    return result.ec == std::errc() && result.ptr != digits.data();
 }
 
-ByteCode InstructionTransformer::parseSymbol(char c) const {
+ByteCodeEnum InstructionTransformer::parseSymbol(char c) const {
     switch (c) {
-        case 'r': return ByteCode(ByteCodeEnum::Read, 0, 8, 1);
-        case 'd': return ByteCode(ByteCodeEnum::DelayUs, 0, 8, 1);
-        case 'D': return ByteCode(ByteCodeEnum::DelayMs, 0, 8, 1);
-        case 's': return ByteCode(ByteCodeEnum::Start);
-        case 'S': return ByteCode(ByteCodeEnum::Stop);
-        case 'h': return ByteCode(ByteCodeEnum::AuxHigh);
-        case 'l': return ByteCode(ByteCodeEnum::AuxLow);
-        default: return ByteCode(ByteCodeEnum::None);
+        case 'r': return ByteCodeEnum::Read;
+        case 'd': return ByteCodeEnum::DelayUs;
+        case 'D': return ByteCodeEnum::DelayMs;
+        case 'n': return ByteCodeEnum::DelayNs;
+        case 's': return ByteCodeEnum::Start;
+        case 'S': return ByteCodeEnum::Stop;
+        case 'h': return ByteCodeEnum::AuxHigh;
+        case 'l': return ByteCodeEnum::AuxLow;
+        default: return ByteCodeEnum::None;
     }
 }
 
-std::pair<ByteCodeEnum, uint8_t> InstructionTransformer::parseSymbolWithRepeat(const std::string& token) const {
-    char symbol = token[0];
-    size_t colonPos = token.find(':');
-    unsigned long parsed = std::stoul(token.substr(colonPos + 1));
-    uint8_t repeat = std::min(parsed, 255ul);
-
-    return { parseSymbol(symbol).getCommand(), repeat };
-}
-
-bool InstructionTransformer::isRepeatedSymbol(const std::string& token) const {
-    if (token.empty()) return false;
-    char first = token[0];
-
-    // repeat available on 
-    switch (first) {
+bool InstructionTransformer::isRepeatable(char c) {
+    switch (c) {
         case 'r':
         case 'd':
         case 'D':
-        case 'h':
-        case 'l':
+        case 'n':
         case 's':
         case 'S':
-            break;
+        case 'h':
+        case 'l':
+            return true;
         default:
             return false;
     }
-
-    // verify each char
-    return std::all_of(token.begin(), token.end(), [first](char c) {
-        return c == first;
-    });
 }
 
+bool InstructionTransformer::isDelimiter(char c) {
+    return std::isspace(static_cast<unsigned char>(c)) ||
+           c == '[' || c == ']' || c == '{' || c == '}' ||
+           c == '\'' || c == '"';
+}
@@ -1,31 +1,28 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <cctype>
-#include <sstream>
-#include <algorithm>
-#include "Models/ByteCode.h"
-#include "Models/Instruction.h"
-#include "Arduino.h"
+#include "Models/ByteCodeProgram.h"
 
 class InstructionTransformer {
 public:
-    std::vector<Instruction> transform(const std::string& raw);
-    std::vector<ByteCode> transformByteCode(const Instruction& instruction);
-    std::vector<ByteCode> transformByteCodes(const std::vector<Instruction>& instructions);
+    // Compile a raw instruction line, the program storage is reused.
+    // With variables, $name and $name.1 to $name.3 write bytes of that variable
+    void transform(std::string_view raw, ByteCodeProgram& program, const std::vector<std::string>* variables = nullptr) const;
 
 private:
-    bool isHex(const std::string& token) const;
-    bool isDecimal(const std::string& token) const;
-    bool isCharLiteral(const std::string& token) const;
-    bool isSymbol(const std::string& token) const;
-    bool isRepeatedSymbol(const std::string& token) const;
-    bool isSymbolWithRepeat(const std::string& token) const;
-    bool isStringLiteral(const std::string& token) const;
-    uint8_t parseHex(const std::string& token) const;
-    uint8_t parseDecimal(const std::string& token) const;
-    uint8_t parseCharLiteral(const std::string& token) const;
-    ByteCode parseSymbol(char c) const;
-    std::pair<ByteCodeEnum, uint8_t> parseSymbolWithRepeat(const std::string& token) const;
+    void compileToken(std::string_view token, ByteCodeProgram& program, const std::vector<std::string>* variables) const;
+    bool compileVariable(std::string_view token, ByteCodeProgram& program, const std::vector<std::string>& variables) const;
+    bool isHex(std::string_view token) const;
+    bool isDecimal(std::string_view token) const;
+    bool isCharLiteral(std::string_view token) const;
+    bool isStringLiteral(std::string_view token) const;
+    bool isSymbol(std::string_view token) const;
+    bool isRepeatedSymbol(std::string_view token) const;
+    bool isSymbolWithRepeat(std::string_view token) const;
+    bool parseNumber(std::string_view digits, int base, uint32_t& value) const;
+    ByteCodeEnum parseSymbol(char c) const;
+    static bool isRepeatable(char c);
+    static bool isDelimiter(char c);
 };
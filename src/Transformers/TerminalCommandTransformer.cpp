@@ -1,21 +1,39 @@
 #include "TerminalCommandTransformer.h"
-#include <sstream>
 
 TerminalCommand TerminalCommandTransformer::transform(const std::string& raw) const {
-    std::istringstream iss(raw);
+    TerminalCommand cmd;
+    transform(raw, cmd);
+    return cmd;
+}
+
+/*
+Transform, root and subcommand are the first two words, args the rest of the line
+*/
+void TerminalCommandTransformer::transform(std::string_view raw, TerminalCommand& cmd) const {
+    size_t pos = 0;
+    auto word = [&]() {
+        while (pos < raw.size() && isSpace(raw[pos])) ++pos;
+        size_t start = pos;
+        while (pos < raw.size() && !isSpace(raw[pos])) ++pos;
+        return raw.substr(start, pos - start);
+    };
 
-    std::string root, subcommand, args;
-    iss >> root >> subcommand;
-    std::getline(iss, args);
+    std::string_view root = word();
+    std::string_view subcommand = root.empty() ? std::string_view() : word();
+    std::string_view args;
 
-    if (!args.empty() && args[0] == ' ') {
-        args.erase(0, 1);
+    // Args keep their spacing, only the separator after the subcommand goes
+    if (!subcommand.empty()) {
+        args = raw.substr(pos);
+        args = args.substr(0, args.find('\n'));
+        if (!args.empty() && args[0] == ' ') args.remove_prefix(1);
     }
 
-    TerminalCommand cmd;
     cmd.setRoot(root);
     cmd.setSubcommand(subcommand);
     cmd.setArgs(args);
+}
 
-    return cmd;
+bool TerminalCommandTransformer::isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
 }
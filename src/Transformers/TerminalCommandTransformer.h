@@ -1,8 +1,15 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <Models/TerminalCommand.h>
 
 class TerminalCommandTransformer {
 public:
     TerminalCommand transform(const std::string& raw) const;
+
+    // Same split into a reused command, no allocation once its strings have grown
+    void transform(std::string_view raw, TerminalCommand& cmd) const;
+
+private:
+    static bool isSpace(char c);
 };
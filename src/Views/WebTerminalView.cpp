@@ -15,7 +15,8 @@ void WebTerminalView::print(const std::string& text) {
 }
 
 void WebTerminalView::println(const std::string& text) {
-    server.sendText(text + "\n");
+    server.sendText(text);
+    server.sendText("\n", 1);
 }
 
 void WebTerminalView::printPrompt(const std::string& mode) {
@@ -17,5 +17,5 @@ public:
     void waitPress() override;
     
 private:
-    WebSocketServer server;
+    WebSocketServer& server;
 };
@@ -0,0 +1,240 @@
+#include "Benchmarks.h"
+#include <cstring>
+#include <cstdio>
+#include <cctype>
+#include <cmath>
+#include "Managers/BinaryAnalyzeManager.h"
+#include "Managers/DumpPipelineManager.h"
+#include "Data/SensitivePatterns.h"
+#include "fakes/FakeTerminalView.h"
+#include "fakes/FakeInput.h"
+
+/*
+Former detectSensitivePattern, one tolower pass per pattern, first label only
+*/
+static const char* legacyDetectSensitivePattern(const uint8_t* buf, size_t size) {
+    for (size_t i = 0; i < sensitivePatternCount; ++i) {
+        const char* pattern = sensitivePatterns[i].text;
+        size_t len = strlen(pattern);
+        for (size_t j = 0; j + len <= size; ++j) {
+            bool match = true;
+            for (size_t k = 0; k < len; ++k) {
+                char c1 = std::tolower((unsigned char)buf[j + k]);
+                char c2 = std::tolower((unsigned char)pattern[k]);
+                if (c1 != c2) {
+                    match = false;
+                    break;
+                }
+            }
+            if (match) return sensitivePatterns[i].label;
+        }
+    }
+    return nullptr;
+}
+
+/*
+Former block entropy, histogram and log2 per bin for every block
+*/
+static float legacyBlockEntropy(const uint8_t* buffer, size_t size) {
+    uint32_t counts[256] = {0};
+    float entropy = 0;
+    for (size_t i = 0; i < size; ++i) counts[buffer[i]]++;
+    for (int i = 0; i < 256; ++i) {
+        if (counts[i]) {
+            float p = (float)counts[i] / size;
+            entropy -= p * log2(p);
+        }
+    }
+    return entropy;
+}
+
+/*
+1 MB image with real headers: ESP-IDF partition table, uImage, ELF,
+SquashFS and Ext2. Payloads are random and full of false magics
+*/
+static std::vector<uint8_t> makeFirmwareImage() {
+    std::vector<uint8_t> image = makeSyntheticImage(1024 * 1024, 11);
+    auto putLe32 = [&](size_t at, uint32_t v) { for (int i = 0; i < 4; ++i) image[at + i] = v >> (8 * i); };
+    auto putBe32 = [&](size_t at, uint32_t v) { for (int i = 0; i < 4; ++i) image[at + i] = v >> (24 - 8 * i); };
+    auto payload = [&](size_t at, size_t len) {
+        uint32_t x = 0x1234567;
+        for (size_t i = 0; i < len; ++i) {
+            x = x * 1103515245 + 12345;
+            image[at + i] = x >> 16;
+            if (i % 512 == 8) { image[at + i] = 0x1F; image[at + i + 1] = 0x8B; image[at + i + 2] = 8; image[at + i + 3] = 0; i += 3; }
+        }
+    };
+
+    // Partition table at 0x8000
+    struct { uint8_t type, subtype; uint32_t offset, size; const char* label; } parts[] = {
+        {1, 0x02, 0x9000, 0x6000, "nvs"}, {1, 0x01, 0xF000, 0x1000, "phy_init"},
+        {0, 0x00, 0x10000, 0x80000, "factory"}, {1, 0x82, 0x90000, 0x70000, "spiffs"},
+    };
+    std::fill(image.begin() + 0x8000, image.begin() + 0x8C00, 0xFF);
+    for (size_t i = 0; i < 4; ++i) {
+        size_t at = 0x8000 + i * 32;
+        image[at] = 0xAA; image[at + 1] = 0x50; image[at + 2] = parts[i].type; image[at + 3] = parts[i].subtype;
+        putLe32(at + 4, parts[i].offset);
+        putLe32(at + 8, parts[i].size);
+        memset(&image[at + 12], 0, 20);
+        memcpy(&image[at + 12], parts[i].label, strlen(parts[i].label));
+    }
+
+    // uImage at 0x10000, 192 KB of lzma payload
+    size_t at = 0x10000;
+    memset(&image[at], 0, 64);
+    putBe32(at, 0x27051956);
+    putBe32(at + 12, 192 * 1024);
+    image[at + 30] = 2; image[at + 31] = 3;
+    memcpy(&image[at + 32], "Linux-4.14", 10);
+    putBe32(at + 4, DumpPipelineManager::crc32(0, &image[at], 64));
+    payload(at + 64, 192 * 1024);
+
+    // ELF32 Xtensa at 0x48000, one 64 KB segment
+    at = 0x48000;
+    memset(&image[at], 0, 0x54 + 32);
+    memcpy(&image[at], "\x7F" "ELF\x01\x01\x01", 7);
+    image[at + 0x12] = 0x5E;
+    image[at + 0x14] = 1;
+    image[at + 0x28] = 52;
+    putLe32(at + 0x1C, 0x34);
+    image[at + 0x2A] = 32; image[at + 0x2C] = 1;
+    putLe32(at + 0x34 + 4, 0x100);
+    putLe32(at + 0x34 + 16, 64 * 1024);
+    payload(at + 0x100, 64 * 1024);
+
+    // SquashFS at 0x90000, 128 KB
+    at = 0x90000;
+    memset(&image[at], 0, 96);
+    memcpy(&image[at], "hsqs", 4);
+    putLe32(at + 4, 42);
+    putLe32(at + 12, 131072);
+    image[at + 20] = 4; image[at + 22] = 17; image[at + 28] = 4;
+    putLe32(at + 40, 128 * 1024);
+    payload(at + 96, 128 * 1024 - 96);
+
+    // Ext2 at 0xC0000, 64 blocks of 1 KB
+    at = 0xC0000;
+    std::fill(image.begin() + at, image.begin() + at + 64 * 1024, 0);
+    putLe32(at + 1024 + 4, 64);
+    image[at + 1024 + 0x38] = 0x53; image[at + 1024 + 0x39] = 0xEF;
+    memcpy(&image[at + 1024 + 0x78], "rootfs", 6);
+
+    return image;
+}
+
+void registerAnalyzerBenchmarks(BenchmarkRunner& runner) {
+    static FakeTerminalView view;
+    static FakeInput input;
+    static BinaryAnalyzeManager analyzer(view, input);
+    static const std::vector<uint8_t> image = makeSyntheticImage(256 * 1024);
+    static const std::vector<uint8_t> largeImage = makeSyntheticImage(4 * 1024 * 1024, 7);
+    static std::vector<SensitiveHit> hits;
+
+    runner.add("BinaryAnalyzeManager/analyze-256K", [] {
+        auto result = analyzer.analyze(0, image.size(), [](uint32_t addr, uint8_t* buf, uint32_t len) {
+            memcpy(buf, image.data() + addr, std::min<size_t>(len, image.size() - addr));
+        });
+        BenchmarkRunner::keep(result.blocks);
+    }, image.size());
+
+    runner.add("BinaryAnalyzeManager/analyze-4M", [] {
+        auto result = analyzer.analyze(0, largeImage.size(), [](uint32_t addr, uint8_t* buf, uint32_t len) {
+            memcpy(buf, largeImage.data() + addr, len);
+        });
+        BenchmarkRunner::keep(result.entropyMap.size());
+    }, largeImage.size());
+
+    runner.add("BinaryAnalyzeManager/entropy-legacy-4M", [] {
+        float sum = 0;
+        for (size_t addr = 0; addr < largeImage.size(); addr += 512) sum += legacyBlockEntropy(&largeImage[addr], 512);
+        BenchmarkRunner::keep(sum);
+    }, largeImage.size());
+
+    runner.addReport("BinaryAnalyzeManager/layout", [] {
+        static const std::vector<uint8_t> firmware = makeFirmwareImage();
+        auto result = analyzer.analyze(0, firmware.size(), [](uint32_t addr, uint8_t* buf, uint32_t len) {
+            memcpy(buf, firmware.data() + addr, std::min<size_t>(len, firmware.size() - addr));
+        });
+
+        // No gzip hit may come from inside the parsed payloads
+        size_t inside = 0;
+        for (const auto& file : result.foundFiles) {
+            uint32_t address = std::stoul(file.substr(2, 6), nullptr, 16);
+            for (const auto& region : result.layout) {
+                if (region.payload && address > region.start && address < region.start + region.length) inside++;
+            }
+        }
+        printf("%zu signatures, %zu inside payloads%s", result.foundFiles.size(), inside, analyzer.formatLayout(result).c_str());
+    });
+
+    runner.addReport("BinaryAnalyzeManager/entropy-map", [] {
+        auto result = analyzer.analyze(0, largeImage.size(), [](uint32_t addr, uint8_t* buf, uint32_t len) {
+            memcpy(buf, largeImage.data() + addr, len);
+        });
+
+        // Map against a direct per region computation
+        int worst = 0;
+        for (size_t r = 0; r < result.entropyMap.size(); ++r) {
+            int expected = std::lround(legacyBlockEntropy(&largeImage[r * BinaryAnalyzeManager::REGION_SIZE], BinaryAnalyzeManager::REGION_SIZE) * 32);
+            worst = std::max(worst, std::abs(expected - result.entropyMap[r]));
+        }
+        printf("%zu regions, worst error %d/32 bit%s", result.entropyMap.size(), worst,
+            analyzer.formatEntropyMap(result).c_str());
+    });
+
+    // Former scan, 512 byte blocks read with a 32 byte overlap
+    runner.add("BinaryAnalyzeManager/sensitive-legacy-4M", [] {
+        size_t found = 0;
+        for (size_t addr = 0; addr < largeImage.size(); addr += 512) {
+            size_t from = addr >= 32 ? addr - 32 : 0;
+            found += legacyDetectSensitivePattern(&largeImage[from], addr + 512 - from) != nullptr;
+        }
+        BenchmarkRunner::keep(found);
+    }, largeImage.size());
+
+    runner.add("BinaryAnalyzeManager/sensitive-automaton-4M", [] {
+        uint16_t state = 0;
+        for (size_t addr = 0; addr < largeImage.size(); addr += 512) {
+            hits.clear();
+            BinaryAnalyzeManager::detectSensitivePatterns(&largeImage[addr], 512, addr, state, hits);
+        }
+        BenchmarkRunner::keep(hits.size());
+    }, largeImage.size());
+
+    runner.addReport("BinaryAnalyzeManager/sensitive-checks", [] {
+        // All case-insensitive occurrences, by brute force
+        size_t expected = 0;
+        for (size_t i = 0; i < largeImage.size(); ++i) {
+            for (const auto& p : sensitivePatterns) {
+                size_t len = strlen(p.text), k = 0;
+                while (k < len && i + k < largeImage.size() && tolower(largeImage[i + k]) == tolower((unsigned char)p.text[k])) ++k;
+                expected += k == len;
+            }
+        }
+
+        // Split at odd sizes, offsets must point at the pattern
+        std::vector<SensitiveHit> all;
+        uint16_t state = 0;
+        for (size_t addr = 0; addr < largeImage.size(); addr += 333) {
+            BinaryAnalyzeManager::detectSensitivePatterns(&largeImage[addr], std::min<size_t>(333, largeImage.size() - addr), addr, state, all);
+        }
+        size_t misplaced = 0;
+        for (const auto& hit : all) {
+            bool ok = false;
+            for (const auto& p : sensitivePatterns) {
+                if (p.label == hit.label && strncasecmp((const char*)&largeImage[hit.offset], p.text, strlen(p.text)) == 0) ok = true;
+            }
+            misplaced += !ok;
+        }
+
+        const char* mixed = "xxPassWord=1 HTTPS://a ssh-RSA";
+        std::vector<SensitiveHit> few;
+        state = 0;
+        BinaryAnalyzeManager::detectSensitivePatterns((const uint8_t*)mixed, strlen(mixed), 0, state, few);
+
+        printf("%zu hits (brute force %zu), %zu misplaced, mixed case %zu/3, %zu states x %zu classes, table %zu bytes\n",
+            all.size(), expected, misplaced, few.size(),
+            SensitivePatternTable::stateCount, SensitivePatternTable::classCount, sizeof(SensitivePatternTable::automaton));
+    });
+}
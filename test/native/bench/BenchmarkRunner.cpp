@@ -0,0 +1,113 @@
+#include "BenchmarkRunner.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <algorithm>
+
+static std::atomic<uint64_t> allocations{0};
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+uint64_t AllocationCounter::count() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+BenchmarkRunner::BenchmarkRunner(const std::string& filter, uint32_t minTimeMs)
+    : filter(filter), minTimeMs(minTimeMs) {}
+
+void BenchmarkRunner::add(const std::string& name, Body body, size_t bytesPerOp) {
+    cases.push_back({name, std::move(body), bytesPerOp});
+}
+
+void BenchmarkRunner::addReport(const std::string& name, Body body) {
+    reports.push_back({name, std::move(body), 0});
+}
+
+int BenchmarkRunner::run() {
+    printf("%-44s %10s %12s %10s %10s\n", "benchmark", "iters", "ns/op", "allocs/op", "MB/s");
+
+    size_t ran = 0;
+    for (const auto& c : cases) {
+        if (!filter.empty() && c.name.find(filter) == std::string::npos) continue;
+        runCase(c);
+        ran++;
+    }
+
+    for (const auto& r : reports) {
+        if (!filter.empty() && r.name.find(filter) == std::string::npos) continue;
+        printf("\n%s\n", r.name.c_str());
+        r.body();
+        ran++;
+    }
+
+    if (ran == 0) {
+        printf("No benchmark matches '%s'\n", filter.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+void BenchmarkRunner::runCase(const Case& c) {
+    using Clock = std::chrono::steady_clock;
+
+    // Warm up caches and lazy statics
+    c.body();
+
+    uint64_t iterations = 1;
+    while (true) {
+        uint64_t allocsBefore = AllocationCounter::count();
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            c.body();
+        }
+        auto elapsed = Clock::now() - start;
+        uint64_t allocs = AllocationCounter::count() - allocsBefore;
+
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        if (ns >= minTimeMs * 1e6 || iterations >= (1ull << 30)) {
+            double nsPerOp = ns / iterations;
+            double allocsPerOp = double(allocs) / iterations;
+
+            if (c.bytesPerOp) {
+                double mbPerSec = (c.bytesPerOp / (1024.0 * 1024.0)) / (nsPerOp / 1e9);
+                printf("%-44s %10llu %12.1f %10.2f %10.2f\n", c.name.c_str(),
+                       (unsigned long long)iterations, nsPerOp, allocsPerOp, mbPerSec);
+            } else {
+                printf("%-44s %10llu %12.1f %10.2f %10s\n", c.name.c_str(),
+                       (unsigned long long)iterations, nsPerOp, allocsPerOp, "-");
+            }
+            return;
+        }
+
+        // Aim directly for the minimum time, at most x10 per round
+        double target = (minTimeMs * 1e6 * 1.2) / std::max(ns / iterations, 1.0);
+        iterations = std::min<uint64_t>(std::max<uint64_t>(iterations * 2, (uint64_t)target), iterations * 10);
+    }
+}
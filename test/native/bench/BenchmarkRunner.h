@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+/*
+Micro-benchmark runner for the native target.
+
+Each case runs in growing batches until it reaches the minimum time,
+then reports ns/op, heap allocations per op and MB/s when the case
+declares how many bytes one op processes.
+*/
+class BenchmarkRunner {
+public:
+    using Body = std::function<void()>;
+
+    explicit BenchmarkRunner(const std::string& filter = "", uint32_t minTimeMs = 200);
+
+    // Register a case, bytesPerOp enables the throughput column
+    void add(const std::string& name, Body body, size_t bytesPerOp = 0);
+
+    // Register a free form report, printed after the cases when its name matches the filter
+    void addReport(const std::string& name, Body body);
+
+    // Run all cases matching the filter, returns the process exit code
+    int run();
+
+    // Keep a value alive so the optimizer cannot drop the benchmarked code
+    template <typename T>
+    static void keep(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+private:
+    struct Case {
+        std::string name;
+        Body body;
+        size_t bytesPerOp;
+    };
+
+    std::string filter;
+    uint32_t minTimeMs;
+    std::vector<Case> cases;
+    std::vector<Case> reports;
+
+    void runCase(const Case& c);
+};
+
+/*
+Heap allocations counter, fed by the global operator new of the bench binary
+*/
+namespace AllocationCounter {
+    uint64_t count();
+}
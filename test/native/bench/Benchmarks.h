@@ -0,0 +1,22 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "BenchmarkRunner.h"
+
+// Benchmark groups, one per translation unit
+void registerTransformerBenchmarks(BenchmarkRunner& runner);
+void registerAnalyzerBenchmarks(BenchmarkRunner& runner);
+void registerServerBenchmarks(BenchmarkRunner& runner);
+void registerBusBenchmarks(BenchmarkRunner& runner);
+void registerFlashBenchmarks(BenchmarkRunner& runner);
+void registerDumpBenchmarks(BenchmarkRunner& runner);
+void registerSearchBenchmarks(BenchmarkRunner& runner);
+void registerJobBenchmarks(BenchmarkRunner& runner);
+void registerCaptureBenchmarks(BenchmarkRunner& runner);
+
+/*
+Flash-like synthetic image: erased areas, strings with secrets,
+a few magic headers and pseudo random (compressed-like) payloads
+*/
+std::vector<uint8_t> makeSyntheticImage(size_t size, uint32_t seed = 1);
@@ -0,0 +1,174 @@
+#include "Benchmarks.h"
+#include "Services/SpiService.h"
+#include "Services/I2cService.h"
+#include "Transformers/InstructionTransformer.h"
+#include "Managers/MacroManager.h"
+#include "fakes/FakeSpiLoopback.h"
+#include "fakes/FakeI2cRegisters.h"
+
+void registerBusBenchmarks(BenchmarkRunner& runner) {
+    static SpiService spiService;
+    static I2cService i2cService;
+    static InstructionTransformer transformer;
+    static FakeSpiLoopback spiDevice;
+    static FakeI2cRegisters i2cDevice;
+
+    spiService.configure(SPI_MOSI_PIN, SPI_MISO_PIN, SPI_CLK_PIN, SPI_CS_PIN);
+    SPI.attachDevice(&spiDevice, SPI_CS_PIN);
+    i2cService.configure(I2C_SDA_PIN, I2C_SCL_PIN, I2C_FREQ);
+    Wire.attachDevice(0x50, &i2cDevice);
+
+    static ByteCodeProgram spiRead;
+    static ByteCodeProgram i2cRead;
+    transformer.transform("[0x03 0 0 0 r:255]", spiRead);
+    transformer.transform("[0x50 0x00 r:32]", i2cRead);
+
+    runner.add("SpiService/executeByteCode-read-255", [] {
+        SPI.attachDevice(&spiDevice, SPI_CS_PIN);
+        auto result = spiService.executeByteCode(spiRead);
+        BenchmarkRunner::keep(result.size());
+    }, 259);
+
+    runner.add("I2cService/executeByteCode-read-32", [] {
+        auto result = i2cService.executeByteCode(i2cRead);
+        BenchmarkRunner::keep(result.size());
+    }, 34);
+
+    // Same sequence issued one call per byte, as before the batching stage
+    runner.addReport("SpiService/executeByteCode-bus-model", [] {
+        SPI.attachDevice(&spiDevice, SPI_CS_PIN);
+
+        SPI.resetCounters();
+        spiService.beginTransaction();
+        for (const auto& op : spiRead.getOps()) {
+            if (op.command != ByteCodeEnum::Write && op.command != ByteCodeEnum::Read) continue;
+            for (uint32_t i = 0; i < op.length; ++i) {
+                spiService.transfer(op.command == ByteCodeEnum::Write ? spiRead.data(op)[i] : 0x00);
+            }
+        }
+        spiService.endTransaction();
+        printf("  %-10s %6u calls %8.1f us\n", "per-byte", SPI.callCount(), SPI.busTimeNs() / 1000.0);
+
+        SPI.resetCounters();
+        spiService.executeByteCode(spiRead);
+        printf("  %-10s %6u calls %8.1f us\n", "batched", SPI.callCount(), SPI.busTimeNs() / 1000.0);
+        printf("%s\n", spiService.formatTrace(TraceModeEnum::Full).c_str());
+    });
+
+    runner.addReport("I2cService/executeByteCode-calls", [] {
+        static ByteCodeProgram i2cWrite;
+        transformer.transform("[0x50 0x10 0x01 0x02 0x03 0x04 0x05 0x06 0x07 0x08] [0x50 0x10 r:8]", i2cWrite);
+        Wire.resetCounters();
+        auto result = i2cService.executeByteCode(i2cWrite);
+        printf("  %u Wire calls, %u transactions, read %s\n", Wire.callCount(), Wire.transactionCount(), result.c_str());
+        printf("%s\n", i2cService.formatTrace(TraceModeEnum::Full).c_str());
+    });
+
+    // Inter-byte delays with the RTOS delays and on the cycle counter
+    runner.addReport("TimingService/delay-jitter", [] {
+        static ByteCodeProgram delays;
+        transformer.transform("[0xAA n:250 0xBB d:5 0xCC d:50 0xDD]", delays);
+        for (bool precise : {false, true}) {
+            GlobalState::getInstance().setPreciseTiming(precise);
+            spiService.executeByteCode(delays);
+            printf("  %s\n%s\n", precise ? "precise" : "normal", spiService.formatJitter().c_str());
+        }
+        GlobalState::getInstance().setPreciseTiming(false);
+    });
+
+    // 64 reads of 4 bytes walking through a flash, as a macro and as typed lines
+    static NvsService nvsService;
+    static SdService sdService;
+    static MacroManager macroManager(nvsService, sdService, transformer);
+    static std::string error;
+    if (!macroManager.define("poll", "set a 0; repeat 64; [0x03 $a.2 $a.1 $a r:4]; add a 256; end", error)) {
+        printf("macro error: %s\n", error.c_str());
+    }
+    static const MacroManager::ExecuteFn execute = [](const ByteCodeProgram& program) {
+        return spiService.executeByteCode(program);
+    };
+    static const MacroManager::OutputFn output = [](const std::string& result) {
+        BenchmarkRunner::keep(result.size());
+        return true;
+    };
+
+    runner.add("MacroManager/run-64-lines", [] {
+        SPI.attachDevice(&spiDevice, SPI_CS_PIN);
+        MacroRunStats stats;
+        macroManager.run("poll", 1, execute, output, stats, error);
+        BenchmarkRunner::keep(stats.executed);
+    });
+
+    runner.add("MacroManager/reparse-64-lines", [] {
+        SPI.attachDevice(&spiDevice, SPI_CS_PIN);
+        static ByteCodeProgram program;
+        char line[48];
+        for (uint32_t a = 0; a < 64 * 256; a += 256) {
+            snprintf(line, sizeof(line), "[0x03 0x%02X 0x%02X 0x%02X r:4]", (a >> 16) & 0xFF, (a >> 8) & 0xFF, a & 0xFF);
+            transformer.transform(line, program);
+            output(spiService.executeByteCode(program));
+        }
+    });
+
+    // ensureConfigured of the I2C and SPI controllers, counting teardowns
+    static uint32_t ensured = 0, reconfigured = 0;
+    static auto& ownership = GlobalState::getInstance().getPinOwnership();
+    static const auto enterI2c = [] {
+        ensured++;
+        uint8_t sda = I2C_SDA_PIN, scl = I2C_SCL_PIN;
+        if (!ownership.claim(ModeEnum::I2C, {sda, scl, PinOwnership::I2C_BUS}, PinOwnership::signature({sda, scl, I2C_FREQ}))) return;
+        reconfigured++;
+        i2cService.end();
+        i2cService.configure(sda, scl, I2C_FREQ);
+    };
+    static const auto enterSpi = [] {
+        ensured++;
+        uint8_t mosi = SPI_MOSI_PIN, miso = SPI_MISO_PIN, clk = SPI_CLK_PIN, cs = SPI_CS_PIN;
+        if (!ownership.claim(ModeEnum::SPI, {clk, miso, mosi, cs, PinOwnership::SPI_BUS}, PinOwnership::signature({clk, miso, mosi, cs}))) return;
+        reconfigured++;
+        spiService.end();
+        spiService.configure(mosi, miso, clk, cs);
+    };
+
+    runner.add("PinOwnership/claim-unchanged", [] {
+        enterI2c();
+    });
+
+    runner.addReport("PinOwnership/scripted-session", [] {
+        // Script switching between an I2C and a SPI target, with a config rerender each time
+        ensured = reconfigured = 0;
+        enterI2c();
+        const std::string i2cExpected = i2cService.executeByteCode(i2cRead);
+        enterSpi();
+        SPI.attachDevice(&spiDevice, SPI_CS_PIN);
+        const std::string spiExpected = spiService.executeByteCode(spiRead);
+        bool intact = true;
+        for (int i = 0; i < 50; ++i) {
+            enterI2c();
+            enterI2c();
+            intact &= i2cService.executeByteCode(i2cRead) == i2cExpected;
+            enterSpi();
+            enterSpi();
+            SPI.attachDevice(&spiDevice, SPI_CS_PIN);
+            intact &= spiService.executeByteCode(spiRead) == spiExpected;
+        }
+        printf("50 I2C/SPI round trips: %u ensureConfigured, %u teardowns (formerly %u), reads %s\n",
+            ensured, reconfigured, ensured, intact ? "intact" : "BROKEN");
+
+        // Sharing a pin, or a GPIO use of it, still reconfigures
+        uint32_t before = reconfigured;
+        ownership.claim(ModeEnum::UART, {I2C_SCL_PIN, I2C_SDA_PIN}, 0);
+        enterI2c();
+        printf("UART took SCL/SDA: I2C %s\n", reconfigured > before ? "reconfigured" : "NOT reconfigured");
+
+        before = reconfigured;
+        ownership.take(I2C_SDA_PIN);
+        enterI2c();
+        printf("DIO used SDA: I2C %s\n", reconfigured > before ? "reconfigured" : "NOT reconfigured");
+
+        before = reconfigured;
+        ownership.release(ModeEnum::I2C);
+        enterI2c();
+        printf("shell released I2C: I2C %s\n", reconfigured > before ? "reconfigured" : "NOT reconfigured");
+    });
+}
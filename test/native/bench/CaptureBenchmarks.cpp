@@ -0,0 +1,361 @@
+#include "Benchmarks.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+#include <chrono>
+#include <freertos/task.h>
+#include "Services/LogicCaptureService.h"
+#include "Managers/LogicCaptureManager.h"
+#include "Managers/SumpManager.h"
+#include "Decoders/UartDecoder.h"
+
+/*
+Pseudo random level per microsecond, a busy line with edges at 1 us
+multiples, so any sample can be checked against it
+*/
+static bool busyLine(uint64_t ns) {
+    uint64_t us = ns / 1000;
+    return ((us * 0x9E3779B97F4A7C15ull) >> 61) & 1;
+}
+
+// CPU time of the reading thread only, the simulated DMA has its own
+static double threadCpuMs() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+/*
+8 channel bus traffic: a counter on channels 0-6, one sample glitch on
+channel 7 in the middle of a long capture
+*/
+static std::vector<uint8_t> makeTraffic(size_t count, size_t glitchAt) {
+    std::vector<uint8_t> samples(count);
+    for (size_t i = 0; i < count; ++i) samples[i] = (i / 16) & 0x7F;
+    samples[glitchAt] |= 0x80;
+    return samples;
+}
+
+// Whole capture as one byte per sample
+static std::vector<uint8_t> expandAll(const LogicCapture& capture) {
+    std::vector<uint8_t> samples(capture.size());
+    samples.resize(capture.expand(0, samples.size(), samples.data()));
+    return samples;
+}
+
+/*
+UART at 115200 baud sampled at 2 MS/s on channel 0, a short burst of
+bytes every 10 ms and an idle line otherwise
+*/
+static void appendIdleUart(LogicCapture& capture, uint64_t count) {
+    const double samplesPerBit = 2000000.0 / 115200;
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t inPeriod = i % 20000;
+        size_t bit = static_cast<size_t>(inPeriod / samplesPerBit);
+        uint8_t level = 1;
+        if (bit < 80) {
+            uint8_t byte = static_cast<uint8_t>(0x41 + (i / 20000) % 26 + bit / 10);
+            size_t frameBit = bit % 10;
+            level = frameBit == 0 ? 0 : frameBit == 9 ? 1 : (byte >> (frameBit - 1)) & 1;
+        }
+        capture.append(level);
+    }
+}
+
+// SUMP long command, the argument little endian
+static std::string sumpLong(uint8_t command, uint32_t argument) {
+    std::string bytes(1, static_cast<char>(command));
+    for (int i = 0; i < 4; ++i) bytes += static_cast<char>((argument >> (8 * i)) & 0xFF);
+    return bytes;
+}
+
+void registerCaptureBenchmarks(BenchmarkRunner& runner) {
+    static LogicCaptureService capture;
+    static LogicCaptureManager manager(capture);
+
+    // Mostly idle DMA buffer, the edge is in the last word
+    runner.add("LogicCapture/firstEdge-idle-block", [] {
+        static std::vector<uint32_t> block = [] {
+            std::vector<uint32_t> words(LogicCaptureService::BLOCK_WORDS, 0xFFFFFFFF);
+            words.back() = 0xFFFF0000;
+            return words;
+        }();
+        BenchmarkRunner::keep(LogicCaptureService::firstEdge(block.data(), block.size()));
+    }, LogicCaptureService::BLOCK_WORDS * sizeof(uint32_t));
+
+    runner.addReport("LogicCapture/dma-stream", [] {
+        NativeI2s::attachSignal(I2S_NUM_1, busyLine);
+        std::vector<uint32_t> block(LogicCaptureService::BLOCK_WORDS);
+
+        // A reader keeping up: every sample arrives, in order
+        for (uint32_t rate : {1000000u, 4000000u}) {
+            capture.start(5, rate);
+            const double sampleNs = 1e9 / capture.getSampleRate();
+            uint64_t index = 0, mismatches = 0;
+            double cpu = threadCpuMs();
+            auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+            while (std::chrono::steady_clock::now() < until) {
+                size_t words = capture.read(block.data(), block.size(), 20);
+                for (size_t i = 0; i < words * LogicCaptureService::SAMPLES_PER_WORD; ++i, ++index) {
+                    mismatches += LogicCaptureService::sampleAt(block.data(), i) != busyLine(uint64_t(index * sampleNs));
+                }
+            }
+            cpu = threadCpuMs() - cpu;
+            uint32_t overruns = capture.getOverruns();
+            capture.stop();
+            printf("%u S/s for 300 ms: %llu samples, %llu mismatches, %u overruns\n",
+                rate, (unsigned long long)index, (unsigned long long)mismatches, overruns);
+        }
+
+        // Reading without checking, the CPU left is what the display gets
+        capture.start(5, 4000000);
+        double cpu = threadCpuMs();
+        uint64_t samples = 0;
+        auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+        while (std::chrono::steady_clock::now() < until) {
+            samples += capture.read(block.data(), block.size(), 20) * LogicCaptureService::SAMPLES_PER_WORD;
+        }
+        cpu = threadCpuMs() - cpu;
+        printf("reader CPU at 4 MS/s: %.2f ms for %llu samples (%.3f ns/sample), the former loop woke once per sample at 2 kS/s\n",
+            cpu, (unsigned long long)samples, cpu * 1e6 / (samples ? samples : 1));
+
+        // A reader stalled longer than the ring lasts loses whole buffers, counted
+        vTaskDelay(150);
+        uint32_t lost = capture.getOverruns();
+        size_t resumed = capture.read(block.data(), block.size(), 100);
+        capture.stop();
+        printf("150 ms stall at 4 MS/s (ring holds %.0f ms): %u DMA buffers dropped, reading resumed with %zu words\n",
+            1e3 * LogicCaptureService::DMA_BUF_COUNT * LogicCaptureService::BLOCK_WORDS * LogicCaptureService::SAMPLES_PER_WORD / 4000000,
+            lost, resumed);
+    });
+
+    // Trigger evaluation per sample while waiting, the budget of the sampling loop
+    static const std::vector<uint8_t> traffic = makeTraffic(1 << 20, 700000);
+    static const auto feedUntilTrigger = [](LogicTriggerEnum type) {
+        LogicTrigger trigger;
+        trigger.type = type;
+        trigger.channel = 7;
+        trigger.mask = 0xFF;
+        trigger.value = traffic[700000];
+        trigger.minWidth = 1;
+        trigger.maxWidth = 1;
+        manager.begin(trigger, 1000, 1000);
+        size_t i = 0;
+        while (i < traffic.size() && manager.push(traffic[i])) ++i;
+        return i;
+    };
+    runner.add("LogicCapture/push-rising-1M", [] {
+        BenchmarkRunner::keep(feedUntilTrigger(LogicTriggerEnum::Rising));
+    }, 700000);
+    runner.add("LogicCapture/push-pulse-1M", [] {
+        BenchmarkRunner::keep(feedUntilTrigger(LogicTriggerEnum::Pulse));
+    }, 700000);
+
+    runner.addReport("LogicCapture/pre-trigger", [] {
+        // A one sample glitch deep into the traffic, with what led to it
+        for (auto type : {LogicTriggerEnum::Rising, LogicTriggerEnum::Pulse, LogicTriggerEnum::Pattern}) {
+            feedUntilTrigger(type);
+            auto samples = expandAll(manager.getCapture());
+            size_t t = manager.getTriggerIndex();
+            bool exact = manager.isTriggered() && samples.size() == 2000 &&
+                std::equal(samples.begin(), samples.end(), traffic.begin() + (700000 + (type == LogicTriggerEnum::Pulse) - t));
+            printf("%-14s trigger at %zu of %zu samples, pre-trigger part %s\n",
+                LogicTriggerEnumMapper::toString(type).c_str(), t, samples.size(), exact ? "matches the traffic" : "WRONG");
+        }
+
+        // Pulses of 1 to 4 samples on channel 7, only the 3 sample one is wanted
+        std::vector<uint8_t> pulses(4000, 0);
+        for (size_t width = 1, at = 500; width <= 4; ++width, at += 1000) {
+            for (size_t i = 0; i < width; ++i) pulses[at + i] = 0x80;
+        }
+        LogicTrigger trigger;
+        trigger.type = LogicTriggerEnum::Pulse;
+        trigger.channel = 7;
+        trigger.minWidth = trigger.maxWidth = 3;
+        manager.begin(trigger, 100, 100);
+        for (uint8_t sample : pulses) {
+            if (!manager.push(sample)) break;
+        }
+        auto around = expandAll(manager.getCapture());
+        size_t width = 0;
+        for (size_t i = manager.getTriggerIndex(); i-- > 0 && around[i];) width++;
+        printf("pulses of 1 to 4 samples, wanted 3: triggered after a %zu sample pulse\n", width);
+
+        // The sampling loop on GPIO 4-7, rising edge on GPIO 7 set 20 ms after start.
+        // Late samples here come from the host scheduler, not from the loop
+        for (uint8_t pin = 4; pin < 8; ++pin) NativeHal::setPinLevel(pin, LOW);
+        NativeHal::setPinLevel(5, HIGH);
+        std::thread edge([] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            NativeHal::setPinLevel(7, HIGH);
+        });
+        trigger = LogicTrigger();
+        trigger.type = LogicTriggerEnum::Rising;
+        trigger.channel = 3;
+        auto start = std::chrono::steady_clock::now();
+        bool complete = manager.capture({4, 5, 6, 7}, 250000, trigger, 5000, 5000, [] { return false; });
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        edge.join();
+        auto samples = expandAll(manager.getCapture());
+        size_t t = manager.getTriggerIndex();
+        printf("250 kS/s on GPIO 4-7: %s in %.1f ms, %zu samples, 0x%02X before and 0x%02X at the trigger (%zu), %u late\n",
+            complete ? "complete" : "STOPPED", ms, samples.size(), samples[t - 1], samples[t], t, manager.getLateSamples());
+
+        // [ENTER] 30 ms into a slow capture that never triggers
+        trigger.channel = 0;
+        for (uint32_t slowRate : {200u, 10000u}) {
+            start = std::chrono::steady_clock::now();
+            complete = manager.capture({4, 5, 6, 7}, slowRate, trigger, 100, 100, [&] {
+                return std::chrono::steady_clock::now() - start > std::chrono::milliseconds(30);
+            });
+            ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            printf("%u S/s, stop asked at 30 ms: %s at %.1f ms\n", slowRate, complete ? "COMPLETED" : "stopped", ms);
+        }
+    });
+
+    // Run storage of an idle-heavy line, the waveform generation included
+    runner.add("LogicCapture/append-idle-uart-1M", [] {
+        static LogicCapture capture;
+        capture.reset(LogicCaptureManager::MAX_PSRAM_BYTES);
+        appendIdleUart(capture, 1000000);
+        BenchmarkRunner::keep(capture.bytes());
+    }, 1000000);
+
+    runner.addReport("LogicCapture/compression", [] {
+        static LogicCapture capture;
+        capture.reset(LogicCaptureManager::MAX_PSRAM_BYTES);
+        const uint64_t count = 2000000ull * 5; // 5 s at 2 MS/s
+        appendIdleUart(capture, count);
+        printf("5 s of UART bursts at 2 MS/s: %llu samples in %zu bytes (%.0fx smaller than one byte per sample)\n",
+            (unsigned long long)capture.size(), capture.bytes(), double(capture.size()) / capture.bytes());
+        printf("the former raw buffer in %zu KB of internal RAM held %.1f ms, the runs in the same RAM hold %.2f s\n",
+            LogicCaptureManager::INTERNAL_BYTES / 1024, LogicCaptureManager::INTERNAL_BYTES / 2000.0,
+            5.0 * LogicCaptureManager::INTERNAL_BYTES / capture.bytes());
+
+        // Windows expanded through the index match the source
+        LogicCapture reference;
+        reference.reset(LogicCaptureManager::MAX_PSRAM_BYTES);
+        appendIdleUart(reference, 3000000);
+        auto expected = expandAll(reference);
+        bool intact = expected.size() == 3000000;
+        std::vector<uint8_t> window(240);
+        using Clock = std::chrono::steady_clock;
+        auto t = Clock::now();
+        for (uint64_t first = 0; intact && first + window.size() < expected.size(); first += 12345) {
+            capture.expand(first, window.size(), window.data());
+            intact = std::equal(window.begin(), window.end(), expected.begin() + first);
+        }
+        double us = std::chrono::duration<double, std::micro>(Clock::now() - t).count() / (3000000 / 12345);
+        printf("240 sample windows anywhere in the capture: %s, %.2f us each\n", intact ? "exact" : "WRONG", us);
+
+        // Full decode, what display and export walk through
+        t = Clock::now();
+        LogicCapture::Reader reader(capture);
+        uint8_t value;
+        uint64_t length, total = 0, runs = 0;
+        while (reader.next(value, length)) {
+            total += length;
+            runs++;
+        }
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t).count();
+        printf("full decode: %llu runs, %llu samples in %.2f ms\n",
+            (unsigned long long)runs, (unsigned long long)total, ms);
+    });
+
+    // A PulseView session: identify, configure, arm on a pattern, read back
+    static SumpManager sump(manager);
+    runner.addReport("Sump/session", [] {
+        for (uint8_t pin = 4; pin < 8; ++pin) NativeHal::setPinLevel(pin, LOW);
+        NativeHal::setPinLevel(5, HIGH);
+        std::thread edge([] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            NativeHal::setPinLevel(7, HIGH);
+        });
+
+        const uint32_t readCount = 8192, delayCount = 4096;
+        std::string session(5, '\0');
+        session += "\x02\x04";
+        session += sumpLong(SumpManager::CMD_DIVIDER, SumpManager::CLOCK_RATE / 250000 - 1);
+        session += sumpLong(SumpManager::CMD_FLAGS, 0x38); // groups 1-3 off
+        session += sumpLong(SumpManager::CMD_CAPTURE_SIZE, (readCount / 4 - 1) | ((delayCount / 4 - 1) << 16));
+        session += sumpLong(SumpManager::CMD_TRIGGER_MASK, 0x0A);
+        session += sumpLong(SumpManager::CMD_TRIGGER_VALUE, 0x0A);
+        session += "\x01\n";
+        Serial.clearOutput();
+        Serial.inject(session);
+        uint32_t captures = sump.serve({4, 5, 6, 7}, [] { return false; });
+        edge.join();
+
+        // ID, then metadata keys: 0x00-0x1F text, 0x20-0x3F u32, 0x40-0x5F u8
+        const std::string wire = Serial.output();
+        Serial.clearOutput();
+        size_t at = 4;
+        printf("ID %s, metadata:", wire.substr(0, 4).c_str());
+        while (at < wire.size() && wire[at]) {
+            uint8_t key = wire[at++];
+            if (key < 0x20) {
+                size_t end = wire.find('\0', at);
+                printf(" [%02X] \"%s\"", key, wire.substr(at, end - at).c_str());
+                at = end + 1;
+            } else if (key < 0x40) {
+                uint32_t value = 0;
+                for (int i = 0; i < 4; ++i) value = value << 8 | uint8_t(wire[at++]);
+                printf(" [%02X] %u", key, value);
+            } else {
+                printf(" [%02X] %u", key, uint8_t(wire[at++]));
+            }
+        }
+        printf("\n");
+
+        // Samples come newest first
+        std::string samples = wire.substr(at + 1);
+        std::reverse(samples.begin(), samples.end());
+        size_t t = readCount - delayCount;
+        bool aligned = samples.size() == readCount && (samples[t] & 0x0A) == 0x0A && (samples[t - 1] & 0x0A) == 0x02 &&
+                       std::all_of(samples.begin(), samples.end(), [](char c) { return c & 0x02; });
+        printf("%u capture, %zu samples back for %u asked, pattern trigger %s\n",
+            captures, samples.size(), readCount, aligned ? "at the asked position" : "MISPLACED");
+    });
+
+    // Readback of a 1M sample capture, windows expanded from the runs and reversed
+    runner.add("Sump/send-1M", [] {
+        LogicTrigger none;
+        manager.begin(none, 0, traffic.size());
+        for (uint8_t sample : traffic) manager.push(sample);
+        Serial.clearOutput();
+        sump.sendCapture(traffic.size(), traffic.size());
+        BenchmarkRunner::keep(Serial.output().size());
+    }, 1 << 20);
+
+    // Decoding walks the runs, 5 s of mostly idle UART at 2 MS/s
+    static const auto uartCapture = [] () -> const LogicCapture& {
+        static LogicCapture capture;
+        if (!capture.size()) {
+            capture.reset(LogicCaptureManager::MAX_PSRAM_BYTES);
+            appendIdleUart(capture, 2000000ull * 5);
+        }
+        return capture;
+    };
+    runner.add("LogicDecode/uart-5s", [] {
+        UartDecoder decoder(0);
+        BenchmarkRunner::keep(decoder.decode(uartCapture(), 2000000).size());
+    }, 2000000 * 5);
+
+    runner.addReport("LogicDecode/uart", [] {
+        UartDecoder decoder(0);
+        auto start = std::chrono::steady_clock::now();
+        const auto& frames = decoder.decode(uartCapture(), 2000000);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        // Bursts of 8 bytes every 20000 samples, as appendIdleUart writes them
+        size_t exact = 0;
+        for (const auto& frame : frames) {
+            uint64_t burst = frame.start / 20000;
+            uint64_t index = static_cast<uint64_t>((frame.start % 20000) / (2000000.0 / 115200) / 10 + 0.5);
+            exact += !frame.error && frame.value == 0x41 + burst % 26 + index;
+        }
+        printf("5 s at 2 MS/s: %u baud detected, %zu bytes, %zu as sent, %.2f ms for %llu samples\n",
+            decoder.getBaud(), frames.size(), exact, ms, (unsigned long long)uartCapture().size());
+    });
+}
@@ -0,0 +1,149 @@
+#include "Benchmarks.h"
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <cstdio>
+#include "Managers/DumpPipelineManager.h"
+#include "Transformers/ArgTransformer.h"
+#include "Services/SdService.h"
+#include "fakes/FakeTerminalView.h"
+#include "fakes/FakeInput.h"
+
+/*
+Terminal taking a fixed time per print, like a slow serial link
+*/
+class SlowTerminalView : public FakeTerminalView {
+public:
+    void println(const std::string& text) override {
+        std::this_thread::sleep_for(std::chrono::microseconds(delayUs));
+        FakeTerminalView::println(text);
+    }
+    uint32_t delayUs = 1000;
+};
+
+void registerDumpBenchmarks(BenchmarkRunner& runner) {
+    static FakeTerminalView view;
+    static FakeInput input;
+    static SdService sdService;
+    static DumpPipelineManager pipeline(view, input, sdService);
+    static ArgTransformer argTransformer;
+    static const std::vector<uint8_t> image = makeSyntheticImage(64 * 1024, 3);
+
+    runner.add("DumpPipelineManager/dump-64K", [] {
+        bool done = pipeline.dump(0, image.size(), [](uint32_t addr, uint8_t* buf, uint32_t len) {
+            memcpy(buf, image.data() + addr, len);
+            return true;
+        });
+        BenchmarkRunner::keep(done);
+    }, image.size());
+
+    // Former formatting, one stringstream line and one println per 16 bytes
+    runner.add("ArgTransformer/toAsciiLine-64K", [] {
+        for (size_t i = 0; i < image.size(); i += 16) {
+            std::vector<uint8_t> line(image.begin() + i, image.begin() + i + 16);
+            view.println(argTransformer.toAsciiLine(i, line));
+        }
+    }, image.size());
+
+    // Same output for both formatters
+    char line[128];
+    std::vector<uint8_t> sample(image.begin(), image.begin() + 16);
+    std::string expected = argTransformer.toAsciiLine(0x1234, sample);
+    if (std::string(line, DumpPipelineManager::formatLine(line, 0x1234, sample.data(), 16)) != expected) {
+        printf("formatLine differs from toAsciiLine\n");
+    }
+
+    static const auto copyFetch = [](uint32_t addr, uint8_t* buf, uint32_t len) {
+        memcpy(buf, image.data() + addr, len);
+        return true;
+    };
+
+    runner.add("DumpPipelineManager/crc32-64K", [] {
+        BenchmarkRunner::keep(DumpPipelineManager::crc32(0, image.data(), image.size()));
+    }, image.size());
+
+    runner.add("DumpPipelineManager/dumpToSd-64K", [] {
+        BenchmarkRunner::keep(pipeline.dumpToSd(0, image.size(), copyFetch, "/dump.bin", SPI_CS_PIN));
+    }, image.size());
+
+    runner.add("DumpPipelineManager/dumpToTerminal-64K", [] {
+        Serial.clearOutput();
+        BenchmarkRunner::keep(pipeline.dumpToTerminal(0, image.size(), copyFetch));
+    }, image.size());
+
+    // Reference CRC-32 and round trips through both raw outputs
+    const uint8_t check[] = "123456789";
+    if (DumpPipelineManager::crc32(0, check, 9) != 0xCBF43926) printf("crc32 check value mismatch\n");
+
+    pipeline.dumpToSd(0, image.size(), copyFetch, "/dump.bin", SPI_CS_PIN);
+    SD.begin();
+    auto* file = SD.fileData("/dump.bin");
+    if (!file || *file != image) printf("dumpToSd image mismatch\n");
+    SD.end();
+
+    // Device on the SD clock pin, read in full before the card is written
+    GlobalState& state = GlobalState::getInstance();
+    std::vector<uint8_t> sharedPins = { state.getSpiCLKPin() };
+    if (!pipeline.sharesSdBus(sharedPins, SPI_CS_PIN)) printf("sharesSdBus missed the SD clock\n");
+    pipeline.dumpToSd(0, image.size(), copyFetch, "/shared.bin", SPI_CS_PIN, 4096, sharedPins);
+    SD.begin();
+    file = SD.fileData("/shared.bin");
+    if (!file || *file != image) printf("dumpToSd shared pins image mismatch\n");
+    SD.end();
+
+    Serial.clearOutput();
+    pipeline.dumpToTerminal(0, image.size(), copyFetch);
+    const std::string& wire = Serial.output();
+    std::vector<uint8_t> received;
+    size_t pos = 0;
+    uint32_t trailerCrc = 0;
+    while (pos + 8 <= wire.size() && (uint8_t)wire[pos] == 0xA5 && (uint8_t)wire[pos + 1] == 0x5A) {
+        uint16_t len = (uint8_t)wire[pos + 6] | ((uint8_t)wire[pos + 7] << 8);
+        pos += 8;
+        if (len == 0) {
+            memcpy(&trailerCrc, wire.data() + pos, 4);
+            break;
+        }
+        received.insert(received.end(), wire.begin() + pos, wire.begin() + pos + len);
+        pos += len;
+    }
+    if (received != image || trailerCrc != DumpPipelineManager::crc32(0, image.data(), image.size())) {
+        printf("dumpToTerminal frames mismatch\n");
+    }
+
+    runner.addReport("DumpPipelineManager/wire-bytes-64K", [] {
+        size_t before = view.getBytesWritten();
+        pipeline.dump(0, image.size(), copyFetch);
+        size_t hexBytes = view.getBytesWritten() - before;
+
+        Serial.clearOutput();
+        pipeline.dumpToTerminal(0, image.size(), copyFetch);
+        printf("  hex lines  %8zu bytes\n  raw frames %8zu bytes\n", hexBytes, Serial.output().size());
+    });
+
+    runner.addReport("DumpPipelineManager/overlap-16x1K", [] {
+        // 1 ms of bus per chunk and 1 ms of terminal per chunk
+        SlowTerminalView slowView;
+        FakeInput slowInput;
+        DumpPipelineManager slowPipeline(slowView, slowInput, sdService);
+        auto fetch = [](uint32_t addr, uint8_t* buf, uint32_t len) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            memcpy(buf, image.data() + addr, len);
+            return true;
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        slowPipeline.dump(0, 16 * 1024, fetch);
+        double pipelined = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        uint8_t buf[1024];
+        for (uint32_t addr = 0; addr < 16 * 1024; addr += 1024) {
+            fetch(addr, buf, sizeof(buf));
+            slowView.println("");
+        }
+        double sequential = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        printf("  sequential %8.1f ms\n  pipelined  %8.1f ms\n", sequential, pipelined);
+    });
+}
@@ -0,0 +1,107 @@
+#include "Benchmarks.h"
+#include "Services/SpiService.h"
+#include "fakes/FakeSpiFlash.h"
+#include <functional>
+#include <cstdio>
+
+/*
+Flash read throughput, legacy byte per byte loop against the bulk paths.
+The fake answers instantly, so MB/s is the host-side cost per byte;
+the bus report gives the modelled on-target throughput at 20 MHz.
+*/
+void registerFlashBenchmarks(BenchmarkRunner& runner) {
+    static SpiService spiService;
+    static FakeSpiFlash flash(1 << 20);
+    static std::vector<uint8_t> buffer(64 * 1024);
+
+    auto image = makeSyntheticImage(flash.data().size(), 7);
+    std::copy(image.begin(), image.end(), flash.data().begin());
+
+    spiService.configure(SPI_MOSI_PIN, SPI_MISO_PIN, SPI_CLK_PIN, SPI_CS_PIN, 20000000);
+    SPI.attachDevice(&flash, SPI_CS_PIN);
+
+    runner.add("SpiService/readFlashData-64K-per-byte", [] {
+        SPI.attachDevice(&flash, SPI_CS_PIN);
+
+        // Shape of the former readFlashData: one SPI.transfer per byte
+        spiService.beginTransaction();
+        spiService.transfer(0x03);
+        spiService.transfer(0x00);
+        spiService.transfer(0x00);
+        spiService.transfer(0x00);
+        for (size_t i = 0; i < buffer.size(); ++i) buffer[i] = spiService.transfer(0x00);
+        spiService.endTransaction();
+        BenchmarkRunner::keep(buffer[0]);
+    }, 64 * 1024);
+
+    runner.add("SpiService/readFlashData-64K-standard", [] {
+        SPI.attachDevice(&flash, SPI_CS_PIN);
+        spiService.readFlashData(0, buffer.data(), buffer.size(), FlashReadModeEnum::Standard);
+        BenchmarkRunner::keep(buffer[0]);
+    }, 64 * 1024);
+
+    runner.add("SpiService/readFlashData-64K-fast", [] {
+        SPI.attachDevice(&flash, SPI_CS_PIN);
+        spiService.readFlashData(0, buffer.data(), buffer.size(), FlashReadModeEnum::Fast);
+        BenchmarkRunner::keep(buffer[0]);
+    }, 64 * 1024);
+
+    // One wide session for the whole command, read in the 4 KB chunks of the dump pipeline
+    runner.add("SpiService/readFlashData-64K-dual", [] {
+        SPI.attachDevice(&flash, SPI_CS_PIN);
+        spiService.beginWideRead();
+        for (size_t offset = 0; offset < buffer.size(); offset += 4096) {
+            spiService.readFlashData(offset, buffer.data() + offset, 4096, FlashReadModeEnum::DualOutput);
+        }
+        spiService.endWideRead();
+        BenchmarkRunner::keep(buffer[0]);
+    }, 64 * 1024);
+
+    // Every mode must read back the same bytes, Dual outside of a session falls back to Fast
+    for (bool wide : { false, true }) {
+        for (auto mode : { FlashReadModeEnum::Standard, FlashReadModeEnum::Fast, FlashReadModeEnum::DualOutput }) {
+            std::fill(buffer.begin(), buffer.end(), 0);
+            if (wide) spiService.beginWideRead();
+            spiService.readFlashData(0x1234, buffer.data(), buffer.size(), mode);
+            if (wide) spiService.endWideRead();
+            if (!std::equal(buffer.begin(), buffer.end(), flash.data().begin() + 0x1234)) {
+                printf("readFlashData mismatch in mode %s%s\n", FlashReadModeEnumMapper::toString(mode).c_str(), wide ? " (wide session)" : "");
+            }
+        }
+    }
+
+    // The Arduino SPI is back after a session
+    uint8_t id[3] = {};
+    spiService.beginWideRead();
+    spiService.endWideRead();
+    spiService.readFlashIdRaw(id);
+    if (id[0] != 0xEF) printf("Arduino SPI not restored after a wide session\n");
+
+    runner.addReport("SpiService/readFlashData-64K-bus-model", [] {
+        SPI.attachDevice(&flash, SPI_CS_PIN);
+        auto report = [](const char* name, std::function<void()> read) {
+            SPI.resetCounters();
+            read();
+            double us = SPI.busTimeNs() / 1000.0;
+            printf("  %-12s %8u calls %10.1f us %8.2f MB/s\n", name, SPI.callCount(), us,
+                   (buffer.size() / (1024.0 * 1024.0)) / (us / 1e6));
+        };
+
+        report("per-byte", [] {
+            spiService.beginTransaction();
+            spiService.transfer(0x03);
+            spiService.transfer(0x00);
+            spiService.transfer(0x00);
+            spiService.transfer(0x00);
+            for (size_t i = 0; i < buffer.size(); ++i) buffer[i] = spiService.transfer(0x00);
+            spiService.endTransaction();
+        });
+        report("standard", [] { spiService.readFlashData(0, buffer.data(), buffer.size(), FlashReadModeEnum::Standard); });
+        report("fast", [] { spiService.readFlashData(0, buffer.data(), buffer.size(), FlashReadModeEnum::Fast); });
+        report("dual", [] {
+            spiService.beginWideRead();
+            spiService.readFlashData(0, buffer.data(), buffer.size(), FlashReadModeEnum::DualOutput);
+            spiService.endWideRead();
+        });
+    });
+}
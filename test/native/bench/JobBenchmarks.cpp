@@ -0,0 +1,109 @@
+#include "Benchmarks.h"
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include "Managers/JobManager.h"
+#include "fakes/FakeTerminalView.h"
+#include "fakes/FakeInput.h"
+
+void registerJobBenchmarks(BenchmarkRunner& runner) {
+    static FakeTerminalView view(true);
+    static FakeInput input;
+    static JobManager jobs(view, input);
+    static const std::string frame = " 📥 ID: 0x123  DLC: 8  Data: 11 22 33 44 55 66 77 88";
+
+    // Capture output into a job ring, the background side of a sniffer line
+    runner.add("JobManager/ring-print-line", [] {
+        static Job job(1, "sniff", ModeEnum::CAN_, JobManager::RING_SIZE);
+        static std::string drained;
+        job.println(frame);
+        if (job.buffered() > JobManager::RING_SIZE / 2) {
+            drained.clear();
+            job.drain(drained);
+        }
+    }, frame.size() + 1);
+
+    runner.addReport("JobManager/concurrent", [] {
+        using Clock = std::chrono::steady_clock;
+
+        // A CAN sniffer and an I2C monitor, each printing while the shell keeps working
+        auto& state = GlobalState::getInstance();
+        std::atomic<uint32_t> frames{0}, changes{0};
+        state.setCurrentMode(ModeEnum::CAN_);
+        jobs.requestBackground("sniff");
+        std::vector<uint8_t> canPins = {
+            state.getCanCspin(), state.getCanSckPin(), state.getCanSoPin(), state.getCanSiPin(), PinOwnership::SPI_BUS
+        };
+        jobs.run("CAN Sniff: Waiting for frame", canPins, [&](IJobOutput& out) {
+            while (out.poll()) {
+                out.println(frame);
+                frames++;
+                vTaskDelay(1);
+            }
+            out.println("\nCan Sniff: Stopped by user.");
+        });
+        // A job on the same pins is refused, the I2C one gets its own
+        state.setCurrentMode(ModeEnum::I2C);
+        view.clear();
+        jobs.requestBackground("sniff");
+        jobs.run("I2C Sniffer: Listening", canPins, [](IJobOutput&) {});
+        printf("second job on the CAN pins: %s\n", view.getOutput().find("in use by job") != std::string::npos ? "refused" : "STARTED");
+
+        uint8_t sda = state.getI2cSdaPin(), scl = state.getI2cSclPin();
+        state.setI2cSdaPin(8);
+        state.setI2cSclPin(9);
+        jobs.requestBackground("monitor 0x50 10");
+        std::vector<uint8_t> i2cPins = { state.getI2cSdaPin(), state.getI2cSclPin(), PinOwnership::I2C_BUS };
+        jobs.run("I2C Monitor: Monitoring register changes at 0x50", i2cPins, [&](IJobOutput& out) {
+            for (uint8_t value = 0; out.poll(); ++value) {
+                out.println("0x10: 0x" + std::to_string(value) + " -> 0x" + std::to_string(value + 1));
+                changes++;
+                vTaskDelay(10);
+            }
+        });
+
+        state.setCurrentMode(ModeEnum::HIZ);
+
+        // Their pins are held, another mode can not reconfigure them
+        auto& ownership = state.getPinOwnership();
+        ownership.takeRefusal();
+        bool reconfigured = ownership.claim(ModeEnum::UART, {i2cPins[0], 0xFF}, 1);
+        uint8_t refusedBy = ownership.takeRefusal();
+        printf("UART claim on SDA: %s by job [%u], I2C busy: %s, SPI busy: %s\n",
+            reconfigured ? "RECONFIGURED" : "refused", refusedBy,
+            jobs.isBusy(ModeEnum::I2C) ? "yes" : "no", jobs.isBusy(ModeEnum::SPI) ? "YES" : "no");
+
+        // The shell is free meanwhile
+        vTaskDelay(300);
+
+        auto list = jobs.list();
+        printf("jobs after 300 ms: %zu running, %u frames and %u changes captured\n",
+            list.size(), frames.load(), changes.load());
+        for (const auto& job : list) {
+            printf("  [%u] %s %s: %zu bytes unread\n", job.id, ModeEnumMapper::toString(job.mode).c_str(),
+                job.command.c_str(), job.buffered);
+        }
+
+        // fg on the sniffer: backlog first, [ENTER] detaches and the job keeps running
+        view.clear();
+        input.inject("\n");
+        jobs.attach(list[0].id);
+        printf("fg [%u]: %zu bytes streamed, still listed: %s\n", list[0].id, view.getOutput().size(),
+            jobs.list().size() == 2 ? "yes" : "NO");
+
+        // kill returns once the capture loop has seen the request
+        for (const auto& job : list) {
+            auto t = Clock::now();
+            bool killed = jobs.kill(job.id);
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - t).count();
+            printf("kill [%u]: %s in %.1f ms\n", job.id, killed ? "stopped" : "FAILED", ms);
+        }
+        printf("jobs left: %zu\n", jobs.list().size());
+
+        // Killed jobs give their pins back, the shell configures their modes again
+        auto ended = jobs.releaseEnded();
+        printf("modes released: %zu, SDA holder after kill: %u\n", ended.size(), ownership.holderOf(i2cPins));
+        state.setI2cSdaPin(sda);
+        state.setI2cSclPin(scl);
+    });
+}
@@ -0,0 +1,81 @@
+#include "Benchmarks.h"
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include "Managers/PatternSearchManager.h"
+
+/*
+Former search, one memcmp per pattern at every offset
+*/
+static size_t naiveSearch(const std::vector<uint8_t>& image, const std::vector<std::string>& patterns) {
+    size_t hits = 0;
+    for (size_t i = 0; i < image.size(); ++i) {
+        for (const auto& p : patterns) {
+            if (i + p.size() <= image.size() && memcmp(&image[i], p.data(), p.size()) == 0) hits++;
+        }
+    }
+    return hits;
+}
+
+void registerSearchBenchmarks(BenchmarkRunner& runner) {
+    static const std::vector<uint8_t> image = makeSyntheticImage(1024 * 1024, 5);
+    static const std::vector<std::string> patterns = {
+        "password", "passwd", "ssh-rsa", "ssh-ed25519", "BEGIN CERTIFICATE",
+        "PRIVATE KEY", "https://", "http://", "ftp://", "admin", "user=",
+        "CONFIG_", "HOME=", "PATH=", "root@", "rootfs", "kernel", "token", "secret",
+    };
+    static PatternSearchManager search;
+    static size_t hits = 0;
+
+    for (const auto& p : patterns) search.addPattern(p);
+    search.compile();
+
+    runner.add("PatternSearchManager/19-patterns-1M", [] {
+        hits = 0;
+        search.reset();
+        for (size_t i = 0; i < image.size(); i += 4096) {
+            search.feed(&image[i], std::min<size_t>(4096, image.size() - i), [](const PatternMatch&) { hits++; });
+        }
+        BenchmarkRunner::keep(hits);
+    }, image.size());
+
+    runner.add("naive/19-patterns-1M", [] {
+        BenchmarkRunner::keep(naiveSearch(image, patterns));
+    }, image.size());
+
+    runner.addReport("PatternSearchManager/checks", [] {
+        // Same hits as the naive scan, whatever the chunk boundaries
+        size_t expected = naiveSearch(image, patterns);
+        for (size_t chunk : { size_t(1), size_t(7), size_t(4096), image.size() }) {
+            size_t count = 0;
+            search.reset();
+            for (size_t i = 0; i < image.size(); i += chunk) {
+                search.feed(&image[i], std::min(chunk, image.size() - i), [&](const PatternMatch&) { count++; });
+            }
+            printf("chunk %7zu: %zu hits (naive %zu)%s\n", chunk, count, expected, count == expected ? "" : "  MISMATCH");
+        }
+
+        // Hex, wildcards and case folding
+        PatternSearchManager mixed;
+        mixed.addPattern("{7F 45 4C 46 ?? 01}");
+        mixed.addPattern("PASSWORD=", true);
+        mixed.addPattern("{1F8B}{??}{00}");
+        bool rejected = !mixed.addPattern("{7G}") && !mixed.addPattern("{??}") && !mixed.addPattern("{1F");
+        mixed.compile();
+
+        size_t counts[3] = {0, 0, 0};
+        mixed.feed(image.data(), image.size(), [&](const PatternMatch& m) { counts[m.pattern]++; });
+
+        size_t elf = 0, gzip = 0, pass = 0;
+        for (size_t i = 0; i + 9 <= image.size(); ++i) {
+            const uint8_t* p = &image[i];
+            if (p[0] == 0x7F && p[1] == 'E' && p[2] == 'L' && p[3] == 'F' && p[5] == 0x01) elf++;
+            if (p[0] == 0x1F && p[1] == 0x8B && p[3] == 0x00) gzip++;
+            std::string s(reinterpret_cast<const char*>(p), 9);
+            std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+            if (s == "password=") pass++;
+        }
+        printf("elf %zu/%zu gzip %zu/%zu password= %zu/%zu, bad specs %s, %zu states\n",
+            counts[0], elf, counts[2], gzip, counts[1], pass, rejected ? "rejected" : "ACCEPTED", mixed.stateCount());
+    });
+}
@@ -0,0 +1,166 @@
+#include "Benchmarks.h"
+#include <cstdio>
+#include <thread>
+#include <chrono>
+#include <ctime>
+#include "Servers/WebSocketServer.h"
+#include "Inputs/WebTerminalInput.h"
+
+/*
+Former sanitizer, appending per char and per substr
+*/
+static std::string legacySanitizeUtf8(const std::string& input) {
+    std::string output;
+    size_t i = 0;
+    while (i < input.size()) {
+        unsigned char c = input[i];
+        if (c <= 0x7F) {
+            output += c;
+            i++;
+        } else if ((c & 0xE0) == 0xC0 && i + 1 < input.size() && (input[i+1] & 0xC0) == 0x80) {
+            output += input.substr(i, 2);
+            i += 2;
+        } else if ((c & 0xF0) == 0xE0 && i + 2 < input.size() && (input[i+1] & 0xC0) == 0x80 && (input[i+2] & 0xC0) == 0x80) {
+            output += input.substr(i, 3);
+            i += 3;
+        } else if ((c & 0xF8) == 0xF0 && i + 3 < input.size() && (input[i+1] & 0xC0) == 0x80 &&
+                   (input[i+2] & 0xC0) == 0x80 && (input[i+3] & 0xC0) == 0x80) {
+            output += input.substr(i, 4);
+            i += 4;
+        } else {
+            i++;
+        }
+    }
+    return output;
+}
+
+void registerServerBenchmarks(BenchmarkRunner& runner) {
+    static httpd_handle_t handle = nullptr;
+    static WebSocketServer server(handle);
+    static const std::string line = "0x001230: 48 65 6C 6C 6F 20 E2 9C 94 20 F0 9F 93 8A 0A 00  Hello ✔ 📊..\n";
+    static const std::string dump = [] {
+        std::string s;
+        while (s.size() < 4096) s += line;
+        return s;
+    }();
+
+    server.setupRoutes();
+    NativeHttpd::connect();
+
+    runner.add("WebSocketServer/sanitizeUtf8-legacy-4K", [] {
+        auto out = legacySanitizeUtf8(dump);
+        BenchmarkRunner::keep(out.size());
+    }, dump.size());
+
+    runner.add("WebSocketServer/sanitizeUtf8-4K", [] {
+        auto out = server.sanitizeUtf8(dump);
+        BenchmarkRunner::keep(out.size());
+    }, dump.size());
+
+    // Dump lines and a byte per byte bridge into the output ring
+    runner.add("WebSocketServer/sendText-line", [] {
+        server.sendText(line);
+    }, line.size());
+
+    runner.add("WebSocketServer/sendText-byte", [] {
+        static size_t i = 0;
+        server.sendText(&dump[i++ % dump.size()], 1);
+    }, 1);
+
+    runner.addReport("WebSocketServer/input", [] {
+        using Clock = std::chrono::steady_clock;
+
+        // Paste: 64 KB in 256 byte frames from the httpd side while the shell reads
+        std::string paste;
+        for (int i = 0; paste.size() < 65536; ++i) paste += char('a' + i % 26);
+        std::thread httpd([&] {
+            for (size_t i = 0; i < paste.size(); i += 256) NativeHttpd::deliver(paste.substr(i, 256));
+        });
+        std::string got;
+        auto start = Clock::now();
+        while (got.size() < paste.size()) got += server.readCharBlocking();
+        double pasteMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        httpd.join();
+        printf("paste 64K: %s in %.1f ms\n", got == paste ? "intact" : "CORRUPTED", pasteMs);
+
+        // Keystroke: time from frame delivery to readCharBlocking returning
+        double worstUs = 0, totalUs = 0;
+        const int keys = 200;
+        for (int i = 0; i < keys; ++i) {
+            Clock::time_point sent;
+            std::thread key([&] {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                sent = Clock::now();
+                NativeHttpd::deliver("k");
+            });
+            server.readCharBlocking();
+            auto now = Clock::now();
+            key.join();
+            double us = std::chrono::duration<double, std::micro>(now - sent).count();
+            worstUs = std::max(worstUs, us);
+            totalUs += us;
+        }
+        printf("keystroke wakeup: avg %.0f us, worst %.0f us (formerly up to 10 ms polling)\n", totalUs / keys, worstUs);
+    });
+
+    runner.addReport("WebTerminalInput/idle-wait", [] {
+        using Clock = std::chrono::steady_clock;
+        static WebTerminalInput input(server);
+        const auto idle = std::chrono::milliseconds(200);
+
+        // Former prompt loop, spinning on readChar while nobody types
+        std::clock_t cpu = std::clock();
+        size_t polls = 0;
+        for (auto end = Clock::now() + idle; Clock::now() < end; ++polls) input.readChar();
+        double spinCpuMs = 1000.0 * (std::clock() - cpu) / CLOCKS_PER_SEC;
+
+        // Prompt loop now sleeping in waitChar between device polls
+        cpu = std::clock();
+        size_t wakeups = 0;
+        for (auto end = Clock::now() + idle; Clock::now() < end; ++wakeups) input.waitChar(20);
+        double waitCpuMs = 1000.0 * (std::clock() - cpu) / CLOCKS_PER_SEC;
+
+        printf("idle 200 ms: spin %.1f ms CPU (%zu polls), waitChar %.1f ms CPU (%zu wakeups)\n",
+            spinCpuMs, polls, waitCpuMs, wakeups);
+
+        // A key still ends the wait right away
+        Clock::time_point sent;
+        std::thread key([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            sent = Clock::now();
+            NativeHttpd::deliver("k");
+        });
+        char c = input.waitChar(1000);
+        auto now = Clock::now();
+        key.join();
+        printf("keystroke during waitChar: '%c' after %.0f us\n", c,
+            std::chrono::duration<double, std::micro>(now - sent).count());
+    });
+
+    runner.addReport("WebSocketServer/frames", [] {
+        // Former transport sent one frame per call
+        server.flush();
+        NativeHttpd::resetCounters();
+        for (char c : dump) server.sendText(&c, 1);
+        server.flush();
+        size_t frames = NativeHttpd::framesSent(), bytes = NativeHttpd::bytesSent();
+        printf("byte per byte: %zu calls -> %zu frames, %zu/%zu bytes\n", dump.size(), frames, bytes, server.sanitizeUtf8(dump).size());
+
+        NativeHttpd::resetCounters();
+        for (int i = 0; i < 64; ++i) server.sendText(dump);
+        server.flush();
+        printf("4K prints: 64 calls -> %zu frames of ~%zu bytes\n",
+            NativeHttpd::framesSent(), NativeHttpd::bytesSent() / std::max<size_t>(1, NativeHttpd::framesSent()));
+
+        // Every frame is valid UTF-8, even when a sequence is cut between calls
+        NativeHttpd::resetCounters();
+        const std::string emoji = "📊✔é";
+        std::string sent;
+        for (int i = 0; i < 200; ++i) sent += emoji;
+        for (size_t i = 0; i < sent.size(); i += 3) server.sendText(sent.substr(i, 3));
+        server.flush();
+        const std::string& last = NativeHttpd::lastFrame();
+        bool valid = server.sanitizeUtf8(last) == last;
+        printf("cut sequences: %zu/%zu bytes, last frame %s\n", NativeHttpd::bytesSent(), sent.size(), valid ? "valid" : "INVALID");
+    });
+}
@@ -0,0 +1,56 @@
+#include "Benchmarks.h"
+#include <cstring>
+#include <algorithm>
+
+std::vector<uint8_t> makeSyntheticImage(size_t size, uint32_t seed) {
+    static const char* texts[] = {
+        "CONFIG_WIFI_SSID=home-network\n",
+        "password=hunter2&user=admin\n",
+        "https://update.example.com/fw.bin\n",
+        "-----BEGIN CERTIFICATE-----\nMIIBszCCAVmgAwIBAgIU\n",
+        "ssh-ed25519 AAAAC3NzaC1lZDI1NTE5AAAAIG root@device\n",
+        "Booting kernel... done. Mounting rootfs\n",
+    };
+    static const uint8_t gzipHeader[] = { 0x1F, 0x8B, 0x08, 0x00 };
+    static const uint8_t elfHeader[] = { 0x7F, 'E', 'L', 'F', 0x01, 0x01, 0x01, 0x00 };
+
+    std::vector<uint8_t> image(size, 0xFF);
+    uint32_t state = seed;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    };
+
+    // 4 KB regions, each one gets a kind
+    for (size_t base = 0; base < size; base += 4096) {
+        size_t len = std::min<size_t>(4096, size - base);
+        uint8_t* region = image.data() + base;
+
+        switch (next() % 4) {
+            case 0: // erased
+                break;
+            case 1: { // text
+                size_t pos = 0;
+                while (pos < len) {
+                    const char* t = texts[next() % (sizeof(texts) / sizeof(texts[0]))];
+                    size_t tl = std::min(strlen(t), len - pos);
+                    memcpy(region + pos, t, tl);
+                    pos += tl;
+                }
+                break;
+            }
+            case 2: // compressed-like
+                for (size_t i = 0; i < len; ++i) region[i] = next() & 0xFF;
+                if (len >= sizeof(gzipHeader)) memcpy(region, gzipHeader, sizeof(gzipHeader));
+                break;
+            case 3: // code-like, small alphabet
+                for (size_t i = 0; i < len; ++i) region[i] = (next() % 24) * 3;
+                if (len >= sizeof(elfHeader)) memcpy(region, elfHeader, sizeof(elfHeader));
+                break;
+        }
+    }
+
+    return image;
+}
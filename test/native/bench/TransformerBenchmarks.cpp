@@ -0,0 +1,135 @@
+#include "Benchmarks.h"
+#include "Transformers/InstructionTransformer.h"
+#include "Transformers/ArgTransformer.h"
+#include "Transformers/TerminalCommandTransformer.h"
+#include "Dispatchers/CommandRouter.h"
+#include <chrono>
+
+// I2C commands routed like a controller, the last route is the worst case of a compare chain
+struct BenchRoutedController {
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    void plain() { hits++; }
+    void withCommand(const TerminalCommand& cmd) { hits += cmd.getRoot().size(); }
+
+    void handleCommand(const TerminalCommand& cmd) {
+        static constexpr CommandRoute<BenchRoutedController> routes[] = {
+            {"scan", &BenchRoutedController::plain},     {"ping", &BenchRoutedController::withCommand},
+            {"identify", &BenchRoutedController::withCommand}, {"sniff", &BenchRoutedController::plain},
+            {"slave", &BenchRoutedController::withCommand}, {"read", &BenchRoutedController::withCommand},
+            {"write", &BenchRoutedController::withCommand}, {"dump", &BenchRoutedController::withCommand},
+            {"glitch", &BenchRoutedController::withCommand}, {"flood", &BenchRoutedController::withCommand},
+            {"monitor", &BenchRoutedController::withCommand}, {"eeprom", &BenchRoutedController::withCommand},
+            {"recover", &BenchRoutedController::plain},  {"config", &BenchRoutedController::plain},
+        };
+        static constexpr CommandRouter router(ModeEnum::I2C, routes);
+        if (!router.dispatch(*this, cmd)) misses++;
+    }
+
+    void handleCommandChain(const TerminalCommand& cmd) {
+        if (cmd.getRoot() == "scan") plain();
+        else if (cmd.getRoot() == "ping") withCommand(cmd);
+        else if (cmd.getRoot() == "identify") withCommand(cmd);
+        else if (cmd.getRoot() == "sniff") plain();
+        else if (cmd.getRoot() == "slave") withCommand(cmd);
+        else if (cmd.getRoot() == "read") withCommand(cmd);
+        else if (cmd.getRoot() == "write") withCommand(cmd);
+        else if (cmd.getRoot() == "dump") withCommand(cmd);
+        else if (cmd.getRoot() == "glitch") withCommand(cmd);
+        else if (cmd.getRoot() == "flood") withCommand(cmd);
+        else if (cmd.getRoot() == "monitor") withCommand(cmd);
+        else if (cmd.getRoot() == "eeprom") withCommand(cmd);
+        else if (cmd.getRoot() == "recover") plain();
+        else if (cmd.getRoot() == "config") plain();
+    }
+};
+
+void registerTransformerBenchmarks(BenchmarkRunner& runner) {
+    static InstructionTransformer instructionTransformer;
+    static ArgTransformer argTransformer;
+    static TerminalCommandTransformer commandTransformer;
+    static ByteCodeProgram program;
+
+    static const std::string flashRead = "[0x03 0x00 0x10 0x00 r:255]";
+    static const std::string mixed = "[0x9F r:3] [0xA0 0x00 'A' \"hello world\" d:10 r:8] {0x13 0x4B 0x1 D:2 r}";
+    static const std::string longWrite = [] {
+        std::string s = "[0x02 0x00 0x00 0x00";
+        for (int i = 0; i < 256; ++i) s += " 0x" + std::to_string(10 + i % 90);
+        return s + "]";
+    }();
+
+    runner.add("InstructionTransformer/flash-read", [] {
+        instructionTransformer.transform(flashRead, program);
+        BenchmarkRunner::keep(program.size());
+    }, flashRead.size());
+
+    runner.add("InstructionTransformer/mixed", [] {
+        instructionTransformer.transform(mixed, program);
+        BenchmarkRunner::keep(program.size());
+    }, mixed.size());
+
+    runner.add("InstructionTransformer/write-256", [] {
+        instructionTransformer.transform(longWrite, program);
+        BenchmarkRunner::keep(program.size());
+    }, longWrite.size());
+
+    // Footprint of the compiled write-256 line
+    runner.addReport("InstructionTransformer/write-256-footprint", [] {
+        instructionTransformer.transform(longWrite, program);
+        printf("  %zu ops (%zu bytes) + %zu payload bytes, was %zu ByteCode objects (%zu bytes)\n",
+               program.size(), program.size() * sizeof(ByteCodeOp), program.payloadSize(),
+               program.payloadSize() + 2, (program.payloadSize() + 2) * size_t(20));
+    });
+
+    // Typical interactive lines, compiled back to back into the same program
+    runner.addReport("InstructionTransformer/lines-per-second", [] {
+        static const char* lines[] = {
+            "[0x9F r:3]", "[0x03 0x00 0x10 0x00 r:255]", "[0x50 0x00 r:32]",
+            "[0xA0 0x00 'A' \"hello world\" d:10 r:8]", "{0x13 0x4B 0x1 D:2 r}", ">0x55 0xAA rrrr",
+        };
+        const size_t rounds = 200000;
+        auto start = std::chrono::steady_clock::now();
+        size_t ops = 0;
+        for (size_t i = 0; i < rounds; ++i) {
+            instructionTransformer.transform(lines[i % 6], program);
+            ops += program.size();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printf("  %.0f lines/s, %zu ops compiled\n", rounds / seconds, ops);
+    });
+
+    runner.add("ArgTransformer/parseHexList", [] {
+        auto bytes = argTransformer.parseHexList("01 A5 FF 10 20 30 40 50 60 70 80 90 AA BB CC DD");
+        BenchmarkRunner::keep(bytes.size());
+    });
+
+    runner.add("ArgTransformer/decodeEscapes", [] {
+        auto decoded = argTransformer.decodeEscapes("AT+CWJAP=\\\"ssid\\\",\\\"pass\\\"\\r\\n\\x41\\x42");
+        BenchmarkRunner::keep(decoded.size());
+    });
+
+    runner.add("TerminalCommandTransformer/transform", [] {
+        auto cmd = commandTransformer.transform("write 0x50 0x10 0xFF");
+        BenchmarkRunner::keep(cmd.getRoot().size());
+    });
+
+    // What the dispatcher does, one command reused for every line
+    runner.add("TerminalCommandTransformer/transform-reused", [] {
+        static TerminalCommand cmd;
+        commandTransformer.transform(std::string_view("write 0x50 0x10 0xFF"), cmd);
+        BenchmarkRunner::keep(cmd.getRoot().size());
+    });
+
+    static BenchRoutedController routed;
+    static const TerminalCommand config("config");
+
+    runner.add("CommandRouter/dispatch-last-route", [] {
+        routed.handleCommand(config);
+        BenchmarkRunner::keep(routed.hits);
+    });
+
+    runner.add("CommandRouter/compare-chain-last-route", [] {
+        routed.handleCommandChain(config);
+        BenchmarkRunner::keep(routed.hits);
+    });
+}
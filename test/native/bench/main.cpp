@@ -0,0 +1,26 @@
+#ifndef UNIT_TEST
+
+#include <string>
+#include "Benchmarks.h"
+
+/*
+Native benchmark entry point
+Usage: pio run -e native -t exec [-a <filter>]
+*/
+int main(int argc, char** argv) {
+    BenchmarkRunner runner(argc > 1 ? argv[1] : "");
+
+    registerTransformerBenchmarks(runner);
+    registerAnalyzerBenchmarks(runner);
+    registerServerBenchmarks(runner);
+    registerBusBenchmarks(runner);
+    registerFlashBenchmarks(runner);
+    registerDumpBenchmarks(runner);
+    registerSearchBenchmarks(runner);
+    registerJobBenchmarks(runner);
+    registerCaptureBenchmarks(runner);
+
+    return runner.run();
+}
+
+#endif
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <Wire.h>
+
+/*
+I2C device with 256 registers and an auto-incremented pointer,
+like most sensors and small EEPROMs
+*/
+class FakeI2cRegisters : public FakeI2cDevice {
+public:
+    FakeI2cRegisters() {
+        for (int i = 0; i < 256; ++i) registers[i] = i;
+    }
+
+    bool onWrite(const uint8_t* data, size_t len) override {
+        if (len == 0) return true;
+        pointer = data[0];
+        for (size_t i = 1; i < len; ++i) registers[pointer++] = data[i];
+        return true;
+    }
+
+    size_t onRead(uint8_t* out, size_t len) override {
+        for (size_t i = 0; i < len; ++i) out[i] = registers[pointer++];
+        return len;
+    }
+
+private:
+    uint8_t registers[256];
+    uint8_t pointer = 0;
+};
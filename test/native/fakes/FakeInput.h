@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <deque>
+#include "Interfaces/IInput.h"
+
+/*
+Input test double, replays injected keys then reports KEY_NONE
+*/
+class FakeInput : public IInput {
+public:
+    char handler() override { return readChar(); }
+
+    char readChar() override {
+        if (keys.empty()) return KEY_NONE;
+        char c = keys.front();
+        keys.pop_front();
+        return c;
+    }
+
+    void waitPress() override { readChar(); }
+
+    void inject(const std::string& data) { keys.insert(keys.end(), data.begin(), data.end()); }
+
+private:
+    std::deque<char> keys;
+};
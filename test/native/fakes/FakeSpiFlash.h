@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SPI.h>
+#include <vector>
+
+/*
+RAM backed SPI NOR flash answering the common command set:
+JEDEC ID, status, write enable, page program, 4K sector erase
+and the 0x03 / 0x0B / 0x3B / 0x6B reads
+*/
+class FakeSpiFlash : public FakeSpiDevice {
+public:
+    explicit FakeSpiFlash(size_t size = 1 << 20, uint8_t manufacturer = 0xEF, uint8_t type = 0x40, uint8_t capacity = 0x14)
+        : memory(size, 0xFF), id{ manufacturer, type, capacity } {}
+
+    void select() override { position = 0; command = 0; }
+
+    void deselect() override {
+        if (command == 0x06) writeEnabled = true;
+        if (command == 0x02 || command == 0x20) writeEnabled = false;
+    }
+
+    uint8_t exchange(uint8_t mosi) override {
+        size_t index = position++;
+        if (index == 0) {
+            command = mosi;
+            address = 0;
+            return 0xFF;
+        }
+
+        switch (command) {
+            case 0x9F: // JEDEC ID
+                return index <= 3 ? id[index - 1] : 0xFF;
+            case 0x05: // status register, never busy
+                return writeEnabled ? 0x02 : 0x00;
+            case 0x03: // read
+                return readAt(index, 0, mosi);
+            case 0x0B: // fast read
+            case 0x3B: // dual output read
+            case 0x6B: // quad output read
+                return readAt(index, 1, mosi);
+            case 0x02: // page program
+                if (index <= 3) { address = (address << 8) | mosi; return 0xFF; }
+                if (writeEnabled) {
+                    uint32_t page = address & ~0xFFu;
+                    uint32_t target = page | ((address + index - 4) & 0xFF);
+                    if (target < memory.size()) memory[target] &= mosi;
+                }
+                return 0xFF;
+            case 0x20: // sector erase
+                if (index <= 3) address = (address << 8) | mosi;
+                if (index == 3 && writeEnabled) {
+                    uint32_t sector = address & ~0xFFFu;
+                    for (uint32_t i = sector; i < sector + 4096 && i < memory.size(); ++i) memory[i] = 0xFF;
+                }
+                return 0xFF;
+            default:
+                return 0xFF;
+        }
+    }
+
+    std::vector<uint8_t>& data() { return memory; }
+
+private:
+    std::vector<uint8_t> memory;
+    uint8_t id[3];
+    size_t position = 0;
+    uint8_t command = 0;
+    uint32_t address = 0;
+    bool writeEnabled = false;
+
+    uint8_t readAt(size_t index, size_t dummyBytes, uint8_t mosi) {
+        if (index <= 3) {
+            address = (address << 8) | mosi;
+            return 0xFF;
+        }
+        if (index <= 3 + dummyBytes) return 0xFF;
+        size_t offset = (address + index - 4 - dummyBytes) % memory.size();
+        return memory[offset];
+    }
+};
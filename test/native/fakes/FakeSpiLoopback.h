@@ -0,0 +1,18 @@
+#pragma once
+
+#include <SPI.h>
+
+/*
+SPI device echoing MOSI on MISO, the cheapest possible chip
+*/
+class FakeSpiLoopback : public FakeSpiDevice {
+public:
+    void select() override { selects++; }
+    void deselect() override {}
+    uint8_t exchange(uint8_t mosi) override { return mosi; }
+
+    uint32_t getSelects() const { return selects; }
+
+private:
+    uint32_t selects = 0;
+};
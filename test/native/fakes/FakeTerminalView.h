@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+#include "Interfaces/ITerminalView.h"
+
+/*
+Terminal view test double, output is counted and optionally kept
+*/
+class FakeTerminalView : public ITerminalView {
+public:
+    explicit FakeTerminalView(bool keepOutput = false) : keepOutput(keepOutput) {}
+
+    void initialize() override {}
+    void welcome(TerminalTypeEnum& terminalType, std::string& terminalInfos) override {}
+    void print(const std::string& text) override { append(text); }
+    void println(const std::string& text) override { append(text); append("\n"); }
+    void printPrompt(const std::string& mode = "HIZ") override { append(mode + "> "); }
+    void waitPress() override {}
+    void clear() override { output.clear(); }
+
+    const std::string& getOutput() const { return output; }
+    size_t getBytesWritten() const { return bytesWritten; }
+    size_t getCalls() const { return calls; }
+
+private:
+    bool keepOutput;
+    std::string output;
+    size_t bytesWritten = 0;
+    size_t calls = 0;
+
+    void append(const std::string& text) {
+        calls++;
+        bytesWritten += text.size();
+        if (keepOutput) output += text;
+    }
+};
@@ -0,0 +1,162 @@
+#include "Arduino.h"
+#include "soc/gpio_reg.h"
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <vector>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+static std::chrono::steady_clock::time_point bootTime = std::chrono::steady_clock::now();
+static uint64_t virtualMicros = 0;
+static std::atomic<uint8_t> levels[NativeHal::PIN_COUNT] = {}; // benches drive pins from other threads
+static uint8_t modes[NativeHal::PIN_COUNT] = {0};
+static std::vector<NativeHal::PinWriteHook> pinHooks;
+static std::mt19937 rng(42);
+
+/*
+Time
+*/
+static uint64_t nowMicros() {
+    auto elapsed = std::chrono::steady_clock::now() - bootTime;
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() + virtualMicros;
+}
+
+uint32_t EspClass::getCycleCount() {
+    auto elapsed = std::chrono::steady_clock::now() - bootTime;
+    uint64_t nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() + virtualMicros * 1000;
+    return static_cast<uint32_t>(nanos * getCpuFreqMHz() / 1000);
+}
+
+unsigned long millis() {
+    return nowMicros() / 1000;
+}
+
+unsigned long micros() {
+    return nowMicros();
+}
+
+void delay(uint32_t ms) {
+    virtualMicros += uint64_t(ms) * 1000;
+}
+
+void delayMicroseconds(uint32_t us) {
+    virtualMicros += us;
+}
+
+void esp_rom_delay_us(uint32_t us) {
+    virtualMicros += us;
+}
+
+void yield() {}
+
+/*
+GPIO
+*/
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin >= NativeHal::PIN_COUNT) return;
+    modes[pin] = mode;
+    if (mode == INPUT_PULLUP) levels[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t level) {
+    if (pin >= NativeHal::PIN_COUNT) return;
+    levels[pin] = level ? HIGH : LOW;
+    for (auto& hook : pinHooks) {
+        hook(pin, levels[pin]);
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    if (pin >= NativeHal::PIN_COUNT) return LOW;
+    return levels[pin];
+}
+
+uint16_t analogRead(uint8_t pin) {
+    return digitalRead(pin) ? 4095 : 0;
+}
+
+/*
+PWM
+*/
+bool ledcSetup(uint8_t channel, uint32_t freq, uint8_t resolution) {
+    return true;
+}
+
+void ledcAttachPin(uint8_t pin, uint8_t channel) {}
+
+void ledcWrite(uint8_t channel, uint32_t duty) {}
+
+/*
+Random
+*/
+long random(long max) {
+    if (max <= 0) return 0;
+    return rng() % max;
+}
+
+long random(long min, long max) {
+    if (max <= min) return min;
+    return min + random(max - min);
+}
+
+void randomSeed(unsigned long seed) {
+    rng.seed(seed);
+}
+
+/*
+Serial
+*/
+int HardwareSerial::read() {
+    if (rx.empty()) return -1;
+    uint8_t c = rx.front();
+    rx.pop_front();
+    return c;
+}
+
+/*
+Native HAL controls
+*/
+namespace NativeHal {
+
+void advanceMicros(uint64_t us) {
+    virtualMicros += us;
+}
+
+void resetClock() {
+    bootTime = std::chrono::steady_clock::now();
+    virtualMicros = 0;
+}
+
+uint8_t pinLevel(uint8_t pin) {
+    return pin < PIN_COUNT ? levels[pin].load() : LOW;
+}
+
+uint8_t pinModeOf(uint8_t pin) {
+    return pin < PIN_COUNT ? modes[pin] : 0;
+}
+
+void setPinLevel(uint8_t pin, uint8_t level) {
+    if (pin < PIN_COUNT) levels[pin] = level ? HIGH : LOW;
+}
+
+uint32_t readRegister(uint32_t address) {
+    uint8_t first = address == GPIO_IN1_REG ? 32 : 0;
+    if (address != GPIO_IN_REG && address != GPIO_IN1_REG) return 0;
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < 32 && first + i < PIN_COUNT; ++i) {
+        value |= uint32_t(levels[first + i] ? 1 : 0) << i;
+    }
+    return value;
+}
+
+void onPinWrite(PinWriteHook hook) {
+    pinHooks.push_back(std::move(hook));
+}
+
+void clearPinHooks() {
+    pinHooks.clear();
+}
+
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+/*
+Host stand-in for the Arduino-ESP32 core, only used by [env:native].
+
+Time is virtual: delay() and delayMicroseconds() advance the clock
+instead of sleeping, so bus code with timeouts runs at full host speed.
+GPIO is a flat array of levels that fakes and benchmarks can drive.
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <deque>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT          0x01
+#define OUTPUT         0x03
+#define PULLUP         0x04
+#define INPUT_PULLUP   0x05
+#define PULLDOWN       0x08
+#define INPUT_PULLDOWN 0x09
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+// Critical sections are spinlocks between host threads, like across the two cores
+struct portMUX_TYPE {
+    std::atomic_flag locked = ATOMIC_FLAG_INIT;
+};
+#define portMUX_INITIALIZER_UNLOCKED {}
+inline void nativeEnterCritical(portMUX_TYPE* mux) {
+    while (mux->locked.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+}
+inline void nativeExitCritical(portMUX_TYPE* mux) {
+    mux->locked.clear(std::memory_order_release);
+}
+#define portENTER_CRITICAL(mux)     nativeEnterCritical(mux)
+#define portEXIT_CRITICAL(mux)      nativeExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux) nativeEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux)  nativeExitCritical(mux)
+
+// Time
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void esp_rom_delay_us(uint32_t us);
+void yield();
+
+// CPU, the cycle counter runs off the clock at a nominal 240 MHz
+class EspClass {
+public:
+    uint32_t getCycleCount();
+    uint32_t getCpuFreqMHz() { return 240; }
+};
+extern EspClass ESP;
+
+// GPIO
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t level);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+
+// PWM
+bool ledcSetup(uint8_t channel, uint32_t freq, uint8_t resolution);
+void ledcAttachPin(uint8_t pin, uint8_t channel);
+void ledcWrite(uint8_t channel, uint32_t duty);
+
+// Random
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+/*
+Native HAL controls, used by fakes and benchmarks to drive the shims
+*/
+namespace NativeHal {
+    constexpr uint8_t PIN_COUNT = 64;
+
+    // Virtual clock
+    void advanceMicros(uint64_t us);
+    void resetClock();
+
+    // Pin levels and modes
+    uint8_t pinLevel(uint8_t pin);
+    uint8_t pinModeOf(uint8_t pin);
+    void setPinLevel(uint8_t pin, uint8_t level);
+
+    // GPIO input registers, the only ones REG_READ knows
+    uint32_t readRegister(uint32_t address);
+
+    // Called on every digitalWrite, eg. chip select for fake SPI devices
+    using PinWriteHook = std::function<void(uint8_t pin, uint8_t level)>;
+    void onPinWrite(PinWriteHook hook);
+    void clearPinHooks();
+}
+
+/*
+Minimal Arduino String, enough for the libraries compiled on the host
+*/
+class String {
+public:
+    String(const char* s = "") : value(s ? s : "") {}
+    String(const std::string& s) : value(s) {}
+
+    const char* c_str() const { return value.c_str(); }
+    unsigned int length() const { return value.length(); }
+    char charAt(unsigned int index) const { return index < value.length() ? value[index] : 0; }
+    void remove(unsigned int index, unsigned int count) { value.erase(index, count); }
+    String& operator+=(char c) { value += c; return *this; }
+    String& operator+=(const String& s) { value += s.value; return *this; }
+    bool operator==(const String& s) const { return value == s.value; }
+
+private:
+    std::string value;
+};
+
+/*
+Fake Serial, output is captured and input can be injected
+*/
+class HardwareSerial {
+public:
+    void begin(unsigned long baud) { baudRate = baud; }
+    void end() {}
+    int available() { return rx.size(); }
+    int read();
+    int peek() { return rx.empty() ? -1 : rx.front(); }
+    size_t write(uint8_t c) { tx += static_cast<char>(c); return 1; }
+    size_t write(const uint8_t* data, size_t len) { tx.append(reinterpret_cast<const char*>(data), len); return len; }
+    size_t print(const char* s) { tx += s; return strlen(s); }
+    size_t print(const String& s) { return print(s.c_str()); }
+    size_t println(const char* s = "") { return print(s) + print("\r\n"); }
+    size_t println(const String& s) { return println(s.c_str()); }
+    void flush() {}
+    operator bool() const { return true; }
+
+    // Native controls
+    void inject(const std::string& data) { rx.insert(rx.end(), data.begin(), data.end()); }
+    const std::string& output() const { return tx; }
+    void clearOutput() { tx.clear(); }
+
+private:
+    unsigned long baudRate = 115200;
+    std::deque<uint8_t> rx;
+    std::string tx;
+};
+
+extern HardwareSerial Serial;
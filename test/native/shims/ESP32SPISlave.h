@@ -0,0 +1,29 @@
+#pragma once
+
+/*
+Host stand-in for hideakitai/ESP32SPISlave, never receives anything
+*/
+
+#include <Arduino.h>
+#include <SPI.h>
+
+typedef struct {
+    size_t length;
+    size_t trans_len;
+    const void* tx_buffer;
+    void* rx_buffer;
+    void* user;
+} spi_slave_transaction_t;
+
+typedef void (*slave_transaction_cb_t)(spi_slave_transaction_t* trans, void* arg);
+
+class ESP32SPISlave {
+public:
+    void setDataMode(uint8_t mode) {}
+    void setQueueSize(size_t size) {}
+    void setUserPostTransCbAndArg(slave_transaction_cb_t cb, void* arg) {}
+    bool begin(uint8_t bus, int sck, int miso, int mosi, int ss) { return true; }
+    void end() {}
+    bool queue(const uint8_t* tx, uint8_t* rx, size_t size) { return true; }
+    bool trigger() { return true; }
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+/*
+Host stand-in for the Arduino-ESP32 Preferences library.
+Namespaces live in RAM for the lifetime of the process.
+*/
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false) {
+        current = &store()[name];
+        return true;
+    }
+    void end() { current = nullptr; }
+
+    bool isKey(const char* key) { return current && current->count(key); }
+    bool remove(const char* key) { return current && current->erase(key); }
+    bool clear() {
+        if (current) current->clear();
+        return current != nullptr;
+    }
+
+    size_t putString(const char* key, const char* value) {
+        if (!current) return 0;
+        (*current)[key] = value;
+        return strlen(value);
+    }
+    String getString(const char* key, const String& defaultValue = String()) {
+        if (!isKey(key)) return defaultValue;
+        return String((*current)[key]);
+    }
+
+    size_t putInt(const char* key, int32_t value) { return putString(key, std::to_string(value).c_str()) ? 4 : 0; }
+    int32_t getInt(const char* key, int32_t defaultValue = 0) {
+        return isKey(key) ? std::atoi((*current)[key].c_str()) : defaultValue;
+    }
+
+private:
+    std::map<std::string, std::string>* current = nullptr;
+
+    static std::map<std::string, std::map<std::string, std::string>>& store() {
+        static std::map<std::string, std::map<std::string, std::string>> namespaces;
+        return namespaces;
+    }
+};
@@ -0,0 +1,3 @@
+#include "SD.h"
+
+SDFS SD;
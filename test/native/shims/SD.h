@@ -0,0 +1,151 @@
+#pragma once
+
+/*
+Host stand-in for the Arduino-ESP32 SD library, a RAM file system.
+Paths are absolute, directories are implicit parents or mkdir'd entries.
+*/
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstring>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+struct NativeFsNode {
+    bool directory = false;
+    std::vector<uint8_t> data;
+};
+
+class File {
+public:
+    File() = default;
+    File(std::shared_ptr<NativeFsNode> node, const std::string& path, std::vector<std::string> children = {})
+        : node(std::move(node)), path(path), children(std::move(children)) {}
+
+    explicit operator bool() const { return node != nullptr; }
+
+    size_t write(const uint8_t* buf, size_t size) {
+        if (!node || node->directory) return 0;
+        writes++;
+        if (position + size > node->data.size()) node->data.resize(position + size);
+        memcpy(node->data.data() + position, buf, size);
+        position += size;
+        return size;
+    }
+    size_t write(uint8_t c) { return write(&c, 1); }
+
+    int read() {
+        if (!node || position >= node->data.size()) return -1;
+        return node->data[position++];
+    }
+    size_t read(uint8_t* buf, size_t size) {
+        if (!node) return 0;
+        size_t n = std::min(size, node->data.size() - std::min(position, node->data.size()));
+        memcpy(buf, node->data.data() + position, n);
+        position += n;
+        return n;
+    }
+    size_t readBytes(char* buf, size_t size) { return read(reinterpret_cast<uint8_t*>(buf), size); }
+    int available() { return node ? int(node->data.size() - std::min(position, node->data.size())) : 0; }
+    bool seek(uint32_t pos) { if (!node || pos > node->data.size()) return false; position = pos; return true; }
+    size_t size() const { return node ? node->data.size() : 0; }
+    void flush() {}
+    void close() { node.reset(); }
+    bool isDirectory() const { return node && node->directory; }
+    const char* name() const {
+        size_t slash = path.find_last_of('/');
+        return path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+    }
+    File openNextFile();
+
+    // Native controls
+    uint32_t writeCount() const { return writes; }
+
+private:
+    std::shared_ptr<NativeFsNode> node;
+    std::string path;
+    size_t position = 0;
+    std::vector<std::string> children;
+    size_t nextChild = 0;
+    uint32_t writes = 0;
+};
+
+class SDFS {
+public:
+    bool begin(uint8_t csPin = 0, SPIClass& spi = SPI, uint32_t frequency = 4000000) { mounted = present; return mounted; }
+    void end() { mounted = false; }
+
+    File open(const char* path, const char* mode = FILE_READ) {
+        if (!mounted) return File();
+        std::string p(path);
+        auto it = nodes.find(p);
+
+        if (mode[0] == 'r') {
+            if (it != nodes.end()) return File(it->second, p, it->second->directory ? childrenOf(p) : std::vector<std::string>{});
+            if (isImplicitDirectory(p)) return File(std::make_shared<NativeFsNode>(NativeFsNode{true, {}}), p, childrenOf(p));
+            return File();
+        }
+
+        if (it == nodes.end() || mode[0] == 'w') {
+            nodes[p] = std::make_shared<NativeFsNode>();
+        }
+        File file(nodes[p], p);
+        if (mode[0] == 'a') file.seek(file.size());
+        return file;
+    }
+    File open(const std::string& path, const char* mode = FILE_READ) { return open(path.c_str(), mode); }
+
+    bool exists(const char* path) { return nodes.count(path) || isImplicitDirectory(path); }
+    bool remove(const char* path) { return nodes.erase(path) > 0; }
+    bool mkdir(const char* path) { nodes[path] = std::make_shared<NativeFsNode>(NativeFsNode{true, {}}); return true; }
+    bool rmdir(const char* path) { return nodes.erase(path) > 0; }
+
+    // Native controls
+    void setCardPresent(bool value) { present = value; }
+    std::vector<uint8_t>* fileData(const std::string& path) {
+        auto it = nodes.find(path);
+        return it == nodes.end() ? nullptr : &it->second->data;
+    }
+    void format() { nodes.clear(); }
+
+private:
+    bool present = true;
+    bool mounted = false;
+    std::map<std::string, std::shared_ptr<NativeFsNode>> nodes;
+
+    static std::string prefixOf(const std::string& dir) { return dir == "/" ? "/" : dir + "/"; }
+
+    bool isImplicitDirectory(const std::string& dir) const {
+        if (dir == "/") return true;
+        std::string prefix = prefixOf(dir);
+        auto it = nodes.lower_bound(prefix);
+        return it != nodes.end() && it->first.compare(0, prefix.size(), prefix) == 0;
+    }
+
+    std::vector<std::string> childrenOf(const std::string& dir) const {
+        std::vector<std::string> out;
+        std::string prefix = prefixOf(dir);
+        for (const auto& entry : nodes) {
+            if (entry.first.compare(0, prefix.size(), prefix) != 0) continue;
+            std::string child = prefix + entry.first.substr(prefix.size()).substr(0, entry.first.substr(prefix.size()).find('/'));
+            if (out.empty() || out.back() != child) out.push_back(child);
+        }
+        return out;
+    }
+
+    friend class File;
+};
+
+extern SDFS SD;
+
+inline File File::openNextFile() {
+    if (nextChild >= children.size()) return File();
+    const std::string& child = children[nextChild++];
+    return SD.open(child.c_str(), FILE_READ);
+}
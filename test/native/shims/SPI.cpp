@@ -0,0 +1,81 @@
+#include "SPI.h"
+
+SPIClass SPI(FSPI);
+
+bool SPIClass::begin(int8_t sck, int8_t miso, int8_t mosi, int8_t ss) {
+    return true;
+}
+
+void SPIClass::end() {}
+
+void SPIClass::beginTransaction(SPISettings s) {
+    settings = s;
+}
+
+void SPIClass::endTransaction() {}
+
+uint8_t SPIClass::transfer(uint8_t data) {
+    account(1);
+    return exchange(data);
+}
+
+void SPIClass::transfer(void* data, uint32_t size) {
+    account(size);
+    uint8_t* buf = static_cast<uint8_t*>(data);
+    for (uint32_t i = 0; i < size; ++i) {
+        buf[i] = exchange(buf[i]);
+    }
+}
+
+void SPIClass::transferBytes(const uint8_t* data, uint8_t* out, uint32_t size) {
+    account(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        uint8_t rx = exchange(data ? data[i] : 0xFF);
+        if (out) out[i] = rx;
+    }
+}
+
+void SPIClass::writeBytes(const uint8_t* data, uint32_t size) {
+    account(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        exchange(data[i]);
+    }
+}
+
+void SPIClass::attachDevice(FakeSpiDevice* dev, uint8_t csPin) {
+    device = dev;
+    devicePin = csPin;
+    selected = false;
+
+    // One hook per bus, it follows the currently attached device
+    if (hooked) return;
+    hooked = true;
+    NativeHal::onPinWrite([this](uint8_t pin, uint8_t level) {
+        if (!device || pin != devicePin) return;
+        if (level == LOW && !selected) {
+            selected = true;
+            device->select();
+        } else if (level == HIGH && selected) {
+            selected = false;
+            device->deselect();
+        }
+    });
+}
+
+void SPIClass::detachDevice() {
+    device = nullptr;
+    devicePin = 0xFF;
+    selected = false;
+}
+
+uint8_t SPIClass::exchange(uint8_t data) {
+    bytes++;
+    if (!device || !selected) return 0xFF;
+    return device->exchange(data);
+}
+
+void SPIClass::account(uint32_t size) {
+    calls++;
+    uint32_t clock = settings.clock ? settings.clock : 1000000;
+    busNanos += CALL_OVERHEAD_NS + (uint64_t(size) * 8 * 1000000000ull) / (uint64_t(clock) * dataLanes);
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+/*
+Host stand-in for the Arduino-ESP32 SPIClass.
+
+A FakeSpiDevice can be attached with its chip select pin, it is selected
+and deselected through digitalWrite() like a real chip on the bus.
+Unattached buses answer 0xFF, like a floating MISO with pull-up.
+
+Bus time is modelled per call: a fixed driver overhead plus the clock
+time of the bytes on the configured number of data lanes.
+*/
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x01
+#define SPI_MODE2 0x02
+#define SPI_MODE3 0x03
+
+#define FSPI 0
+#define HSPI 1
+
+class FakeSpiDevice {
+public:
+    virtual ~FakeSpiDevice() = default;
+
+    // CS asserted
+    virtual void select() = 0;
+
+    // CS released
+    virtual void deselect() = 0;
+
+    // One full duplex byte
+    virtual uint8_t exchange(uint8_t mosi) = 0;
+};
+
+class SPISettings {
+public:
+    SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0)
+        : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+
+    uint32_t clock;
+    uint8_t bitOrder;
+    uint8_t dataMode;
+};
+
+class SPIClass {
+public:
+    explicit SPIClass(uint8_t bus = FSPI) : bus(bus) {}
+
+    bool begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1);
+    void end();
+
+    void beginTransaction(SPISettings settings);
+    void endTransaction();
+    void setFrequency(uint32_t freq) { settings.clock = freq; }
+
+    uint8_t transfer(uint8_t data);
+    void transfer(void* data, uint32_t size);
+    void transferBytes(const uint8_t* data, uint8_t* out, uint32_t size);
+    void writeBytes(const uint8_t* data, uint32_t size);
+
+    // Native controls, attaching replaces the previous device
+    void attachDevice(FakeSpiDevice* device, uint8_t csPin);
+    void detachDevice();
+    uint32_t callCount() const { return calls; }
+    uint64_t byteCount() const { return bytes; }
+    uint64_t busTimeNs() const { return busNanos; }
+    void resetCounters() { calls = 0; bytes = 0; busNanos = 0; }
+    void setDataLanes(uint8_t lanes) { dataLanes = lanes; }
+
+    // Rough cost of one HAL call on target (register setup and busy wait)
+    static constexpr uint32_t CALL_OVERHEAD_NS = 1000;
+
+private:
+    uint8_t bus;
+    SPISettings settings;
+    FakeSpiDevice* device = nullptr;
+    uint8_t devicePin = 0xFF;
+    bool selected = false;
+    bool hooked = false;
+    uint32_t calls = 0;
+    uint64_t bytes = 0;
+    uint64_t busNanos = 0;
+    uint8_t dataLanes = 1;
+
+    uint8_t exchange(uint8_t data);
+    void account(uint32_t size);
+};
+
+extern SPIClass SPI;
@@ -0,0 +1,57 @@
+#pragma once
+
+/*
+Host stand-in for the SparkFun External EEPROM library, backed by RAM
+*/
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <vector>
+
+class ExternalEEPROM {
+public:
+    bool begin(uint8_t deviceAddress = 0x50, TwoWire& wirePort = Wire) { address = deviceAddress; return true; }
+    void setMemoryType(uint16_t typeKbits) { setMemorySizeBytes(uint32_t(typeKbits) * 128); }
+    void setMemorySizeBytes(uint32_t size) { memory.assign(size, 0xFF); }
+    void setAddressBytes(uint8_t bytes) { addressBytes = bytes; }
+    void setPageSizeBytes(uint16_t size) { pageSize = size; }
+
+    uint8_t read(uint32_t addr) { return addr < memory.size() ? memory[addr] : 0xFF; }
+    void read(uint32_t addr, uint8_t* buffer, uint16_t size) {
+        for (uint16_t i = 0; i < size; ++i) buffer[i] = read(addr + i);
+    }
+    int write(uint32_t addr, uint8_t value) {
+        if (addr >= memory.size()) return 1;
+        memory[addr] = value;
+        return 0;
+    }
+
+    uint32_t putString(uint32_t addr, String& str) {
+        for (unsigned int i = 0; i <= str.length(); ++i) write(addr + i, str.charAt(i));
+        return str.length() + 1;
+    }
+    void getString(uint32_t addr, String& str) {
+        str.remove(0, str.length());
+        for (uint8_t c = read(addr); c != 0 && addr < memory.size(); c = read(++addr)) str += static_cast<char>(c);
+    }
+
+    void erase(uint8_t fill = 0x00) { std::fill(memory.begin(), memory.end(), fill); }
+    uint32_t length() { return memory.size(); }
+    uint32_t getMemorySizeBytes() { return memory.size(); }
+    uint16_t getPageSizeBytes() { return pageSize; }
+    uint8_t getWriteTimeMs() { return 5; }
+    uint8_t getAddressBytes() { return addressBytes; }
+    bool isConnected(uint8_t i2cAddress = 255) { return true; }
+    bool isBusy(uint8_t i2cAddress = 255) { return false; }
+
+    uint32_t detectMemorySizeBytes() { return memory.size(); }
+    uint8_t detectAddressBytes() { return addressBytes; }
+    uint16_t detectPageSizeBytes() { return pageSize; }
+    uint8_t detectWriteTimeMs(uint8_t numberOfTests = 8) { return 5; }
+
+private:
+    uint8_t address = 0x50;
+    uint8_t addressBytes = 2;
+    uint16_t pageSize = 64;
+    std::vector<uint8_t> memory = std::vector<uint8_t>(65536, 0xFF);
+};
@@ -0,0 +1,85 @@
+#include "Wire.h"
+
+TwoWire Wire(0);
+TwoWire Wire1(1);
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) {
+    if (frequency) clock = frequency;
+    return true;
+}
+
+bool TwoWire::begin(uint8_t slaveAddr, int sda, int scl, uint32_t frequency) {
+    return begin(sda, scl, frequency);
+}
+
+bool TwoWire::end() {
+    txBuffer.clear();
+    rxBuffer.clear();
+    rxIndex = 0;
+    return true;
+}
+
+void TwoWire::beginTransmission(uint16_t address) {
+    calls++;
+    txAddress = address;
+    txBuffer.clear();
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    calls++;
+    transactions++;
+    auto it = devices.find(txAddress);
+    if (it == devices.end()) return 2; // address NACK
+    return it->second->onWrite(txBuffer.data(), txBuffer.size()) ? 0 : 3; // 3 = data NACK
+}
+
+uint8_t TwoWire::requestFrom(uint16_t address, uint8_t size, bool sendStop) {
+    calls++;
+    transactions++;
+    rxBuffer.assign(size, 0xFF);
+    rxIndex = 0;
+
+    auto it = devices.find(address);
+    if (it == devices.end()) {
+        rxBuffer.clear();
+        return 0;
+    }
+    size_t got = it->second->onRead(rxBuffer.data(), size);
+    rxBuffer.resize(got);
+    return got;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    calls++;
+    txBuffer.push_back(data);
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t size) {
+    calls++;
+    txBuffer.insert(txBuffer.end(), data, data + size);
+    return size;
+}
+
+int TwoWire::available() {
+    return rxBuffer.size() - rxIndex;
+}
+
+int TwoWire::read() {
+    calls++;
+    if (rxIndex >= rxBuffer.size()) return -1;
+    return rxBuffer[rxIndex++];
+}
+
+int TwoWire::peek() {
+    if (rxIndex >= rxBuffer.size()) return -1;
+    return rxBuffer[rxIndex];
+}
+
+void TwoWire::attachDevice(uint8_t address, FakeI2cDevice* device) {
+    devices[address] = device;
+}
+
+void TwoWire::detachDevices() {
+    devices.clear();
+}
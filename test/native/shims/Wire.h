@@ -0,0 +1,69 @@
+#pragma once
+
+/*
+Host stand-in for the Arduino-ESP32 TwoWire.
+
+FakeI2cDevice instances are attached by 7-bit address. Transmissions
+to an address without a device return a NACK (2), like an empty bus.
+*/
+
+#include <Arduino.h>
+#include <vector>
+#include <map>
+
+class FakeI2cDevice {
+public:
+    virtual ~FakeI2cDevice() = default;
+
+    // Master wrote a full transmission, return false to NACK
+    virtual bool onWrite(const uint8_t* data, size_t len) = 0;
+
+    // Master requested len bytes, return the count actually provided
+    virtual size_t onRead(uint8_t* out, size_t len) = 0;
+};
+
+class TwoWire {
+public:
+    explicit TwoWire(uint8_t bus = 0) : bus(bus) {}
+
+    // Master
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    bool end();
+    bool setClock(uint32_t frequency) { clock = frequency; return true; }
+    void beginTransmission(uint16_t address);
+    uint8_t endTransmission(bool sendStop = true);
+    uint8_t requestFrom(uint16_t address, uint8_t size, bool sendStop = true);
+    size_t write(uint8_t data);
+    size_t write(const uint8_t* data, size_t size);
+    int available();
+    int read();
+    int peek();
+
+    // Slave
+    bool begin(uint8_t slaveAddr, int sda, int scl, uint32_t frequency);
+    void onReceive(void (*callback)(int)) { receiveCallback = callback; }
+    void onRequest(void (*callback)()) { requestCallback = callback; }
+
+    // Native controls
+    void attachDevice(uint8_t address, FakeI2cDevice* device);
+    void detachDevices();
+    uint32_t callCount() const { return calls; }
+    uint32_t transactionCount() const { return transactions; }
+    void resetCounters() { calls = 0; transactions = 0; }
+
+private:
+    uint8_t bus;
+    uint32_t clock = 100000;
+    uint16_t txAddress = 0;
+    std::vector<uint8_t> txBuffer;
+    std::vector<uint8_t> rxBuffer;
+    size_t rxIndex = 0;
+    std::map<uint8_t, FakeI2cDevice*> devices;
+    void (*receiveCallback)(int) = nullptr;
+    void (*requestCallback)() = nullptr;
+    uint32_t calls = 0;
+    uint32_t transactions = 0;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
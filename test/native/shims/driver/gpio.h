@@ -0,0 +1,37 @@
+#pragma once
+
+/*
+Host stand-in for the ESP-IDF GPIO driver, backed by the native HAL pins
+*/
+
+#include <Arduino.h>
+
+typedef int gpio_num_t;
+typedef int esp_err_t;
+
+#ifndef ESP_OK
+#define ESP_OK 0
+#endif
+
+typedef enum {
+    GPIO_MODE_DISABLE = 0,
+    GPIO_MODE_INPUT = 1,
+    GPIO_MODE_OUTPUT = 2,
+    GPIO_MODE_OUTPUT_OD = 6,
+    GPIO_MODE_INPUT_OUTPUT_OD = 7,
+    GPIO_MODE_INPUT_OUTPUT = 3,
+} gpio_mode_t;
+
+inline int gpio_get_level(gpio_num_t pin) {
+    return digitalRead(pin);
+}
+
+inline esp_err_t gpio_set_level(gpio_num_t pin, uint32_t level) {
+    digitalWrite(pin, level);
+    return ESP_OK;
+}
+
+inline esp_err_t gpio_set_direction(gpio_num_t pin, gpio_mode_t mode) {
+    pinMode(pin, mode == GPIO_MODE_INPUT ? INPUT : OUTPUT);
+    return ESP_OK;
+}
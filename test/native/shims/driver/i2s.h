@@ -0,0 +1,263 @@
+#pragma once
+
+/*
+Host stand-in for the legacy ESP-IDF I2S driver, master RX only.
+
+A producer thread plays the DMA engine: at the bit clock of the config it
+fills buffers of dma_buf_len frames with the level of the data input,
+sampled from the signal attached with NativeI2s::attachSignal, first bit
+in the MSB of each 32 bit slot. Filled buffers wait in a ring of
+dma_buf_count, when the reader is late the oldest one is dropped and
+I2S_EVENT_RX_Q_OVF is posted, as the driver interrupt does.
+*/
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef int esp_err_t;
+
+#ifndef ESP_OK
+#define ESP_OK 0
+#endif
+#ifndef ESP_FAIL
+#define ESP_FAIL -1
+#endif
+#ifndef ESP_ERR_INVALID_ARG
+#define ESP_ERR_INVALID_ARG 0x102
+#endif
+#ifndef ESP_ERR_INVALID_STATE
+#define ESP_ERR_INVALID_STATE 0x103
+#endif
+#ifndef ESP_ERR_TIMEOUT
+#define ESP_ERR_TIMEOUT 0x107
+#endif
+#ifndef ESP_INTR_FLAG_LEVEL1
+#define ESP_INTR_FLAG_LEVEL1 (1 << 1)
+#endif
+
+#define I2S_PIN_NO_CHANGE (-1)
+
+typedef enum { I2S_NUM_0 = 0, I2S_NUM_1 = 1, I2S_NUM_MAX } i2s_port_t;
+
+typedef enum {
+    I2S_MODE_MASTER = 1 << 0,
+    I2S_MODE_SLAVE = 1 << 1,
+    I2S_MODE_TX = 1 << 2,
+    I2S_MODE_RX = 1 << 3,
+} i2s_mode_t;
+
+typedef enum {
+    I2S_BITS_PER_SAMPLE_8BIT = 8,
+    I2S_BITS_PER_SAMPLE_16BIT = 16,
+    I2S_BITS_PER_SAMPLE_24BIT = 24,
+    I2S_BITS_PER_SAMPLE_32BIT = 32,
+} i2s_bits_per_sample_t;
+
+typedef enum {
+    I2S_CHANNEL_FMT_RIGHT_LEFT,
+    I2S_CHANNEL_FMT_ALL_RIGHT,
+    I2S_CHANNEL_FMT_ALL_LEFT,
+    I2S_CHANNEL_FMT_ONLY_RIGHT,
+    I2S_CHANNEL_FMT_ONLY_LEFT,
+} i2s_channel_fmt_t;
+
+typedef enum {
+    I2S_COMM_FORMAT_STAND_I2S = 0x01,
+    I2S_COMM_FORMAT_I2S = 0x01,
+} i2s_comm_format_t;
+
+typedef struct {
+    i2s_mode_t mode;
+    uint32_t sample_rate;
+    i2s_bits_per_sample_t bits_per_sample;
+    i2s_channel_fmt_t channel_format;
+    i2s_comm_format_t communication_format;
+    int intr_alloc_flags;
+    int dma_buf_count;
+    int dma_buf_len;
+    bool use_apll;
+    bool tx_desc_auto_clear;
+    int fixed_mclk;
+} i2s_config_t;
+
+typedef struct {
+    int mck_io_num;
+    int bck_io_num;
+    int ws_io_num;
+    int data_out_num;
+    int data_in_num;
+} i2s_pin_config_t;
+
+typedef enum {
+    I2S_EVENT_DMA_ERROR,
+    I2S_EVENT_TX_DONE,
+    I2S_EVENT_RX_DONE,
+    I2S_EVENT_TX_Q_OVF,
+    I2S_EVENT_RX_Q_OVF,
+    I2S_EVENT_MAX,
+} i2s_event_type_t;
+
+typedef struct {
+    i2s_event_type_t type;
+    size_t size;
+} i2s_event_t;
+
+namespace NativeI2s {
+    // Level of the data input at a time since the driver was installed
+    using Signal = std::function<bool(uint64_t ns)>;
+
+    struct Port {
+        bool installed = false;
+        i2s_config_t config{};
+        Signal signal;
+        QueueHandle_t events = nullptr;
+        std::thread dma;
+        std::atomic<bool> running{false};
+        std::mutex mutex;
+        std::condition_variable filled;
+        std::deque<std::vector<uint8_t>> ring;
+        size_t offset = 0; // read position in the front buffer
+    };
+
+    inline Port& port(i2s_port_t num) {
+        static Port ports[I2S_NUM_MAX];
+        return ports[num];
+    }
+
+    inline void attachSignal(i2s_port_t num, Signal signal) {
+        port(num).signal = std::move(signal);
+    }
+
+    inline void post(Port& p, i2s_event_type_t type, size_t size) {
+        if (!p.events) return;
+        // The oldest event makes room, as in the driver interrupt
+        i2s_event_t event{type, size}, dropped;
+        if (xQueueSend(p.events, &event, 0) != pdPASS) {
+            xQueueReceive(p.events, &dropped, 0);
+            xQueueSend(p.events, &event, 0);
+        }
+    }
+
+    // The DMA engine, one buffer per dma_buf_len frames at the bit clock
+    inline void dmaLoop(Port* p) {
+        using Clock = std::chrono::steady_clock;
+        const auto& cfg = p->config;
+        const uint32_t bits = cfg.bits_per_sample;
+        const uint32_t slots = cfg.channel_format == I2S_CHANNEL_FMT_RIGHT_LEFT ? 2 : 1;
+        const double bitNs = 1e9 / (double(cfg.sample_rate) * bits * 2);
+        const size_t bufferBytes = size_t(cfg.dma_buf_len) * slots * bits / 8;
+        const auto bufferTime = std::chrono::nanoseconds(uint64_t(bitNs * bufferBytes * 8));
+        const auto startTime = Clock::now();
+        uint64_t bit = 0;
+
+        for (uint64_t n = 1; p->running; ++n) {
+            std::this_thread::sleep_until(startTime + bufferTime * n);
+
+            std::vector<uint8_t> buffer(bufferBytes, 0);
+            for (size_t word = 0; word < bufferBytes / 4; ++word) {
+                uint32_t value = 0;
+                for (int i = 31; i >= 0; --i, ++bit) {
+                    if (p->signal && p->signal(uint64_t(bit * bitNs))) value |= 1u << i;
+                }
+                memcpy(&buffer[word * 4], &value, 4);
+            }
+
+            bool overflow = false;
+            {
+                std::lock_guard<std::mutex> lock(p->mutex);
+                if (p->ring.size() >= size_t(cfg.dma_buf_count)) {
+                    p->ring.pop_front();
+                    p->offset = 0;
+                    overflow = true;
+                }
+                p->ring.push_back(std::move(buffer));
+            }
+            p->filled.notify_all();
+            if (overflow) post(*p, I2S_EVENT_RX_Q_OVF, bufferBytes);
+            post(*p, I2S_EVENT_RX_DONE, bufferBytes);
+        }
+    }
+}
+
+inline esp_err_t i2s_driver_install(i2s_port_t num, const i2s_config_t* config, int queueSize, void* queue) {
+    auto& p = NativeI2s::port(num);
+    if (p.installed) return ESP_ERR_INVALID_STATE;
+    if (!(config->mode & I2S_MODE_RX) || config->dma_buf_count < 2 || config->dma_buf_len <= 0) return ESP_ERR_INVALID_ARG;
+
+    p.config = *config;
+    p.ring.clear();
+    p.offset = 0;
+    p.events = nullptr;
+    if (queueSize > 0 && queue) {
+        p.events = xQueueCreate(queueSize, sizeof(i2s_event_t));
+        *static_cast<QueueHandle_t*>(queue) = p.events;
+    }
+
+    p.installed = true;
+    p.running = true;
+    p.dma = std::thread(NativeI2s::dmaLoop, &p);
+    return ESP_OK;
+}
+
+inline esp_err_t i2s_driver_uninstall(i2s_port_t num) {
+    auto& p = NativeI2s::port(num);
+    if (!p.installed) return ESP_ERR_INVALID_STATE;
+    p.running = false;
+    if (p.dma.joinable()) p.dma.join();
+    if (p.events) vQueueDelete(p.events);
+    p.events = nullptr;
+    p.installed = false;
+    return ESP_OK;
+}
+
+inline esp_err_t i2s_set_pin(i2s_port_t num, const i2s_pin_config_t* pins) {
+    if (pins && pins->data_in_num >= 0) pinMode(pins->data_in_num, INPUT);
+    return ESP_OK;
+}
+
+inline esp_err_t i2s_read(i2s_port_t num, void* dest, size_t size, size_t* bytesRead, TickType_t ticks) {
+    auto& p = NativeI2s::port(num);
+    *bytesRead = 0;
+    if (!p.installed) return ESP_ERR_INVALID_STATE;
+
+    auto* out = static_cast<uint8_t*>(dest);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ticks);
+    std::unique_lock<std::mutex> lock(p.mutex);
+    while (*bytesRead < size) {
+        auto ready = [&p] { return !p.ring.empty(); };
+        if (ticks == portMAX_DELAY) {
+            p.filled.wait(lock, ready);
+        } else if (!p.filled.wait_until(lock, deadline, ready)) {
+            break;
+        }
+
+        auto& front = p.ring.front();
+        size_t count = std::min(size - *bytesRead, front.size() - p.offset);
+        memcpy(out + *bytesRead, front.data() + p.offset, count);
+        *bytesRead += count;
+        p.offset += count;
+        if (p.offset == front.size()) {
+            p.ring.pop_front();
+            p.offset = 0;
+        }
+    }
+    return ESP_OK;
+}
+
+inline esp_err_t i2s_zero_dma_buffer(i2s_port_t num) {
+    auto& p = NativeI2s::port(num);
+    std::lock_guard<std::mutex> lock(p.mutex);
+    p.ring.clear();
+    p.offset = 0;
+    return ESP_OK;
+}
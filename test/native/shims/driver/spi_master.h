@@ -0,0 +1,116 @@
+#pragma once
+
+/*
+Host stand-in for the ESP-IDF SPI master driver.
+
+Transactions are replayed on the SPI fake device attached to the
+Arduino SPIClass, chip select included. Dual/quad data phases are
+emulated byte wise, the fake sees the same bytes as on a single line.
+*/
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <driver/gpio.h>
+
+#ifndef ESP_FAIL
+#define ESP_FAIL -1
+#endif
+
+#define SPI_DEVICE_HALFDUPLEX (1 << 4)
+#define SPI_TRANS_MODE_DIO (1 << 0)
+#define SPI_TRANS_MODE_QIO (1 << 1)
+#define SPI_DMA_CH_AUTO 3
+
+typedef enum { SPI1_HOST = 0, SPI2_HOST = 1, SPI3_HOST = 2 } spi_host_device_t;
+
+typedef struct {
+    int mosi_io_num;
+    int miso_io_num;
+    int sclk_io_num;
+    int quadwp_io_num;
+    int quadhd_io_num;
+    int max_transfer_sz;
+    uint32_t flags;
+} spi_bus_config_t;
+
+typedef struct {
+    uint8_t command_bits;
+    uint8_t address_bits;
+    uint8_t dummy_bits;
+    uint8_t mode;
+    int clock_speed_hz;
+    int spics_io_num;
+    uint32_t flags;
+    int queue_size;
+} spi_device_interface_config_t;
+
+typedef struct {
+    uint32_t flags;
+    uint16_t cmd;
+    uint64_t addr;
+    size_t length;
+    size_t rxlength;
+    const void* tx_buffer;
+    void* rx_buffer;
+} spi_transaction_t;
+
+struct spi_device_t {
+    spi_host_device_t host;
+    spi_device_interface_config_t config;
+};
+typedef spi_device_t* spi_device_handle_t;
+
+namespace NativeSpiMaster {
+    inline bool busInitialized[3] = { false, false, false };
+    inline spi_device_t devices[3];
+}
+
+inline esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t* config, int dmaChannel) {
+    if (NativeSpiMaster::busInitialized[host]) return ESP_FAIL;
+    NativeSpiMaster::busInitialized[host] = true;
+    return ESP_OK;
+}
+
+inline esp_err_t spi_bus_free(spi_host_device_t host) {
+    NativeSpiMaster::busInitialized[host] = false;
+    return ESP_OK;
+}
+
+inline esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t* config, spi_device_handle_t* handle) {
+    if (!NativeSpiMaster::busInitialized[host]) return ESP_FAIL;
+    NativeSpiMaster::devices[host] = { host, *config };
+    *handle = &NativeSpiMaster::devices[host];
+    return ESP_OK;
+}
+
+inline esp_err_t spi_bus_remove_device(spi_device_handle_t handle) {
+    return ESP_OK;
+}
+
+inline esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t* transaction) {
+    const auto& config = handle->config;
+    uint8_t header[8];
+    size_t headerLength = 0;
+
+    if (config.command_bits) header[headerLength++] = transaction->cmd & 0xFF;
+    for (int shift = config.address_bits - 8; shift >= 0; shift -= 8) {
+        header[headerLength++] = (transaction->addr >> shift) & 0xFF;
+    }
+    for (int i = 0; i < config.dummy_bits / 8; ++i) header[headerLength++] = 0xFF;
+
+    SPI.setFrequency(config.clock_speed_hz);
+    digitalWrite(config.spics_io_num, LOW);
+    SPI.writeBytes(header, headerLength);
+    if (transaction->length) {
+        SPI.writeBytes(static_cast<const uint8_t*>(transaction->tx_buffer), transaction->length / 8);
+    }
+    if (transaction->rxlength) {
+        bool dual = transaction->flags & SPI_TRANS_MODE_DIO;
+        bool quad = transaction->flags & SPI_TRANS_MODE_QIO;
+        SPI.setDataLanes(quad ? 4 : dual ? 2 : 1);
+        SPI.transferBytes(nullptr, static_cast<uint8_t*>(transaction->rx_buffer), transaction->rxlength / 8);
+        SPI.setDataLanes(1);
+    }
+    digitalWrite(config.spics_io_num, HIGH);
+    return ESP_OK;
+}
@@ -0,0 +1,89 @@
+#include "esp_http_server.h"
+#include <cstring>
+#include <mutex>
+
+static const httpd_uri_t* registeredWs = nullptr;
+static size_t frames = 0;
+static size_t bytes = 0;
+static std::string last;
+static std::mutex statsMutex; // frames are sent from the flusher task
+
+esp_err_t httpd_start(httpd_handle_t* handle, const httpd_config_t* config) {
+    static int server = 0;
+    *handle = &server;
+    return ESP_OK;
+}
+
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t* uri_handler) {
+    if (uri_handler->is_websocket) registeredWs = uri_handler;
+    return ESP_OK;
+}
+
+int httpd_req_to_sockfd(httpd_req_t* r) {
+    return r->sockfd;
+}
+
+esp_err_t httpd_ws_recv_frame(httpd_req_t* req, httpd_ws_frame_t* pkt, size_t max_len) {
+    pkt->len = req->body.size();
+    pkt->final = true;
+    if (max_len == 0) return ESP_OK;
+    if (!pkt->payload || max_len < pkt->len) return ESP_ERR_INVALID_ARG;
+    memcpy(pkt->payload, req->body.data(), pkt->len);
+    return ESP_OK;
+}
+
+esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t* frame) {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    frames++;
+    bytes += frame->len;
+    last.assign(reinterpret_cast<const char*>(frame->payload), frame->len);
+    return ESP_OK;
+}
+
+namespace NativeHttpd {
+
+const httpd_uri_t* wsHandler() {
+    return registeredWs;
+}
+
+esp_err_t connect() {
+    if (!registeredWs) return ESP_FAIL;
+    httpd_req_t req = {};
+    req.method = HTTP_GET;
+    req.user_ctx = registeredWs->user_ctx;
+    req.sockfd = 1;
+    return registeredWs->handler(&req);
+}
+
+esp_err_t deliver(const std::string& payload) {
+    if (!registeredWs) return ESP_FAIL;
+    httpd_req_t req = {};
+    req.method = HTTP_POST;
+    req.user_ctx = registeredWs->user_ctx;
+    req.sockfd = 1;
+    req.body = payload;
+    return registeredWs->handler(&req);
+}
+
+size_t framesSent() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return frames;
+}
+
+size_t bytesSent() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return bytes;
+}
+
+const std::string& lastFrame() {
+    return last;
+}
+
+void resetCounters() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    frames = 0;
+    bytes = 0;
+    last.clear();
+}
+
+}
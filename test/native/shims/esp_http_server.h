@@ -0,0 +1,98 @@
+#pragma once
+
+/*
+Host stand-in for the ESP-IDF HTTP server websocket API.
+
+Outgoing frames are counted (and the last payload kept) so transport
+changes can be measured, incoming frames can be injected per request.
+*/
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+typedef int esp_err_t;
+typedef void* httpd_handle_t;
+
+#ifndef ESP_OK
+#define ESP_OK 0
+#endif
+#define ESP_FAIL         -1
+#define ESP_ERR_NO_MEM   0x101
+#define ESP_ERR_INVALID_ARG 0x102
+
+enum http_method {
+    HTTP_DELETE = 0,
+    HTTP_GET = 1,
+    HTTP_HEAD = 2,
+    HTTP_POST = 3,
+    HTTP_PUT = 4,
+};
+
+typedef enum {
+    HTTPD_WS_TYPE_CONTINUE = 0x0,
+    HTTPD_WS_TYPE_TEXT     = 0x1,
+    HTTPD_WS_TYPE_BINARY   = 0x2,
+    HTTPD_WS_TYPE_CLOSE    = 0x8,
+    HTTPD_WS_TYPE_PING     = 0x9,
+    HTTPD_WS_TYPE_PONG     = 0xA
+} httpd_ws_type_t;
+
+typedef struct httpd_ws_frame {
+    bool final;
+    bool fragmented;
+    httpd_ws_type_t type;
+    uint8_t* payload;
+    size_t len;
+} httpd_ws_frame_t;
+
+typedef struct httpd_req {
+    httpd_handle_t handle;
+    int method;
+    const char* uri;
+    void* user_ctx;
+    int sockfd;
+    std::string body; // native: payload of the incoming ws frame
+} httpd_req_t;
+
+typedef struct httpd_uri {
+    const char* uri;
+    http_method method;
+    esp_err_t (*handler)(httpd_req_t* r);
+    void* user_ctx;
+    bool is_websocket;
+} httpd_uri_t;
+
+typedef struct httpd_config {
+    uint16_t server_port;
+    uint16_t max_uri_handlers;
+    size_t stack_size;
+} httpd_config_t;
+
+#define HTTPD_DEFAULT_CONFIG() { 80, 8, 4096 }
+
+esp_err_t httpd_start(httpd_handle_t* handle, const httpd_config_t* config);
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t* uri_handler);
+int httpd_req_to_sockfd(httpd_req_t* r);
+esp_err_t httpd_ws_recv_frame(httpd_req_t* req, httpd_ws_frame_t* pkt, size_t max_len);
+esp_err_t httpd_ws_send_frame_async(httpd_handle_t hd, int fd, httpd_ws_frame_t* frame);
+
+/*
+Native controls
+*/
+namespace NativeHttpd {
+    // Registered websocket handler, to deliver frames from a fake client
+    const httpd_uri_t* wsHandler();
+
+    // Deliver one text frame to the registered websocket handler
+    esp_err_t deliver(const std::string& payload);
+
+    // Open a websocket client connection (GET handshake)
+    esp_err_t connect();
+
+    // Outgoing frames stats
+    size_t framesSent();
+    size_t bytesSent();
+    const std::string& lastFrame();
+    void resetCounters();
+}
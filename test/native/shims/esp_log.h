@@ -0,0 +1,11 @@
+#pragma once
+
+/*
+Host stand-in for the ESP-IDF logger, logs are dropped
+*/
+
+#define ESP_LOGE(tag, ...) ((void)(tag))
+#define ESP_LOGW(tag, ...) ((void)(tag))
+#define ESP_LOGI(tag, ...) ((void)(tag))
+#define ESP_LOGD(tag, ...) ((void)(tag))
+#define ESP_LOGV(tag, ...) ((void)(tag))
@@ -0,0 +1,72 @@
+#pragma once
+
+/*
+Host stand-in for FreeRTOS queues, copy semantics and blocking timeouts
+*/
+
+#include "FreeRTOS.h"
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <cstring>
+
+struct NativeQueue {
+    size_t capacity;
+    size_t itemSize;
+    std::deque<std::vector<uint8_t>> items;
+    std::mutex mutex;
+    std::condition_variable changed;
+};
+typedef NativeQueue* QueueHandle_t;
+
+namespace NativeRtos {
+    // Wait on the queue condition for at most ticks, false on timeout
+    template <typename Pred>
+    inline bool waitFor(NativeQueue* q, std::unique_lock<std::mutex>& lock, TickType_t ticks, Pred pred) {
+        if (ticks == portMAX_DELAY) {
+            q->changed.wait(lock, pred);
+            return true;
+        }
+        return q->changed.wait_for(lock, std::chrono::milliseconds(ticks), pred);
+    }
+}
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    auto* q = new NativeQueue();
+    q->capacity = length;
+    q->itemSize = itemSize;
+    return q;
+}
+
+inline void vQueueDelete(QueueHandle_t q) {
+    delete q;
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(q->mutex);
+    if (!NativeRtos::waitFor(q, lock, ticks, [q] { return q->items.size() < q->capacity; })) return errQUEUE_FULL;
+    const uint8_t* bytes = static_cast<const uint8_t*>(item);
+    q->items.emplace_back(bytes, bytes + q->itemSize);
+    q->changed.notify_all();
+    return pdPASS;
+}
+
+inline BaseType_t xQueueSendToBack(QueueHandle_t q, const void* item, TickType_t ticks) {
+    return xQueueSend(q, item, ticks);
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(q->mutex);
+    if (!NativeRtos::waitFor(q, lock, ticks, [q] { return !q->items.empty(); })) return pdFALSE;
+    memcpy(item, q->items.front().data(), q->itemSize);
+    q->items.pop_front();
+    q->changed.notify_all();
+    return pdPASS;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    std::lock_guard<std::mutex> lock(q->mutex);
+    return q->items.size();
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+/*
+Host stand-in for FreeRTOS tasks, each task is a detached std::thread.
+Core affinity and priority are ignored, a task ends when its function returns.
+Direct to task notifications are a counter with a condition variable.
+*/
+
+#include "FreeRTOS.h"
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+
+typedef void (*TaskFunction_t)(void*);
+
+struct NativeTask {
+    std::mutex mutex;
+    std::condition_variable notified;
+    uint32_t value = 0;
+};
+typedef NativeTask* TaskHandle_t;
+
+namespace NativeRtos {
+    // Task of the calling thread, threads not created as tasks get one on first use
+    inline NativeTask*& currentTask() {
+        thread_local NativeTask* task = nullptr;
+        return task;
+    }
+}
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackDepth,
+                                          void* param, UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+    auto* task = new NativeTask();
+    std::thread([fn, param, task] {
+        NativeRtos::currentTask() = task;
+        fn(param);
+    }).detach();
+    if (handle) *handle = task;
+    return pdPASS;
+}
+
+inline BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stackDepth,
+                              void* param, UBaseType_t priority, TaskHandle_t* handle) {
+    return xTaskCreatePinnedToCore(fn, name, stackDepth, param, priority, handle, tskNO_AFFINITY);
+}
+
+// Threads cannot be killed, deleting the calling task lets its function return
+inline void vTaskDelete(TaskHandle_t task) {}
+
+inline void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+inline void taskYIELD() {
+    std::this_thread::yield();
+}
+
+inline TickType_t xTaskGetTickCount() {
+    static const auto boot = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - boot).count();
+}
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {
+    auto*& task = NativeRtos::currentTask();
+    if (!task) task = new NativeTask();
+    return task;
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    if (!task) return pdFAIL;
+    std::lock_guard<std::mutex> lock(task->mutex);
+    task->value++;
+    task->notified.notify_all();
+    return pdPASS;
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+    NativeTask* task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    auto ready = [task] { return task->value > 0; };
+    if (ticks == portMAX_DELAY) {
+        task->notified.wait(lock, ready);
+    } else if (!task->notified.wait_for(lock, std::chrono::milliseconds(ticks), ready)) {
+        return 0;
+    }
+    uint32_t value = task->value;
+    task->value = clearOnExit ? 0 : value - 1;
+    return value;
+}
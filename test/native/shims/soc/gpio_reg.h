@@ -0,0 +1,9 @@
+#pragma once
+
+/*
+Host stand-in for the GPIO register addresses of the ESP32-S3
+*/
+
+#define DR_REG_GPIO_BASE 0x60004000
+#define GPIO_IN_REG      (DR_REG_GPIO_BASE + 0x3C) // GPIO 0-31
+#define GPIO_IN1_REG     (DR_REG_GPIO_BASE + 0x40) // GPIO 32-48
@@ -0,0 +1,9 @@
+#pragma once
+
+/*
+Host stand-in for the register access macros, reads come from the native HAL pins
+*/
+
+#include <Arduino.h>
+
+#define REG_READ(reg) NativeHal::readRegister(reg)
@@ -0,0 +1,328 @@
+#include <unity.h>
+#include <string>
+#include "Models/LogicCapture.h"
+#include "Decoders/UartDecoder.h"
+#include "Decoders/I2cDecoder.h"
+#include "Decoders/SpiDecoder.h"
+#include "Decoders/OneWireDecoder.h"
+
+/*
+Decoder tests on synthetic captures, run with: pio test -e native
+*/
+
+// Levels of 8 channels, each change held up to a point in time
+class Waveform {
+public:
+    explicit Waveform(uint8_t idle = 0xFF) : value(idle) {
+        capture.reset(1 << 20);
+    }
+
+    void set(uint8_t channel, bool high) {
+        value = high ? value | (1 << channel) : value & ~(1 << channel);
+    }
+
+    // Current levels until sample round(time)
+    void holdUntil(double time) {
+        while (capture.size() < static_cast<uint64_t>(time + 0.5)) capture.append(value);
+    }
+
+    void hold(double samples) {
+        clock += samples;
+        holdUntil(clock);
+    }
+
+    LogicCapture capture;
+    uint8_t value;
+    double clock = 0;
+};
+
+static void uartByte(Waveform& wave, uint8_t channel, uint8_t byte, double bitSamples, bool stopBit = true) {
+    wave.set(channel, false);
+    wave.hold(bitSamples);
+    for (int i = 0; i < 8; ++i) {
+        wave.set(channel, (byte >> i) & 1);
+        wave.hold(bitSamples);
+    }
+    wave.set(channel, stopBit);
+    wave.hold(bitSamples);
+    wave.set(channel, true);
+}
+
+static void uartText(Waveform& wave, uint8_t channel, const std::string& text, double bitSamples) {
+    for (char c : text) {
+        uartByte(wave, channel, c, bitSamples);
+        wave.hold(bitSamples * 3);
+    }
+}
+
+// I2C on SCL 0 and SDA 1, a quarter clock per step
+static constexpr uint8_t SCL = 0, SDA = 1;
+static constexpr double QUARTER = 10;
+
+static void i2cStart(Waveform& wave) {
+    wave.set(SDA, true);
+    wave.hold(QUARTER);
+    wave.set(SCL, true);
+    wave.hold(QUARTER);
+    wave.set(SDA, false);
+    wave.hold(QUARTER);
+    wave.set(SCL, false);
+    wave.hold(QUARTER);
+}
+
+static void i2cBit(Waveform& wave, bool bit) {
+    wave.set(SDA, bit);
+    wave.hold(QUARTER);
+    wave.set(SCL, true);
+    wave.hold(QUARTER * 2);
+    wave.set(SCL, false);
+    wave.hold(QUARTER);
+}
+
+static void i2cByte(Waveform& wave, uint8_t byte, bool ack) {
+    for (int i = 7; i >= 0; --i) i2cBit(wave, (byte >> i) & 1);
+    i2cBit(wave, !ack);
+}
+
+static void i2cStop(Waveform& wave) {
+    wave.set(SDA, false);
+    wave.hold(QUARTER);
+    wave.set(SCL, true);
+    wave.hold(QUARTER);
+    wave.set(SDA, true);
+    wave.hold(QUARTER * 4);
+}
+
+// SPI on CLK 0, MOSI 1, MISO 2, CS 3, data changes on the edge before the sampling one
+static constexpr uint8_t CLK = 0, MOSI = 1, MISO = 2, CS = 3;
+
+static void spiWord(Waveform& wave, uint8_t mode, uint32_t mosi, uint32_t miso, uint8_t bits = 8) {
+    bool idle = mode >= 2;
+    bool shiftFirst = mode == 0 || mode == 2; // CPHA 0, data before the first edge
+    for (int i = bits - 1; i >= 0; --i) {
+        if (shiftFirst) {
+            wave.set(MOSI, (mosi >> i) & 1);
+            wave.set(MISO, (miso >> i) & 1);
+        }
+        wave.hold(4);
+        wave.set(CLK, !idle);
+        if (!shiftFirst) {
+            wave.set(MOSI, (mosi >> i) & 1);
+            wave.set(MISO, (miso >> i) & 1);
+        }
+        wave.hold(4);
+        wave.set(CLK, idle);
+    }
+    wave.hold(4);
+}
+
+// 1-Wire at 1 MS/s, one sample per microsecond
+static void oneWireLow(Waveform& wave, uint8_t channel, double lowUs, double slotUs) {
+    wave.set(channel, false);
+    wave.hold(lowUs);
+    wave.set(channel, true);
+    wave.hold(slotUs - lowUs);
+}
+
+static void oneWireByte(Waveform& wave, uint8_t channel, uint8_t byte) {
+    for (int i = 0; i < 8; ++i) oneWireLow(wave, channel, (byte >> i) & 1 ? 6 : 65, 75);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_uart_detects_standard_baud() {
+    Waveform wave;
+    wave.hold(500);
+    uartText(wave, 2, "Hello", 2000000.0 / 115200);
+    wave.hold(500);
+
+    UartDecoder decoder(2);
+    const auto& frames = decoder.decode(wave.capture, 2000000);
+
+    TEST_ASSERT_EQUAL_UINT32(115200, decoder.getBaud());
+    TEST_ASSERT_EQUAL(5, frames.size());
+    std::string text;
+    for (const auto& frame : frames) {
+        TEST_ASSERT_FALSE(frame.error);
+        text += static_cast<char>(frame.value);
+    }
+    TEST_ASSERT_EQUAL_STRING("Hello", text.c_str());
+}
+
+void test_uart_keeps_non_standard_baud() {
+    Waveform wave;
+    wave.hold(100);
+    uartText(wave, 0, "\x55\x0F\xF0", 1000000.0 / 31250); // MIDI
+    wave.hold(100);
+
+    UartDecoder decoder(0);
+    const auto& frames = decoder.decode(wave.capture, 1000000);
+
+    TEST_ASSERT_UINT32_WITHIN(300, 31250, decoder.getBaud());
+    TEST_ASSERT_EQUAL(3, frames.size());
+    TEST_ASSERT_EQUAL_HEX32(0x55, frames[0].value);
+    TEST_ASSERT_EQUAL_HEX32(0x0F, frames[1].value);
+    TEST_ASSERT_EQUAL_HEX32(0xF0, frames[2].value);
+}
+
+void test_uart_marks_framing_error() {
+    Waveform wave;
+    const double bit = 1000000.0 / 9600;
+    wave.hold(bit * 2);
+    uartByte(wave, 0, 'A', bit);
+    wave.hold(bit * 2);
+    uartByte(wave, 0, 0x80, bit, false);
+    wave.hold(bit * 2);
+
+    UartDecoder decoder(0, 9600);
+    const auto& frames = decoder.decode(wave.capture, 1000000);
+
+    TEST_ASSERT_EQUAL(2, frames.size());
+    TEST_ASSERT_EQUAL_HEX32('A', frames[0].value);
+    TEST_ASSERT_FALSE(frames[0].error);
+    TEST_ASSERT_TRUE(frames[1].error);
+    TEST_ASSERT_UINT64_WITHIN(1, static_cast<uint64_t>(bit * 2 + 0.5), frames[0].start);
+}
+
+void test_i2c_register_read() {
+    Waveform wave;
+    wave.hold(20);
+    i2cStart(wave);
+    i2cByte(wave, 0x50 << 1, true);
+    i2cByte(wave, 0x12, true);
+    i2cStart(wave);
+    i2cByte(wave, (0x50 << 1) | 1, true);
+    i2cByte(wave, 0xAB, false);
+    i2cStop(wave);
+
+    I2cDecoder decoder(SCL, SDA);
+    const auto& frames = decoder.decode(wave.capture, 1000000);
+
+    TEST_ASSERT_EQUAL(7, frames.size());
+    TEST_ASSERT_TRUE(frames[0].type == LogicFrameEnum::Start);
+    TEST_ASSERT_TRUE(frames[1].type == LogicFrameEnum::Address);
+    TEST_ASSERT_EQUAL_HEX32(0x50, frames[1].value);
+    TEST_ASSERT_FALSE(frames[1].read);
+    TEST_ASSERT_TRUE(frames[1].ack);
+    TEST_ASSERT_TRUE(frames[2].type == LogicFrameEnum::Data);
+    TEST_ASSERT_EQUAL_HEX32(0x12, frames[2].value);
+    TEST_ASSERT_TRUE(frames[3].type == LogicFrameEnum::Start);
+    TEST_ASSERT_TRUE(frames[4].read);
+    TEST_ASSERT_EQUAL_HEX32(0xAB, frames[5].value);
+    TEST_ASSERT_FALSE(frames[5].ack);
+    TEST_ASSERT_TRUE(frames[6].type == LogicFrameEnum::Stop);
+}
+
+void test_spi_mode0_with_cs() {
+    Waveform wave(0xFF & ~(1 << CLK));
+    wave.hold(10);
+    wave.set(CS, false);
+    wave.hold(4);
+    spiWord(wave, 0, 0x9F, 0xFF);
+    spiWord(wave, 0, 0x00, 0xEF);
+    spiWord(wave, 0, 0x00, 0x40);
+    wave.set(CS, true);
+    wave.hold(10);
+
+    SpiDecoder decoder(CLK, MOSI, MISO, CS, 0);
+    const auto& frames = decoder.decode(wave.capture, 1000000);
+
+    TEST_ASSERT_EQUAL(3, frames.size());
+    TEST_ASSERT_EQUAL_HEX32(0x9F, frames[0].value);
+    TEST_ASSERT_EQUAL_HEX32(0xFF, frames[0].miso);
+    TEST_ASSERT_EQUAL_HEX32(0xEF, frames[1].miso);
+    TEST_ASSERT_EQUAL_HEX32(0x40, frames[2].miso);
+    TEST_ASSERT_FALSE(frames[2].error);
+}
+
+void test_spi_mode3_word_cut_by_cs() {
+    Waveform wave;
+    wave.hold(10);
+    wave.set(CS, false);
+    wave.hold(4);
+    spiWord(wave, 3, 0xA55A, 0x1234, 16);
+    spiWord(wave, 3, 0x5, 0x0, 3);
+    wave.set(CS, true);
+    wave.hold(10);
+
+    SpiDecoder decoder(CLK, MOSI, MISO, CS, 3, 16);
+    const auto& frames = decoder.decode(wave.capture, 1000000);
+
+    TEST_ASSERT_EQUAL(2, frames.size());
+    TEST_ASSERT_EQUAL_HEX32(0xA55A, frames[0].value);
+    TEST_ASSERT_EQUAL_HEX32(0x1234, frames[0].miso);
+    TEST_ASSERT_TRUE(frames[1].error);
+    TEST_ASSERT_EQUAL_HEX32(0x5, frames[1].value);
+}
+
+void test_onewire_reset_presence_and_bytes() {
+    Waveform wave;
+    wave.hold(100);
+    oneWireLow(wave, 4, 480, 510);      // reset, released for 30 us
+    oneWireLow(wave, 4, 120, 450);      // presence
+    oneWireByte(wave, 4, 0xCC);         // skip ROM
+    oneWireByte(wave, 4, 0x44);         // convert T
+    wave.hold(100);
+
+    OneWireDecoder decoder(4);
+    const auto& frames = decoder.decode(wave.capture, 1000000);
+
+    TEST_ASSERT_EQUAL(4, frames.size());
+    TEST_ASSERT_TRUE(frames[0].type == LogicFrameEnum::Reset);
+    TEST_ASSERT_TRUE(frames[1].type == LogicFrameEnum::Presence);
+    TEST_ASSERT_EQUAL_HEX32(0xCC, frames[2].value);
+    TEST_ASSERT_EQUAL_HEX32(0x44, frames[3].value);
+}
+
+void test_onewire_reset_without_presence() {
+    Waveform wave;
+    wave.hold(100);
+    oneWireLow(wave, 0, 500, 1000);
+    oneWireByte(wave, 0, 0x33);
+
+    OneWireDecoder decoder(0);
+    const auto& frames = decoder.decode(wave.capture, 1000000);
+
+    TEST_ASSERT_EQUAL(2, frames.size());
+    TEST_ASSERT_TRUE(frames[0].type == LogicFrameEnum::Reset);
+    TEST_ASSERT_EQUAL_HEX32(0x33, frames[1].value);
+}
+
+void test_decode_stops_at_frame_limit() {
+    Waveform wave;
+    wave.hold(100);
+    uartText(wave, 0, "0123456789", 10);
+
+    UartDecoder decoder(0, 100000);
+    const auto& frames = decoder.decode(wave.capture, 1000000, 4);
+
+    TEST_ASSERT_EQUAL(4, frames.size());
+    TEST_ASSERT_EQUAL_HEX32('3', frames[3].value);
+}
+
+void test_idle_capture_has_no_frames() {
+    Waveform wave;
+    wave.hold(100000);
+
+    UartDecoder uart(0);
+    I2cDecoder i2c(SCL, SDA);
+    TEST_ASSERT_EQUAL(0, uart.decode(wave.capture, 1000000).size());
+    TEST_ASSERT_EQUAL_UINT32(0, uart.getBaud());
+    TEST_ASSERT_EQUAL(0, i2c.decode(wave.capture, 1000000).size());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_uart_detects_standard_baud);
+    RUN_TEST(test_uart_keeps_non_standard_baud);
+    RUN_TEST(test_uart_marks_framing_error);
+    RUN_TEST(test_i2c_register_read);
+    RUN_TEST(test_spi_mode0_with_cs);
+    RUN_TEST(test_spi_mode3_word_cut_by_cs);
+    RUN_TEST(test_onewire_reset_presence_and_bytes);
+    RUN_TEST(test_onewire_reset_without_presence);
+    RUN_TEST(test_decode_stops_at_frame_limit);
+    RUN_TEST(test_idle_capture_has_no_frames);
+    return UNITY_END();
+}